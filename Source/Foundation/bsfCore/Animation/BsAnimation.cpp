@@ -22,8 +22,8 @@ namespace bs
 	AnimationProxy::AnimationProxy(UINT64 id)
 		: id(id), layers(nullptr), numLayers(0), numSceneObjects(0), sceneObjectInfos(nullptr)
 		, sceneObjectTransforms(nullptr), morphChannelInfos(nullptr), morphShapeInfos(nullptr), numMorphChannels(0)
-		, numMorphShapes(0), numMorphVertices(0), morphChannelWeightsDirty(false), mCullEnabled(true), numGenericCurves(0)
-		, genericCurveOutputs(nullptr)
+		, numMorphShapes(0), numMorphVertices(0), morphChannelWeightsDirty(false), mCullEnabled(true), lodIdx((UINT32)-1)
+		, lodUpdateIdx(0), numGenericCurves(0), genericCurveOutputs(nullptr)
 	{ }
 
 	AnimationProxy::~AnimationProxy()
@@ -106,12 +106,21 @@ namespace bs
 	}
 
 	void AnimationProxy::rebuild(const SPtr<Skeleton>& skeleton, const SkeletonMask& mask, 
-		Vector<AnimationClipInfo>& clipInfos, const Vector<AnimatedSceneObject>& sceneObjects, 
-		const SPtr<MorphShapes>& morphShapes)
+		const Vector<AnimationLOD>& lods, Vector<AnimationClipInfo>& clipInfos, 
+		const Vector<AnimatedSceneObject>& sceneObjects, const SPtr<MorphShapes>& morphShapes)
 	{
 		this->skeleton = skeleton;
 		this->skeletonMask = mask;
 
+		this->lods = lods;
+		for (auto& lod : this->lods)
+			lod.mask = lod.mask.intersect(mask);
+
+		// Cached poses might not match the new skeleton, restart the interpolation on the next evaluation
+		lodIdx = (UINT32)-1;
+		lodPoses[0] = LocalSkeletonPose();
+		lodPoses[1] = LocalSkeletonPose();
+
 		// Note: I could avoid having a separate allocation for LocalSkeletonPoses and use the same buffer as the rest
 		// of AnimationProxy
 		if (skeleton != nullptr)
@@ -438,12 +447,14 @@ namespace bs
 					if (isClipValid)
 					{
 						state.curves = clipInfo.clip->getCurves();
+						state.compressedCurves = clipInfo.clip->getCompressedCurves();
 						state.disabled = clipInfo.playbackType == AnimPlaybackType::None;
 					}
 					else
 					{
 						static SPtr<AnimationCurves> zeroCurves = bs_shared_ptr_new<AnimationCurves>();
 						state.curves = zeroCurves;
+						state.compressedCurves = nullptr;
 						state.disabled = true;
 					}
 
@@ -693,6 +704,18 @@ namespace bs
 		mDirty |= AnimDirtyStateFlag::All;
 	}
 
+	void Animation::setLODs(const Vector<AnimationLOD>& lods)
+	{
+		mLODs = lods;
+		std::sort(mLODs.begin(), mLODs.end(), 
+			[](const AnimationLOD& a, const AnimationLOD& b)
+		{
+			return a.distance < b.distance;
+		});
+
+		mDirty |= AnimDirtyStateFlag::All;
+	}
+
 	void Animation::setWrapMode(AnimWrapMode wrapMode)
 	{
 		mDefaultWrapMode = wrapMode;
@@ -1310,7 +1333,7 @@ namespace bs
 			{
 				Vector<AnimatedSceneObject> animatedSOs = getAnimatedSOList();
 
-				mAnimProxy->rebuild(mSkeleton, mSkeletonMask, mClipInfos, animatedSOs, mMorphShapes);
+				mAnimProxy->rebuild(mSkeleton, mSkeletonMask, mLODs, mClipInfos, animatedSOs, mMorphShapes);
 				didFullRebuild = true;
 			}
 			else if (mDirty.isSet(AnimDirtyStateFlag::Layout))
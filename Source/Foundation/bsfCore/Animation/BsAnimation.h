@@ -115,6 +115,28 @@ namespace bs
 		HAnimationClip botRightClip;
 	};
 
+	/** 
+	 * Describes a level of detail at which an animation is evaluated, once its bounds are at least @p distance away
+	 * from the nearest camera. Lower levels of detail are evaluated less often and can evaluate fewer bones.
+	 */
+	struct AnimationLOD
+	{
+		/** Distance from the nearest camera, in world units, at which this level of detail starts being used. */
+		float distance = 0.0f;
+
+		/** 
+		 * Number of animation updates between two evaluations. Poses for the updates in between are interpolated from the
+		 * last two evaluated poses. Evaluations of different animations are staggered across updates.
+		 */
+		UINT32 updateInterval = 1;
+
+		/** 
+		 * Mask that disables bones not evaluated at this level of detail, such as fingers or facial bones. Disabled bones
+		 * keep their bind pose relative to their parent. Applied on top of the mask provided to Animation::setMask().
+		 */
+		SkeletonMask mask;
+	};
+
 	/** Contains a mapping between a scene object and an animation curve it is animated with. */
 	struct AnimatedSceneObject
 	{
@@ -167,6 +189,7 @@ namespace bs
 		 *
 		 * @param[in]		skeleton		New skeleton to assign to the proxy.
 		 * @param[in]		mask			Mask that filters which skeleton bones are enabled or disabled.
+		 * @param[in]		lods			Levels of detail to evaluate the animation at, sorted by distance.
 		 * @param[in, out]	clipInfos		Potentially new clip infos that will be used for rebuilding the proxy. Once the
 		 *									method completes clip info layout and state indices will be populated for 
 		 *									further use in the update*() methods.
@@ -175,8 +198,9 @@ namespace bs
 		 *
 		 * @note	Should be called from the sim thread when the caller is sure the animation thread is not using it.
 		 */
-		void rebuild(const SPtr<Skeleton>& skeleton, const SkeletonMask& mask, Vector<AnimationClipInfo>& clipInfos, 
-			const Vector<AnimatedSceneObject>& sceneObjects, const SPtr<MorphShapes>& morphShapes);
+		void rebuild(const SPtr<Skeleton>& skeleton, const SkeletonMask& mask, const Vector<AnimationLOD>& lods,
+			Vector<AnimationClipInfo>& clipInfos, const Vector<AnimatedSceneObject>& sceneObjects, 
+			const SPtr<MorphShapes>& morphShapes);
 
 		/** 
 		 * Rebuilds the internal proxy data according to the newly clips. This should be called whenever clips are added
@@ -249,6 +273,12 @@ namespace bs
 		AABox mBounds;
 		bool mCullEnabled;
 
+		// Level of detail
+		Vector<AnimationLOD> lods; /**< Levels of detail, with masks already combined with @p skeletonMask. */
+		UINT32 lodIdx; /**< Level of detail used on the last evaluation, or -1 if evaluated at full detail. */
+		UINT32 lodUpdateIdx; /**< Index of the animation update the animation was last evaluated on. */
+		LocalSkeletonPose lodPoses[2]; /**< Last two evaluated local skeleton poses, used for interpolation. */
+
 		// Evaluation results
 		LocalSkeletonPose skeletonPose;
 		LocalSkeletonPose sceneObjectPose;
@@ -312,6 +342,14 @@ namespace bs
 		 */
 		void setCulling(bool cull);
 
+		/** 
+		 * Sets levels of detail that determine how often and with how many bones is the animation evaluated, depending on
+		 * the distance between its bounds (as provided to setBounds()) and the nearest camera. Animations closer than the
+		 * distance of the first level are evaluated at full detail. Caller must ensure the level masks match the skeleton
+		 * assigned to the animation.
+		 */
+		void setLODs(const Vector<AnimationLOD>& lods);
+
 		/** 
 		 * Plays the specified animation clip. 
 		 *
@@ -513,6 +551,7 @@ namespace bs
 
 		SPtr<Skeleton> mSkeleton;
 		SkeletonMask mSkeletonMask;
+		Vector<AnimationLOD> mLODs;
 		SPtr<MorphShapes> mMorphShapes;
 		Vector<float> mMorphChannelWeights;
 		Vector<AnimationClipInfo> mClipInfos;
@@ -139,12 +139,47 @@ namespace bs
 	void AnimationClip::setCurves(const AnimationCurves& curves)
 	{
 		*mCurves = curves;
+		mCompressedCurves = nullptr;
 
 		buildNameMapping();
 		calculateLength();
 		mVersion++;
 	}
 
+	AnimationCompressionReport AnimationClip::compress(const AnimationCompressionSettings& settings)
+	{
+		if (mCompressedCurves != nullptr)
+			return mCompressedCurves->getReport();
+
+		mCompressedCurves = CompressedAnimationCurves::create(*mCurves, settings);
+
+		// Keep curve names and flags so name mapping remains the same, but drop the now unused keyframes
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		curves->generic = mCurves->generic;
+
+		auto copyNames = [](const auto& input, auto& output)
+		{
+			output.resize(input.size());
+			for (UINT32 i = 0; i < (UINT32)input.size(); i++)
+			{
+				output[i].name = input[i].name;
+				output[i].flags = input[i].flags;
+			}
+		};
+
+		copyNames(mCurves->position, curves->position);
+		copyNames(mCurves->rotation, curves->rotation);
+		copyNames(mCurves->scale, curves->scale);
+
+		mCurves = curves;
+
+		buildNameMapping();
+		calculateLength();
+		mVersion++;
+
+		return mCompressedCurves->getReport();
+	}
+
 	bool AnimationClip::hasRootMotion() const
 	{
 		return mRootMotion != nullptr && 
@@ -166,6 +201,9 @@ namespace bs
 
 		for (auto& entry : mCurves->generic)
 			mLength = std::max(mLength, entry.curve.getLength());
+
+		if (mCompressedCurves != nullptr)
+			mLength = std::max(mLength, mCompressedCurves->getLength());
 	}
 
 	void AnimationClip::buildNameMapping()
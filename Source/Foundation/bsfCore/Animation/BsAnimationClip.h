@@ -7,6 +7,7 @@
 #include "Math/BsVector3.h"
 #include "Math/BsQuaternion.h"
 #include "Animation/BsAnimationCurve.h"
+#include "Animation/BsAnimationCompression.h"
 
 namespace bs
 {
@@ -242,6 +243,27 @@ namespace bs
 		 */
 		UINT64 getVersion() const { return mVersion; }
 
+		/**
+		 * Compresses the position, rotation and scale curves of the clip. Compressed curves require significantly less
+		 * memory and are faster to evaluate, at the cost of some precision as controlled by @p settings. After compression
+		 * the position, rotation and scale curves returned by getCurves() will retain their names and flags, but will
+		 * no longer contain any keyframes. Generic curves and root motion are not affected. Calling setCurves() will
+		 * discard the compressed data.
+		 *
+		 * @param[in]	settings	Settings that control the allowed error and the amount of keyframe reduction.
+		 * @return					Information about the achieved compression ratio and the introduced error.
+		 */
+		AnimationCompressionReport compress(const AnimationCompressionSettings& settings);
+
+		/** Checks has the clip been compressed through compress(). */
+		bool isCompressed() const { return mCompressedCurves != nullptr; }
+
+		/**
+		 * Returns the compressed position, rotation and scale curves of the clip, or null if the clip hasn't been
+		 * compressed. Tracks in the compressed curve set have the same indices as the curves returned by getCurves().
+		 */
+		SPtr<CompressedAnimationCurves> getCompressedCurves() const { return mCompressedCurves; }
+
 		/** 
 		 * Creates an animation clip with no curves. After creation make sure to register some animation curves before
 		 * using it. 
@@ -298,6 +320,12 @@ namespace bs
 		 */
 		SPtr<AnimationCurves> mCurves;
 
+		/** 
+		 * Compressed version of position, rotation and scale curves from mCurves, if the clip was compressed. Immutable,
+		 * same as mCurves.
+		 */
+		SPtr<CompressedAnimationCurves> mCompressedCurves;
+
 		/**
 		 * A set of curves containing motion of the root bone. If this is non-empty it should be true that mCurves does not
 		 * contain animation curves for the root bone. Root motion will not be evaluated through normal animation process
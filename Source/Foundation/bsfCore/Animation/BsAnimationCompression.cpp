@@ -0,0 +1,519 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Animation/BsAnimationCompression.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationUtility.h"
+#include "Private/RTTI/BsAnimationCompressionRTTI.h"
+#include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
+
+namespace bs
+{
+	/** Maximum value of a quantized vector component. */
+	static const float VECTOR_QUANT_MAX = 65535.0f;
+
+	/** Maximum value of a quantized rotation component, and the mask used for extracting it. */
+	static const float ROTATION_QUANT_MAX = 32767.0f;
+	static const UINT16 ROTATION_QUANT_MASK = 0x7FFF;
+
+	/**
+	 * Range of the three smallest components of a normalized quaternion. Since the largest component is at least as
+	 * large as any other, the remaining ones must be in [-1/sqrt(2), 1/sqrt(2)] range.
+	 */
+	static const float ROTATION_RANGE = 0.70710678f;
+
+	/** Samples a curve at evenly spaced intervals. */
+	template<class T>
+	static void sampleCurve(const TAnimationCurve<T>& curve, UINT32 numFrames, float frameStep, Vector<T>& output)
+	{
+		output.resize(numFrames);
+		for (UINT32 i = 0; i < numFrames; i++)
+			output[i] = curve.evaluate(i * frameStep, false);
+	}
+
+	/** Returns the angle between two rotations, in radians. */
+	static float getRotationError(const Quaternion& a, const Quaternion& b)
+	{
+		float dot = std::min(std::abs(Quaternion::dot(a, b)), 1.0f);
+		return 2.0f * std::acos(dot);
+	}
+
+	/** Returns the maximum per-component difference between two vectors. */
+	static float getVectorError(const Vector3& a, const Vector3& b)
+	{
+		return std::max(std::max(std::abs(a.x - b.x), std::abs(a.y - b.y)), std::abs(a.z - b.z));
+	}
+
+	/** Encodes a rotation using three 15-bit components, with the index of the omitted largest component in top bits. */
+	static void encodeRotation(const Quaternion& input, UINT16& a, UINT16& b, UINT16& c)
+	{
+		Quaternion rotation = Quaternion::normalize(input);
+
+		UINT32 largestIdx = 0;
+		for (UINT32 i = 1; i < 4; i++)
+		{
+			if (std::abs(rotation[i]) > std::abs(rotation[largestIdx]))
+				largestIdx = i;
+		}
+
+		// Both q and -q represent the same rotation, make sure the omitted component is positive so it can be restored
+		float sign = rotation[largestIdx] < 0.0f ? -1.0f : 1.0f;
+
+		UINT16 values[3];
+		UINT32 outIdx = 0;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (i == largestIdx)
+				continue;
+
+			float normalized = (rotation[i] * sign + ROTATION_RANGE) / (2.0f * ROTATION_RANGE);
+			normalized = Math::clamp01(normalized);
+
+			values[outIdx++] = (UINT16)Math::roundToInt(normalized * ROTATION_QUANT_MAX);
+		}
+
+		a = values[0] | (UINT16)((largestIdx & 0x1) << 15);
+		b = values[1] | (UINT16)((largestIdx >> 1) << 15);
+		c = values[2];
+	}
+
+	/** Interpolates between two rotations, taking the shortest path. */
+	static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t)
+	{
+		float sign = Quaternion::dot(a, b) < 0.0f ? -1.0f : 1.0f;
+
+		Quaternion output(
+			a.w + (b.w * sign - a.w) * t,
+			a.x + (b.x * sign - a.x) * t,
+			a.y + (b.y * sign - a.y) * t,
+			a.z + (b.z * sign - a.z) * t);
+
+		output.normalize();
+		return output;
+	}
+
+	/** Decodes the rotations of a group of tracks from a single frame. */
+	static void decodeRotationGroup(const UINT16* a, const UINT16* b, const UINT16* c, Quaternion* output)
+	{
+		using namespace simd;
+
+		uint16<8> encodedA = load_u<uint16<8>>(a);
+		uint16<8> encodedB = load_u<uint16<8>>(b);
+		uint16<8> encodedC = load_u<uint16<8>>(c);
+
+		uint16<8> mask = splat<uint16<8>>(ROTATION_QUANT_MASK);
+		uint16<8> largestIdx = bit_or(shift_r<15>(encodedA), shift_l<1>(shift_r<15>(encodedB)));
+
+		float32<8> scale = splat<float32<8>>(2.0f * ROTATION_RANGE / ROTATION_QUANT_MAX);
+		float32<8> offset = splat<float32<8>>(-ROTATION_RANGE);
+
+		float32<8> valueA = add(mul(to_float32(to_int32(bit_and(encodedA, mask))), scale), offset);
+		float32<8> valueB = add(mul(to_float32(to_int32(bit_and(encodedB, mask))), scale), offset);
+		float32<8> valueC = add(mul(to_float32(to_int32(bit_and(encodedC, mask))), scale), offset);
+
+		float32<8> sumSqrd = add(add(mul(valueA, valueA), mul(valueB, valueB)), mul(valueC, valueC));
+		float32<8> valueD = sqrt(max(sub(splat<float32<8>>(1.0f), sumSqrd), splat<float32<8>>(0.0f)));
+
+		float components[4][8];
+		UINT16 indices[8];
+		store_u(components[0], valueA);
+		store_u(components[1], valueB);
+		store_u(components[2], valueC);
+		store_u(components[3], valueD);
+		store_u(indices, largestIdx);
+
+		for (UINT32 i = 0; i < 8; i++)
+		{
+			UINT32 largest = indices[i];
+			Quaternion& rotation = output[i];
+
+			UINT32 inIdx = 0;
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				if (j == largest)
+					rotation[j] = components[3][i];
+				else
+					rotation[j] = components[inIdx++][i];
+			}
+		}
+	}
+
+	UINT32 CompressedAnimationCurves::getPaddedCount(UINT32 count)
+	{
+		return Math::divideAndRoundUp(count, TRACK_GROUP_SIZE) * TRACK_GROUP_SIZE;
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::create(const AnimationCurves& curves,
+		const AnimationCompressionSettings& settings)
+	{
+		float sampleRate = (float)std::max(settings.sampleRate, 1U);
+
+		// Errors are measured at a multiple of the source rate, so the values in-between the source samples are validated
+		// as well
+		float referenceRate = sampleRate * 4.0f;
+
+		// Find the lowest sample rate that still keeps all tracks within their error thresholds
+		UINT32 maxReduction = std::max(settings.maxSampleRateReduction, 1U);
+		for (UINT32 i = maxReduction; i > 1; i--)
+		{
+			SPtr<CompressedAnimationCurves> output = compress(curves, settings, sampleRate / i);
+			output->calculateError(curves, referenceRate);
+
+			const AnimationCompressionReport& report = output->mReport;
+			if (report.maxPositionError <= settings.positionError &&
+				report.maxRotationError <= settings.rotationError &&
+				report.maxScaleError <= settings.scaleError)
+			{
+				return output;
+			}
+		}
+
+		SPtr<CompressedAnimationCurves> output = compress(curves, settings, sampleRate);
+		output->calculateError(curves, referenceRate);
+
+		return output;
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::compress(const AnimationCurves& curves,
+		const AnimationCompressionSettings& settings, float sampleRate)
+	{
+		SPtr<CompressedAnimationCurves> output = bs_shared_ptr_new<CompressedAnimationCurves>();
+		AnimationCompressionReport& report = output->mReport;
+
+		float length = 0.0f;
+		UINT32 uncompressedSize = 0;
+		for (auto& entry : curves.position)
+		{
+			length = std::max(length, entry.curve.getLength());
+			uncompressedSize += entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Vector3>);
+		}
+
+		for (auto& entry : curves.rotation)
+		{
+			length = std::max(length, entry.curve.getLength());
+			uncompressedSize += entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Quaternion>);
+		}
+
+		for (auto& entry : curves.scale)
+		{
+			length = std::max(length, entry.curve.getLength());
+			uncompressedSize += entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Vector3>);
+		}
+
+		// Frames are evenly spaced and the last frame always lands at the end of the animation
+		UINT32 numFrames = 1;
+		float frameStep = 0.0f;
+		if (length > 0.0f)
+		{
+			numFrames = std::max((UINT32)std::ceil(length * sampleRate - 0.001f), 1U) + 1;
+			frameStep = length / (numFrames - 1);
+		}
+
+		output->mLength = length;
+		output->mNumFrames = numFrames;
+		output->mSampleRate = frameStep > 0.0f ? 1.0f / frameStep : 0.0f;
+
+		// Sample all curves and determine which tracks are constant
+		Vector<Vector<Vector3>> positionSamples(curves.position.size());
+		Vector<Vector<Quaternion>> rotationSamples(curves.rotation.size());
+		Vector<Vector<Vector3>> scaleSamples(curves.scale.size());
+
+		auto findConstantVectorTracks = [numFrames, frameStep](const Vector<TNamedAnimationCurve<Vector3>>& curves,
+			float maxError, Vector<Vector<Vector3>>& samples, VectorTracks& tracks)
+		{
+			UINT32 numCurves = (UINT32)curves.size();
+			tracks.constantValues.resize(numCurves);
+
+			for (UINT32 i = 0; i < numCurves; i++)
+			{
+				sampleCurve(curves[i].curve, numFrames, frameStep, samples[i]);
+
+				Vector3 min = samples[i][0];
+				Vector3 max = samples[i][0];
+				for (auto& value : samples[i])
+				{
+					min = Vector3::min(min, value);
+					max = Vector3::max(max, value);
+				}
+
+				tracks.constantValues[i] = (min + max) * 0.5f;
+
+				Vector3 extent = max - min;
+				if (extent.x > maxError * 2.0f || extent.y > maxError * 2.0f || extent.z > maxError * 2.0f)
+					tracks.animatedTracks.push_back(i);
+			}
+		};
+
+		findConstantVectorTracks(curves.position, settings.positionError, positionSamples, output->mPositions);
+		findConstantVectorTracks(curves.scale, settings.scaleError, scaleSamples, output->mScales);
+
+		UINT32 numRotationCurves = (UINT32)curves.rotation.size();
+		output->mRotations.constantValues.resize(numRotationCurves);
+		for (UINT32 i = 0; i < numRotationCurves; i++)
+		{
+			sampleCurve(curves.rotation[i].curve, numFrames, frameStep, rotationSamples[i]);
+
+			Quaternion first = Quaternion::normalize(rotationSamples[i][0]);
+			output->mRotations.constantValues[i] = first;
+
+			for (auto& value : rotationSamples[i])
+			{
+				if (getRotationError(first, Quaternion::normalize(value)) > settings.rotationError)
+				{
+					output->mRotations.animatedTracks.push_back(i);
+					break;
+				}
+			}
+		}
+
+		// Calculate quantization ranges of animated vector tracks
+		auto calculateRanges = [](const Vector<Vector<Vector3>>& samples, VectorTracks& tracks)
+		{
+			UINT32 numAnimated = (UINT32)tracks.animatedTracks.size();
+			UINT32 paddedCount = getPaddedCount(numAnimated);
+
+			tracks.rangeMin.resize(paddedCount * 3, 0.0f);
+			tracks.rangeStep.resize(paddedCount * 3, 0.0f);
+
+			for (UINT32 i = 0; i < numAnimated; i++)
+			{
+				const Vector<Vector3>& trackSamples = samples[tracks.animatedTracks[i]];
+
+				Vector3 min = trackSamples[0];
+				Vector3 max = trackSamples[0];
+				for (auto& value : trackSamples)
+				{
+					min = Vector3::min(min, value);
+					max = Vector3::max(max, value);
+				}
+
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					tracks.rangeMin[j * paddedCount + i] = min[j];
+					tracks.rangeStep[j * paddedCount + i] = (max[j] - min[j]) / VECTOR_QUANT_MAX;
+				}
+			}
+		};
+
+		calculateRanges(positionSamples, output->mPositions);
+		calculateRanges(scaleSamples, output->mScales);
+
+		// Quantize the samples and store them in the frame data
+		UINT32 paddedPositionCount = getPaddedCount((UINT32)output->mPositions.animatedTracks.size());
+		UINT32 paddedRotationCount = getPaddedCount((UINT32)output->mRotations.animatedTracks.size());
+		UINT32 paddedScaleCount = getPaddedCount((UINT32)output->mScales.animatedTracks.size());
+
+		output->mFrameStride = (paddedPositionCount + paddedRotationCount + paddedScaleCount) * 3;
+		output->mFrameData.resize(output->mFrameStride * numFrames, 0);
+
+		auto quantizeVectorTracks = [numFrames, stride = output->mFrameStride](const Vector<Vector<Vector3>>& samples,
+			const VectorTracks& tracks, UINT16* data)
+		{
+			UINT32 numAnimated = (UINT32)tracks.animatedTracks.size();
+			UINT32 paddedCount = getPaddedCount(numAnimated);
+
+			for (UINT32 i = 0; i < numAnimated; i++)
+			{
+				const Vector<Vector3>& trackSamples = samples[tracks.animatedTracks[i]];
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					UINT32 rangeIdx = j * paddedCount + i;
+					float min = tracks.rangeMin[rangeIdx];
+					float step = tracks.rangeStep[rangeIdx];
+					float invStep = step > 0.0f ? 1.0f / step : 0.0f;
+
+					for (UINT32 frame = 0; frame < numFrames; frame++)
+					{
+						float normalized = Math::clamp((trackSamples[frame][j] - min) * invStep, 0.0f, VECTOR_QUANT_MAX);
+						data[frame * stride + rangeIdx] = (UINT16)Math::roundToInt(normalized);
+					}
+				}
+			}
+		};
+
+		UINT16* positionData = output->mFrameData.data();
+		UINT16* rotationData = positionData + paddedPositionCount * 3;
+		UINT16* scaleData = rotationData + paddedRotationCount * 3;
+
+		quantizeVectorTracks(positionSamples, output->mPositions, positionData);
+		quantizeVectorTracks(scaleSamples, output->mScales, scaleData);
+
+		UINT32 numAnimatedRotations = (UINT32)output->mRotations.animatedTracks.size();
+		for (UINT32 i = 0; i < numAnimatedRotations; i++)
+		{
+			const Vector<Quaternion>& trackSamples = rotationSamples[output->mRotations.animatedTracks[i]];
+			for (UINT32 frame = 0; frame < numFrames; frame++)
+			{
+				UINT16* frameData = rotationData + frame * output->mFrameStride;
+				encodeRotation(trackSamples[frame], frameData[i], frameData[paddedRotationCount + i],
+					frameData[paddedRotationCount * 2 + i]);
+			}
+		}
+
+		// Fill out the report
+		UINT32 numTracks = (UINT32)(curves.position.size() + curves.rotation.size() + curves.scale.size());
+		report.numAnimatedTracks = (UINT32)(output->mPositions.animatedTracks.size() + numAnimatedRotations +
+			output->mScales.animatedTracks.size());
+		report.numConstantTracks = numTracks - report.numAnimatedTracks;
+		report.sampleRate = output->mSampleRate;
+
+		UINT32 compressedSize = (UINT32)(output->mFrameData.size() * sizeof(UINT16));
+		compressedSize += (UINT32)((output->mPositions.constantValues.size() + output->mScales.constantValues.size())
+			* sizeof(Vector3));
+		compressedSize += (UINT32)(output->mRotations.constantValues.size() * sizeof(Quaternion));
+		compressedSize += (UINT32)((output->mPositions.rangeMin.size() + output->mScales.rangeMin.size()) * 2
+			* sizeof(float));
+		compressedSize += report.numAnimatedTracks * sizeof(UINT32);
+
+		report.uncompressedSize = uncompressedSize;
+		report.compressedSize = compressedSize;
+		report.compressionRatio = compressedSize > 0 ? uncompressedSize / (float)compressedSize : 1.0f;
+
+		return output;
+	}
+
+	void CompressedAnimationCurves::calculateError(const AnimationCurves& curves, float sampleRate)
+	{
+		UINT32 numPositions = getNumPositionTracks();
+		UINT32 numRotations = getNumRotationTracks();
+		UINT32 numScales = getNumScaleTracks();
+
+		Vector<Vector3> positions(numPositions);
+		Vector<Quaternion> rotations(numRotations);
+		Vector<Vector3> scales(numScales);
+
+		UINT32 numSamples = (UINT32)std::ceil(mLength * sampleRate) + 1;
+		float sampleStep = numSamples > 1 ? mLength / (numSamples - 1) : 0.0f;
+
+		mReport.maxPositionError = 0.0f;
+		mReport.maxRotationError = 0.0f;
+		mReport.maxScaleError = 0.0f;
+
+		for (UINT32 i = 0; i < numSamples; i++)
+		{
+			float time = i * sampleStep;
+			evaluate(time, false, positions.data(), rotations.data(), scales.data());
+
+			for (UINT32 j = 0; j < numPositions; j++)
+			{
+				Vector3 expected = curves.position[j].curve.evaluate(time, false);
+				mReport.maxPositionError = std::max(mReport.maxPositionError, getVectorError(expected, positions[j]));
+			}
+
+			for (UINT32 j = 0; j < numRotations; j++)
+			{
+				Quaternion expected = Quaternion::normalize(curves.rotation[j].curve.evaluate(time, false));
+				mReport.maxRotationError = std::max(mReport.maxRotationError, getRotationError(expected, rotations[j]));
+			}
+
+			for (UINT32 j = 0; j < numScales; j++)
+			{
+				Vector3 expected = curves.scale[j].curve.evaluate(time, false);
+				mReport.maxScaleError = std::max(mReport.maxScaleError, getVectorError(expected, scales[j]));
+			}
+		}
+	}
+
+	void CompressedAnimationCurves::evaluate(float time, bool loop, Vector3* positions, Quaternion* rotations,
+		Vector3* scales) const
+	{
+		// Find the two frames to interpolate between
+		UINT32 frameIdx = 0;
+		float t = 0.0f;
+		if (mNumFrames > 1)
+		{
+			AnimationUtility::wrapTime(time, 0.0f, mLength, loop);
+
+			float framePos = time * mSampleRate;
+			frameIdx = std::min((UINT32)framePos, mNumFrames - 2);
+			t = Math::clamp01(framePos - frameIdx);
+		}
+
+		const UINT16* frame0 = mFrameData.data() + frameIdx * mFrameStride;
+		const UINT16* frame1 = mNumFrames > 1 ? frame0 + mFrameStride : frame0;
+
+		UINT32 positionOffset = getPaddedCount((UINT32)mPositions.animatedTracks.size()) * 3;
+		UINT32 rotationOffset = positionOffset + getPaddedCount((UINT32)mRotations.animatedTracks.size()) * 3;
+
+		if (positions != nullptr)
+		{
+			memcpy(positions, mPositions.constantValues.data(), mPositions.constantValues.size() * sizeof(Vector3));
+			evaluateVectorTracks(mPositions, frame0, frame1, t, positions);
+		}
+
+		if (rotations != nullptr)
+		{
+			memcpy(rotations, mRotations.constantValues.data(), mRotations.constantValues.size() * sizeof(Quaternion));
+			evaluateRotationTracks(mRotations, frame0 + positionOffset, frame1 + positionOffset, t, rotations);
+		}
+
+		if (scales != nullptr)
+		{
+			memcpy(scales, mScales.constantValues.data(), mScales.constantValues.size() * sizeof(Vector3));
+			evaluateVectorTracks(mScales, frame0 + rotationOffset, frame1 + rotationOffset, t, scales);
+		}
+	}
+
+	void CompressedAnimationCurves::evaluateVectorTracks(const VectorTracks& tracks, const UINT16* frame0,
+		const UINT16* frame1, float t, Vector3* output) const
+	{
+		using namespace simd;
+
+		UINT32 numAnimated = (UINT32)tracks.animatedTracks.size();
+		UINT32 paddedCount = getPaddedCount(numAnimated);
+
+		float32<8> factor = splat<float32<8>>(t);
+		for (UINT32 i = 0; i < numAnimated; i += TRACK_GROUP_SIZE)
+		{
+			float values[3][TRACK_GROUP_SIZE];
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				UINT32 offset = j * paddedCount + i;
+
+				float32<8> min = load_u<float32<8>>(&tracks.rangeMin[offset]);
+				float32<8> step = load_u<float32<8>>(&tracks.rangeStep[offset]);
+
+				float32<8> value0 = to_float32(to_int32(load_u<uint16<8>>(frame0 + offset)));
+				float32<8> value1 = to_float32(to_int32(load_u<uint16<8>>(frame1 + offset)));
+
+				// Interpolate the quantized values first, since de-normalization is linear
+				float32<8> value = add(value0, mul(sub(value1, value0), factor));
+				store_u(values[j], add(min, mul(value, step)));
+			}
+
+			UINT32 groupSize = std::min(numAnimated - i, TRACK_GROUP_SIZE);
+			for (UINT32 j = 0; j < groupSize; j++)
+				output[tracks.animatedTracks[i + j]] = Vector3(values[0][j], values[1][j], values[2][j]);
+		}
+	}
+
+	void CompressedAnimationCurves::evaluateRotationTracks(const RotationTracks& tracks, const UINT16* frame0,
+		const UINT16* frame1, float t, Quaternion* output) const
+	{
+		UINT32 numAnimated = (UINT32)tracks.animatedTracks.size();
+		UINT32 paddedCount = getPaddedCount(numAnimated);
+
+		for (UINT32 i = 0; i < numAnimated; i += TRACK_GROUP_SIZE)
+		{
+			Quaternion rotations0[TRACK_GROUP_SIZE];
+			Quaternion rotations1[TRACK_GROUP_SIZE];
+
+			decodeRotationGroup(frame0 + i, frame0 + paddedCount + i, frame0 + paddedCount * 2 + i, rotations0);
+			decodeRotationGroup(frame1 + i, frame1 + paddedCount + i, frame1 + paddedCount * 2 + i, rotations1);
+
+			UINT32 groupSize = std::min(numAnimated - i, TRACK_GROUP_SIZE);
+			for (UINT32 j = 0; j < groupSize; j++)
+				output[tracks.animatedTracks[i + j]] = nlerp(rotations0[j], rotations1[j], t);
+		}
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTIStatic()
+	{
+		return CompressedAnimationCurvesRTTI::instance();
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTI() const
+	{
+		return CompressedAnimationCurves::getRTTIStatic();
+	}
+}
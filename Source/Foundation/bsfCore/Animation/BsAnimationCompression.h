@@ -0,0 +1,212 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsIReflectable.h"
+#include "Math/BsVector3.h"
+#include "Math/BsQuaternion.h"
+
+namespace bs
+{
+	struct AnimationCurves;
+
+	/** @addtogroup Animation
+	 *  @{
+	 */
+
+	/** Settings that control how are position, rotation and scale curves of an animation clip compressed. */
+	struct BS_CORE_EXPORT AnimationCompressionSettings
+	{
+		/** Maximum allowed error of position tracks, in world units. */
+		float positionError = 0.0001f;
+
+		/** Maximum allowed error of rotation tracks, in radians. */
+		float rotationError = 0.001f;
+
+		/** Maximum allowed error of scale tracks, per component. */
+		float scaleError = 0.0001f;
+
+		/**
+		 * Rate at which the curves are sampled during compression, in samples per second. Should generally match the
+		 * rate the source animation was authored at.
+		 */
+		UINT32 sampleRate = 30;
+
+		/**
+		 * Maximum factor by which the sample rate can be reduced (removing keyframes), as long as the result stays within
+		 * the error thresholds.
+		 */
+		UINT32 maxSampleRateReduction = 4;
+	};
+
+	/** Contains information about the results of animation clip compression. */
+	struct BS_CORE_EXPORT AnimationCompressionReport
+	{
+		/** Size of the position, rotation and scale curve data before compression, in bytes. */
+		UINT32 uncompressedSize = 0;
+
+		/** Size of the position, rotation and scale curve data after compression, in bytes. */
+		UINT32 compressedSize = 0;
+
+		/** Ratio between the uncompressed and compressed size. */
+		float compressionRatio = 1.0f;
+
+		/** Maximum position error introduced by compression, in world units. */
+		float maxPositionError = 0.0f;
+
+		/** Maximum rotation error introduced by compression, in radians. */
+		float maxRotationError = 0.0f;
+
+		/** Maximum per-component scale error introduced by compression. */
+		float maxScaleError = 0.0f;
+
+		/** Rate the compressed curves are sampled at, in samples per second. */
+		float sampleRate = 0.0f;
+
+		/** Number of tracks that were determined to be constant, and require no per-frame data. */
+		UINT32 numConstantTracks = 0;
+
+		/** Number of tracks that require per-frame data. */
+		UINT32 numAnimatedTracks = 0;
+	};
+
+	/** @} */
+
+	/** @addtogroup Animation-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Stores position, rotation and scale curves of an animation clip in a compressed form. Curves are uniformly sampled
+	 * and the samples are quantized: positions and scales are normalized to the range of their track and stored in 16
+	 * bits per component, while rotations are stored using the smallest-three encoding in 48 bits. Tracks that don't
+	 * change within the error threshold are stored as a single value.
+	 *
+	 * Sample data is stored frame by frame, and for each frame track components are stored in structure-of-arrays
+	 * format. This means evaluating all tracks at a specific time only needs to touch two consecutive blocks of memory,
+	 * and decompression can process multiple tracks at once using vector instructions.
+	 *
+	 * @note	Immutable and therefore thread safe.
+	 */
+	class BS_CORE_EXPORT CompressedAnimationCurves : public IReflectable
+	{
+	public:
+		/**
+		 * Compresses the position, rotation and scale curves from the provided curve set. Generic curves are ignored.
+		 * Tracks in the compressed curve set will have the same indices as the curves in the source curve set.
+		 */
+		static SPtr<CompressedAnimationCurves> create(const AnimationCurves& curves,
+			const AnimationCompressionSettings& settings);
+
+		/**
+		 * Evaluates all the tracks at the specified time.
+		 *
+		 * @param[in]	time		Time to evaluate the tracks at.
+		 * @param[in]	loop		If true the time will wrap around when it goes past the end or the beginning of the
+		 *							curves. Otherwise it will be clamped.
+		 * @param[out]	positions	Pre-allocated array that will receive values of all position tracks. Must be able to
+		 *							hold getNumPositionTracks() entries. Can be null.
+		 * @param[out]	rotations	Pre-allocated array that will receive values of all rotation tracks. Must be able to
+		 *							hold getNumRotationTracks() entries. Can be null.
+		 * @param[out]	scales		Pre-allocated array that will receive values of all scale tracks. Must be able to
+		 *							hold getNumScaleTracks() entries. Can be null.
+		 */
+		void evaluate(float time, bool loop, Vector3* positions, Quaternion* rotations, Vector3* scales) const;
+
+		/** Returns the number of position tracks. */
+		UINT32 getNumPositionTracks() const { return (UINT32)mPositions.constantValues.size(); }
+
+		/** Returns the number of rotation tracks. */
+		UINT32 getNumRotationTracks() const { return (UINT32)mRotations.constantValues.size(); }
+
+		/** Returns the number of scale tracks. */
+		UINT32 getNumScaleTracks() const { return (UINT32)mScales.constantValues.size(); }
+
+		/** Returns the length of the compressed curves, in seconds. */
+		float getLength() const { return mLength; }
+
+		/** Returns information about compression ratio and the error introduced by the compression. */
+		const AnimationCompressionReport& getReport() const { return mReport; }
+
+	private:
+		friend class CompressedAnimationCurvesRTTI;
+
+		/** Tracks containing 3D vector values (positions or scales). */
+		struct VectorTracks
+		{
+			/** Values of each track, if constant. Also determines the number of tracks. */
+			Vector<Vector3> constantValues;
+
+			/** Indices of tracks that are animated, in the order they are stored in frame data. */
+			Vector<UINT32> animatedTracks;
+
+			/**
+			 * Minimum value and quantization step of the animated tracks, used for de-normalizing quantized values.
+			 * Stored as all X components, then all Y components, followed by all Z components. Each set of components is
+			 * padded to a multiple of TRACK_GROUP_SIZE.
+			 */
+			Vector<float> rangeMin;
+			Vector<float> rangeStep;
+		};
+
+		/** Tracks containing rotations. */
+		struct RotationTracks
+		{
+			/** Values of each track, if constant. Also determines the number of tracks. */
+			Vector<Quaternion> constantValues;
+
+			/** Indices of tracks that are animated, in the order they are stored in frame data. */
+			Vector<UINT32> animatedTracks;
+		};
+
+		/** Returns the number of animated tracks in a set, padded to a multiple of TRACK_GROUP_SIZE. */
+		static UINT32 getPaddedCount(UINT32 count);
+
+		/**
+		 * Compresses the provided curves by sampling them at the specified rate. Fills out the error and size
+		 * information in the report.
+		 */
+		static SPtr<CompressedAnimationCurves> compress(const AnimationCurves& curves,
+			const AnimationCompressionSettings& settings, float sampleRate);
+
+		/**
+		 * Calculates the maximum error of the compressed curves, compared to the source curves, by evaluating both at the
+		 * provided sample rate.
+		 */
+		void calculateError(const AnimationCurves& curves, float sampleRate);
+
+		/** Decodes a set of vector tracks from the frame data and interpolates between two frames. */
+		void evaluateVectorTracks(const VectorTracks& tracks, const UINT16* frame0, const UINT16* frame1, float t,
+			Vector3* output) const;
+
+		/** Decodes a set of rotation tracks from the frame data and interpolates between two frames. */
+		void evaluateRotationTracks(const RotationTracks& tracks, const UINT16* frame0, const UINT16* frame1, float t,
+			Quaternion* output) const;
+
+		static const UINT32 TRACK_GROUP_SIZE = 8;
+
+		VectorTracks mPositions;
+		RotationTracks mRotations;
+		VectorTracks mScales;
+
+		/** Quantized values of all animated tracks, for every frame. */
+		Vector<UINT16> mFrameData;
+		UINT32 mFrameStride = 0;
+		UINT32 mNumFrames = 0;
+		float mSampleRate = 0.0f;
+		float mLength = 0.0f;
+
+		AnimationCompressionReport mReport;
+
+		/************************************************************************/
+		/* 								SERIALIZATION                      		*/
+		/************************************************************************/
+	public:
+		friend class CompressedAnimationCurvesRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	/** @} */
+}
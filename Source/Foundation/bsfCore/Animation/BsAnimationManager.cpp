@@ -35,6 +35,11 @@ namespace bs
 		mUpdateRate = 1.0f / fps;
 	}
 
+	void AnimationManager::setPoseSharingTolerance(float seconds)
+	{
+		mPoseSharingTolerance = std::max(seconds, 0.0f);
+	}
+
 	const EvaluatedAnimationData* AnimationManager::update(bool async)
 	{
 		// Wait for any workers to complete
@@ -84,8 +89,9 @@ namespace bs
 			mProxies.push_back(anim.second->mAnimProxy);
 		}
 
-		// Build frustums for culling
+		// Build frustums for culling, and camera positions for level of detail selection
 		mCullFrustums.clear();
+		mLODOrigins.clear();
 
 		auto& allCameras = gSceneManager().getAllCameras();
 		for(auto& entry : allCameras)
@@ -97,17 +103,21 @@ namespace bs
 			// TODO: Not checking if camera and animation renderable's layers match. If we checked more animations could
 			// be culled.
 			mCullFrustums.push_back(entry.second->getWorldFrustum());
+			mLODOrigins.push_back(entry.second->getTransform().getPosition());
 		}
 
+		// Animations evaluating to the same skeleton pose share a single evaluated pose
+		buildPoseGroups();
+
 		// Prepare the write buffer
 		UINT32 totalNumBones = 0;
-		for (auto& anim : mProxies)
+		for (auto& group : mPoseGroups)
 		{
+			const SPtr<AnimationProxy>& anim = mProxies[group.firstAnimIdx];
 			if (anim->skeleton != nullptr)
 				totalNumBones += anim->skeleton->getNumBones();
 		}
 
-		// Prepare the write buffer
 		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		renderData.transforms.resize(totalNumBones);
 		renderData.infos.clear();
@@ -115,16 +125,20 @@ namespace bs
 		// Queue animation evaluation tasks
 		{
 			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mProxies.size();
+			mNumActiveWorkers = (UINT32)mPoseGroups.size();
 		}
 
-		UINT32 curBoneIdx = 0;
-		for (auto& anim : mProxies)
+		mUpdateIdx++;
+
+		for (UINT32 i = 0; i < (UINT32)mPoseGroups.size(); i++)
 		{
-			auto evaluateAnimWorker = [this, anim, curBoneIdx]()
+			auto evaluateAnimWorker = [this, i]()
 			{
-				UINT32 boneIdx = curBoneIdx;
-				evaluateAnimation(anim.get(), boneIdx);
+				const PoseGroup& group = mPoseGroups[i];
+
+				bool poseEvaluated = false;
+				for (UINT32 animIdx = group.firstAnimIdx; animIdx != (UINT32)-1; animIdx = mNextInPoseGroup[animIdx])
+					evaluateAnimation(mProxies[animIdx].get(), group.boneIdx, poseEvaluated);
 
 				Lock lock(mMutex);
 				{
@@ -137,9 +151,6 @@ namespace bs
 
 			SPtr<Task> task = Task::create("AnimWorker", evaluateAnimWorker);
 			TaskScheduler::instance().addTask(task);
-
-			if (anim->skeleton != nullptr)
-				curBoneIdx += anim->skeleton->getNumBones();
 		}
 
 		// Wait for tasks to complete
@@ -165,7 +176,147 @@ namespace bs
 		return &mAnimData[mPoseReadBufferIdx];
 	}
 
-	void AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32& curBoneIdx)
+	/** Returns the clip time used when comparing animation states for pose sharing. */
+	static float getPoseSharingTime(float time, float tolerance)
+	{
+		if (tolerance <= 0.0f)
+			return time;
+
+		return Math::floor(time / tolerance) * tolerance;
+	}
+
+	/** Checks if the skeleton pose of the provided animation can be shared with other animations. */
+	static bool canSharePose(const AnimationProxy& anim)
+	{
+		// Levels of detail keep per-animation pose history
+		if (anim.skeleton == nullptr || !anim.lods.empty())
+			return false;
+
+		// Scene objects mapped to bones override the pose, and read back the animation's local pose
+		for (UINT32 i = 0; i < anim.numSceneObjects; i++)
+		{
+			if (anim.sceneObjectInfos[i].boneIdx != -1)
+				return false;
+		}
+
+		return true;
+	}
+
+	/** Generates a hash from all the animation properties that determine the evaluated skeleton pose. */
+	static size_t getPoseHash(const AnimationProxy& anim, float tolerance)
+	{
+		size_t hash = 0;
+		bs::hash_combine(hash, anim.skeleton.get());
+
+		for (UINT32 i = 0; i < anim.numLayers; i++)
+		{
+			const AnimationStateLayer& layer = anim.layers[i];
+			for (UINT32 j = 0; j < layer.numStates; j++)
+			{
+				const AnimationState& state = layer.states[j];
+				bs::hash_combine(hash, state.curves.get());
+				bs::hash_combine(hash, getPoseSharingTime(state.time, tolerance));
+				bs::hash_combine(hash, state.weight);
+			}
+		}
+
+		return hash;
+	}
+
+	/** Checks if two animations evaluate to the same skeleton pose. */
+	static bool isPoseEqual(const AnimationProxy& a, const AnimationProxy& b, float tolerance)
+	{
+		if (a.skeleton != b.skeleton || a.numLayers != b.numLayers || a.skeletonMask != b.skeletonMask)
+			return false;
+
+		for (UINT32 i = 0; i < a.numLayers; i++)
+		{
+			const AnimationStateLayer& layerA = a.layers[i];
+			const AnimationStateLayer& layerB = b.layers[i];
+
+			if (layerA.index != layerB.index || layerA.additive != layerB.additive || layerA.numStates != layerB.numStates)
+				return false;
+
+			for (UINT32 j = 0; j < layerA.numStates; j++)
+			{
+				const AnimationState& stateA = layerA.states[j];
+				const AnimationState& stateB = layerB.states[j];
+
+				if (stateA.curves != stateB.curves || stateA.compressedCurves != stateB.compressedCurves ||
+					stateA.weight != stateB.weight || stateA.loop != stateB.loop || stateA.disabled != stateB.disabled)
+					return false;
+
+				if (getPoseSharingTime(stateA.time, tolerance) != getPoseSharingTime(stateB.time, tolerance))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Copies the local transforms and override flags of all bones in @p src to @p dst, resizing it if needed. */
+	static void copyLocalPose(const LocalSkeletonPose& src, LocalSkeletonPose& dst)
+	{
+		if (dst.numBones != src.numBones)
+			dst = LocalSkeletonPose(src.numBones);
+
+		memcpy(dst.positions, src.positions, sizeof(Vector3) * src.numBones);
+		memcpy(dst.rotations, src.rotations, sizeof(Quaternion) * src.numBones);
+		memcpy(dst.scales, src.scales, sizeof(Vector3) * src.numBones);
+		memcpy(dst.hasOverride, src.hasOverride, sizeof(bool) * src.numBones);
+	}
+
+	void AnimationManager::buildPoseGroups()
+	{
+		UINT32 numProxies = (UINT32)mProxies.size();
+
+		mPoseGroups.clear();
+		mPoseGroupLookup.clear();
+		mNextInPoseGroup.assign(numProxies, (UINT32)-1);
+
+		UINT32 curBoneIdx = 0;
+		for (UINT32 i = 0; i < numProxies; i++)
+		{
+			const AnimationProxy& anim = *mProxies[i];
+
+			if (canSharePose(anim))
+			{
+				size_t hash = getPoseHash(anim, mPoseSharingTolerance);
+
+				bool foundGroup = false;
+				auto range = mPoseGroupLookup.equal_range(hash);
+				for (auto iter = range.first; iter != range.second; ++iter)
+				{
+					PoseGroup& group = mPoseGroups[iter->second];
+					if (!isPoseEqual(*mProxies[group.firstAnimIdx], anim, mPoseSharingTolerance))
+						continue;
+
+					mNextInPoseGroup[group.lastAnimIdx] = i;
+					group.lastAnimIdx = i;
+
+					foundGroup = true;
+					break;
+				}
+
+				if (foundGroup)
+					continue;
+
+				mPoseGroupLookup.insert(std::make_pair(hash, (UINT32)mPoseGroups.size()));
+			}
+
+			PoseGroup group;
+			group.firstAnimIdx = i;
+			group.lastAnimIdx = i;
+			group.boneIdx = curBoneIdx;
+
+			mPoseGroups.push_back(group);
+
+			if (anim.skeleton != nullptr)
+				curBoneIdx += anim.skeleton->getNumBones();
+		}
+	}
+
+	void AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32 boneIdx, bool& poseEvaluated)
 	{
 		if (anim->mCullEnabled)
 		{
@@ -188,6 +339,59 @@ namespace bs
 		UINT32 prevPoseBufferIdx = (mPoseWriteBufferIdx + CoreThread::NUM_SYNC_BUFFERS) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 		EvaluatedAnimationData& prevRenderData = mAnimData[prevPoseBufferIdx];
 
+		// Pick the level of detail depending on the distance between the bounds and the nearest camera
+		UINT32 lodIdx = (UINT32)-1;
+		if (!anim->lods.empty() && !mLODOrigins.empty())
+		{
+			float minSqrdDistance = std::numeric_limits<float>::max();
+			for (auto& origin : mLODOrigins)
+			{
+				Vector3 closestPoint = Vector3::min(Vector3::max(origin, anim->mBounds.getMin()), anim->mBounds.getMax());
+				minSqrdDistance = std::min(minSqrdDistance, origin.squaredDistance(closestPoint));
+			}
+
+			for (UINT32 i = 0; i < (UINT32)anim->lods.size(); i++)
+			{
+				float lodDistance = anim->lods[i].distance;
+				if (minSqrdDistance < lodDistance * lodDistance)
+					break;
+
+				lodIdx = i;
+			}
+		}
+
+		// At lower levels of detail the animation is only evaluated every few updates, with the updates staggered by
+		// animation ID so they don't all land on the same frame. Updates in between interpolate the skeleton pose.
+		bool evaluate = true;
+		float lodInterpolation = 1.0f;
+		if (lodIdx != (UINT32)-1)
+		{
+			UINT32 updateInterval = std::max(anim->lods[lodIdx].updateInterval, 1U);
+			UINT32 numSkippedUpdates = mUpdateIdx - anim->lodUpdateIdx;
+
+			// Nothing to interpolate from if the level of detail changed, or the animation was culled for a while
+			bool restart = lodIdx != anim->lodIdx || numSkippedUpdates > updateInterval;
+			if (restart)
+				numSkippedUpdates = 0;
+			else
+				evaluate = (mUpdateIdx + (UINT32)anim->id) % updateInterval == 0;
+
+			if (evaluate)
+			{
+				if (restart)
+					anim->lodPoses[0] = LocalSkeletonPose();
+				else
+					std::swap(anim->lodPoses[0], anim->lodPoses[1]);
+
+				anim->lodUpdateIdx = mUpdateIdx;
+				numSkippedUpdates = 0;
+			}
+
+			lodInterpolation = std::min((numSkippedUpdates + 1) / (float)updateInterval, 1.0f);
+		}
+
+		anim->lodIdx = lodIdx;
+
 		EvaluatedAnimationData::AnimInfo animInfo;
 		bool hasAnimInfo = false;
 
@@ -198,30 +402,80 @@ namespace bs
 
 			EvaluatedAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
 			poseInfo.animId = anim->id;
-			poseInfo.startIdx = curBoneIdx;
+			poseInfo.startIdx = boneIdx;
 			poseInfo.numBones = numBones;
 
-			memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
-			Matrix4* boneDst = renderData.transforms.data() + curBoneIdx;
-
-			// Copy transforms from mapped scene objects
-			UINT32 boneTfrmIdx = 0;
-			for (UINT32 i = 0; i < anim->numSceneObjects; i++)
+			// Pose might have already been evaluated by another animation in the same pose group
+			if (!poseEvaluated)
 			{
-				const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+				memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
+				Matrix4* boneDst = renderData.transforms.data() + boneIdx;
 
-				if (soInfo.boneIdx == -1)
-					continue;
+				// Copy transforms from mapped scene objects
+				UINT32 boneTfrmIdx = 0;
+				for (UINT32 i = 0; i < anim->numSceneObjects; i++)
+				{
+					const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
 
-				boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
-				anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
-				boneTfrmIdx++;
-			}
+					if (soInfo.boneIdx == -1)
+						continue;
+
+					boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
+					anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
+					boneTfrmIdx++;
+				}
+
+				if (lodIdx == (UINT32)-1)
+				{
+					// Animate bones
+					anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, 
+						anim->numLayers);
+				}
+				else
+				{
+					LocalSkeletonPose& prevPose = anim->lodPoses[0];
+					LocalSkeletonPose& curPose = anim->lodPoses[1];
+					LocalSkeletonPose& pose = anim->skeletonPose;
+
+					bool evaluated = false;
+					if (evaluate || curPose.numBones != numBones)
+					{
+						// Animate bones, excluding the ones disabled by the level of detail
+						const SkeletonMask& mask = anim->lods[lodIdx].mask;
+						anim->skeleton->getPose(boneDst, pose, mask, anim->layers, anim->numLayers);
 
-			// Animate bones
-			anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
+						copyLocalPose(pose, curPose);
+						if (prevPose.numBones != numBones)
+							copyLocalPose(curPose, prevPose);
+
+						evaluated = true;
+					}
+
+					// Blend from the previous evaluated pose to the latest one. This lags behind the evaluation by up to
+					// one update interval, but avoids the popping of holding the latest pose until the next evaluation.
+					// Local transforms are blended and then converted to bone matrices, as blending the matrices
+					// directly would introduce shearing and shrinking of rotated bones.
+					if (!evaluated || lodInterpolation < 1.0f)
+					{
+						for (UINT32 i = 0; i < numBones; i++)
+						{
+							pose.positions[i] = Vector3::lerp(lodInterpolation, prevPose.positions[i], 
+								curPose.positions[i]);
+							pose.rotations[i] = Quaternion::lerp(lodInterpolation, prevPose.rotations[i], 
+								curPose.rotations[i]);
+							pose.scales[i] = Vector3::lerp(lodInterpolation, prevPose.scales[i], curPose.scales[i]);
+
+							// Bones with an animation curve ignore their scene object override during evaluation
+							pose.hasOverride[i] = curPose.hasOverride[i];
+						}
+
+						anim->skeleton->getPose(boneDst, pose);
+					}
+				}
+
+				poseEvaluated = true;
+			}
 
-			curBoneIdx += numBones;
 			hasAnimInfo = true;
 		}
 		else
@@ -232,77 +486,139 @@ namespace bs
 			poseInfo.numBones = 0;
 		}
 
-		// Reset mapped SO transform
-		for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
+		// Scene object and generic curves keep their last evaluated values in between level of detail updates
+		if (evaluate)
 		{
-			anim->sceneObjectPose.positions[i] = Vector3::ZERO;
-			anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
-			anim->sceneObjectPose.scales[i] = Vector3::ONE;
-		}
-
-		// Update mapped scene objects
-		memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * anim->numSceneObjects);
+			// Reset mapped SO transform
+			for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
+			{
+				anim->sceneObjectPose.positions[i] = Vector3::ZERO;
+				anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
+				anim->sceneObjectPose.scales[i] = Vector3::ONE;
+			}
 
-		// Update scene object transforms
-		for (UINT32 i = 0; i < anim->numSceneObjects; i++)
-		{
-			const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+			// Update mapped scene objects
+			memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * anim->numSceneObjects);
 
-			// We already evaluated bones
-			if (soInfo.boneIdx != -1)
-				continue;
+			// Compressed clips evaluate all of their tracks at once, prepare a buffer large enough for any of them
+			UINT32 maxNumPositions = 0;
+			UINT32 maxNumRotations = 0;
+			UINT32 maxNumScales = 0;
+			for (UINT32 i = 0; i < anim->numLayers; i++)
+			{
+				for (UINT32 j = 0; j < anim->layers[i].numStates; j++)
+				{
+					const SPtr<CompressedAnimationCurves>& compressedCurves = anim->layers[i].states[j].compressedCurves;
+					if (compressedCurves == nullptr)
+						continue;
 
-			if (soInfo.layerIdx == -1 || soInfo.stateIdx == -1)
-				continue;
+					maxNumPositions = std::max(maxNumPositions, compressedCurves->getNumPositionTracks());
+					maxNumRotations = std::max(maxNumRotations, compressedCurves->getNumRotationTracks());
+					maxNumScales = std::max(maxNumScales, compressedCurves->getNumScaleTracks());
+				}
+			}
 
-			const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
-			if (state.disabled)
-				continue;
+			Vector3* positionSamples = maxNumPositions > 0 ? bs_stack_alloc<Vector3>(maxNumPositions) : nullptr;
+			Quaternion* rotationSamples = maxNumRotations > 0 ? bs_stack_alloc<Quaternion>(maxNumRotations) : nullptr;
+			Vector3* scaleSamples = maxNumScales > 0 ? bs_stack_alloc<Vector3>(maxNumScales) : nullptr;
+			const AnimationState* sampledState = nullptr;
 
+			// Update scene object transforms
+			for (UINT32 i = 0; i < anim->numSceneObjects; i++)
 			{
-				UINT32 curveIdx = soInfo.curveIndices.position;
-				if (curveIdx != (UINT32)-1)
+				const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+
+				// We already evaluated bones
+				if (soInfo.boneIdx != -1)
+					continue;
+
+				if (soInfo.layerIdx == -1 || soInfo.stateIdx == -1)
+					continue;
+
+				const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
+				if (state.disabled)
+					continue;
+
+				// Scene objects are usually animated by the same state, so only evaluate compressed tracks when it changes
+				const CompressedAnimationCurves* compressedCurves = state.compressedCurves.get();
+				if (compressedCurves != nullptr && sampledState != &state)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-					anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
-					anim->sceneObjectPose.hasOverride[curveIdx] = false;
+					compressedCurves->evaluate(state.time, state.loop, positionSamples, rotationSamples, scaleSamples);
+					sampledState = &state;
 				}
-			}
 
-			{
-				UINT32 curveIdx = soInfo.curveIndices.rotation;
-				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-					anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-					anim->sceneObjectPose.rotations[curveIdx].normalize();
-					anim->sceneObjectPose.hasOverride[curveIdx] = false;
+					UINT32 curveIdx = soInfo.curveIndices.position;
+					if (curveIdx != (UINT32)-1)
+					{
+						if (compressedCurves != nullptr)
+							anim->sceneObjectPose.positions[curveIdx] = positionSamples[curveIdx];
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+							anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+						}
+
+						anim->sceneObjectPose.hasOverride[curveIdx] = false;
+					}
 				}
-			}
 
-			{
-				UINT32 curveIdx = soInfo.curveIndices.scale;
-				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-					anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
-					anim->sceneObjectPose.hasOverride[curveIdx] = false;
+					UINT32 curveIdx = soInfo.curveIndices.rotation;
+					if (curveIdx != (UINT32)-1)
+					{
+						if (compressedCurves != nullptr)
+							anim->sceneObjectPose.rotations[curveIdx] = rotationSamples[curveIdx];
+						else
+						{
+							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+							anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+						}
+
+						anim->sceneObjectPose.rotations[curveIdx].normalize();
+						anim->sceneObjectPose.hasOverride[curveIdx] = false;
+					}
+				}
+
+				{
+					UINT32 curveIdx = soInfo.curveIndices.scale;
+					if (curveIdx != (UINT32)-1)
+					{
+						if (compressedCurves != nullptr)
+							anim->sceneObjectPose.scales[curveIdx] = scaleSamples[curveIdx];
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+							anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+						}
+
+						anim->sceneObjectPose.hasOverride[curveIdx] = false;
+					}
 				}
 			}
-		}
 
-		// Update generic curves
-		// Note: No blending for generic animations, just use first animation
-		if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
-		{
-			const AnimationState& state = anim->layers[0].states[0];
-			if (!state.disabled)
+			if (scaleSamples != nullptr)
+				bs_stack_free(scaleSamples);
+
+			if (rotationSamples != nullptr)
+				bs_stack_free(rotationSamples);
+
+			if (positionSamples != nullptr)
+				bs_stack_free(positionSamples);
+
+			// Update generic curves
+			// Note: No blending for generic animations, just use first animation
+			if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
 			{
-				UINT32 numCurves = (UINT32)state.curves->generic.size();
-				for (UINT32 i = 0; i < numCurves; i++)
+				const AnimationState& state = anim->layers[0].states[0];
+				if (!state.disabled)
 				{
-					const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
-					anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
+					UINT32 numCurves = (UINT32)state.curves->generic.size();
+					for (UINT32 i = 0; i < numCurves; i++)
+					{
+						const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
+						anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
+					}
 				}
 			}
 		}
@@ -425,7 +741,7 @@ namespace bs
 			}
 
 			// Generate morph shape vertices
-			if (anim->morphChannelWeightsDirty || hasMorphCurves)
+			if (anim->morphChannelWeightsDirty || (hasMorphCurves && evaluate))
 			{
 				SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
 
@@ -70,6 +70,16 @@ namespace bs
 		 */
 		void setUpdateRate(UINT32 fps);
 
+		/**
+		 * Animations playing the same clips with the same weights on the same skeleton share a single evaluated skeleton
+		 * pose. By default clip times must match exactly for the pose to be shared. Setting a non-zero tolerance allows
+		 * animations whose clip times differ by less than the tolerance to share a pose as well, trading animation 
+		 * accuracy for performance in large crowds.
+		 *
+		 * @param[in]	seconds		Maximum amount of time the shared pose can differ from the animation's own pose.
+		 */
+		void setPoseSharingTolerance(float seconds);
+
 		/**
 		 * Evaluates animations for all animated objects, and returns the evaluated skeleton bone poses and morph shape
 		 * meshes that can be passed along to the renderer.
@@ -89,6 +99,14 @@ namespace bs
 	private:
 		friend class Animation;
 
+		/** Group of animations that evaluate to the same skeleton pose. */
+		struct PoseGroup
+		{
+			UINT32 firstAnimIdx; /**< Index of the first animation proxy in the group. */
+			UINT32 lastAnimIdx; /**< Index of the last animation proxy in the group. */
+			UINT32 boneIdx; /**< Index of the first bone of the shared pose in the output buffer. */
+		};
+
 		/** Possible states the worker thread can be in, used for synchronization. */
 		enum class WorkerState
 		{
@@ -111,11 +129,19 @@ namespace bs
 		/** 
 		 * Evaluates animation for a single object and writes the result in the currently active write buffer. 
 		 *
-		 * @param[in]	anim		Proxy representing the animation to evaluate.
-		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information. This will be
-		 *							automatically advanced by the number of written bone transforms.
+		 * @param[in]		anim			Proxy representing the animation to evaluate.
+		 * @param[in]		boneIdx			Index in the output buffer in which to write evaluated bone information.
+		 * @param[in, out]	poseEvaluated	If true the skeleton pose at @p boneIdx was already evaluated by another
+		 *									animation from the same pose group and will be re-used. Set to true once the
+		 *									method evaluates the pose.
 		 */
-		void evaluateAnimation(AnimationProxy* anim, UINT32& boneIdx);
+		void evaluateAnimation(AnimationProxy* anim, UINT32 boneIdx, bool& poseEvaluated);
+
+		/** 
+		 * Assigns all the animation proxies to pose groups, so that animations that evaluate to the same skeleton pose
+		 * end up in the same group.
+		 */
+		void buildPoseGroups();
 
 		UINT64 mNextId;
 		UnorderedMap<UINT64, Animation*> mAnimations;
@@ -124,6 +150,7 @@ namespace bs
 		float mAnimationTime;
 		float mLastAnimationUpdateTime;
 		float mNextAnimationUpdateTime;
+		float mPoseSharingTolerance = 0.0f;
 		bool mPaused;
 
 		SPtr<VertexDataDesc> mBlendShapeVertexDesc;
@@ -131,6 +158,12 @@ namespace bs
 		// Animation thread
 		Vector<SPtr<AnimationProxy>> mProxies;
 		Vector<ConvexVolume> mCullFrustums;
+		Vector<Vector3> mLODOrigins;
+		UINT32 mUpdateIdx = 0;
+
+		Vector<PoseGroup> mPoseGroups;
+		Vector<UINT32> mNextInPoseGroup;
+		UnorderedMultimap<size_t, UINT32> mPoseGroupLookup;
 		EvaluatedAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS + 1];
 
 		UINT32 mPoseReadBufferIdx;
@@ -4,9 +4,249 @@
 #include "Animation/BsAnimationClip.h"
 #include "Animation/BsSkeletonMask.h"
 #include "Private/RTTI/BsSkeletonRTTI.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
+	/** Number of bones processed at once by the vectorized parts of Skeleton::getPose(). */
+	static constexpr UINT32 SIMD_WIDTH = 4;
+
+	/** Local bone positions, rotations and scales stored in structure-of-arrays layout. */
+	struct LocalPoseSoA
+	{
+		/** Number of float arrays required for storing the pose. */
+		static constexpr UINT32 NUM_COMPONENTS = 10;
+
+		LocalPoseSoA(float* data, UINT32 numBones)
+		{
+			for (UINT32 i = 0; i < 3; i++)
+				position[i] = data + numBones * i;
+
+			for (UINT32 i = 0; i < 4; i++)
+				rotation[i] = data + numBones * (3 + i);
+
+			for (UINT32 i = 0; i < 3; i++)
+				scale[i] = data + numBones * (7 + i);
+		}
+
+		void set(UINT32 idx, const Vector3& pos, const Quaternion& rot, const Vector3& scl)
+		{
+			position[0][idx] = pos.x;
+			position[1][idx] = pos.y;
+			position[2][idx] = pos.z;
+
+			setRotation(idx, rot);
+
+			scale[0][idx] = scl.x;
+			scale[1][idx] = scl.y;
+			scale[2][idx] = scl.z;
+		}
+
+		void setRotation(UINT32 idx, const Quaternion& rot)
+		{
+			rotation[0][idx] = rot.x;
+			rotation[1][idx] = rot.y;
+			rotation[2][idx] = rot.z;
+			rotation[3][idx] = rot.w;
+		}
+
+		Vector3 getPosition(UINT32 idx) const
+		{
+			return Vector3(position[0][idx], position[1][idx], position[2][idx]);
+		}
+
+		Quaternion getRotation(UINT32 idx) const
+		{
+			return Quaternion(rotation[3][idx], rotation[0][idx], rotation[1][idx], rotation[2][idx]);
+		}
+
+		Vector3 getScale(UINT32 idx) const
+		{
+			return Vector3(scale[0][idx], scale[1][idx], scale[2][idx]);
+		}
+
+		float* position[3];
+		float* rotation[4];
+		float* scale[3];
+	};
+
+	/** 
+	 * Adds weighted samples to the blended pose. Positions are summed and scales multiplied. If @p blendRotations is
+	 * true the rotations are summed as well, flipping the sampled rotation when it points away from the blended one so
+	 * the blend takes the shortest path once normalized.
+	 */
+	static void blendSamples(LocalPoseSoA& blended, const LocalPoseSoA& samples, UINT32 numBones, bool blendRotations)
+	{
+		for (UINT32 i = 0; i < numBones; i += SIMD_WIDTH)
+		{
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				simd::float32x4 position = simd::load_u<simd::float32x4>(blended.position[j] + i);
+				simd::float32x4 positionSample = simd::load_u<simd::float32x4>(samples.position[j] + i);
+				simd::store_u(blended.position[j] + i, simd::add(position, positionSample));
+
+				simd::float32x4 scale = simd::load_u<simd::float32x4>(blended.scale[j] + i);
+				simd::float32x4 scaleSample = simd::load_u<simd::float32x4>(samples.scale[j] + i);
+				simd::store_u(blended.scale[j] + i, simd::mul(scale, scaleSample));
+			}
+
+			if (!blendRotations)
+				continue;
+
+			simd::float32x4 rotation[4];
+			simd::float32x4 rotationSample[4];
+			simd::float32x4 dot = simd::splat<simd::float32x4>(0.0f);
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				rotation[j] = simd::load_u<simd::float32x4>(blended.rotation[j] + i);
+				rotationSample[j] = simd::load_u<simd::float32x4>(samples.rotation[j] + i);
+
+				dot = simd::add(dot, simd::mul(rotation[j], rotationSample[j]));
+			}
+
+			simd::mask_float32x4 flip = simd::cmp_lt(dot, simd::splat<simd::float32x4>(0.0f));
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				simd::float32x4 sample = simd::blend(simd::neg(rotationSample[j]), rotationSample[j], flip);
+				simd::store_u(blended.rotation[j] + i, simd::add(rotation[j], sample));
+			}
+		}
+	}
+
+	/** Normalizes all rotations in the pose. Rotations that were never assigned (zero W) are set to identity. */
+	static void normalizeRotations(LocalPoseSoA& pose, UINT32 numBones)
+	{
+		simd::float32x4 zero = simd::splat<simd::float32x4>(0.0f);
+		simd::float32x4 one = simd::splat<simd::float32x4>(1.0f);
+
+		for (UINT32 i = 0; i < numBones; i += SIMD_WIDTH)
+		{
+			simd::float32x4 rotation[4];
+			simd::float32x4 sqrdLength = zero;
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				rotation[j] = simd::load_u<simd::float32x4>(pose.rotation[j] + i);
+				sqrdLength = simd::add(sqrdLength, simd::mul(rotation[j], rotation[j]));
+			}
+
+			simd::mask_float32x4 isAssigned = simd::cmp_neq(rotation[3], zero);
+
+			// Avoid dividing by zero for the unassigned rotations, they get replaced by identity either way
+			sqrdLength = simd::blend(sqrdLength, one, isAssigned);
+			simd::float32x4 invLength = simd::div(one, simd::sqrt(sqrdLength));
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				simd::float32x4 identity = j == 3 ? one : zero;
+				simd::float32x4 normalized = simd::mul(rotation[j], invLength);
+				simd::store_u(pose.rotation[j] + i, simd::blend(normalized, identity, isAssigned));
+			}
+		}
+	}
+
+	/** 
+	 * Converts local positions, rotations and scales into local bone matrices. Only the first three rows of the 
+	 * matrices are calculated, the last row is always (0, 0, 0, 1). Matrices for bones with an override are left as is.
+	 */
+	static void calculateLocalMatrices(const LocalPoseSoA& pose, UINT32 numPaddedBones, UINT32 numBones, 
+		const bool* hasOverride, Matrix4* output)
+	{
+		simd::float32x4 one = simd::splat<simd::float32x4>(1.0f);
+		simd::float32x4 lastRow = simd::make_float<simd::float32x4>(0.0f, 0.0f, 0.0f, 1.0f);
+
+		for (UINT32 i = 0; i < numPaddedBones; i += SIMD_WIDTH)
+		{
+			simd::float32x4 x = simd::load_u<simd::float32x4>(pose.rotation[0] + i);
+			simd::float32x4 y = simd::load_u<simd::float32x4>(pose.rotation[1] + i);
+			simd::float32x4 z = simd::load_u<simd::float32x4>(pose.rotation[2] + i);
+			simd::float32x4 w = simd::load_u<simd::float32x4>(pose.rotation[3] + i);
+
+			// Same as Quaternion::toRotationMatrix()
+			simd::float32x4 tx = simd::add(x, x);
+			simd::float32x4 ty = simd::add(y, y);
+			simd::float32x4 tz = simd::add(z, z);
+			simd::float32x4 twx = simd::mul(tx, w);
+			simd::float32x4 twy = simd::mul(ty, w);
+			simd::float32x4 twz = simd::mul(tz, w);
+			simd::float32x4 txx = simd::mul(tx, x);
+			simd::float32x4 txy = simd::mul(ty, x);
+			simd::float32x4 txz = simd::mul(tz, x);
+			simd::float32x4 tyy = simd::mul(ty, y);
+			simd::float32x4 tyz = simd::mul(tz, y);
+			simd::float32x4 tzz = simd::mul(tz, z);
+
+			simd::float32x4 scaleX = simd::load_u<simd::float32x4>(pose.scale[0] + i);
+			simd::float32x4 scaleY = simd::load_u<simd::float32x4>(pose.scale[1] + i);
+			simd::float32x4 scaleZ = simd::load_u<simd::float32x4>(pose.scale[2] + i);
+
+			// Same as Matrix4::setTRS(), each variable contains one matrix element for four bones
+			simd::float32x4 rows[3][4];
+			rows[0][0] = simd::mul(simd::sub(one, simd::add(tyy, tzz)), scaleX);
+			rows[0][1] = simd::mul(simd::sub(txy, twz), scaleY);
+			rows[0][2] = simd::mul(simd::add(txz, twy), scaleZ);
+			rows[0][3] = simd::load_u<simd::float32x4>(pose.position[0] + i);
+
+			rows[1][0] = simd::mul(simd::add(txy, twz), scaleX);
+			rows[1][1] = simd::mul(simd::sub(one, simd::add(txx, tzz)), scaleY);
+			rows[1][2] = simd::mul(simd::sub(tyz, twx), scaleZ);
+			rows[1][3] = simd::load_u<simd::float32x4>(pose.position[1] + i);
+
+			rows[2][0] = simd::mul(simd::sub(txz, twy), scaleX);
+			rows[2][1] = simd::mul(simd::add(tyz, twx), scaleY);
+			rows[2][2] = simd::mul(simd::sub(one, simd::add(txx, tyy)), scaleZ);
+			rows[2][3] = simd::load_u<simd::float32x4>(pose.position[2] + i);
+
+			// Transpose so each variable contains one matrix row of a single bone
+			for (UINT32 j = 0; j < 3; j++)
+				simd::transpose4(rows[j][0], rows[j][1], rows[j][2], rows[j][3]);
+
+			UINT32 numBatchBones = std::min(SIMD_WIDTH, numBones - std::min(i, numBones));
+			for (UINT32 j = 0; j < numBatchBones; j++)
+			{
+				if (hasOverride[i + j])
+					continue;
+
+				float* dst = (float*)&output[i + j];
+				simd::store_u(dst, rows[0][j]);
+				simd::store_u(dst + 4, rows[1][j]);
+				simd::store_u(dst + 8, rows[2][j]);
+				simd::store_u(dst + 12, lastRow);
+			}
+		}
+	}
+
+	/** 
+	 * Multiplies two affine matrices, ignoring the last row of both as it is always (0, 0, 0, 1). @p output can be the
+	 * same matrix as either of the inputs.
+	 */
+	static void concatenateAffine(const Matrix4& a, const Matrix4& b, Matrix4& output)
+	{
+		const float* aData = (const float*)&a;
+		const float* bData = (const float*)&b;
+
+		simd::float32x4 b0 = simd::load_u<simd::float32x4>(bData);
+		simd::float32x4 b1 = simd::load_u<simd::float32x4>(bData + 4);
+		simd::float32x4 b2 = simd::load_u<simd::float32x4>(bData + 8);
+		simd::float32x4 lastRow = simd::make_float<simd::float32x4>(0.0f, 0.0f, 0.0f, 1.0f);
+
+		simd::float32x4 rows[3];
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			const float* aRow = aData + i * 4;
+
+			simd::float32x4 row = simd::mul(simd::splat<simd::float32x4>(aRow[0]), b0);
+			row = simd::add(row, simd::mul(simd::splat<simd::float32x4>(aRow[1]), b1));
+			row = simd::add(row, simd::mul(simd::splat<simd::float32x4>(aRow[2]), b2));
+			rows[i] = simd::add(row, simd::mul(simd::splat<simd::float32x4>(aRow[3]), lastRow));
+		}
+
+		float* dst = (float*)&output;
+		simd::store_u(dst, rows[0]);
+		simd::store_u(dst + 4, rows[1]);
+		simd::store_u(dst + 8, rows[2]);
+		simd::store_u(dst + 12, lastRow);
+	}
+
 	LocalSkeletonPose::LocalSkeletonPose()
 		: positions(nullptr), rotations(nullptr), scales(nullptr), hasOverride(nullptr), numBones(0)
 	{ }
@@ -98,6 +338,8 @@ namespace bs
 			mBoneInfo[i].name = bones[i].name;
 			mBoneInfo[i].parent = bones[i].parent;
 		}
+
+		buildEvaluationOrder();
 	}
 
 	Skeleton::~Skeleton()
@@ -128,6 +370,7 @@ namespace bs
 
 			AnimationState state;
 			state.curves = clip.getCurves();
+			state.compressedCurves = clip.getCompressedCurves();
 			state.boneToCurveMapping = boneToCurveMapping.data();
 			state.loop = loop;
 			state.weight = 1.0f;
@@ -159,20 +402,47 @@ namespace bs
 	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
 		const AnimationStateLayer* layers, UINT32 numLayers)
 	{
-		// Note: If more performance is required this method could be optimized with vector instructions
-
 		assert(localPose.numBones == mNumBones);
 
-		for(UINT32 i = 0; i < mNumBones; i++)
+		// Bone transforms are blended and converted to matrices in SoA layout, multiple bones at a time. Padding bones
+		// at the end are kept at neutral values and never written to the output.
+		UINT32 numPaddedBones = Math::divideAndRoundUp(mNumBones, SIMD_WIDTH) * SIMD_WIDTH;
+		float* poseData = bs_stack_alloc<float>(numPaddedBones * LocalPoseSoA::NUM_COMPONENTS * 2);
+
+		LocalPoseSoA blended(poseData, numPaddedBones);
+		LocalPoseSoA samples(poseData + numPaddedBones * LocalPoseSoA::NUM_COMPONENTS, numPaddedBones);
+
+		for(UINT32 i = 0; i < numPaddedBones; i++)
 		{
-			localPose.positions[i] = Vector3::ZERO;
-			localPose.rotations[i] = Quaternion::ZERO;
-			localPose.scales[i] = Vector3::ONE;
+			blended.set(i, Vector3::ZERO, Quaternion::ZERO, Vector3::ONE);
+			samples.set(i, Vector3::ZERO, Quaternion::ZERO, Vector3::ONE);
 		}
 
 		bool* hasAnimCurve = bs_stack_alloc<bool>(mNumBones);
 		bs_zero_out(hasAnimCurve, mNumBones);
 
+		// Compressed clips evaluate all of their tracks at once, prepare a buffer large enough for any of them
+		UINT32 maxNumPositions = 0;
+		UINT32 maxNumRotations = 0;
+		UINT32 maxNumScales = 0;
+		for(UINT32 i = 0; i < numLayers; i++)
+		{
+			for (UINT32 j = 0; j < layers[i].numStates; j++)
+			{
+				const SPtr<CompressedAnimationCurves>& compressedCurves = layers[i].states[j].compressedCurves;
+				if (compressedCurves == nullptr)
+					continue;
+
+				maxNumPositions = std::max(maxNumPositions, compressedCurves->getNumPositionTracks());
+				maxNumRotations = std::max(maxNumRotations, compressedCurves->getNumRotationTracks());
+				maxNumScales = std::max(maxNumScales, compressedCurves->getNumScaleTracks());
+			}
+		}
+
+		Vector3* positionSamples = maxNumPositions > 0 ? bs_stack_alloc<Vector3>(maxNumPositions) : nullptr;
+		Quaternion* rotationSamples = maxNumRotations > 0 ? bs_stack_alloc<Quaternion>(maxNumRotations) : nullptr;
+		Vector3* scaleSamples = maxNumScales > 0 ? bs_stack_alloc<Vector3>(maxNumScales) : nullptr;
+
 		// Note: For a possible performance improvement consider keeping an array of only active (non-disabled) bones and
 		// just iterate over them without mask checks. Possibly also a list of active curve mappings to avoid those checks
 		// as well.
@@ -204,17 +474,38 @@ namespace bs
 				if (Math::approxEquals(normWeight, 0.0f))
 					continue;
 
+				const CompressedAnimationCurves* compressedCurves = state.compressedCurves.get();
+				if (compressedCurves != nullptr)
+					compressedCurves->evaluate(state.time, state.loop, positionSamples, rotationSamples, scaleSamples);
+
+				// Sample the curves and pre-multiply them by the weight. Bones without a curve get values that leave the
+				// blended pose unchanged.
 				for (UINT32 k = 0; k < mNumBones; k++)
 				{
+					Vector3 position = Vector3::ZERO;
+					Quaternion rotation = Quaternion::ZERO;
+					Vector3 scale = Vector3::ONE;
+
 					if (!mask.isEnabled(k))
+					{
+						samples.set(k, position, rotation, scale);
 						continue;
+					}
 
 					const AnimationCurveMapping& mapping = state.boneToCurveMapping[k];
 					UINT32 curveIdx = mapping.position;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-						localPose.positions[k] += curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value;
+						if (compressedCurves != nullptr)
+							value = positionSamples[curveIdx];
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+							value = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+						}
+
+						position = value * normWeight;
 
 						localPose.hasOverride[k] = false;
 						hasAnimCurve[k] = true;
@@ -223,115 +514,156 @@ namespace bs
 					curveIdx = mapping.scale;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-						localPose.scales[k] *= curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value;
+						if (compressedCurves != nullptr)
+							value = scaleSamples[curveIdx];
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+							value = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+						}
+
+						scale = value * normWeight;
 
 						localPose.hasOverride[k] = false;
 						hasAnimCurve[k] = true;
 					}
 
-					if (layer.additive)
+					curveIdx = mapping.rotation;
+					if (curveIdx != (UINT32)-1)
 					{
-						curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
+						Quaternion value;
+						if (compressedCurves != nullptr)
+							value = rotationSamples[curveIdx];
+						else
 						{
-							bool isAssigned = localPose.rotations[k].w != 0.0f;
-							if (!isAssigned)
-								localPose.rotations[k] = Quaternion::IDENTITY;
-
 							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-							value = Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
-
-							localPose.rotations[k] *= value;
-							localPose.hasOverride[k] = false;
-							hasAnimCurve[k] = true;
+							value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
 						}
-					}
-					else
-					{
-						curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
+
+						// Additive rotations are rare, so they're applied directly rather than through the SIMD path
+						if (layer.additive)
 						{
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop) * normWeight;
+							Quaternion blendedRotation = blended.getRotation(k);
 
-							if (value.dot(localPose.rotations[k]) < 0.0f)
-								value = -value;
+							bool isAssigned = blendedRotation.w != 0.0f;
+							if (!isAssigned)
+								blendedRotation = Quaternion::IDENTITY;
 
-							localPose.rotations[k] += value;
-							localPose.hasOverride[k] = false;
-							hasAnimCurve[k] = true;
+							blendedRotation *= Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
+							blended.setRotation(k, blendedRotation);
 						}
+						else
+							rotation = value * normWeight;
+
+						localPose.hasOverride[k] = false;
+						hasAnimCurve[k] = true;
 					}
+
+					samples.set(k, position, rotation, scale);
 				}
+
+				blendSamples(blended, samples, numPaddedBones, !layer.additive);
 			}
 		}
 
+		if (scaleSamples != nullptr)
+			bs_stack_free(scaleSamples);
+
+		if (rotationSamples != nullptr)
+			bs_stack_free(rotationSamples);
+
+		if (positionSamples != nullptr)
+			bs_stack_free(positionSamples);
+
 		// Apply default local tranform to non-animated bones (so that any potential child bones are transformed properly)
 		for(UINT32 i = 0; i < mNumBones; i++)
 		{
 			if(hasAnimCurve[i])
 				continue;
 
-			localPose.positions[i] = mBoneTransforms[i].getPosition();
-			localPose.rotations[i] = mBoneTransforms[i].getRotation();
-			localPose.scales[i] = mBoneTransforms[i].getScale();
+			blended.set(i, mBoneTransforms[i].getPosition(), mBoneTransforms[i].getRotation(), 
+				mBoneTransforms[i].getScale());
 		}
 
-		// Calculate local pose matrices
-		UINT32 isGlobalBytes = sizeof(bool) * mNumBones;
-		bool* isGlobal = (bool*)bs_stack_alloc(isGlobalBytes);
-		memset(isGlobal, 0, isGlobalBytes);
+		normalizeRotations(blended, numPaddedBones);
 
 		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			bool isAssigned = localPose.rotations[i].w != 0.0f;
-			if (!isAssigned)
-				localPose.rotations[i] = Quaternion::IDENTITY;
-			else
-				localPose.rotations[i].normalize();
+			localPose.positions[i] = blended.getPosition(i);
+			localPose.rotations[i] = blended.getRotation(i);
+			localPose.scales[i] = blended.getScale(i);
+		}
 
-			if (localPose.hasOverride[i])
-			{
-				isGlobal[i] = true;
-				continue;
-			}
+		// Calculate local pose matrices. Overriden bones already contain their global transform.
+		calculateLocalMatrices(blended, numPaddedBones, mNumBones, localPose.hasOverride, pose);
+		calculateGlobalPose(pose, localPose.hasOverride);
 
-			pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
-		}
+		bs_stack_free(hasAnimCurve);
+		bs_stack_free(poseData);
+	}
 
-		// Calculate global poses
-		// Note: For a possible performance improvement consider sorting bones in such order so that parents (and overrides)
-		// always come before children, we no isGlobal check is needed.
-		std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+	void Skeleton::getPose(Matrix4* pose, const LocalSkeletonPose& localPose) const
+	{
+		assert(localPose.numBones == mNumBones);
+
+		UINT32 numPaddedBones = Math::divideAndRoundUp(mNumBones, SIMD_WIDTH) * SIMD_WIDTH;
+		float* poseData = bs_stack_alloc<float>(numPaddedBones * LocalPoseSoA::NUM_COMPONENTS);
+
+		LocalPoseSoA soaPose(poseData, numPaddedBones);
+		for (UINT32 i = 0; i < mNumBones; i++)
+			soaPose.set(i, localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
+
+		for (UINT32 i = mNumBones; i < numPaddedBones; i++)
+			soaPose.set(i, Vector3::ZERO, Quaternion::IDENTITY, Vector3::ONE);
+
+		calculateLocalMatrices(soaPose, numPaddedBones, mNumBones, localPose.hasOverride, pose);
+		calculateGlobalPose(pose, localPose.hasOverride);
+
+		bs_stack_free(poseData);
+	}
+
+	void Skeleton::calculateGlobalPose(Matrix4* pose, const bool* hasOverride) const
+	{
+		// Parents always come before their children in the evaluation order
+		for (auto& boneIdx : mEvaluationOrder)
 		{
+			if (hasOverride[boneIdx])
+				continue;
+
 			UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
 			if (parentBoneIdx == (UINT32)-1)
-			{
-				isGlobal[boneIdx] = true;
-				return;
-			}
+				continue;
+
+			concatenateAffine(pose[parentBoneIdx], pose[boneIdx], pose[boneIdx]);
+		}
 
-			if (!isGlobal[parentBoneIdx])
-				calcGlobal(parentBoneIdx);
+		for (UINT32 i = 0; i < mNumBones; i++)
+			concatenateAffine(pose[i], mInvBindPoses[i], pose[i]);
+	}
 
-			pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
-			isGlobal[boneIdx] = true;
-		};
+	void Skeleton::buildEvaluationOrder()
+	{
+		mEvaluationOrder.clear();
+		mEvaluationOrder.reserve(mNumBones);
 
+		Vector<bool> isAdded(mNumBones, false);
+		Vector<UINT32> parentChain;
 		for (UINT32 i = 0; i < mNumBones; i++)
 		{
-			if (!isGlobal[i])
-				calcGlobal(i);
-		}
+			// Add any parents that weren't yet added, starting from the top of the hierarchy
+			UINT32 boneIdx = i;
+			while (boneIdx < mNumBones && !isAdded[boneIdx])
+			{
+				parentChain.push_back(boneIdx);
+				isAdded[boneIdx] = true;
 
-		for (UINT32 i = 0; i < mNumBones; i++)
-			pose[i] = pose[i] * mInvBindPoses[i];
+				boneIdx = mBoneInfo[boneIdx].parent;
+			}
 
-		bs_stack_free(isGlobal);
-		bs_stack_free(hasAnimCurve);
+			mEvaluationOrder.insert(mEvaluationOrder.end(), parentChain.rbegin(), parentChain.rend());
+			parentChain.clear();
+		}
 	}
 
 	UINT32 Skeleton::getRootBoneIndex() const
@@ -43,6 +43,8 @@ namespace bs
 	struct AnimationState
 	{
 		SPtr<AnimationCurves> curves; /**< All curves in the animation clip. */
+		/** Compressed position, rotation and scale curves, if the clip was compressed. Replaces the curves in @p curves. */
+		SPtr<CompressedAnimationCurves> compressedCurves;
 		AnimationCurveMapping* boneToCurveMapping; /**< Mapping of bone indices to curve indices for quick lookup .*/
 		AnimationCurveMapping* soToCurveMapping; /**< Mapping of scene object indices to curve indices for quick lookup. */
 
@@ -152,6 +154,18 @@ namespace bs
 		void getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
 			const AnimationStateLayer* layers, UINT32 numLayers);
 
+		/** 
+		 * Outputs a skeleton pose containing required transforms for transforming the skeleton to the provided local
+		 * pose, such as one blended from multiple evaluated poses.
+		 *
+		 * @param[in, out]	pose		Output pose containing the requested transforms. Must be pre-allocated with
+		 *								enough space to hold all the bone matrices of this skeleton. Entries for bones
+		 *								that have an override in @p localPose must already contain their final
+		 *								transform.
+		 * @param[in]		localPose	Local transforms of all the bones in this skeleton.
+		 */
+		void getPose(Matrix4* pose, const LocalSkeletonPose& localPose) const;
+
 		/** Returns the total number of bones in the skeleton. */
 		BS_SCRIPT_EXPORT(pr:getter,n:NumBones)
 		UINT32 getNumBones() const { return mNumBones; }
@@ -177,10 +191,20 @@ namespace bs
 		Skeleton();
 		Skeleton(BONE_DESC* bones, UINT32 numBones);
 
+		/** Sorts the bones in an order in which every parent bone comes before its children. */
+		void buildEvaluationOrder();
+
+		/** 
+		 * Converts local bone matrices in @p pose into final bone transforms, by applying parent transforms and the
+		 * inverse bind pose. Bones that have an override are not transformed by their parents.
+		 */
+		void calculateGlobalPose(Matrix4* pose, const bool* hasOverride) const;
+
 		UINT32 mNumBones = 0;
 		Transform* mBoneTransforms = nullptr;
 		Matrix4* mInvBindPoses = nullptr;
 		SkeletonBoneInfo* mBoneInfo = nullptr;
+		Vector<UINT32> mEvaluationOrder;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -17,6 +17,17 @@ namespace bs
 		return !mIsDisabled[boneIdx];
 	}
 
+	SkeletonMask SkeletonMask::intersect(const SkeletonMask& other) const
+	{
+		UINT32 numBones = (UINT32)std::max(mIsDisabled.size(), other.mIsDisabled.size());
+
+		SkeletonMask output(numBones);
+		for (UINT32 i = 0; i < numBones; i++)
+			output.mIsDisabled[i] = !isEnabled(i) || !other.isEnabled(i);
+
+		return output;
+	}
+
 	SkeletonMaskBuilder::SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton)
 		:mSkeleton(skeleton), mMask(skeleton->getNumBones())
 	{ }
@@ -33,4 +44,33 @@ namespace bs
 			}
 		}
 	}
+
+	void SkeletonMaskBuilder::setLeafBoneState(UINT32 height, bool enabled)
+	{
+		// Find the length of the longest path from each bone to one of its leaf bones
+		UINT32 numBones = mSkeleton->getNumBones();
+		Vector<UINT32> boneHeights(numBones, 0);
+		for(UINT32 i = 0; i < numBones; i++)
+		{
+			UINT32 childHeight = 0;
+			UINT32 parent = mSkeleton->getBoneInfo(i).parent;
+			while(parent < numBones)
+			{
+				childHeight++;
+
+				// Parent chain was already visited through a longer path
+				if(boneHeights[parent] >= childHeight)
+					break;
+
+				boneHeights[parent] = childHeight;
+				parent = mSkeleton->getBoneInfo(parent).parent;
+			}
+		}
+
+		for(UINT32 i = 0; i < numBones; i++)
+		{
+			if(boneHeights[i] <= height)
+				mMask.mIsDisabled[i] = !enabled;
+		}
+	}
 }
\ No newline at end of file
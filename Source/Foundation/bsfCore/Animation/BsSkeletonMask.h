@@ -26,6 +26,12 @@ namespace bs
 		 */
 		bool isEnabled(UINT32 boneIdx) const;
 
+		/** Returns a mask that has only the bones enabled in both this and the provided mask enabled. */
+		SkeletonMask intersect(const SkeletonMask& other) const;
+
+		bool operator==(const SkeletonMask& rhs) const { return mIsDisabled == rhs.mIsDisabled; }
+		bool operator!=(const SkeletonMask& rhs) const { return !(*this == rhs); }
+
 	private:
 		friend class SkeletonMaskBuilder;
 
@@ -41,6 +47,13 @@ namespace bs
 		/** Enables or disables a bone with the specified name. */
 		void setBoneState(const String& name, bool enabled);
 
+		/** 
+		 * Enables or disables all bones that are at most @p height levels above a leaf bone. Height of zero affects only
+		 * the leaf bones (e.g. finger tips), height of one their parents as well, and so on. Useful for building masks
+		 * for lower animation levels of detail, where small bones such as fingers and facial bones can be skipped.
+		 */
+		void setLeafBoneState(UINT32 height, bool enabled);
+
 		/** Teturns the built skeleton mask. */
 		SkeletonMask getMask() const { return mMask; }
 
@@ -6,7 +6,7 @@
 namespace bs
 {
 	AudioClipImportOptions::AudioClipImportOptions()
-		:mFormat(AudioFormat::PCM), mReadMode(AudioReadMode::LoadDecompressed), mIs3D(true), mBitDepth(16)
+		:mFormat(AudioFormat::PCM), mReadMode(AudioReadMode::LoadDecompressed), mIs3D(true), mBitDepth(16), mSampleRate(0)
 	{
 		
 	}
@@ -45,7 +45,14 @@ namespace bs
 		/** Sets the size of a single sample in bits. The clip will be converted to this bit depth on import. */
 		void setBitDepth(UINT32 bitDepth) { mBitDepth = bitDepth; }
 
-		// Note: Add options to resample to a different frequency
+		/** Returns the sample rate to convert the clip to on import, in hertz. Zero if the original rate is kept. */
+		UINT32 getSampleRate() const { return mSampleRate; }
+
+		/** 
+		 * Sets the sample rate to convert the clip to on import, in hertz. Set to zero to keep the sample rate of the
+		 * source audio.
+		 */
+		void setSampleRate(UINT32 sampleRate) { mSampleRate = sampleRate; }
 
 		/** Creates a new import options object that allows you to customize how are audio clips imported. */
 		static SPtr<AudioClipImportOptions> create();
@@ -55,6 +62,7 @@ namespace bs
 		AudioReadMode mReadMode;
 		bool mIs3D;
 		UINT32 mBitDepth;
+		UINT32 mSampleRate;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -0,0 +1,216 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Audio/BsAudioResampler.h"
+#include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
+
+namespace bs
+{
+	/** Zero-order modified Bessel function of the first kind, used for the Kaiser window. */
+	double besselI0(double x)
+	{
+		double sum = 1.0;
+		double term = 1.0;
+		double halfX = x * 0.5;
+
+		for (UINT32 i = 1; i < 32; i++)
+		{
+			term *= halfX / i;
+			sum += term * term;
+		}
+
+		return sum;
+	}
+
+	UINT32 greatestCommonDivisor(UINT32 a, UINT32 b)
+	{
+		while (b != 0)
+		{
+			UINT32 temp = a % b;
+			a = b;
+			b = temp;
+		}
+
+		return a;
+	}
+
+	AudioResampler::AudioResampler(UINT32 inSampleRate, UINT32 outSampleRate, UINT32 numChannels, UINT32 quality)
+		:mNumChannels(numChannels), mPosition(0), mPhase(0)
+	{
+		assert(inSampleRate > 0 && outSampleRate > 0 && numChannels > 0);
+
+		UINT32 divisor = greatestCommonDivisor(inSampleRate, outSampleRate);
+		mNumPhases = outSampleRate / divisor;
+		mStep = inSampleRate / divisor;
+
+		// Unusual rate pairs can require a huge number of phases. Limit the size of the filter table in that case and
+		// use the closest filter phase instead. The rate ratio itself remains exact.
+		mNumFilterPhases = std::min(mNumPhases, MaxNumFilterPhases);
+
+		// When downsampling, lower the cutoff to the output Nyquist frequency to avoid aliasing. The filter is made
+		// longer proportionally to keep the same transition band width. Cutoff is also pulled a bit below Nyquist to
+		// leave room for the transition band.
+		double cutoff = std::min(1.0, mNumPhases / (double)mStep) * 0.95;
+
+		mHalfNumTaps = (UINT32)std::ceil(quality / cutoff);
+		mHalfNumTaps = (mHalfNumTaps + 1) & ~1U; // Keep the total number of taps a multiple of four, for SIMD
+		mNumTaps = mHalfNumTaps * 2;
+
+		static const double KAISER_BETA = 8.0;
+		double invI0Beta = 1.0 / besselI0(KAISER_BETA);
+
+		mFilter.resize(mNumFilterPhases * mNumTaps);
+		for (UINT32 phase = 0; phase < mNumFilterPhases; phase++)
+		{
+			float* coefficients = &mFilter[phase * mNumTaps];
+
+			double sum = 0.0;
+			for (UINT32 tap = 0; tap < mNumTaps; tap++)
+			{
+				// Distance from the output sample to the input sample this tap applies to, in input samples
+				double x = (double)tap - (mHalfNumTaps - 1) - phase / (double)mNumFilterPhases;
+
+				double sinc = 1.0;
+				if (std::abs(x) > 1e-9)
+				{
+					double arg = Math::PI * cutoff * x;
+					sinc = std::sin(arg) / arg;
+				}
+
+				double windowPos = x / mHalfNumTaps;
+				double window = 0.0;
+				if (std::abs(windowPos) < 1.0)
+					window = besselI0(KAISER_BETA * std::sqrt(1.0 - windowPos * windowPos)) * invI0Beta;
+
+				double value = cutoff * sinc * window;
+				coefficients[tap] = (float)value;
+				sum += value;
+			}
+
+			// Normalize for unity gain at DC
+			float invSum = (float)(1.0 / sum);
+			for (UINT32 tap = 0; tap < mNumTaps; tap++)
+				coefficients[tap] *= invSum;
+		}
+
+		mBuffers.resize(mNumChannels);
+		reset();
+	}
+
+	UINT32 AudioResampler::process(const float* input, UINT32 numFrames, float* output)
+	{
+		append(input, numFrames);
+		return this->output(output);
+	}
+
+	UINT32 AudioResampler::flush(float* output)
+	{
+		appendSilence(mHalfNumTaps);
+		return this->output(output);
+	}
+
+	void AudioResampler::reset()
+	{
+		// Start with enough silence before the first input frame so the first output frame is aligned with it
+		for (auto& buffer : mBuffers)
+		{
+			buffer.clear();
+			buffer.resize(mHalfNumTaps - 1, 0.0f);
+		}
+
+		mPosition = mHalfNumTaps - 1;
+		mPhase = 0;
+	}
+
+	UINT32 AudioResampler::getMaxNumOutputFrames(UINT32 numFrames, bool flush) const
+	{
+		UINT32 numAvailableFrames = (UINT32)mBuffers[0].size() + numFrames;
+		if (flush)
+			numAvailableFrames += mHalfNumTaps;
+
+		if (numAvailableFrames < mPosition + mHalfNumTaps + 1)
+			return 0;
+
+		UINT64 start = (UINT64)mPosition * mNumPhases + mPhase;
+		UINT64 end = (UINT64)(numAvailableFrames - mHalfNumTaps) * mNumPhases;
+
+		return (UINT32)((end - start + mStep - 1) / mStep);
+	}
+
+	UINT32 AudioResampler::getNumResampledFrames(UINT32 numFrames, UINT32 inSampleRate, UINT32 outSampleRate)
+	{
+		return (UINT32)(((UINT64)numFrames * outSampleRate + inSampleRate - 1) / inSampleRate);
+	}
+
+	void AudioResampler::append(const float* input, UINT32 numFrames)
+	{
+		for (UINT32 i = 0; i < mNumChannels; i++)
+		{
+			Vector<float>& buffer = mBuffers[i];
+
+			UINT32 offset = (UINT32)buffer.size();
+			buffer.resize(offset + numFrames);
+
+			const float* src = input + i;
+			for (UINT32 j = 0; j < numFrames; j++)
+			{
+				buffer[offset + j] = *src;
+				src += mNumChannels;
+			}
+		}
+	}
+
+	void AudioResampler::appendSilence(UINT32 numFrames)
+	{
+		for (auto& buffer : mBuffers)
+			buffer.resize(buffer.size() + numFrames, 0.0f);
+	}
+
+	UINT32 AudioResampler::output(float* output)
+	{
+		UINT32 numBufferedFrames = (UINT32)mBuffers[0].size();
+
+		UINT32 numOutputFrames = 0;
+		while (mPosition + mHalfNumTaps < numBufferedFrames)
+		{
+			UINT32 filterPhase = (UINT32)((UINT64)mPhase * mNumFilterPhases / mNumPhases);
+			const float* coefficients = &mFilter[filterPhase * mNumTaps];
+			UINT32 firstFrame = mPosition - (mHalfNumTaps - 1);
+
+			for (UINT32 i = 0; i < mNumChannels; i++)
+			{
+				const float* samples = &mBuffers[i][firstFrame];
+
+				simd::float32<4> sum = simd::splat<simd::float32<4>>(0.0f);
+				for (UINT32 tap = 0; tap < mNumTaps; tap += 4)
+				{
+					simd::float32<4> sampleValues = simd::load_u<simd::float32<4>>(samples + tap);
+					simd::float32<4> coefficientValues = simd::load_u<simd::float32<4>>(coefficients + tap);
+
+					sum = simd::add(sum, simd::mul(sampleValues, coefficientValues));
+				}
+
+				output[i] = simd::reduce_add(sum);
+			}
+
+			output += mNumChannels;
+			numOutputFrames++;
+
+			UINT64 phase = (UINT64)mPhase + mStep;
+			mPosition += (UINT32)(phase / mNumPhases);
+			mPhase = (UINT32)(phase % mNumPhases);
+		}
+
+		// Discard frames that are no longer needed by any future output frame
+		UINT32 firstNeededFrame = std::min(mPosition - (mHalfNumTaps - 1), numBufferedFrames);
+		if (firstNeededFrame > 0)
+		{
+			for (auto& buffer : mBuffers)
+				buffer.erase(buffer.begin(), buffer.begin() + firstNeededFrame);
+
+			mPosition -= firstNeededFrame;
+		}
+
+		return numOutputFrames;
+	}
+}
@@ -0,0 +1,100 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Audio
+	 *  @{
+	 */
+
+	/**
+	 * Converts floating point audio samples from one sample rate to another, using a polyphase windowed-sinc filter.
+	 * Keeps internal state between calls to process(), so a continuous stream of data can be resampled in chunks of
+	 * arbitrary size (e.g. when streaming).
+	 */
+	class BS_CORE_EXPORT AudioResampler
+	{
+	public:
+		/**
+		 * Creates a new resampler.
+		 *
+		 * @param[in]	inSampleRate	Sample rate of the input data, in hertz.
+		 * @param[in]	outSampleRate	Sample rate to convert the data to, in hertz.
+		 * @param[in]	numChannels		Number of interleaved channels in the input (and output) data.
+		 * @param[in]	quality			Number of zero crossings of the filter on each side of an output sample. Higher
+		 *								values yield a sharper filter with less aliasing, at a higher CPU cost.
+		 */
+		AudioResampler(UINT32 inSampleRate, UINT32 outSampleRate, UINT32 numChannels, UINT32 quality = 16);
+
+		/**
+		 * Resamples the provided input data. Resampled data is written to @p output as it becomes available. Because of
+		 * filter latency the last few input frames are kept internally until more data is provided, or flush() is called.
+		 *
+		 * @param[in]	input			Interleaved input samples. Should contain @p numFrames * number of channels
+		 *								samples.
+		 * @param[in]	numFrames		Number of frames (samples per channel) in the @p input buffer.
+		 * @param[out]	output			Pre-allocated buffer to write the interleaved output samples to. Should be large
+		 *								enough to contain getMaxNumOutputFrames(@p numFrames) frames.
+		 * @return						Number of frames written to the @p output buffer.
+		 */
+		UINT32 process(const float* input, UINT32 numFrames, float* output);
+
+		/**
+		 * Outputs any remaining data held by the resampler, as if the input was followed by silence. Should be called once
+		 * after all input has been provided.
+		 *
+		 * @param[out]	output			Pre-allocated buffer to write the interleaved output samples to. Should be large
+		 *								enough to contain getMaxNumOutputFrames(0, true) frames.
+		 * @return						Number of frames written to the @p output buffer.
+		 */
+		UINT32 flush(float* output);
+
+		/** Clears all internal state, so the resampler can be re-used for an unrelated set of input data. */
+		void reset();
+
+		/**
+		 * Returns the maximum number of frames that may be output for the specified number of input frames.
+		 *
+		 * @param[in]	numFrames	Number of input frames that will be provided to process().
+		 * @param[in]	flush		True if the value is being calculated for a call to flush(), in which case
+		 *							@p numFrames should be zero.
+		 * @return					Maximum number of output frames.
+		 */
+		UINT32 getMaxNumOutputFrames(UINT32 numFrames, bool flush = false) const;
+
+		/**
+		 * Returns the number of frames the data will have after being resampled from @p inSampleRate to
+		 * @p outSampleRate.
+		 */
+		static UINT32 getNumResampledFrames(UINT32 numFrames, UINT32 inSampleRate, UINT32 outSampleRate);
+
+	private:
+		/** Appends interleaved input frames to the internal per-channel buffers. */
+		void append(const float* input, UINT32 numFrames);
+
+		/** Appends silence to the internal per-channel buffers. */
+		void appendSilence(UINT32 numFrames);
+
+		/** Outputs as many frames as currently possible with the buffered data, and discards data no longer needed. */
+		UINT32 output(float* output);
+
+		static const UINT32 MaxNumFilterPhases = 1024;
+
+		UINT32 mNumChannels;
+		UINT32 mNumPhases; // Upsampling factor
+		UINT32 mStep; // Downsampling factor
+		UINT32 mHalfNumTaps;
+		UINT32 mNumTaps;
+		UINT32 mNumFilterPhases;
+		Vector<float> mFilter; // mNumFilterPhases filters of mNumTaps coefficients each
+
+		Vector<Vector<float>> mBuffers; // Per-channel input data
+		UINT32 mPosition; // Index of the input frame the next output frame is sampled at
+		UINT32 mPhase; // Fractional position between mPosition and the next input frame, in 1/mNumPhases units
+	};
+
+	/** @} */
+}
@@ -1,12 +1,50 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Audio/BsAudioUtility.h"
+#include "Audio/BsAudioResampler.h"
+#include "Audio/BsAudioClipImportOptions.h"
+#include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
+	/** Divides a sum of two 32-bit values by two, rounding towards zero (same as integer division by two). */
+	simd::int32<4> halveTowardsZero(const simd::int32<4>& sum)
+	{
+		simd::int32<4> negativeBias = simd::bit_cast<simd::int32<4>>(simd::shift_r<31>(simd::bit_cast<simd::uint32<4>>(sum)));
+		return simd::shift_r<1>(simd::add(sum, negativeBias));
+	}
+
 	void convertToMono8(const INT8* input, UINT8* output, UINT32 numSamples, UINT32 numChannels)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		UINT32 i = 0;
+		if (numChannels == 2)
+		{
+			// Down-mix 8 frames at a time
+			for (; i + 8 <= numSamples; i += 8)
+			{
+				simd::int8<16> frames = simd::load_u<simd::int8<16>>(input);
+				simd::int32<16> samples = simd::to_int32(frames);
+
+				simd::int32<4> sums[2];
+				for (UINT32 j = 0; j < 2; j++)
+				{
+					simd::int32<4> left = simd::unzip4_lo(samples.vec(j * 2), samples.vec(j * 2 + 1));
+					simd::int32<4> right = simd::unzip4_hi(samples.vec(j * 2), samples.vec(j * 2 + 1));
+
+					sums[j] = halveTowardsZero(simd::add(left, right));
+				}
+
+				INT8 mono[8];
+				simd::store_u(mono, simd::to_int8(simd::combine(sums[0], sums[1])));
+				memcpy(output, mono, sizeof(mono));
+
+				input += 16;
+				output += 8;
+			}
+		}
+
+		for (; i < numSamples; i++)
 		{
 			INT16 sum = 0;
 			for (UINT32 j = 0; j < numChannels; j++)
@@ -15,14 +53,35 @@ namespace bs
 				++input;
 			}
 
-			*output = sum / numChannels;
+			*output = sum / (INT32)numChannels;
 			++output;
 		}
 	}
 
 	void convertToMono16(const INT16* input, INT16* output, UINT32 numSamples, UINT32 numChannels)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		UINT32 i = 0;
+		if (numChannels == 2)
+		{
+			// Down-mix 4 frames at a time
+			for (; i + 4 <= numSamples; i += 4)
+			{
+				simd::int32<8> samples = simd::to_int32(simd::load_u<simd::int16<8>>(input));
+
+				simd::int32<4> left = simd::unzip4_lo(samples.vec(0), samples.vec(1));
+				simd::int32<4> right = simd::unzip4_hi(samples.vec(0), samples.vec(1));
+
+				INT32 mono[4];
+				simd::store_u(mono, halveTowardsZero(simd::add(left, right)));
+				for (UINT32 j = 0; j < 4; j++)
+					output[j] = (INT16)mono[j];
+
+				input += 8;
+				output += 4;
+			}
+		}
+
+		for (; i < numSamples; i++)
 		{
 			INT32 sum = 0;
 			for (UINT32 j = 0; j < numChannels; j++)
@@ -31,7 +90,7 @@ namespace bs
 				++input;
 			}
 
-			*output = sum / numChannels;
+			*output = sum / (INT32)numChannels;
 			++output;
 		}
 	}
@@ -63,7 +122,35 @@ namespace bs
 
 	void convertToMono32(const INT32* input, INT32* output, UINT32 numSamples, UINT32 numChannels)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		UINT32 i = 0;
+		if (numChannels == 2)
+		{
+			// Down-mix 4 frames at a time. The sum can overflow 32 bits so the average is calculated as 
+			// floor(a / 2) + floor(b / 2) + (a & b & 1), and then corrected to round towards zero.
+			simd::int32<4> one = simd::splat<simd::int32<4>>(1);
+			for (; i + 4 <= numSamples; i += 4)
+			{
+				simd::int32<4> first = simd::load_u<simd::int32<4>>(input);
+				simd::int32<4> second = simd::load_u<simd::int32<4>>(input + 4);
+
+				simd::int32<4> left = simd::unzip4_lo(first, second);
+				simd::int32<4> right = simd::unzip4_hi(first, second);
+
+				simd::int32<4> avg = simd::add(simd::shift_r<1>(left), simd::shift_r<1>(right));
+				avg = simd::add(avg, simd::bit_and(simd::bit_and(left, right), one));
+
+				simd::int32<4> isOdd = simd::bit_and(simd::bit_xor(left, right), one);
+				simd::int32<4> isNegative = simd::bit_cast<simd::int32<4>>(simd::shift_r<31>(simd::bit_cast<simd::uint32<4>>(avg)));
+				avg = simd::add(avg, simd::bit_and(isOdd, isNegative));
+
+				simd::store_u(output, avg);
+
+				input += 8;
+				output += 4;
+			}
+		}
+
+		for (; i < numSamples; i++)
 		{
 			INT64 sum = 0;
 			for (UINT32 j = 0; j < numChannels; j++)
@@ -77,9 +164,43 @@ namespace bs
 		}
 	}
 
+	/** 
+	 * Expands four packed 24-bit samples into 32-bit samples. Reads 16 bytes from @p input, even though only the first
+	 * 12 are used.
+	 */
+	simd::int32<4> load24BitSamples(const UINT8* input)
+	{
+		// Place the three sample bytes in the upper three bytes of each 32-bit value. The lowest byte is masked out.
+		static const UINT8 expandMask[16] = { 0, 0, 1, 2, 3, 3, 4, 5, 6, 6, 7, 8, 9, 9, 10, 11 };
+
+		simd::uint8<16> bytes = simd::load_u<simd::uint8<16>>(input);
+		simd::uint8<16> expanded = simd::permute_bytes16(bytes, simd::load_u<simd::uint8<16>>(expandMask));
+
+		return simd::bit_and(simd::bit_cast<simd::int32<4>>(expanded), simd::splat<simd::int32<4>>((INT32)0xFFFFFF00));
+	}
+
+	/** 
+	 * Packs the upper three bytes of four 32-bit samples into 24-bit samples. Writes 16 bytes to @p output, even though
+	 * only the first 12 are valid.
+	 */
+	void store24BitSamples(UINT8* output, const simd::int32<4>& samples)
+	{
+		static const UINT8 packMask[16] = { 1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, 0, 0, 0, 0 };
+
+		simd::uint8<16> bytes = simd::bit_cast<simd::uint8<16>>(samples);
+		simd::store_u(output, simd::permute_bytes16(bytes, simd::load_u<simd::uint8<16>>(packMask)));
+	}
+
 	void convert8To32Bits(const INT8* input, INT32* output, UINT32 numSamples)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		UINT32 i = 0;
+		for (; i + 16 <= numSamples; i += 16)
+		{
+			simd::int32<16> samples = simd::to_int32(simd::load_u<simd::int8<16>>(input + i));
+			simd::store_u(output + i, simd::shift_l<24>(samples));
+		}
+
+		for (; i < numSamples; i++)
 		{
 			INT8 val = input[i];
 			output[i] = val << 24;
@@ -88,13 +209,28 @@ namespace bs
 
 	void convert16To32Bits(const INT16* input, INT32* output, UINT32 numSamples)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		UINT32 i = 0;
+		for (; i + 8 <= numSamples; i += 8)
+		{
+			simd::int32<8> samples = simd::to_int32(simd::load_u<simd::int16<8>>(input + i));
+			simd::store_u(output + i, simd::shift_l<16>(samples));
+		}
+
+		for (; i < numSamples; i++)
 			output[i] = input[i] << 16;
 	}
 
 	void convert24To32Bits(const UINT8* input, INT32* output, UINT32 numSamples)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		// Vector loads read 16 bytes, so stop early enough not to read past the end of the buffer
+		UINT32 i = 0;
+		for (; i + 6 <= numSamples; i += 4)
+		{
+			simd::store_u(output + i, load24BitSamples(input));
+			input += 12;
+		}
+
+		for (; i < numSamples; i++)
 		{
 			output[i] = AudioUtility::convert24To32Bits(input);
 			input += 3;
@@ -103,19 +239,41 @@ namespace bs
 
 	void convert32To8Bits(const INT32* input, UINT8* output, UINT32 numSamples)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		UINT32 i = 0;
+		for (; i + 16 <= numSamples; i += 16)
+		{
+			simd::int32<16> samples = simd::load_u<simd::int32<16>>(input + i);
+			simd::store_u(output + i, simd::to_int8(simd::shift_r<24>(samples)));
+		}
+
+		for (; i < numSamples; i++)
 			output[i] = (INT8)(input[i] >> 24);
 	}
 
 	void convert32To16Bits(const INT32* input, INT16* output, UINT32 numSamples)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		UINT32 i = 0;
+		for (; i + 8 <= numSamples; i += 8)
+		{
+			simd::int32<8> samples = simd::load_u<simd::int32<8>>(input + i);
+			simd::store_u(output + i, simd::to_int16(simd::shift_r<16>(samples)));
+		}
+
+		for (; i < numSamples; i++)
 			output[i] = (INT16)(input[i] >> 16);
 	}
 
 	void convert32To24Bits(const INT32* input, UINT8* output, UINT32 numSamples)
 	{
-		for (UINT32 i = 0; i < numSamples; i++)
+		// Vector stores write 16 bytes, so stop early enough not to write past the end of the buffer
+		UINT32 i = 0;
+		for (; i + 6 <= numSamples; i += 4)
+		{
+			store24BitSamples(output, simd::load_u<simd::int32<4>>(input + i));
+			output += 12;
+		}
+
+		for (; i < numSamples; i++)
 		{
 			convert32To24Bits(input[i], output);
 			output += 3;
@@ -204,29 +362,48 @@ namespace bs
 
 	void AudioUtility::convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples)
 	{
+		UINT32 i = 0;
 		if (inBitDepth == 8)
 		{
-			for (UINT32 i = 0; i < numSamples; i++)
-			{
-				INT8 sample = *(INT8*)input;
-				output[i] = sample / 127.0f;
+			const INT8* samples = (const INT8*)input;
 
-				input++;
+			simd::float32<16> scale = simd::splat<simd::float32<16>>(1.0f / 127.0f);
+			for (; i + 16 <= numSamples; i += 16)
+			{
+				simd::float32<16> values = simd::to_float32(simd::load_u<simd::int8<16>>(samples + i));
+				simd::store_u(output + i, simd::mul(values, scale));
 			}
+
+			for (; i < numSamples; i++)
+				output[i] = samples[i] / 127.0f;
 		}
 		else if (inBitDepth == 16)
 		{
-			for (UINT32 i = 0; i < numSamples; i++)
-			{
-				INT16 sample = *(INT16*)input;
-				output[i] = sample / 32767.0f;
+			const INT16* samples = (const INT16*)input;
 
-				input += 2;
+			simd::float32<8> scale = simd::splat<simd::float32<8>>(1.0f / 32767.0f);
+			for (; i + 8 <= numSamples; i += 8)
+			{
+				simd::float32<8> values = simd::to_float32(simd::load_u<simd::int16<8>>(samples + i));
+				simd::store_u(output + i, simd::mul(values, scale));
 			}
+
+			for (; i < numSamples; i++)
+				output[i] = samples[i] / 32767.0f;
 		}
 		else if (inBitDepth == 24)
 		{
-			for (UINT32 i = 0; i < numSamples; i++)
+			// Vector loads read 16 bytes, so stop early enough not to read past the end of the buffer
+			simd::float32<4> scale = simd::splat<simd::float32<4>>(1.0f / 2147483647.0f);
+			for (; i + 6 <= numSamples; i += 4)
+			{
+				simd::float32<4> values = simd::to_float32(load24BitSamples(input));
+				simd::store_u(output + i, simd::mul(values, scale));
+
+				input += 12;
+			}
+
+			for (; i < numSamples; i++)
 			{
 				INT32 sample = convert24To32Bits(input);
 				output[i] = sample / 2147483647.0f;
@@ -236,18 +413,210 @@ namespace bs
 		}
 		else if (inBitDepth == 32)
 		{
-			for (UINT32 i = 0; i < numSamples; i++)
+			const INT32* samples = (const INT32*)input;
+
+			simd::float32<4> scale = simd::splat<simd::float32<4>>(1.0f / 2147483647.0f);
+			for (; i + 4 <= numSamples; i += 4)
 			{
-				INT32 sample = *(INT32*)input;
-				output[i] = sample / 2147483647.0f;
+				simd::float32<4> values = simd::to_float32(simd::load_u<simd::int32<4>>(samples + i));
+				simd::store_u(output + i, simd::mul(values, scale));
+			}
+
+			for (; i < numSamples; i++)
+				output[i] = samples[i] / 2147483647.0f;
+		}
+		else
+			assert(false);
+	}
+
+	void AudioUtility::convertFromFloat(const float* input, UINT8* output, UINT32 outBitDepth, UINT32 numSamples)
+	{
+		// Largest float that still fits into a 32-bit signed integer
+		static const float MAX_INT32_FLOAT = 2147483520.0f;
+
+		simd::float32<4> minValue = simd::splat<simd::float32<4>>(-1.0f);
+		simd::float32<4> maxValue = simd::splat<simd::float32<4>>(1.0f);
+
+		UINT32 i = 0;
+		if (outBitDepth == 8)
+		{
+			INT8* samples = (INT8*)output;
+
+			simd::float32<4> scale = simd::splat<simd::float32<4>>(127.0f);
+			for (; i + 16 <= numSamples; i += 16)
+			{
+				simd::int32<4> values[4];
+				for (UINT32 j = 0; j < 4; j++)
+				{
+					simd::float32<4> value = simd::load_u<simd::float32<4>>(input + i + j * 4);
+					value = simd::min(simd::max(value, minValue), maxValue);
+
+					values[j] = simd::to_int32(simd::mul(value, scale));
+				}
+
+				simd::int32<16> combined = simd::combine(simd::combine(values[0], values[1]), 
+					simd::combine(values[2], values[3]));
+				simd::store_u(samples + i, simd::to_int8(combined));
+			}
+
+			for (; i < numSamples; i++)
+				samples[i] = (INT8)(Math::clamp(input[i], -1.0f, 1.0f) * 127.0f);
+		}
+		else if (outBitDepth == 16)
+		{
+			INT16* samples = (INT16*)output;
+
+			simd::float32<4> scale = simd::splat<simd::float32<4>>(32767.0f);
+			for (; i + 8 <= numSamples; i += 8)
+			{
+				simd::int32<4> values[2];
+				for (UINT32 j = 0; j < 2; j++)
+				{
+					simd::float32<4> value = simd::load_u<simd::float32<4>>(input + i + j * 4);
+					value = simd::min(simd::max(value, minValue), maxValue);
+
+					values[j] = simd::to_int32(simd::mul(value, scale));
+				}
+
+				simd::store_u(samples + i, simd::to_int16(simd::combine(values[0], values[1])));
+			}
+
+			for (; i < numSamples; i++)
+				samples[i] = (INT16)(Math::clamp(input[i], -1.0f, 1.0f) * 32767.0f);
+		}
+		else if (outBitDepth == 24)
+		{
+			// Vector stores write 16 bytes, so stop early enough not to write past the end of the buffer
+			simd::float32<4> scale = simd::splat<simd::float32<4>>(8388607.0f);
+			for (; i + 6 <= numSamples; i += 4)
+			{
+				simd::float32<4> value = simd::load_u<simd::float32<4>>(input + i);
+				value = simd::min(simd::max(value, minValue), maxValue);
+
+				simd::int32<4> values = simd::shift_l<8>(simd::to_int32(simd::mul(value, scale)));
+				store24BitSamples(output, values);
+
+				output += 12;
+			}
+
+			for (; i < numSamples; i++)
+			{
+				INT32 sample = (INT32)(Math::clamp(input[i], -1.0f, 1.0f) * 8388607.0f);
+				convert32To24Bits(sample << 8, output);
+
+				output += 3;
+			}
+		}
+		else if (outBitDepth == 32)
+		{
+			INT32* samples = (INT32*)output;
+
+			simd::float32<4> scale = simd::splat<simd::float32<4>>(2147483647.0f);
+			simd::float32<4> maxScaled = simd::splat<simd::float32<4>>(MAX_INT32_FLOAT);
+			for (; i + 4 <= numSamples; i += 4)
+			{
+				simd::float32<4> value = simd::load_u<simd::float32<4>>(input + i);
+				value = simd::min(simd::max(value, minValue), maxValue);
+				value = simd::min(simd::mul(value, scale), maxScaled);
+
+				simd::store_u(samples + i, simd::to_int32(value));
+			}
 
-				input += 4;
+			for (; i < numSamples; i++)
+			{
+				float value = Math::clamp(input[i], -1.0f, 1.0f) * 2147483647.0f;
+				samples[i] = (INT32)std::min(value, MAX_INT32_FLOAT);
 			}
 		}
 		else
 			assert(false);
 	}
 
+	void AudioUtility::resample(const float* input, UINT32 numFrames, UINT32 numChannels, UINT32 inSampleRate, 
+		float* output, UINT32 outSampleRate)
+	{
+		UINT32 numOutputFrames = AudioResampler::getNumResampledFrames(numFrames, inSampleRate, outSampleRate);
+		if (inSampleRate == outSampleRate)
+		{
+			memcpy(output, input, numFrames * numChannels * sizeof(float));
+			return;
+		}
+
+		// Process in chunks so the resampler doesn't need to keep a copy of the entire input
+		static const UINT32 CHUNK_SIZE = 16384;
+
+		AudioResampler resampler(inSampleRate, outSampleRate, numChannels);
+
+		// Resampler keeps a few frames buffered between calls, so leave some extra room
+		UINT32 maxChunkOutputFrames = AudioResampler::getNumResampledFrames(CHUNK_SIZE * 2, inSampleRate, outSampleRate);
+		maxChunkOutputFrames = std::max(maxChunkOutputFrames, resampler.getMaxNumOutputFrames(0, true));
+
+		float* chunkOutput = (float*)bs_alloc(maxChunkOutputFrames * numChannels * sizeof(float));
+
+		UINT32 numWrittenFrames = 0;
+		auto writeOutput = [&](UINT32 numChunkFrames)
+		{
+			UINT32 numFramesToCopy = std::min(numChunkFrames, numOutputFrames - numWrittenFrames);
+			memcpy(output + numWrittenFrames * numChannels, chunkOutput, numFramesToCopy * numChannels * sizeof(float));
+
+			numWrittenFrames += numFramesToCopy;
+		};
+
+		for (UINT32 i = 0; i < numFrames; i += CHUNK_SIZE)
+		{
+			UINT32 numChunkFrames = std::min(CHUNK_SIZE, numFrames - i);
+			assert(resampler.getMaxNumOutputFrames(numChunkFrames) <= maxChunkOutputFrames);
+
+			writeOutput(resampler.process(input + i * numChannels, numChunkFrames, chunkOutput));
+		}
+
+		assert(resampler.getMaxNumOutputFrames(0, true) <= maxChunkOutputFrames);
+		writeOutput(resampler.flush(chunkOutput));
+
+		bs_free(chunkOutput);
+
+		// Shouldn't happen, but make sure the output is fully initialized
+		if (numWrittenFrames < numOutputFrames)
+			memset(output + numWrittenFrames * numChannels, 0, (numOutputFrames - numWrittenFrames) * numChannels * sizeof(float));
+	}
+
+	void AudioUtility::resampleForImport(const AudioClipImportOptions& importOptions, UINT8*& samples, 
+		UINT32& bufferSize, AudioDataInfo& info)
+	{
+		UINT32 sampleRate = importOptions.getSampleRate();
+		if(sampleRate == 0 || sampleRate == info.sampleRate)
+			return;
+
+		UINT32 numFrames = info.numSamples / info.numChannels;
+		UINT32 numResampledFrames = AudioResampler::getNumResampledFrames(numFrames, info.sampleRate, sampleRate);
+		UINT32 numResampledSamples = numResampledFrames * info.numChannels;
+
+		float* floatSamples = (float*)bs_alloc(info.numSamples * sizeof(float));
+		convertToFloat(samples, info.bitDepth, floatSamples, info.numSamples);
+
+		bs_free(samples);
+
+		float* resampledSamples = (float*)bs_alloc(numResampledSamples * sizeof(float));
+		resample(floatSamples, numFrames, info.numChannels, info.sampleRate, resampledSamples, sampleRate);
+
+		bs_free(floatSamples);
+
+		UINT32 outBitDepth = importOptions.getBitDepth();
+		UINT32 outBufferSize = numResampledSamples * (outBitDepth / 8);
+		UINT8* outBuffer = (UINT8*)bs_alloc(outBufferSize);
+
+		convertFromFloat(resampledSamples, outBuffer, outBitDepth, numResampledSamples);
+
+		bs_free(resampledSamples);
+
+		info.numSamples = numResampledSamples;
+		info.sampleRate = sampleRate;
+		info.bitDepth = outBitDepth;
+
+		samples = outBuffer;
+		bufferSize = outBufferSize;
+	}
+
 	INT32 AudioUtility::convert24To32Bits(const UINT8* input)
 	{
 		return (input[2] << 24) | (input[1] << 16) | (input[0] << 8);
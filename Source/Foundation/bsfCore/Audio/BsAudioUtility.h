@@ -53,6 +53,50 @@ namespace bs
 		 */
 		static void convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples);
 
+		/**
+		 * Converts a set of floating point audio samples in range [-1, 1] into a set of signed integer samples of the
+		 * specified bit depth. Values outside of the valid range are clamped.
+		 *
+		 * @param[in]	input		A set of input samples. Total size of the buffer should be @p numSamples *
+		 *							sizeof(float).
+		 * @param[out]	output		Pre-allocated buffer to store the output samples in. Total size of the buffer should be
+		 *							@p numSamples * @p outBitDepth / 8.
+		 * @param[in]	outBitDepth	Size of a single sample in the @p output array, in bits.
+		 * @param[in]	numSamples	Total number of samples to process.
+		 */
+		static void convertFromFloat(const float* input, UINT8* output, UINT32 outBitDepth, UINT32 numSamples);
+
+		/**
+		 * Converts a set of floating point audio samples from one sample rate to another, using a high quality polyphase
+		 * filter. Use AudioResampler directly if the data needs to be resampled in multiple chunks (e.g. when streaming).
+		 *
+		 * @param[in]	input			Interleaved input samples. Should contain @p numFrames * @p numChannels samples.
+		 * @param[in]	numFrames		Number of frames (samples per channel) in the @p input buffer.
+		 * @param[in]	numChannels		Number of channels in the input and output data.
+		 * @param[in]	inSampleRate	Sample rate of the @p input data, in hertz.
+		 * @param[out]	output			Pre-allocated buffer to store the interleaved output samples in. Should contain
+		 *								AudioResampler::getNumResampledFrames() * @p numChannels samples.
+		 * @param[in]	outSampleRate	Sample rate to convert the data to, in hertz.
+		 */
+		static void resample(const float* input, UINT32 numFrames, UINT32 numChannels, UINT32 inSampleRate, 
+			float* output, UINT32 outSampleRate);
+
+		/**
+		 * Resamples decoded audio samples to the sample rate requested by the import options, if it differs from the
+		 * sample rate of the samples. Resampling is done in floating point, after which the samples are converted 
+		 * straight to the bit depth requested by the import options. Does nothing if no resampling is required.
+		 *
+		 * @param[in]		importOptions	Import options containing the requested sample rate and bit depth.
+		 * @param[in, out]	samples			Buffer containing the interleaved samples, allocated with bs_alloc().
+		 *									If the samples are resampled the buffer is freed and replaced with a new
+		 *									one.
+		 * @param[in, out]	bufferSize		Size of the @p samples buffer, in bytes.
+		 * @param[in, out]	info			Information about the samples. Updated with the new number of samples,
+		 *									sample rate and bit depth.
+		 */
+		static void resampleForImport(const AudioClipImportOptions& importOptions, UINT8*& samples, UINT32& bufferSize,
+			AudioDataInfo& info);
+
 		/** 
 		 * Converts a 24-bit signed integer into a 32-bit signed integer. 
 		 *
@@ -240,6 +240,9 @@ namespace bs
 			// Send out resource events in case any were loaded/destroyed/modified
 			ResourceListenerManager::instance().update();
 
+			// Unload unused resources if over the memory budget
+			gResources()._update();
+
 			// Trigger any renderer task callbacks (should be done before scene object update, or core sync, so objects have
 			// a chance to respond to the callback).
 			RendererManager::instance().getActive()->update();
@@ -321,6 +321,7 @@ namespace bs
 	class AudioSource;
 	class AudioClipImportOptions;
 	class AnimationClip;
+	class CompressedAnimationCurves;
 	class CCamera;
 	class CRenderable;
 	class CLight;
@@ -592,6 +593,7 @@ namespace bs
 		TID_DepthStencilStateDesc = 1152,
 		TID_SerializedGpuProgramData = 1153,
 		TID_SubShader = 1154,
+		TID_CompressedAnimationCurves = 1155,
 
 		// Moved from Engine layer
 		TID_CCamera = 30000,
@@ -353,6 +353,7 @@ set(BS_CORE_INC_RTTI
 	"bsfCore/Private/RTTI/BsCAudioSourceRTTI.h"
 	"bsfCore/Private/RTTI/BsCAudioListenerRTTI.h"
 	"bsfCore/Private/RTTI/BsAnimationClipRTTI.h"
+	"bsfCore/Private/RTTI/BsAnimationCompressionRTTI.h"
 	"bsfCore/Private/RTTI/BsAnimationCurveRTTI.h"
 	"bsfCore/Private/RTTI/BsSkeletonRTTI.h"
 	"bsfCore/Private/RTTI/BsCCameraRTTI.h"
@@ -543,6 +544,7 @@ set(BS_CORE_INC_AUDIO
 	"bsfCore/Audio/BsAudioSource.h"
 	"bsfCore/Audio/BsAudioClipImportOptions.h"
 	"bsfCore/Audio/BsAudioUtility.h"
+	"bsfCore/Audio/BsAudioResampler.h"
 	"bsfCore/Audio/BsAudioManager.h"
 )
 
@@ -553,12 +555,14 @@ set(BS_CORE_SRC_AUDIO
 	"bsfCore/Audio/BsAudioSource.cpp"
 	"bsfCore/Audio/BsAudioClipImportOptions.cpp"
 	"bsfCore/Audio/BsAudioUtility.cpp"
+	"bsfCore/Audio/BsAudioResampler.cpp"
 	"bsfCore/Audio/BsAudioManager.cpp"
 )
 
 set(BS_CORE_INC_ANIMATION
 	"bsfCore/Animation/BsAnimationCurve.h"
 	"bsfCore/Animation/BsAnimationClip.h"
+	"bsfCore/Animation/BsAnimationCompression.h"
 	"bsfCore/Animation/BsSkeleton.h"
 	"bsfCore/Animation/BsAnimation.h"
 	"bsfCore/Animation/BsAnimationManager.h"
@@ -571,6 +575,7 @@ set(BS_CORE_INC_ANIMATION
 set(BS_CORE_SRC_ANIMATION
 	"bsfCore/Animation/BsAnimationCurve.cpp"
 	"bsfCore/Animation/BsAnimationClip.cpp"
+	"bsfCore/Animation/BsAnimationCompression.cpp"
 	"bsfCore/Animation/BsSkeleton.cpp"
 	"bsfCore/Animation/BsAnimation.cpp"
 	"bsfCore/Animation/BsAnimationManager.cpp"
@@ -161,6 +161,34 @@ namespace bs
 			mProperties.getHeight(), mProperties.getDepth(), mProperties.getFormat());
 	}
 
+	UINT64 Texture::getCPUMemoryUsage() const
+	{
+		UINT64 size = 0;
+		for(auto& subresourceData : mCPUSubresourceData)
+		{
+			if(subresourceData != nullptr)
+				size += subresourceData->getSize();
+		}
+
+		return size;
+	}
+
+	UINT64 Texture::getGPUMemoryUsage() const
+	{
+		UINT64 faceSize = 0;
+		for(UINT32 i = 0; i <= mProperties.getNumMipmaps(); i++)
+		{
+			UINT32 mipWidth, mipHeight, mipDepth;
+			PixelUtil::getSizeForMipLevel(mProperties.getWidth(), mProperties.getHeight(), mProperties.getDepth(), i, 
+				mipWidth, mipHeight, mipDepth);
+
+			faceSize += PixelUtil::getMemorySize(mipWidth, mipHeight, mipDepth, mProperties.getFormat());
+		}
+
+		UINT32 numSamples = std::max(1U, mProperties.getNumSamples());
+		return faceSize * mProperties.getNumFaces() * numSamples;
+	}
+
 	void Texture::updateCPUBuffers(UINT32 subresourceIdx, const PixelData& pixelData)
 	{
 		if ((mProperties.getUsage() & TU_CPUCACHED) == 0)
@@ -312,6 +312,12 @@ namespace bs
 		/** Calculates the size of the texture, in bytes. */
 		UINT32 calculateSize() const;
 
+		/** @copydoc Resource::getCPUMemoryUsage */
+		UINT64 getCPUMemoryUsage() const override;
+
+		/** @copydoc Resource::getGPUMemoryUsage */
+		UINT64 getGPUMemoryUsage() const override;
+
 		/**
 		 * Creates buffers used for caching of CPU texture data.
 		 *
@@ -20,6 +20,34 @@ namespace bs
 		Convex /**< A convex hull will be generated from the source mesh. */
 	};
 
+	/** Settings that control which optimizations are performed on the mesh geometry during import. */
+	struct BS_CORE_EXPORT MeshOptimizationSettings
+	{
+		/** Merges vertices with identical attributes, and removes vertices not referenced by any triangle. */
+		bool deduplicateVertices = true;
+
+		/** Reorders triangles so that shared vertices get reused from the GPU post-transform vertex cache. */
+		bool optimizeVertexCache = true;
+
+		/** 
+		 * Reorders clusters of triangles so that triangles likely to occlude others are rendered first. Performed after
+		 * vertex cache optimization.
+		 */
+		bool optimizeOverdraw = true;
+
+		/** 
+		 * Determines by how much can overdraw optimization degrade vertex cache efficiency. For example 1.05 allows the
+		 * average cache miss ratio to increase by 5%.
+		 */
+		float overdrawThreshold = 1.05f;
+
+		/** Reorders vertices in the order they are referenced by the triangles, improving memory locality. */
+		bool optimizeVertexFetch = true;
+
+		/** Number of vertices in the post-transform vertex cache to optimize for. */
+		UINT32 vertexCacheSize = 16;
+	};
+
 	/** Information about how to split an AnimationClip into multiple separate clips. */
 	struct BS_CORE_EXPORT AnimationSplitInfo : IReflectable
 	{
@@ -150,6 +178,48 @@ namespace bs
 		 */
 		bool getKeyFrameReduction() const { return mReduceKeyFrames; }
 
+		/**	
+		 * Enables or disables animation clip compression. Compressed clips use significantly less memory and are faster
+		 * to evaluate, at the cost of some precision. Use setAnimationCompressionSettings() to control the allowed error.
+		 */
+		void setAnimationCompression(bool enabled) { mCompressAnimation = enabled; }
+
+		/**	
+		 * Checks is animation clip compression enabled.
+		 *
+		 * @see	setAnimationCompression
+		 */
+		bool getAnimationCompression() const { return mCompressAnimation; }
+
+		/** Determines the allowed error and amount of keyframe reduction when animation clip compression is enabled. */
+		void setAnimationCompressionSettings(const AnimationCompressionSettings& settings) 
+		{ mAnimationCompressionSettings = settings; }
+
+		/** @copydoc setAnimationCompressionSettings */
+		const AnimationCompressionSettings& getAnimationCompressionSettings() const 
+		{ return mAnimationCompressionSettings; }
+
+		/**
+		 * Enables or disables optimization of the mesh geometry for GPU rendering. When enabled, vertices and triangles
+		 * of the imported meshes will be reordered (and duplicate vertices merged) in order to make better use of the 
+		 * vertex cache and reduce overdraw. Use setMeshOptimizationSettings() to control which optimizations are 
+		 * performed.
+		 */
+		void setMeshOptimization(bool enabled) { mOptimizeMesh = enabled; }
+
+		/**
+		 * Checks is mesh optimization enabled.
+		 *
+		 * @see	setMeshOptimization
+		 */
+		bool getMeshOptimization() const { return mOptimizeMesh; }
+
+		/** Settings that control which optimizations are performed if mesh optimization is enabled. */
+		void setMeshOptimizationSettings(const MeshOptimizationSettings& settings) { mMeshOptimizationSettings = settings; }
+
+		/** @copydoc setMeshOptimizationSettings */
+		const MeshOptimizationSettings& getMeshOptimizationSettings() const { return mMeshOptimizationSettings; }
+
 		/**	
 		 * Enables or disables import of root motion curves. When enabled, any animation curves in imported animations 
 		 * affecting the root bone will be available through a set of separate curves in AnimationClip, and they won't be
@@ -176,6 +246,10 @@ namespace bs
 		bool mImportSkin;
 		bool mImportAnimation;
 		bool mReduceKeyFrames;
+		bool mCompressAnimation;
+		AnimationCompressionSettings mAnimationCompressionSettings;
+		bool mOptimizeMesh;
+		MeshOptimizationSettings mMeshOptimizationSettings;
 		bool mImportRootMotion;
 		float mImportScale;
 		CollisionMeshType mCollisionMeshType;
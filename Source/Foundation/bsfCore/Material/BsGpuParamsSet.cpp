@@ -884,6 +884,10 @@ namespace bs
 		// a ring buffer and a version number. Then we could just iterate over the ring buffer and only access dirty
 		// parameters. If the version number is too high (larger than ring buffer can store), then we force update for all.
 
+		// Parameter versions never exceed the global version, so if that hasn't changed there is nothing to update
+		if (!updateAll && params->getParamVersion() <= mParamVersion)
+			return;
+
 		// Update data params
 		for(auto& paramInfo : mDataParamInfos)
 		{
@@ -14,6 +14,7 @@
 #include "Serialization/BsMemorySerializer.h"
 #include "Material/BsMaterialParams.h"
 #include "Material/BsGpuParamsSet.h"
+#include "Renderer/BsRenderer.h"
 
 namespace bs
 {
@@ -866,6 +867,11 @@ namespace bs
 			mParams->setSyncData((UINT8*)dataPtr, paramsSize);
 
 		dataPtr += paramsSize;
+
+		// Let the renderer update any state it derives from the material parameters
+		SPtr<Renderer> renderer = gRenderer();
+		if(renderer != nullptr)
+			renderer->notifyMaterialUpdated(this);
 	}
 
 	SPtr<Material> Material::create(const SPtr<Shader>& shader)
@@ -196,6 +196,24 @@ namespace bs
 		mCPUData = allocBuffer();
 	}
 
+	UINT64 Mesh::getCPUMemoryUsage() const
+	{
+		if (mCPUData == nullptr)
+			return 0;
+
+		return mCPUData->getSize();
+	}
+
+	UINT64 Mesh::getGPUMemoryUsage() const
+	{
+		if (mVertexDesc == nullptr)
+			return 0;
+
+		UINT32 indexSize = mIndexType == IT_16BIT ? sizeof(UINT16) : sizeof(UINT32);
+		return (UINT64)mVertexDesc->getVertexStride() * mProperties.getNumVertices() + 
+			(UINT64)indexSize * mProperties.getNumIndices();
+	}
+
 	HMesh Mesh::dummy()
 	{
 		return MeshManager::instance().getDummyMesh();
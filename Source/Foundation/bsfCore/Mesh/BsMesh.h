@@ -153,6 +153,12 @@ namespace bs
 		/**	Updates the cached CPU buffers with new data. */
 		void updateCPUBuffer(UINT32 subresourceIdx, const MeshData& data);
 
+		/** @copydoc Resource::getCPUMemoryUsage */
+		UINT64 getCPUMemoryUsage() const override;
+
+		/** @copydoc Resource::getGPUMemoryUsage */
+		UINT64 getGPUMemoryUsage() const override;
+
 		mutable SPtr<MeshData> mCPUData;
 
 		SPtr<VertexDataDesc> mVertexDesc;
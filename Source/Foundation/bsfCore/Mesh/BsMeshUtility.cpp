@@ -5,80 +5,680 @@
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
 #include "Math/BsPlane.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
-	struct VertexFaces
+	/** Number of triangles or vertices processed at once by the vectorized operations. */
+	static constexpr UINT32 SIMD_WIDTH = 4;
+
+	/** Minimum number of triangles or vertices worth processing on a separate task. */
+	static constexpr UINT32 MIN_ELEMENTS_PER_TASK = 16384;
+
+	/** 
+	 * Splits the range [0, @p count) into sub-ranges and calls @p worker(start, end) for each. If the range is large
+	 * enough the sub-ranges are processed in parallel on the task scheduler, with the calling thread processing the first
+	 * one. Sub-ranges start at multiples of SIMD_WIDTH. Returns once the entire range has been processed.
+	 */
+	template<class T>
+	static void parallelFor(UINT32 count, const T& worker)
 	{
-		UINT32* faces;
-		UINT32 numFaces = 0;
+		UINT32 numTasks = 1;
+		if (TaskScheduler::isStarted())
+			numTasks = std::min(TaskScheduler::instance().getNumWorkers() + 1, count / MIN_ELEMENTS_PER_TASK);
+
+		if (numTasks <= 1)
+		{
+			worker(0, count);
+			return;
+		}
+
+		UINT32 rangeSize = Math::divideAndRoundUp(Math::divideAndRoundUp(count, numTasks), SIMD_WIDTH) * SIMD_WIDTH;
+
+		Vector<SPtr<Task>> tasks;
+		for (UINT32 start = rangeSize; start < count; start += rangeSize)
+		{
+			UINT32 end = std::min(start + rangeSize, count);
+			tasks.push_back(Task::create("MeshUtility", [&worker, start, end]() { worker(start, end); }));
+
+			TaskScheduler::instance().addTask(tasks.back());
+		}
+
+		worker(0, rangeSize);
+
+		for (auto& task : tasks)
+			task->wait();
+	}
+
+	/** Lists the triangles referencing each vertex. Triangles referencing the same vertex are stored contiguously. */
+	struct VertexFaceTable
+	{
+		template<class T>
+		VertexFaceTable(const T* indices, UINT32 numVertices, UINT32 numFaces)
+		{
+			UINT32 numIndices = numFaces * 3;
+
+			offsets.resize(numVertices + 1, 0);
+			for (UINT32 i = 0; i < numIndices; i++)
+			{
+				assert(indices[i] < numVertices);
+				offsets[indices[i] + 1]++;
+			}
+
+			for (UINT32 i = 0; i < numVertices; i++)
+				offsets[i + 1] += offsets[i];
+
+			Vector<UINT32> nextFace(offsets.begin(), offsets.end() - 1);
+
+			faces.resize(numIndices);
+			for (UINT32 i = 0; i < numIndices; i++)
+				faces[nextFace[indices[i]]++] = i / 3;
+		}
+
+		/** 
+		 * Offset into the @p faces array of the first triangle referencing each vertex. Contains one extra entry, so the
+		 * range of triangles of vertex i is [offsets[i], offsets[i + 1]).
+		 */
+		Vector<UINT32> offsets;
+
+		/** Indices of triangles referencing each vertex. */
+		Vector<UINT32> faces;
+	};
+
+	/** Set of three-component vectors stored in structure-of-arrays layout, padded to a multiple of SIMD_WIDTH. */
+	struct Vector3SoA
+	{
+		Vector3SoA(UINT32 count)
+		{
+			UINT32 paddedCount = Math::divideAndRoundUp(count, SIMD_WIDTH) * SIMD_WIDTH;
+			data.resize(paddedCount * 3);
+
+			for (UINT32 i = 0; i < 3; i++)
+				components[i] = data.data() + paddedCount * i;
+		}
+
+		/** Returns the vector at the specified index. */
+		Vector3 get(UINT32 idx) const
+		{
+			return Vector3(components[0][idx], components[1][idx], components[2][idx]);
+		}
+
+		/** Stores four vectors starting at the specified index. */
+		void store(UINT32 idx, const simd::float32x4* values)
+		{
+			for (UINT32 i = 0; i < 3; i++)
+				simd::store_u(components[i] + idx, values[i]);
+		}
+
+		Vector<float> data;
+		float* components[3];
 	};
 
-	struct VertexConnectivity
+	/** 
+	 * Loads the corners of up to four consecutive triangles into SIMD registers, in structure-of-arrays layout. Values
+	 * for missing triangles are set to zero.
+	 *
+	 * @param[in]	data		Per-vertex data, containing at least @p numComponents floats per vertex.
+	 * @param[in]	stride		Distance between two vertices in @p data, in bytes.
+	 * @param[in]	indices		Triangle indices.
+	 * @param[in]	firstFace	Index of the first triangle to load.
+	 * @param[in]	numFaces	Number of triangles to load, at most SIMD_WIDTH.
+	 * @param[out]	output		Loaded values, indexed by triangle corner and component.
+	 */
+	template<UINT32 numComponents, class T>
+	static void gatherTriangles(const UINT8* data, UINT32 stride, const T* indices, UINT32 firstFace, UINT32 numFaces,
+		simd::float32x4 (&output)[3][numComponents])
+	{
+		float values[3][numComponents][SIMD_WIDTH] = {};
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			const T* triangle = indices + (firstFace + i) * 3;
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				const float* vertex = (const float*)(data + triangle[j] * (size_t)stride);
+				for (UINT32 k = 0; k < numComponents; k++)
+					values[j][k][i] = vertex[k];
+			}
+		}
+
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			for (UINT32 j = 0; j < numComponents; j++)
+				output[i][j] = simd::load_u<simd::float32x4>(values[i][j]);
+		}
+	}
+
+	/** 
+	 * Writes up to four vectors stored in SIMD registers in structure-of-arrays layout, into an array of vectors.
+	 *
+	 * @param[in]	input		Vector components, one register per component.
+	 * @param[out]	data		Array to write the vectors to.
+	 * @param[in]	stride		Distance between two vectors in @p data, in bytes.
+	 * @param[in]	count		Number of vectors to write, at most SIMD_WIDTH.
+	 */
+	template<UINT32 numComponents>
+	static void scatterVectors(const simd::float32x4 (&input)[numComponents], UINT8* data, UINT32 stride, UINT32 count)
 	{
-		VertexConnectivity(UINT8* indices, UINT32 numVertices, UINT32 numFaces, UINT32 indexSize)
-			:vertexFaces(nullptr), mMaxFacesPerVertex(0), mNumVertices(numVertices), mFaces(nullptr)
+		float values[numComponents][SIMD_WIDTH];
+		for (UINT32 i = 0; i < numComponents; i++)
+			simd::store_u(values[i], input[i]);
+
+		for (UINT32 i = 0; i < count; i++)
 		{
-			vertexFaces = bs_newN<VertexFaces>(numVertices);
+			float* vector = (float*)(data + i * stride);
+			for (UINT32 j = 0; j < numComponents; j++)
+				vector[j] = values[j][i];
+		}
+	}
 
-			resizeFaceArray(10);
+	/** Calculates the dot product of four pairs of vectors stored in structure-of-arrays layout. */
+	static simd::float32x4 dot(const simd::float32x4 (&a)[3], const simd::float32x4 (&b)[3])
+	{
+		return simd::add(simd::add(simd::mul(a[0], b[0]), simd::mul(a[1], b[1])), simd::mul(a[2], b[2]));
+	}
 
-			for (UINT32 i = 0; i < numFaces; i++)
+	/** 
+	 * Normalizes four vectors stored in structure-of-arrays layout. Vectors of near zero length are left as is, same as
+	 * with Vector3::normalize().
+	 */
+	static void normalize(simd::float32x4 (&vector)[3])
+	{
+		simd::float32x4 one = simd::splat<simd::float32x4>(1.0f);
+
+		simd::float32x4 length = simd::sqrt(dot(vector, vector));
+		simd::mask_float32x4 isValid = simd::cmp_gt(length, simd::splat<simd::float32x4>(1e-08f));
+		simd::float32x4 invLength = simd::div(one, simd::blend(length, one, isValid));
+
+		for (UINT32 i = 0; i < 3; i++)
+			vector[i] = simd::mul(vector[i], invLength);
+	}
+
+	/** Implementation of MeshUtility::calculateNormals() for a specific index type. */
+	template<class T>
+	static void calculateNormalsInternal(const Vector3* vertices, const T* indices, UINT32 numVertices, 
+		UINT32 numIndices, Vector3* normals)
+	{
+		UINT32 numFaces = numIndices / 3;
+
+		Vector3SoA faceNormals(numFaces);
+		parallelFor(numFaces, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i += SIMD_WIDTH)
 			{
+				simd::float32x4 corners[3][3];
+				gatherTriangles((const UINT8*)vertices, sizeof(Vector3), indices, i, std::min(SIMD_WIDTH, end - i), 
+					corners);
+
+				simd::float32x4 edgeA[3];
+				simd::float32x4 edgeB[3];
 				for (UINT32 j = 0; j < 3; j++)
 				{
-					UINT32 idx = i * 3 + j;
-					UINT32 vertexIdx = 0;
-					memcpy(&vertexIdx, indices + idx * indexSize, indexSize);
+					edgeA[j] = simd::sub(corners[1][j], corners[0][j]);
+					edgeB[j] = simd::sub(corners[2][j], corners[0][j]);
+				}
 
-					assert(vertexIdx < mNumVertices);
-					VertexFaces& faces = vertexFaces[vertexIdx];
-					if (faces.numFaces >= mMaxFacesPerVertex)
-						resizeFaceArray(mMaxFacesPerVertex * 2);
+				simd::float32x4 normal[3];
+				normal[0] = simd::sub(simd::mul(edgeA[1], edgeB[2]), simd::mul(edgeA[2], edgeB[1]));
+				normal[1] = simd::sub(simd::mul(edgeA[2], edgeB[0]), simd::mul(edgeA[0], edgeB[2]));
+				normal[2] = simd::sub(simd::mul(edgeA[0], edgeB[1]), simd::mul(edgeA[1], edgeB[0]));
 
-					faces.faces[faces.numFaces] = i;
-					faces.numFaces++;
+				// Note: Potentially don't normalize here in order to weigh the normals by triangle size
+				normalize(normal);
+
+				faceNormals.store(i, normal);
+			}
+		});
+
+		// Each vertex only reads the normals of its own faces, so vertex ranges can be processed in parallel without
+		// synchronization
+		VertexFaceTable faceTable(indices, numVertices, numFaces);
+		parallelFor(numVertices, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i += SIMD_WIDTH)
+			{
+				UINT32 numBatchVertices = std::min(SIMD_WIDTH, end - i);
+
+				float sums[3][SIMD_WIDTH] = {};
+				for (UINT32 j = 0; j < numBatchVertices; j++)
+				{
+					Vector3 sum = Vector3::ZERO;
+					for (UINT32 k = faceTable.offsets[i + j]; k < faceTable.offsets[i + j + 1]; k++)
+						sum += faceNormals.get(faceTable.faces[k]);
+
+					sums[0][j] = sum.x;
+					sums[1][j] = sum.y;
+					sums[2][j] = sum.z;
 				}
+
+				simd::float32x4 normal[3];
+				for (UINT32 j = 0; j < 3; j++)
+					normal[j] = simd::load_u<simd::float32x4>(sums[j]);
+
+				normalize(normal);
+				scatterVectors(normal, (UINT8*)(normals + i), sizeof(Vector3), numBatchVertices);
 			}
+		});
+	}
+
+	/** Implementation of MeshUtility::calculateTangents() for a specific index type. */
+	template<class T>
+	static void calculateTangentsInternal(const Vector3* vertices, const Vector3* normals, const Vector2* uv, 
+		const T* indices, UINT32 numVertices, UINT32 numIndices, Vector3* tangents, Vector3* bitangents, 
+		UINT32 vertexStride)
+	{
+		UINT32 numFaces = numIndices / 3;
+		UINT32 vec2Stride = vertexStride == 0 ? sizeof(Vector2) : vertexStride;
+		UINT32 vec3Stride = vertexStride == 0 ? sizeof(Vector3) : vertexStride;
+
+		Vector3SoA faceTangents(numFaces);
+		Vector3SoA faceBitangents(numFaces);
+		parallelFor(numFaces, [&](UINT32 start, UINT32 end)
+		{
+			simd::float32x4 zero = simd::splat<simd::float32x4>(0.0f);
+			simd::float32x4 one = simd::splat<simd::float32x4>(1.0f);
+
+			for (UINT32 i = start; i < end; i += SIMD_WIDTH)
+			{
+				UINT32 numBatchFaces = std::min(SIMD_WIDTH, end - i);
+
+				simd::float32x4 positions[3][3];
+				gatherTriangles((const UINT8*)vertices, vec3Stride, indices, i, numBatchFaces, positions);
+
+				simd::float32x4 uvs[3][2];
+				gatherTriangles((const UINT8*)uv, vec2Stride, indices, i, numBatchFaces, uvs);
+
+				simd::float32x4 q0[3];
+				simd::float32x4 q1[3];
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					q0[j] = simd::sub(positions[1][j], positions[0][j]);
+					q1[j] = simd::sub(positions[2][j], positions[0][j]);
+				}
+
+				simd::float32x4 s[2] = { simd::sub(uvs[1][0], uvs[0][0]), simd::sub(uvs[2][0], uvs[0][0]) };
+				simd::float32x4 t[2] = { simd::sub(uvs[1][1], uvs[0][1]), simd::sub(uvs[2][1], uvs[0][1]) };
+
+				// Faces with degenerate UV coordinates don't contribute to the tangents of their vertices
+				simd::float32x4 denom = simd::sub(simd::mul(s[0], t[1]), simd::mul(s[1], t[0]));
+				simd::mask_float32x4 isValid = simd::cmp_ge(simd::abs(denom), simd::splat<simd::float32x4>(1e-8f));
+
+				simd::float32x4 r = simd::div(one, simd::blend(denom, one, isValid));
+				for (UINT32 j = 0; j < 2; j++)
+				{
+					s[j] = simd::mul(s[j], r);
+					t[j] = simd::mul(t[j], r);
+				}
+
+				simd::float32x4 tangent[3];
+				simd::float32x4 bitangent[3];
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					tangent[j] = simd::sub(simd::mul(t[1], q0[j]), simd::mul(t[0], q1[j]));
+					tangent[j] = simd::blend(tangent[j], zero, isValid);
+
+					bitangent[j] = simd::sub(simd::mul(s[0], q1[j]), simd::mul(s[1], q0[j]));
+					bitangent[j] = simd::blend(bitangent[j], zero, isValid);
+				}
+
+				// Note: Potentially don't normalize here in order to weight the tangents by triangle size
+				normalize(tangent);
+				normalize(bitangent);
+
+				faceTangents.store(i, tangent);
+				faceBitangents.store(i, bitangent);
+			}
+		});
+
+		VertexFaceTable faceTable(indices, numVertices, numFaces);
+		parallelFor(numVertices, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i += SIMD_WIDTH)
+			{
+				UINT32 numBatchVertices = std::min(SIMD_WIDTH, end - i);
+
+				float tangentSums[3][SIMD_WIDTH] = {};
+				float bitangentSums[3][SIMD_WIDTH] = {};
+				float normalValues[3][SIMD_WIDTH] = {};
+				for (UINT32 j = 0; j < numBatchVertices; j++)
+				{
+					Vector3 tangentSum = Vector3::ZERO;
+					Vector3 bitangentSum = Vector3::ZERO;
+					for (UINT32 k = faceTable.offsets[i + j]; k < faceTable.offsets[i + j + 1]; k++)
+					{
+						UINT32 faceIdx = faceTable.faces[k];
+						tangentSum += faceTangents.get(faceIdx);
+						bitangentSum += faceBitangents.get(faceIdx);
+					}
+
+					Vector3 normal = *(const Vector3*)((const UINT8*)normals + (i + j) * (size_t)vec3Stride);
+					for (UINT32 k = 0; k < 3; k++)
+					{
+						tangentSums[k][j] = tangentSum[k];
+						bitangentSums[k][j] = bitangentSum[k];
+						normalValues[k][j] = normal[k];
+					}
+				}
+
+				simd::float32x4 tangent[3];
+				simd::float32x4 bitangent[3];
+				simd::float32x4 normal[3];
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					tangent[j] = simd::load_u<simd::float32x4>(tangentSums[j]);
+					bitangent[j] = simd::load_u<simd::float32x4>(bitangentSums[j]);
+					normal[j] = simd::load_u<simd::float32x4>(normalValues[j]);
+				}
+
+				normalize(tangent);
+				normalize(bitangent);
+
+				// Orthonormalize
+				simd::float32x4 dot0 = dot(normal, tangent);
+				for (UINT32 j = 0; j < 3; j++)
+					tangent[j] = simd::sub(tangent[j], simd::mul(dot0, normal[j]));
+
+				normalize(tangent);
+
+				simd::float32x4 dot1 = dot(tangent, bitangent);
+				dot0 = dot(normal, bitangent);
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					simd::float32x4 offset = simd::add(simd::mul(dot0, normal[j]), simd::mul(dot1, tangent[j]));
+					bitangent[j] = simd::sub(bitangent[j], offset);
+				}
+
+				normalize(bitangent);
+
+				scatterVectors(tangent, (UINT8*)(tangents + i), sizeof(Vector3), numBatchVertices);
+				scatterVectors(bitangent, (UINT8*)(bitangents + i), sizeof(Vector3), numBatchVertices);
+			}
+		});
+
+		// TODO - Consider weighing tangents by triangle size and/or edge angles
+	}
+
+	/** 
+	 * Encodes vectors with @p numComponents components from 32-bit float format into 4D 8-bit packed format. Components
+	 * not present in the source are set to 128.
+	 */
+	template<UINT32 numComponents>
+	static void packNormalsInternal(const UINT8* source, UINT8* destination, UINT32 count, UINT32 inStride, 
+		UINT32 outStride)
+	{
+		simd::float32x4 scaleBias = simd::splat<simd::float32x4>(127.5f);
+		simd::int32x4 minValue = simd::splat<simd::int32x4>(0);
+		simd::int32x4 maxValue = simd::splat<simd::int32x4>(255);
+
+		PackedNormal defaultValue;
+		defaultValue.packed = 0;
+
+		for (UINT32 i = numComponents; i < 4; i++)
+			((UINT8*)&defaultValue)[i] = 128;
+
+		for (UINT32 i = 0; i < count; i += SIMD_WIDTH)
+		{
+			UINT32 numBatchVectors = std::min(SIMD_WIDTH, count - i);
+
+			float values[numComponents][SIMD_WIDTH] = {};
+			for (UINT32 j = 0; j < numBatchVectors; j++)
+			{
+				const float* vector = (const float*)(source + (i + j) * (size_t)inStride);
+				for (UINT32 k = 0; k < numComponents; k++)
+					values[k][j] = vector[k];
+			}
+
+			simd::uint32x4 packed = simd::splat<simd::uint32x4>(defaultValue.packed);
+			for (UINT32 j = 0; j < numComponents; j++)
+			{
+				simd::float32x4 value = simd::load_u<simd::float32x4>(values[j]);
+				simd::int32x4 quantized = simd::to_int32(simd::add(simd::mul(value, scaleBias), scaleBias));
+				quantized = simd::max(simd::min(quantized, maxValue), minValue);
+
+				packed = simd::bit_or(packed, simd::shift_l(simd::uint32x4(quantized), j * 8));
+			}
+
+			PackedNormal output[SIMD_WIDTH];
+			simd::store_u(output, packed);
+
+			for (UINT32 j = 0; j < numBatchVectors; j++)
+				memcpy(destination + (i + j) * (size_t)outStride, &output[j], sizeof(PackedNormal));
 		}
+	}
+
+	/** 
+	 * Decodes vectors with @p numComponents components from 4D 8-bit packed format into a 32-bit float format. Remaining
+	 * packed components are ignored.
+	 */
+	template<UINT32 numComponents>
+	static void unpackNormalsInternal(const UINT8* source, float* destination, UINT32 count, UINT32 stride)
+	{
+		simd::float32x4 scale = simd::splat<simd::float32x4>(1.0f / 127.5f);
+		simd::float32x4 one = simd::splat<simd::float32x4>(1.0f);
+		simd::uint32x4 mask = simd::splat<simd::uint32x4>(0xFF);
 
-		~VertexConnectivity()
+		for (UINT32 i = 0; i < count; i += SIMD_WIDTH)
 		{
-			if (vertexFaces != nullptr)
-				bs_deleteN(vertexFaces, mNumVertices);
+			UINT32 numBatchVectors = std::min(SIMD_WIDTH, count - i);
+
+			PackedNormal input[SIMD_WIDTH] = {};
+			for (UINT32 j = 0; j < numBatchVectors; j++)
+				memcpy(&input[j], source + (i + j) * (size_t)stride, sizeof(PackedNormal));
+
+			simd::uint32x4 packed = simd::load_u<simd::uint32x4>(input);
 
-			if (mFaces != nullptr)
-				bs_free(mFaces);
+			float values[numComponents][SIMD_WIDTH];
+			for (UINT32 j = 0; j < numComponents; j++)
+			{
+				simd::int32x4 component = simd::bit_and(simd::shift_r(packed, j * 8), mask);
+				simd::store_u(values[j], simd::sub(simd::mul(simd::to_float32(component), scale), one));
+			}
+
+			for (UINT32 j = 0; j < numBatchVectors; j++)
+			{
+				for (UINT32 k = 0; k < numComponents; k++)
+					destination[(i + j) * numComponents + k] = values[k][j];
+			}
 		}
+	}
 
-		VertexFaces* vertexFaces;
+	/** Marks a vertex that was removed in a vertex remap table. */
+	static constexpr UINT32 REMOVED_VERTEX = (UINT32)-1;
 
-	private:
-		void resizeFaceArray(UINT32 numFaces)
+	/** 
+	 * Simulates a FIFO post-transform vertex cache using timestamps. A vertex is in the cache if it was inserted less
+	 * than cacheSize insertions ago.
+	 */
+	struct VertexCacheSimulator
+	{
+		VertexCacheSimulator(UINT32 numVertices, UINT32 cacheSize)
+			:cacheTime(numVertices, 0), cacheSize(cacheSize), timestamp(cacheSize + 1)
+		{ }
+
+		/** Processes a single triangle and returns the number of its vertices that were not in the cache. */
+		UINT32 addTriangle(const UINT32* triangle)
+		{
+			UINT32 numMisses = 0;
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				UINT32 vertex = triangle[i];
+				if ((timestamp - cacheTime[vertex]) > cacheSize)
+				{
+					cacheTime[vertex] = timestamp++;
+					numMisses++;
+				}
+			}
+
+			return numMisses;
+		}
+
+		/** Removes all vertices from the cache. */
+		void flush()
 		{
-			UINT32* newFaces = (UINT32*)bs_alloc(numFaces * mNumVertices * sizeof(UINT32));
+			timestamp += cacheSize + 1;
+		}
+
+		Vector<UINT32> cacheTime;
+		UINT32 cacheSize;
+		UINT32 timestamp;
+	};
 
-			if (mFaces != nullptr)
+	/** 
+	 * Selects the next vertex whose triangles to output during vertex cache optimization. See optimizeVertexCache() for
+	 * details.
+	 */
+	static UINT32 getNextFanningVertex(const Vector<UINT32>& candidates, const VertexCacheSimulator& cache,
+		const Vector<UINT32>& liveFaces, Vector<UINT32>& deadEndStack, UINT32& cursor)
+	{
+		// Prefer the candidate that will remain in the cache, and of those, the one that was inserted earliest
+		UINT32 nextVertex = REMOVED_VERTEX;
+		INT32 bestPriority = -1;
+		for (auto& vertex : candidates)
+		{
+			if (liveFaces[vertex] == 0)
+				continue;
+
+			INT32 priority = 0;
+			UINT32 age = cache.timestamp - cache.cacheTime[vertex];
+			if (age + 2 * liveFaces[vertex] <= cache.cacheSize)
+				priority = (INT32)age;
+
+			if (priority > bestPriority)
 			{
-				for (UINT32 i = 0; i < mNumVertices; i++)
-					memcpy(newFaces + (i * numFaces), mFaces + (i * mMaxFacesPerVertex), mMaxFacesPerVertex * sizeof(UINT32));
+				bestPriority = priority;
+				nextVertex = vertex;
+			}
+		}
+
+		if (nextVertex != REMOVED_VERTEX)
+			return nextVertex;
+
+		// Dead end, try recently referenced vertices first, then fall back to the next vertex in input order
+		while (!deadEndStack.empty())
+		{
+			UINT32 vertex = deadEndStack.back();
+			deadEndStack.pop_back();
+
+			if (liveFaces[vertex] > 0)
+				return vertex;
+		}
 
-				bs_free(mFaces);
+		while (cursor < (UINT32)liveFaces.size())
+		{
+			if (liveFaces[cursor] > 0)
+				return cursor;
+
+			cursor++;
+		}
+
+		return REMOVED_VERTEX;
+	}
+
+	/** Hashes and compares vertices by their data in a set of vertex streams. */
+	struct VertexStreamHasher
+	{
+		VertexStreamHasher(const MeshVertexStream* streams, UINT32 numStreams)
+			:streams(streams), numStreams(numStreams)
+		{ }
+
+		size_t operator()(UINT32 vertex) const
+		{
+			// FNV-1a
+			UINT32 hash = 2166136261U;
+			for (UINT32 i = 0; i < numStreams; i++)
+			{
+				const UINT8* data = streams[i].data + vertex * (size_t)streams[i].stride;
+				for (UINT32 j = 0; j < streams[i].size; j++)
+					hash = (hash ^ data[j]) * 16777619U;
 			}
 
-			for (UINT32 i = 0; i < mNumVertices; i++)
-				vertexFaces[i].faces = newFaces + (i * numFaces);
+			return hash;
+		}
+
+		bool operator()(UINT32 a, UINT32 b) const
+		{
+			for (UINT32 i = 0; i < numStreams; i++)
+			{
+				const UINT8* dataA = streams[i].data + a * (size_t)streams[i].stride;
+				const UINT8* dataB = streams[i].data + b * (size_t)streams[i].stride;
 
-			mFaces = newFaces;
-			mMaxFacesPerVertex = numFaces;
+				if (memcmp(dataA, dataB, streams[i].size) != 0)
+					return false;
+			}
+
+			return true;
 		}
 
-		UINT32 mMaxFacesPerVertex;
-		UINT32 mNumVertices;
-		UINT32* mFaces;
+		const MeshVertexStream* streams;
+		UINT32 numStreams;
+	};
+
+	/** Range of triangles that is kept together when reordering triangles to reduce overdraw. */
+	struct TriangleCluster
+	{
+		UINT32 firstFace;
+		UINT32 numFaces;
+		float sortKey;
 	};
 
-	/** Provides base methods required for clipping of arbitrary triangles. */
+	/** 
+	 * Splits the triangles into clusters at points where the vertex cache gets flushed, and then further splits them
+	 * wherever the average cache miss ratio of the new cluster stays within @p threshold of its parent cluster.
+	 */
+	static Vector<UINT32> generateTriangleClusters(const UINT32* indices, UINT32 numFaces, UINT32 numVertices,
+		float threshold, UINT32 cacheSize)
+	{
+		// Hard boundaries: all vertices of the triangle miss the cache
+		Vector<UINT32> hardBoundaries;
+		VertexCacheSimulator cache(numVertices, cacheSize);
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			if (cache.addTriangle(&indices[i * 3]) == 3 || i == 0)
+				hardBoundaries.push_back(i);
+		}
+
+		hardBoundaries.push_back(numFaces);
+
+		// Soft boundaries: the split off cluster has good enough cache efficiency on its own
+		Vector<UINT32> boundaries;
+		for (UINT32 i = 0; i < (UINT32)hardBoundaries.size() - 1; i++)
+		{
+			UINT32 start = hardBoundaries[i];
+			UINT32 end = hardBoundaries[i + 1];
+
+			cache.flush();
+
+			UINT32 clusterMisses = 0;
+			for (UINT32 j = start; j < end; j++)
+				clusterMisses += cache.addTriangle(&indices[j * 3]);
+
+			float maxACMR = threshold * clusterMisses / (float)(end - start);
+
+			cache.flush();
+			boundaries.push_back(start);
+
+			UINT32 runningMisses = 0;
+			UINT32 runningFaces = 0;
+			for (UINT32 j = start; j < end - 1; j++)
+			{
+				runningMisses += cache.addTriangle(&indices[j * 3]);
+				runningFaces++;
+
+				if (runningMisses <= maxACMR * runningFaces)
+				{
+					boundaries.push_back(j + 1);
+
+					cache.flush();
+					runningMisses = 0;
+					runningFaces = 0;
+				}
+			}
+		}
+
+		boundaries.push_back(numFaces);
+		return boundaries;
+	}
+
 	class TriangleClipperBase // Implementation from: http://www.geometrictools.com/Documentation/ClipMesh.pdf
 	{
 	protected:
@@ -727,222 +1327,285 @@ namespace bs
 	void MeshUtility::calculateNormals(Vector3* vertices, UINT8* indices, UINT32 numVertices,
 		UINT32 numIndices, Vector3* normals, UINT32 indexSize)
 	{
-		UINT32 numFaces = numIndices / 3;
+		if (indexSize == sizeof(UINT16))
+			calculateNormalsInternal(vertices, (UINT16*)indices, numVertices, numIndices, normals);
+		else
+		{
+			assert(indexSize == sizeof(UINT32));
+			calculateNormalsInternal(vertices, (UINT32*)indices, numVertices, numIndices, normals);
+		}
+	}
 
-		Vector3* faceNormals = bs_newN<Vector3>(numFaces);
-		for (UINT32 i = 0; i < numFaces; i++)
+	void MeshUtility::calculateTangents(Vector3* vertices, Vector3* normals, Vector2* uv, UINT8* indices, UINT32 numVertices,
+		UINT32 numIndices, Vector3* tangents, Vector3* bitangents, UINT32 indexSize, UINT32 vertexStride)
+	{
+		if (indexSize == sizeof(UINT16))
+		{
+			calculateTangentsInternal(vertices, normals, uv, (UINT16*)indices, numVertices, numIndices, tangents, 
+				bitangents, vertexStride);
+		}
+		else
 		{
-			UINT32 triangle[3];
-			memcpy(&triangle[0], indices + (i * 3 + 0) * indexSize, indexSize);
-			memcpy(&triangle[1], indices + (i * 3 + 1) * indexSize, indexSize);
-			memcpy(&triangle[2], indices + (i * 3 + 2) * indexSize, indexSize);
+			assert(indexSize == sizeof(UINT32));
+			calculateTangentsInternal(vertices, normals, uv, (UINT32*)indices, numVertices, numIndices, tangents, 
+				bitangents, vertexStride);
+		}
+	}
+
+	void MeshUtility::calculateTangentSpace(Vector3* vertices, Vector2* uv, UINT8* indices, UINT32 numVertices,
+		UINT32 numIndices, Vector3* normals, Vector3* tangents, Vector3* bitangents, UINT32 indexSize)
+	{
+		calculateNormals(vertices, indices, numVertices, numIndices, normals, indexSize);
+		calculateTangents(vertices, normals, uv, indices, numVertices, numIndices, tangents, bitangents, indexSize);
+	}
 
-			Vector3 edgeA = vertices[triangle[1]] - vertices[triangle[0]];
-			Vector3 edgeB = vertices[triangle[2]] - vertices[triangle[0]];
-			faceNormals[i] = Vector3::normalize(Vector3::cross(edgeA, edgeB));
+	void MeshUtility::clip2D(UINT8* vertices, UINT8* uvs, UINT32 numTris, UINT32 vertexStride, const Vector<Plane>& clipPlanes,
+		const std::function<void(Vector2*, Vector2*, UINT32)>& writeCallback)
+	{
+		TriangleClipper2D clipper;
+		clipper.clip(vertices, uvs, numTris, vertexStride, clipPlanes, writeCallback);
+	}
 
-			// Note: Potentially don't normalize here in order to weigh the normals
-			// by triangle size
-		}
+	void MeshUtility::clip3D(UINT8* vertices, UINT8* uvs, UINT32 numTris, UINT32 vertexStride, const Vector<Plane>& clipPlanes,
+		const std::function<void(Vector3*, Vector2*, UINT32)>& writeCallback)
+	{
+		TriangleClipper3D clipper;
+		clipper.clip(vertices, uvs, numTris, vertexStride, clipPlanes, writeCallback);
+	}
 
-		VertexConnectivity connectivity(indices, numVertices, numFaces, indexSize);
-		for (UINT32 i = 0; i < numVertices; i++)
+	void MeshUtility::packNormals(Vector3* source, UINT8* destination, UINT32 count, UINT32 inStride, UINT32 outStride)
+	{
+		packNormalsInternal<3>((UINT8*)source, destination, count, inStride, outStride);
+	}
+
+	void MeshUtility::packNormals(Vector4* source, UINT8* destination, UINT32 count, UINT32 inStride, UINT32 outStride)
+	{
+		packNormalsInternal<4>((UINT8*)source, destination, count, inStride, outStride);
+	}
+
+	void MeshUtility::unpackNormals(UINT8* source, Vector3* destination, UINT32 count, UINT32 stride)
+	{
+		unpackNormalsInternal<3>(source, (float*)destination, count, stride);
+	}
+
+	void MeshUtility::unpackNormals(UINT8* source, Vector4* destination, UINT32 count, UINT32 stride)
+	{
+		unpackNormalsInternal<4>(source, (float*)destination, count, stride);
+	}
+
+	UINT32 MeshUtility::deduplicateVertices(UINT32* indices, UINT32 numIndices, UINT32 numVertices,
+		const MeshVertexStream* streams, UINT32 numStreams, UINT32* remap)
+	{
+		std::fill(remap, remap + numVertices, REMOVED_VERTEX);
+
+		VertexStreamHasher hasher(streams, numStreams);
+		UnorderedMap<UINT32, UINT32, VertexStreamHasher, VertexStreamHasher> uniqueVertices(numVertices, hasher, hasher);
+
+		UINT32 numUniqueVertices = 0;
+		for (UINT32 i = 0; i < numIndices; i++)
 		{
-			VertexFaces& faces = connectivity.vertexFaces[i];
+			UINT32 vertex = indices[i];
+			assert(vertex < numVertices);
 
-			normals[i] = Vector3::ZERO;
-			for (UINT32 j = 0; j < faces.numFaces; j++)
+			if (remap[vertex] == REMOVED_VERTEX)
 			{
-				UINT32 faceIdx = faces.faces[j];
-				normals[i] += faceNormals[faceIdx];
+				auto result = uniqueVertices.insert(std::make_pair(vertex, numUniqueVertices));
+				if (result.second)
+					numUniqueVertices++;
+
+				remap[vertex] = result.first->second;
 			}
 
-			normals[i].normalize();
+			indices[i] = remap[vertex];
 		}
 
-		bs_deleteN(faceNormals, numFaces);
+		return numUniqueVertices;
 	}
 
-	void MeshUtility::calculateTangents(Vector3* vertices, Vector3* normals, Vector2* uv, UINT8* indices, UINT32 numVertices,
-		UINT32 numIndices, Vector3* tangents, Vector3* bitangents, UINT32 indexSize, UINT32 vertexStride)
+	void MeshUtility::optimizeVertexCache(UINT32* indices, UINT32 numIndices, UINT32 numVertices, UINT32 cacheSize)
 	{
+		// Implementation of "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (Sander et al. 2007). 
+		// Triangles are output by fanning around vertices, choosing the next vertex among the ones just referenced, 
+		// preferring those that will still be in the cache once all of their remaining triangles are output.
 		UINT32 numFaces = numIndices / 3;
-		UINT32 vec2Stride = vertexStride == 0 ? sizeof(Vector2) : vertexStride;
-		UINT32 vec3Stride = vertexStride == 0 ? sizeof(Vector3) : vertexStride;
-
-		UINT8* positionBytes = (UINT8*)vertices;
-		UINT8* normalBytes = (UINT8*)normals;
-		UINT8* uvBytes = (UINT8*)uv;
+		if (numFaces == 0)
+			return;
 
-		Vector3* faceTangents = bs_newN<Vector3>(numFaces);
-		Vector3* faceBitangents = bs_newN<Vector3>(numFaces);
-		for (UINT32 i = 0; i < numFaces; i++)
-		{
-			UINT32 triangle[3];
-			memcpy(&triangle[0], indices + (i * 3 + 0) * indexSize, indexSize);
-			memcpy(&triangle[1], indices + (i * 3 + 1) * indexSize, indexSize);
-			memcpy(&triangle[2], indices + (i * 3 + 2) * indexSize, indexSize);
+		VertexFaceTable vertexFaces(indices, numVertices, numFaces);
 
-			Vector3 p0 = *(Vector3*)&positionBytes[triangle[0] * vec3Stride];
-			Vector3 p1 = *(Vector3*)&positionBytes[triangle[1] * vec3Stride];
-			Vector3 p2 = *(Vector3*)&positionBytes[triangle[2] * vec3Stride];
-
-			Vector2 uv0 = *(Vector2*)&uvBytes[triangle[0] * vec2Stride];
-			Vector2 uv1 = *(Vector2*)&uvBytes[triangle[1] * vec2Stride];
-			Vector2 uv2 = *(Vector2*)&uvBytes[triangle[2] * vec2Stride];
+		Vector<UINT32> liveFaces(numVertices);
+		for (UINT32 i = 0; i < numVertices; i++)
+			liveFaces[i] = vertexFaces.offsets[i + 1] - vertexFaces.offsets[i];
 
-			Vector3 q0 = p1 - p0;
-			Vector3 q1 = p2 - p0;
+		Vector<UINT32> output(numIndices);
+		Vector<bool> emitted(numFaces, false);
+		Vector<UINT32> deadEndStack;
+		Vector<UINT32> candidates;
 
-			Vector2 s;
-			s.x = uv1.x - uv0.x;
-			s.y = uv2.x - uv0.x;
+		VertexCacheSimulator cache(numVertices, cacheSize);
+		UINT32 cursor = 0;
+		UINT32 numOutputIndices = 0;
 
-			Vector2 t;
-			t.x = uv1.y - uv0.y;
-			t.y = uv2.y - uv0.y;
+		UINT32 fanningVertex = getNextFanningVertex(candidates, cache, liveFaces, deadEndStack, cursor);
+		while (fanningVertex != REMOVED_VERTEX)
+		{
+			candidates.clear();
 
-			float denom = s.x*t.y - s.y * t.x;
-			if (fabs(denom) >= 0e-8f)
+			for (UINT32 i = vertexFaces.offsets[fanningVertex]; i < vertexFaces.offsets[fanningVertex + 1]; i++)
 			{
-				float r = 1.0f / denom;
-				s *= r;
-				t *= r;
+				UINT32 face = vertexFaces.faces[i];
+				if (emitted[face])
+					continue;
 
-				faceTangents[i] = t.y * q0 - t.x * q1;
-				faceBitangents[i] = s.x * q0 - s.y * q1;
+				const UINT32* triangle = &indices[face * 3];
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					UINT32 vertex = triangle[j];
 
-				faceTangents[i].normalize();
-				faceBitangents[i].normalize();
+					output[numOutputIndices++] = vertex;
+					deadEndStack.push_back(vertex);
+					candidates.push_back(vertex);
+					liveFaces[vertex]--;
+				}
+
+				cache.addTriangle(triangle);
+				emitted[face] = true;
 			}
 
-			// Note: Potentially don't normalize here in order to weight the normals by triangle size
+			fanningVertex = getNextFanningVertex(candidates, cache, liveFaces, deadEndStack, cursor);
 		}
 
-		VertexConnectivity connectivity(indices, numVertices, numFaces, indexSize);
-		for (UINT32 i = 0; i < numVertices; i++)
-		{
-			VertexFaces& faces = connectivity.vertexFaces[i];
+		assert(numOutputIndices == numFaces * 3);
+		memcpy(indices, output.data(), numOutputIndices * sizeof(UINT32));
+	}
 
-			tangents[i] = Vector3::ZERO;
-			bitangents[i] = Vector3::ZERO;
+	void MeshUtility::optimizeOverdraw(UINT32* indices, UINT32 numIndices, const Vector3* positions, UINT32 numVertices,
+		float threshold, UINT32 cacheSize)
+	{
+		UINT32 numFaces = numIndices / 3;
+		if (numFaces == 0)
+			return;
+
+		Vector<UINT32> boundaries = generateTriangleClusters(indices, numFaces, numVertices, threshold, cacheSize);
+		UINT32 numClusters = (UINT32)boundaries.size() - 1;
 
-			for (UINT32 j = 0; j < faces.numFaces; j++)
+		// Area weighted centroid and normal of each cluster
+		Vector<Vector3> clusterCentroids(numClusters, Vector3::ZERO);
+		Vector<Vector3> clusterNormals(numClusters, Vector3::ZERO);
+		Vector<float> clusterAreas(numClusters, 0.0f);
+
+		Vector3 meshCentroid = Vector3::ZERO;
+		float meshArea = 0.0f;
+		for (UINT32 i = 0; i < numClusters; i++)
+		{
+			for (UINT32 j = boundaries[i]; j < boundaries[i + 1]; j++)
 			{
-				UINT32 faceIdx = faces.faces[j];
-				tangents[i] += faceTangents[faceIdx];
-				bitangents[i] += faceBitangents[faceIdx];
+				const Vector3& v0 = positions[indices[j * 3 + 0]];
+				const Vector3& v1 = positions[indices[j * 3 + 1]];
+				const Vector3& v2 = positions[indices[j * 3 + 2]];
+
+				Vector3 normal = (v1 - v0).cross(v2 - v0);
+				float area = normal.length();
+
+				clusterCentroids[i] += (v0 + v1 + v2) * (area / 3.0f);
+				clusterNormals[i] += normal;
+				clusterAreas[i] += area;
 			}
 
-			tangents[i].normalize();
-			bitangents[i].normalize();
+			meshCentroid += clusterCentroids[i];
+			meshArea += clusterAreas[i];
+		}
 
-			Vector3 normal = *(Vector3*)&normalBytes[i * vec3Stride];
+		if (meshArea > 0.0f)
+			meshCentroid /= meshArea;
 
-			// Orthonormalize
-			float dot0 = normal.dot(tangents[i]);
-			tangents[i] -= dot0*normal;
-			tangents[i].normalize();
+		// Clusters facing away from the mesh center are more likely to occlude others, so they get rendered first
+		Vector<TriangleCluster> clusters(numClusters);
+		for (UINT32 i = 0; i < numClusters; i++)
+		{
+			clusters[i].firstFace = boundaries[i];
+			clusters[i].numFaces = boundaries[i + 1] - boundaries[i];
+			clusters[i].sortKey = 0.0f;
 
-			float dot1 = tangents[i].dot(bitangents[i]);
-			dot0 = normal.dot(bitangents[i]);
-			bitangents[i] -= dot0*normal + dot1*tangents[i];
-			bitangents[i].normalize();
+			float normalLength = clusterNormals[i].length();
+			if (clusterAreas[i] > 0.0f && normalLength > 0.0f)
+			{
+				Vector3 centroid = clusterCentroids[i] / clusterAreas[i];
+				clusters[i].sortKey = (centroid - meshCentroid).dot(clusterNormals[i] / normalLength);
+			}
 		}
 
-		bs_deleteN(faceTangents, numFaces);
-		bs_deleteN(faceBitangents, numFaces);
+		std::stable_sort(clusters.begin(), clusters.end(), 
+			[](const TriangleCluster& a, const TriangleCluster& b) { return a.sortKey > b.sortKey; });
 
-		// TODO - Consider weighing tangents by triangle size and/or edge angles
-	}
-
-	void MeshUtility::calculateTangentSpace(Vector3* vertices, Vector2* uv, UINT8* indices, UINT32 numVertices,
-		UINT32 numIndices, Vector3* normals, Vector3* tangents, Vector3* bitangents, UINT32 indexSize)
-	{
-		calculateNormals(vertices, indices, numVertices, numIndices, normals, indexSize);
-		calculateTangents(vertices, normals, uv, indices, numVertices, numIndices, tangents, bitangents, indexSize);
-	}
+		Vector<UINT32> output(numFaces * 3);
+		UINT32* dst = output.data();
+		for (auto& cluster : clusters)
+		{
+			memcpy(dst, &indices[cluster.firstFace * 3], cluster.numFaces * 3 * sizeof(UINT32));
+			dst += cluster.numFaces * 3;
+		}
 
-	void MeshUtility::clip2D(UINT8* vertices, UINT8* uvs, UINT32 numTris, UINT32 vertexStride, const Vector<Plane>& clipPlanes,
-		const std::function<void(Vector2*, Vector2*, UINT32)>& writeCallback)
-	{
-		TriangleClipper2D clipper;
-		clipper.clip(vertices, uvs, numTris, vertexStride, clipPlanes, writeCallback);
+		memcpy(indices, output.data(), output.size() * sizeof(UINT32));
 	}
 
-	void MeshUtility::clip3D(UINT8* vertices, UINT8* uvs, UINT32 numTris, UINT32 vertexStride, const Vector<Plane>& clipPlanes,
-		const std::function<void(Vector3*, Vector2*, UINT32)>& writeCallback)
+	UINT32 MeshUtility::optimizeVertexFetch(UINT32* indices, UINT32 numIndices, UINT32 numVertices, UINT32* remap)
 	{
-		TriangleClipper3D clipper;
-		clipper.clip(vertices, uvs, numTris, vertexStride, clipPlanes, writeCallback);
-	}
+		std::fill(remap, remap + numVertices, REMOVED_VERTEX);
 
-	void MeshUtility::packNormals(Vector3* source, UINT8* destination, UINT32 count, UINT32 inStride, UINT32 outStride)
-	{
-		UINT8* srcPtr = (UINT8*)source;
-		UINT8* dstPtr = destination;
-		for (UINT32 i = 0; i < count; i++)
+		UINT32 numUsedVertices = 0;
+		for (UINT32 i = 0; i < numIndices; i++)
 		{
-			Vector3 src = *(Vector3*)srcPtr;
+			UINT32 vertex = indices[i];
+			assert(vertex < numVertices);
 
-			PackedNormal& packed = *(PackedNormal*)dstPtr;
-			packed.x = Math::clamp((int)(src.x * 127.5f + 127.5f), 0, 255);
-			packed.y = Math::clamp((int)(src.y * 127.5f + 127.5f), 0, 255);
-			packed.z = Math::clamp((int)(src.z * 127.5f + 127.5f), 0, 255);
-			packed.w = 128;
+			if (remap[vertex] == REMOVED_VERTEX)
+				remap[vertex] = numUsedVertices++;
 
-			srcPtr += inStride;
-			dstPtr += outStride;
+			indices[i] = remap[vertex];
 		}
+
+		return numUsedVertices;
 	}
 
-	void MeshUtility::packNormals(Vector4* source, UINT8* destination, UINT32 count, UINT32 inStride, UINT32 outStride)
+	void MeshUtility::remapVertices(const UINT8* source, UINT8* destination, UINT32 numVertices, UINT32 vertexSize,
+		const UINT32* remap)
 	{
-		UINT8* srcPtr = (UINT8*)source;
-		UINT8* dstPtr = destination;
-		for (UINT32 i = 0; i < count; i++)
+		for (UINT32 i = 0; i < numVertices; i++)
 		{
-			Vector4 src = *(Vector4*)srcPtr;
-			PackedNormal& packed = *(PackedNormal*)dstPtr;
-
-			packed.x = Math::clamp((int)(src.x * 127.5f + 127.5f), 0, 255);
-			packed.y = Math::clamp((int)(src.y * 127.5f + 127.5f), 0, 255);
-			packed.z = Math::clamp((int)(src.z * 127.5f + 127.5f), 0, 255);
-			packed.w = Math::clamp((int)(src.w * 127.5f + 127.5f), 0, 255);
-
-			srcPtr += inStride;
-			dstPtr += outStride;
+			if (remap[i] != REMOVED_VERTEX)
+				memcpy(destination + remap[i] * (size_t)vertexSize, source + i * (size_t)vertexSize, vertexSize);
 		}
 	}
 
-	void MeshUtility::unpackNormals(UINT8* source, Vector3* destination, UINT32 count, UINT32 stride)
+	VertexCacheStatistics MeshUtility::analyzeVertexCache(const UINT32* indices, UINT32 numIndices, UINT32 numVertices,
+		UINT32 cacheSize)
 	{
-		UINT8* ptr = source;
-		for (UINT32 i = 0; i < count; i++)
-		{
-			PackedNormal& packed = *(PackedNormal*)ptr;
+		VertexCacheStatistics stats;
 
-			destination[i].x = (packed.x * 2.0f - 1.0f);
-			destination[i].y = (packed.y * 2.0f - 1.0f);
-			destination[i].z = (packed.z * 2.0f - 1.0f);
+		UINT32 numFaces = numIndices / 3;
+		if (numFaces == 0)
+			return stats;
 
-			ptr += stride;
-		}
-	}
+		VertexCacheSimulator cache(numVertices, cacheSize);
+		UINT32 numMisses = 0;
+		for (UINT32 i = 0; i < numFaces; i++)
+			numMisses += cache.addTriangle(&indices[i * 3]);
 
-	void MeshUtility::unpackNormals(UINT8* source, Vector4* destination, UINT32 count, UINT32 stride)
-	{
-		UINT8* ptr = source;
-		for (UINT32 i = 0; i < count; i++)
+		Vector<bool> used(numVertices, false);
+		UINT32 numUsedVertices = 0;
+		for (UINT32 i = 0; i < numIndices; i++)
 		{
-			PackedNormal& packed = *(PackedNormal*)ptr;
+			if (!used[indices[i]])
+			{
+				used[indices[i]] = true;
+				numUsedVertices++;
+			}
+		}
 
-			destination[i].x = (packed.x * 2.0f - 1.0f);
-			destination[i].y = (packed.y * 2.0f - 1.0f);
-			destination[i].z = (packed.z * 2.0f - 1.0f);
-			destination[i].w = (packed.w * 2.0f - 1.0f);
+		stats.acmr = numMisses / (float)numFaces;
+		stats.atvr = numMisses / (float)numUsedVertices;
 
-			ptr += stride;
-		}
+		return stats;
 	}
 }
\ No newline at end of file
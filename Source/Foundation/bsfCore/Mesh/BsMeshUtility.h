@@ -24,6 +24,39 @@ namespace bs
 		UINT32 packed;
 	};
 
+	/** Describes a single set of per-vertex data of a mesh, used by operations that need to compare vertices. */
+	struct MeshVertexStream
+	{
+		MeshVertexStream() = default;
+		MeshVertexStream(const UINT8* data, UINT32 size, UINT32 stride)
+			:data(data), size(size), stride(stride)
+		{ }
+
+		/** Data belonging to the first vertex. */
+		const UINT8* data = nullptr;
+
+		/** Size of the data belonging to a single vertex, in bytes. */
+		UINT32 size = 0;
+
+		/** Distance between data of two sequential vertices, in bytes. */
+		UINT32 stride = 0;
+	};
+
+	/** Contains information about how efficiently a mesh uses the GPU post-transform vertex cache. */
+	struct VertexCacheStatistics
+	{
+		/** 
+		 * Average cache miss ratio, the average number of vertices transformed per triangle. Ranges from 3 in the worst
+		 * case to around 0.5 for large regular meshes.
+		 */
+		float acmr = 0.0f;
+
+		/** 
+		 * Average transform to vertex ratio, the average number of times each vertex is transformed. Ideal value is 1.
+		 */
+		float atvr = 0.0f;
+	};
+
 	/** Performs various operations on mesh geometry. */
 	class BS_CORE_EXPORT MeshUtility
 	{
@@ -37,7 +70,7 @@ namespace bs
 		 * @param[in]	numIndices	Number of indices in the @p indices array. Must be a multiple of three.
 		 * @param[out]	normals		Pre-allocated buffer that will contain the calculated normals. Must be the same size
 		 *							as the vertex array.
-		 * @param[in]	indexSize	Size of a single index in the indices array, in bytes.
+		 * @param[in]	indexSize	Size of a single index in the indices array, in bytes. Must be 2 or 4.
 		 *
 		 * @note	
 		 * Vertices should be split before calling this method if there are any discontinuities. (for example a vertex on a
@@ -62,7 +95,7 @@ namespace bs
 		 *								size as the vertex array.
 		 * @param[out]	bitangents		Pre-allocated buffer that will contain the calculated bitangents. Must be the same
 		 *								size as the vertex array.
-		 * @param[in]	indexSize		Size of a single index in the indices array, in bytes.
+		 * @param[in]	indexSize		Size of a single index in the indices array, in bytes. Must be 2 or 4.
 		 * @param[in]	vertexStride	Number of bytes to advance the @p vertices, @p normals and @p uv arrays with each
 		 *								vertex. If set to zero them each array is advanced according to its own size.
 		 *
@@ -89,7 +122,7 @@ namespace bs
 		 *							as the vertex array.
 		 * @param[out]	bitangents	Pre-allocated buffer that will contain the calculated bitangents. Must be the same size
 		 *							as the vertex array.
-		 * @param[in]	indexSize	Size of a single index in the indices array, in bytes.
+		 * @param[in]	indexSize	Size of a single index in the indices array, in bytes. Must be 2 or 4.
 		 *
 		 * @note	
 		 * Vertices should be split before calling this method if there are any discontinuities. (for example. a vertex on
@@ -177,6 +210,91 @@ namespace bs
 		 * @param[in]	stride			Distance between two entries in the @p source buffer, in bytes.
 		 */
 		static void unpackNormals(UINT8* source, Vector4* destination, UINT32 count, UINT32 stride);
+
+		/**
+		 * Finds vertices with identical data and merges them into one. Vertices not referenced by any of the indices are
+		 * removed. Remaining vertices are ordered by their first use in the index buffer.
+		 *
+		 * @param[in, out]	indices		Triangle indices. Updated to reference the remaining vertices.
+		 * @param[in]		numIndices	Number of indices in the @p indices array.
+		 * @param[in]		numVertices	Total number of vertices in the mesh.
+		 * @param[in]		streams		Per-vertex data to compare the vertices by. Vertices are merged only if their data 
+		 *								in all of the streams is identical.
+		 * @param[in]		numStreams	Number of entries in the @p streams array.
+		 * @param[out]		remap		Pre-allocated buffer with @p numVertices entries. Will contain the new index of 
+		 *								each vertex, or -1 if the vertex was removed. Provide it to remapVertices() in 
+		 *								order to reorder the vertex data.
+		 * @return						Number of remaining vertices.
+		 */
+		static UINT32 deduplicateVertices(UINT32* indices, UINT32 numIndices, UINT32 numVertices, 
+			const MeshVertexStream* streams, UINT32 numStreams, UINT32* remap);
+
+		/**
+		 * Reorders triangles so that vertices shared between triangles are likely to still be in the GPU post-transform 
+		 * vertex cache when they are reused. 
+		 *
+		 * @param[in, out]	indices		Triangle indices to reorder.
+		 * @param[in]		numIndices	Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]		numVertices	Number of vertices referenced by the indices.
+		 * @param[in]		cacheSize	Number of vertices that fit in the vertex cache.
+		 */
+		static void optimizeVertexCache(UINT32* indices, UINT32 numIndices, UINT32 numVertices, UINT32 cacheSize = 16);
+
+		/**
+		 * Reorders clusters of triangles so that triangles likely to occlude others are rendered first, reducing overdraw.
+		 * Should be called after optimizeVertexCache(), as it keeps the existing order within each cluster.
+		 *
+		 * @param[in, out]	indices		Triangle indices to reorder.
+		 * @param[in]		numIndices	Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]		positions	Vertex positions.
+		 * @param[in]		numVertices	Number of vertices in the @p positions array.
+		 * @param[in]		threshold	Determines by how much can the vertex cache efficiency degrade, in order to allow
+		 *								for more clusters. For example 1.05 allows the average cache miss ratio to increase
+		 *								by 5%.
+		 * @param[in]		cacheSize	Number of vertices that fit in the vertex cache.
+		 */
+		static void optimizeOverdraw(UINT32* indices, UINT32 numIndices, const Vector3* positions, UINT32 numVertices,
+			float threshold = 1.05f, UINT32 cacheSize = 16);
+
+		/**
+		 * Determines a new vertex order, in which vertices are ordered by their first use in the index buffer. This 
+		 * improves memory locality when the GPU fetches vertex data. Vertices not referenced by any of the indices are 
+		 * removed.
+		 *
+		 * @param[in, out]	indices		Triangle indices. Updated to reference the vertices in their new order.
+		 * @param[in]		numIndices	Number of indices in the @p indices array.
+		 * @param[in]		numVertices	Total number of vertices in the mesh.
+		 * @param[out]		remap		Pre-allocated buffer with @p numVertices entries. Will contain the new index of 
+		 *								each vertex, or -1 if the vertex was removed. Provide it to remapVertices() in 
+		 *								order to reorder the vertex data.
+		 * @return						Number of remaining vertices.
+		 */
+		static UINT32 optimizeVertexFetch(UINT32* indices, UINT32 numIndices, UINT32 numVertices, UINT32* remap);
+
+		/**
+		 * Reorders vertex data according to a remap table, as generated by deduplicateVertices() or optimizeVertexFetch().
+		 *
+		 * @param[in]	source			Vertex data in the original order.
+		 * @param[out]	destination		Buffer to output the reordered data to. Must be large enough to store all the 
+		 *								remaining vertices.
+		 * @param[in]	numVertices		Number of vertices in the @p source buffer.
+		 * @param[in]	vertexSize		Size of the data belonging to a single vertex, in bytes.
+		 * @param[in]	remap			Table containing the new index of each vertex, or -1 if the vertex was removed.
+		 */
+		static void remapVertices(const UINT8* source, UINT8* destination, UINT32 numVertices, UINT32 vertexSize,
+			const UINT32* remap);
+
+		/**
+		 * Simulates rendering the provided triangles using a FIFO post-transform vertex cache, and reports how efficiently
+		 * the cache is used.
+		 *
+		 * @param[in]	indices		Triangle indices.
+		 * @param[in]	numIndices	Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]	numVertices	Number of vertices referenced by the indices.
+		 * @param[in]	cacheSize	Number of vertices that fit in the vertex cache.
+		 */
+		static VertexCacheStatistics analyzeVertexCache(const UINT32* indices, UINT32 numIndices, UINT32 numVertices,
+			UINT32 cacheSize = 16);
 	};
 
 	/** @} */
@@ -0,0 +1,61 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsRTTIType.h"
+#include "Animation/BsAnimationCompression.h"
+
+namespace bs
+{
+	/** @cond RTTI */
+	/** @addtogroup RTTI-Impl-Core
+	 *  @{
+	 */
+
+	BS_ALLOW_MEMCPY_SERIALIZATION(AnimationCompressionSettings)
+	BS_ALLOW_MEMCPY_SERIALIZATION(AnimationCompressionReport)
+
+	class BS_CORE_EXPORT CompressedAnimationCurvesRTTI :
+		public RTTIType <CompressedAnimationCurves, IReflectable, CompressedAnimationCurvesRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_NAMED(positionConstants, mPositions.constantValues, 0)
+			BS_RTTI_MEMBER_PLAIN_NAMED(positionTracks, mPositions.animatedTracks, 1)
+			BS_RTTI_MEMBER_PLAIN_NAMED(positionRangeMin, mPositions.rangeMin, 2)
+			BS_RTTI_MEMBER_PLAIN_NAMED(positionRangeStep, mPositions.rangeStep, 3)
+			BS_RTTI_MEMBER_PLAIN_NAMED(rotationConstants, mRotations.constantValues, 4)
+			BS_RTTI_MEMBER_PLAIN_NAMED(rotationTracks, mRotations.animatedTracks, 5)
+			BS_RTTI_MEMBER_PLAIN_NAMED(scaleConstants, mScales.constantValues, 6)
+			BS_RTTI_MEMBER_PLAIN_NAMED(scaleTracks, mScales.animatedTracks, 7)
+			BS_RTTI_MEMBER_PLAIN_NAMED(scaleRangeMin, mScales.rangeMin, 8)
+			BS_RTTI_MEMBER_PLAIN_NAMED(scaleRangeStep, mScales.rangeStep, 9)
+			BS_RTTI_MEMBER_PLAIN(mFrameData, 10)
+			BS_RTTI_MEMBER_PLAIN(mFrameStride, 11)
+			BS_RTTI_MEMBER_PLAIN(mNumFrames, 12)
+			BS_RTTI_MEMBER_PLAIN(mSampleRate, 13)
+			BS_RTTI_MEMBER_PLAIN(mLength, 14)
+			BS_RTTI_MEMBER_PLAIN(mReport, 15)
+		BS_END_RTTI_MEMBERS
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "CompressedAnimationCurves";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_CompressedAnimationCurves;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<CompressedAnimationCurves>();
+		}
+	};
+
+	/** @} */
+	/** @endcond */
+}
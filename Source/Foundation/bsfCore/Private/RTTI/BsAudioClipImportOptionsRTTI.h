@@ -21,6 +21,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(mReadMode, 1)
 			BS_RTTI_MEMBER_PLAIN(mIs3D, 2)
 			BS_RTTI_MEMBER_PLAIN(mBitDepth, 3)
+			BS_RTTI_MEMBER_PLAIN(mSampleRate, 4)
 		BS_END_RTTI_MEMBERS
 	public:
 		/** @copydoc RTTIType::getRTTIName */
@@ -14,6 +14,8 @@ namespace bs
 	 *  @{
 	 */
 
+	BS_ALLOW_MEMCPY_SERIALIZATION(MeshOptimizationSettings)
+
 	class BS_CORE_EXPORT MeshImportOptionsRTTI : public RTTIType <MeshImportOptions, ImportOptions, MeshImportOptionsRTTI>
 	{
 	private:
@@ -30,6 +32,10 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(mReduceKeyFrames, 9)
 			BS_RTTI_MEMBER_REFL_ARRAY(mAnimationEvents, 10)
 			BS_RTTI_MEMBER_PLAIN(mImportRootMotion, 11)
+			BS_RTTI_MEMBER_PLAIN(mCompressAnimation, 12)
+			BS_RTTI_MEMBER_PLAIN(mAnimationCompressionSettings, 13)
+			BS_RTTI_MEMBER_PLAIN(mOptimizeMesh, 14)
+			BS_RTTI_MEMBER_PLAIN(mMeshOptimizationSettings, 15)
 		BS_END_RTTI_MEMBERS
 	public:
 		const String& getRTTIName() override
@@ -32,11 +32,20 @@ namespace bs
 				obj->mFilePathToUUID[entry.second] = entry.first;
 			}
 		} 
+
+		UnorderedMap<UUID, Vector<UUID>>& getDependencies(ResourceManifest* obj) { return obj->mDependencies; }
+		void setDependencies(ResourceManifest* obj, UnorderedMap<UUID, Vector<UUID>>& val) { obj->mDependencies = val; }
+
+		UnorderedMap<UUID, UINT64>& getSizes(ResourceManifest* obj) { return obj->mSizes; }
+		void setSizes(ResourceManifest* obj, UnorderedMap<UUID, UINT64>& val) { obj->mSizes = val; }
 	public:
 		ResourceManifestRTTI()
 		{
 			addPlainField("mName", 0, &ResourceManifestRTTI::getName, &ResourceManifestRTTI::setName);
 			addPlainField("mUUIDToFilePath", 1, &ResourceManifestRTTI::getUUIDMap, &ResourceManifestRTTI::setUUIDMap);
+			addPlainField("mDependencies", 2, &ResourceManifestRTTI::getDependencies, 
+				&ResourceManifestRTTI::setDependencies);
+			addPlainField("mSizes", 3, &ResourceManifestRTTI::getSizes, &ResourceManifestRTTI::setSizes);
 		}
 
 		const String& getRTTIName() override
@@ -0,0 +1,371 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/UnitTests/BsAudioTestSuite.h"
+#include "Audio/BsAudioUtility.h"
+#include "Audio/BsAudioResampler.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	/** Bit depths supported by the sample conversion methods. */
+	static const UINT32 TEST_BIT_DEPTHS[] = { 8, 16, 24, 32 };
+
+	/**
+	 * Conversions are tested with every sample count up to this value, so that both the vectorized loops and the scalar
+	 * loops handling the remaining samples run, with every possible number of remaining samples.
+	 */
+	static const UINT32 MAX_TEST_SAMPLES = 40;
+
+	/** Extra bytes after the end of an output buffer, used for detecting writes past the end of the output. */
+	static const UINT32 GUARD_SIZE = 16;
+	static const UINT8 GUARD_VALUE = 0xCD;
+
+	/** Fills the provided buffer with random bytes. */
+	static void fillRandom(Vector<UINT8>& data)
+	{
+		for (auto& entry : data)
+			entry = (UINT8)rand();
+	}
+
+	/** Returns a random sample in range [-1.5, 1.5], so that out of range samples are tested as well. */
+	static float getRandomFloatSample()
+	{
+		return (rand() / (float)RAND_MAX) * 3.0f - 1.5f;
+	}
+
+	/**
+	 * Reads a signed integer sample of the specified bit depth, and returns it as a 32-bit sample, with the value in
+	 * the most significant bits.
+	 */
+	static INT32 readSample(const UINT8* data, UINT32 bitDepth, UINT32 idx)
+	{
+		switch (bitDepth)
+		{
+		case 8:
+			return (INT32)((UINT32)data[idx] << 24);
+		case 16:
+		{
+			const UINT8* sample = data + idx * 2;
+			return (INT32)(((UINT32)sample[1] << 24) | ((UINT32)sample[0] << 16));
+		}
+		case 24:
+		{
+			const UINT8* sample = data + idx * 3;
+			return (INT32)(((UINT32)sample[2] << 24) | ((UINT32)sample[1] << 16) | ((UINT32)sample[0] << 8));
+		}
+		default:
+		{
+			INT32 sample;
+			memcpy(&sample, data + idx * 4, sizeof(sample));
+			return sample;
+		}
+		}
+	}
+
+	/** Writes a 32-bit sample as a sample of the specified bit depth, keeping its most significant bits. */
+	static void writeSample(UINT8* data, UINT32 bitDepth, UINT32 idx, INT32 value)
+	{
+		UINT32 bytesPerSample = bitDepth / 8;
+		UINT32 bits = (UINT32)value;
+
+		UINT8* sample = data + idx * bytesPerSample;
+		for (UINT32 i = 0; i < bytesPerSample; i++)
+			sample[i] = (UINT8)(bits >> (32 - bitDepth + i * 8));
+	}
+
+	/**
+	 * Resamples the provided data with an AudioResampler, providing the input in chunks of the specified size. Checks
+	 * that the number of output frames never exceeds the number reported by the resampler.
+	 */
+	static bool resampleInChunks(const Vector<float>& input, UINT32 numChannels, UINT32 inSampleRate,
+		UINT32 outSampleRate, UINT32 chunkSize, Vector<float>& output)
+	{
+		AudioResampler resampler(inSampleRate, outSampleRate, numChannels);
+		UINT32 numFrames = (UINT32)input.size() / numChannels;
+
+		bool valid = true;
+		output.clear();
+		for (UINT32 i = 0; i < numFrames; i += chunkSize)
+		{
+			UINT32 numChunkFrames = std::min(chunkSize, numFrames - i);
+
+			UINT32 numMaxFrames = resampler.getMaxNumOutputFrames(numChunkFrames);
+			Vector<float> buffer(numMaxFrames * numChannels + 1);
+
+			UINT32 numWrittenFrames = resampler.process(input.data() + i * numChannels, numChunkFrames, buffer.data());
+			valid &= numWrittenFrames <= numMaxFrames;
+
+			output.insert(output.end(), buffer.begin(), buffer.begin() + numWrittenFrames * numChannels);
+		}
+
+		UINT32 numMaxFrames = resampler.getMaxNumOutputFrames(0, true);
+		Vector<float> buffer(numMaxFrames * numChannels + 1);
+
+		UINT32 numWrittenFrames = resampler.flush(buffer.data());
+		valid &= numWrittenFrames <= numMaxFrames;
+
+		output.insert(output.end(), buffer.begin(), buffer.begin() + numWrittenFrames * numChannels);
+		return valid;
+	}
+
+	AudioTestSuite::AudioTestSuite()
+	{
+		BS_ADD_TEST(AudioTestSuite::testConvertToMono);
+		BS_ADD_TEST(AudioTestSuite::testConvertBitDepth);
+		BS_ADD_TEST(AudioTestSuite::testConvertToFloat);
+		BS_ADD_TEST(AudioTestSuite::testConvertFromFloat);
+		BS_ADD_TEST(AudioTestSuite::testResample_output_length);
+		BS_ADD_TEST(AudioTestSuite::testResample_sine);
+	}
+
+	void AudioTestSuite::startUp()
+	{
+		MemStack::beginThread();
+	}
+
+	void AudioTestSuite::shutDown()
+	{
+		MemStack::endThread();
+	}
+
+	void AudioTestSuite::testConvertToMono()
+	{
+		for (auto bitDepth : TEST_BIT_DEPTHS)
+		{
+			UINT32 bytesPerSample = bitDepth / 8;
+			for (UINT32 numChannels = 1; numChannels <= 3; numChannels++)
+			{
+				for (UINT32 numSamples = 1; numSamples <= MAX_TEST_SAMPLES; numSamples++)
+				{
+					Vector<UINT8> input(numSamples * numChannels * bytesPerSample);
+					fillRandom(input);
+
+					// Largest and smallest values, to catch overflows when summing the channels
+					for (UINT32 i = 0; i < numChannels && numSamples >= 2; i++)
+					{
+						writeSample(input.data(), bitDepth, i, std::numeric_limits<INT32>::max());
+						writeSample(input.data(), bitDepth, numChannels + i, std::numeric_limits<INT32>::min());
+					}
+
+					// Average of the channels, rounded towards zero. 24-bit samples are averaged as 32-bit values.
+					Vector<UINT8> expected(numSamples * bytesPerSample + GUARD_SIZE, GUARD_VALUE);
+					for (UINT32 i = 0; i < numSamples; i++)
+					{
+						UINT32 shift = bitDepth == 24 ? 0 : 32 - bitDepth;
+
+						INT64 sum = 0;
+						for (UINT32 j = 0; j < numChannels; j++)
+							sum += readSample(input.data(), bitDepth, i * numChannels + j) >> shift;
+
+						INT32 average = (INT32)(sum / numChannels);
+						writeSample(expected.data(), bitDepth, i, (INT32)((UINT32)average << shift));
+					}
+
+					Vector<UINT8> output(numSamples * bytesPerSample + GUARD_SIZE, GUARD_VALUE);
+					AudioUtility::convertToMono(input.data(), output.data(), bitDepth, numSamples, numChannels);
+
+					BS_TEST_ASSERT(output == expected);
+				}
+			}
+		}
+	}
+
+	void AudioTestSuite::testConvertBitDepth()
+	{
+		for (auto inBitDepth : TEST_BIT_DEPTHS)
+		{
+			for (auto outBitDepth : TEST_BIT_DEPTHS)
+			{
+				UINT32 outBytesPerSample = outBitDepth / 8;
+				for (UINT32 numSamples = 1; numSamples <= MAX_TEST_SAMPLES; numSamples++)
+				{
+					Vector<UINT8> input(numSamples * inBitDepth / 8);
+					fillRandom(input);
+
+					// Samples keep their most significant bits, and are padded with zeroes when expanded
+					Vector<UINT8> expected(numSamples * outBytesPerSample + GUARD_SIZE, GUARD_VALUE);
+					for (UINT32 i = 0; i < numSamples; i++)
+						writeSample(expected.data(), outBitDepth, i, readSample(input.data(), inBitDepth, i));
+
+					Vector<UINT8> output(numSamples * outBytesPerSample + GUARD_SIZE, GUARD_VALUE);
+					AudioUtility::convertBitDepth(input.data(), inBitDepth, output.data(), outBitDepth, numSamples);
+
+					BS_TEST_ASSERT(output == expected);
+				}
+			}
+		}
+	}
+
+	void AudioTestSuite::testConvertToFloat()
+	{
+		static const float GUARD_FLOAT = 1234.0f;
+
+		for (auto bitDepth : TEST_BIT_DEPTHS)
+		{
+			for (UINT32 numSamples = 1; numSamples <= MAX_TEST_SAMPLES; numSamples++)
+			{
+				Vector<UINT8> input(numSamples * bitDepth / 8);
+				fillRandom(input);
+
+				Vector<float> output(numSamples + 4, GUARD_FLOAT);
+				AudioUtility::convertToFloat(input.data(), bitDepth, output.data(), numSamples);
+
+				bool matches = true;
+				for (UINT32 i = 0; i < numSamples; i++)
+				{
+					INT32 sample = readSample(input.data(), bitDepth, i);
+
+					float expected;
+					if (bitDepth == 8)
+						expected = (sample >> 24) / 127.0f;
+					else if (bitDepth == 16)
+						expected = (sample >> 16) / 32767.0f;
+					else
+						expected = sample / 2147483647.0f;
+
+					matches &= Math::approxEquals(output[i], expected, 1.0e-6f);
+				}
+
+				for (UINT32 i = numSamples; i < (UINT32)output.size(); i++)
+					matches &= output[i] == GUARD_FLOAT;
+
+				BS_TEST_ASSERT(matches);
+			}
+		}
+	}
+
+	void AudioTestSuite::testConvertFromFloat()
+	{
+		for (auto bitDepth : TEST_BIT_DEPTHS)
+		{
+			UINT32 bytesPerSample = bitDepth / 8;
+			for (UINT32 numSamples = 1; numSamples <= MAX_TEST_SAMPLES; numSamples++)
+			{
+				Vector<float> input(numSamples);
+				for (auto& entry : input)
+					entry = getRandomFloatSample();
+
+				input[0] = 1.0f;
+				input[numSamples - 1] = -1.0f;
+
+				// Samples are clamped to [-1, 1] and scaled to the largest positive value, rounding towards zero
+				Vector<UINT8> expected(numSamples * bytesPerSample + GUARD_SIZE, GUARD_VALUE);
+				for (UINT32 i = 0; i < numSamples; i++)
+				{
+					float value = Math::clamp(input[i], -1.0f, 1.0f);
+
+					INT32 sample;
+					if (bitDepth == 8)
+						sample = (INT32)((UINT32)(INT32)(value * 127.0f) << 24);
+					else if (bitDepth == 16)
+						sample = (INT32)((UINT32)(INT32)(value * 32767.0f) << 16);
+					else if (bitDepth == 24)
+						sample = (INT32)((UINT32)(INT32)(value * 8388607.0f) << 8);
+					else
+						sample = (INT32)std::min(value * 2147483647.0f, 2147483520.0f);
+
+					writeSample(expected.data(), bitDepth, i, sample);
+				}
+
+				Vector<UINT8> output(numSamples * bytesPerSample + GUARD_SIZE, GUARD_VALUE);
+				AudioUtility::convertFromFloat(input.data(), output.data(), bitDepth, numSamples);
+
+				BS_TEST_ASSERT(output == expected);
+			}
+		}
+	}
+
+	void AudioTestSuite::testResample_output_length()
+	{
+		BS_TEST_ASSERT(AudioResampler::getNumResampledFrames(44100, 44100, 48000) == 48000);
+		BS_TEST_ASSERT(AudioResampler::getNumResampledFrames(48000, 48000, 22050) == 22050);
+		BS_TEST_ASSERT(AudioResampler::getNumResampledFrames(1000, 48000, 22050) == 460);
+		BS_TEST_ASSERT(AudioResampler::getNumResampledFrames(1, 44100, 48000) == 2);
+		BS_TEST_ASSERT(AudioResampler::getNumResampledFrames(1, 48000, 22050) == 1);
+		BS_TEST_ASSERT(AudioResampler::getNumResampledFrames(0, 44100, 48000) == 0);
+
+		static const UINT32 NUM_CHANNELS = 2;
+		static const UINT32 SAMPLE_RATES[][2] = { { 44100, 48000 }, { 48000, 22050 } };
+
+		for (auto& sampleRates : SAMPLE_RATES)
+		{
+			UINT32 inSampleRate = sampleRates[0];
+			UINT32 outSampleRate = sampleRates[1];
+
+			// Large enough for AudioUtility::resample() to process the data in multiple chunks
+			for (UINT32 numFrames : { 1U, 37U, 20011U })
+			{
+				Vector<float> input(numFrames * NUM_CHANNELS);
+				for (auto& entry : input)
+					entry = getRandomFloatSample();
+
+				UINT32 numOutputFrames = AudioResampler::getNumResampledFrames(numFrames, inSampleRate, outSampleRate);
+
+				// Resampling in chunks outputs the same data as resampling all at once
+				Vector<float> chunkedOutput;
+				BS_TEST_ASSERT(resampleInChunks(input, NUM_CHANNELS, inSampleRate, outSampleRate, 999,
+					chunkedOutput));
+				BS_TEST_ASSERT(chunkedOutput.size() == numOutputFrames * NUM_CHANNELS);
+
+				Vector<float> output(numOutputFrames * NUM_CHANNELS);
+				AudioUtility::resample(input.data(), numFrames, NUM_CHANNELS, inSampleRate, output.data(),
+					outSampleRate);
+
+				bool matches = chunkedOutput.size() == output.size();
+				for (UINT32 i = 0; i < (UINT32)output.size() && matches; i++)
+					matches &= Math::approxEquals(output[i], chunkedOutput[i], 1.0e-6f);
+
+				BS_TEST_ASSERT(matches);
+			}
+		}
+	}
+
+	void AudioTestSuite::testResample_sine()
+	{
+		static const UINT32 NUM_CHANNELS = 2;
+		static const UINT32 SAMPLE_RATES[][2] = { { 44100, 48000 }, { 48000, 22050 } };
+		static const float FREQUENCIES[NUM_CHANNELS] = { 1000.0f, 3000.0f };
+		static const float AMPLITUDE = 0.5f;
+
+		/** Output frames at the start and the end that are affected by the filter reaching outside the input. */
+		static const UINT32 NUM_EDGE_FRAMES = 100;
+
+		auto evaluate = [](UINT32 channel, UINT32 frame, UINT32 sampleRate)
+		{
+			double phase = 2.0 * Math::PI * FREQUENCIES[channel] * frame / sampleRate;
+			return AMPLITUDE * (float)(channel == 0 ? std::sin(phase) : std::cos(phase));
+		};
+
+		for (auto& sampleRates : SAMPLE_RATES)
+		{
+			UINT32 inSampleRate = sampleRates[0];
+			UINT32 outSampleRate = sampleRates[1];
+
+			// A quarter of a second of a different tone in each channel
+			UINT32 numFrames = inSampleRate / 4;
+			Vector<float> input(numFrames * NUM_CHANNELS);
+			for (UINT32 i = 0; i < numFrames; i++)
+			{
+				for (UINT32 j = 0; j < NUM_CHANNELS; j++)
+					input[i * NUM_CHANNELS + j] = evaluate(j, i, inSampleRate);
+			}
+
+			UINT32 numOutputFrames = AudioResampler::getNumResampledFrames(numFrames, inSampleRate, outSampleRate);
+			Vector<float> output(numOutputFrames * NUM_CHANNELS);
+			AudioUtility::resample(input.data(), numFrames, NUM_CHANNELS, inSampleRate, output.data(), outSampleRate);
+
+			// Tones below the output Nyquist frequency pass through with the same amplitude and phase
+			float maxError = 0.0f;
+			for (UINT32 i = NUM_EDGE_FRAMES; i < numOutputFrames - NUM_EDGE_FRAMES; i++)
+			{
+				for (UINT32 j = 0; j < NUM_CHANNELS; j++)
+				{
+					float error = std::abs(output[i * NUM_CHANNELS + j] - evaluate(j, i, outSampleRate));
+					maxError = std::max(maxError, error);
+				}
+			}
+
+			BS_TEST_ASSERT(maxError < 1.0e-4f);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class AudioTestSuite : public TestSuite
+	{
+	public:
+		AudioTestSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testConvertToMono();
+		void testConvertBitDepth();
+		void testConvertToFloat();
+		void testConvertFromFloat();
+		void testResample_output_length();
+		void testResample_sine();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/UnitTests/BsCoreTestSuite.h"
+#include "Private/UnitTests/BsResourcesTestSuite.h"
+#include "Private/UnitTests/BsAudioTestSuite.h"
+#include "Private/UnitTests/BsMeshUtilityTestSuite.h"
+
+namespace bs
+{
+	CoreTestSuite::CoreTestSuite()
+	{ }
+
+	void CoreTestSuite::startUp()
+	{
+		SPtr<TestSuite> resourcesTests = create<ResourcesTestSuite>();
+		add(resourcesTests);
+
+		SPtr<TestSuite> audioTests = create<AudioTestSuite>();
+		add(audioTests);
+
+		SPtr<TestSuite> meshUtilityTests = create<MeshUtilityTestSuite>();
+		add(meshUtilityTests);
+	}
+
+	void CoreTestSuite::shutDown()
+	{
+	}
+}
\ No newline at end of file
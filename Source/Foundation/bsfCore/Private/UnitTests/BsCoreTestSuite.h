@@ -0,0 +1,16 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class CoreTestSuite : public TestSuite
+	{
+	public:
+		CoreTestSuite();
+		void startUp() override;
+		void shutDown() override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/UnitTests/BsMeshUtilityTestSuite.h"
+#include "Mesh/BsMeshUtility.h"
+#include "Math/BsVector2.h"
+#include "Math/BsVector3.h"
+#include "Math/BsVector4.h"
+
+namespace bs
+{
+	/** Largest error introduced by packing a normal component into 8 bits. */
+	static const float PACKED_NORMAL_ERROR = 1.0f / 127.5f;
+
+	/** Returns true if all components of the vector are finite numbers. */
+	static bool isFinite(const Vector3& vector)
+	{
+		return std::isfinite(vector.x) && std::isfinite(vector.y) && std::isfinite(vector.z);
+	}
+
+	/** Returns true if the two vectors are equal, within a small tolerance. */
+	static bool approxEquals(const Vector3& a, const Vector3& b)
+	{
+		return Math::approxEquals(a, b, 1.0e-5f);
+	}
+
+	/**
+	 * Square in the XY plane, facing positive Z, made out of two triangles. Both triangles use the first and the third
+	 * vertex.
+	 */
+	static const Vector3 QUAD_POSITIONS[] =
+	{
+		Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f)
+	};
+
+	static const UINT32 QUAD_INDICES[] = { 0, 1, 2, 0, 2, 3 };
+	static const UINT32 QUAD_NUM_VERTICES = 4;
+	static const UINT32 QUAD_NUM_INDICES = 6;
+
+	MeshUtilityTestSuite::MeshUtilityTestSuite()
+	{
+		BS_ADD_TEST(MeshUtilityTestSuite::testPackNormals_round_trip);
+		BS_ADD_TEST(MeshUtilityTestSuite::testUnpackNormals);
+		BS_ADD_TEST(MeshUtilityTestSuite::testCalculateTangents);
+		BS_ADD_TEST(MeshUtilityTestSuite::testCalculateTangents_degenerate_uv);
+	}
+
+	void MeshUtilityTestSuite::startUp()
+	{
+	}
+
+	void MeshUtilityTestSuite::shutDown()
+	{
+	}
+
+	void MeshUtilityTestSuite::testPackNormals_round_trip()
+	{
+		// Count isn't a multiple of the SIMD width, so the last batch is only partially filled
+		Vector<Vector3> normals =
+		{
+			Vector3::UNIT_X, -Vector3::UNIT_X, Vector3::UNIT_Y, -Vector3::UNIT_Y, Vector3::UNIT_Z, -Vector3::UNIT_Z,
+			Vector3::normalize(Vector3(1.0f, 2.0f, -3.0f))
+		};
+
+		for (UINT32 i = 0; i < 10; i++)
+		{
+			Vector3 normal((rand() / (float)RAND_MAX) * 2.0f - 1.0f, (rand() / (float)RAND_MAX) * 2.0f - 1.0f,
+				(rand() / (float)RAND_MAX) * 2.0f - 1.0f);
+
+			normals.push_back(Vector3::normalize(normal));
+		}
+
+		UINT32 count = (UINT32)normals.size();
+
+		// Packed normals are interleaved with other data, which must not be overwritten
+		static const UINT32 STRIDE = 8;
+		static const UINT8 GUARD_VALUE = 0xCD;
+
+		Vector<UINT8> packed(count * STRIDE, GUARD_VALUE);
+		MeshUtility::packNormals(normals.data(), packed.data(), count, sizeof(Vector3), STRIDE);
+
+		Vector<Vector3> unpacked(count);
+		MeshUtility::unpackNormals(packed.data(), unpacked.data(), count, STRIDE);
+
+		bool matches = true;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			PackedNormal packedNormal;
+			memcpy(&packedNormal, &packed[i * STRIDE], sizeof(packedNormal));
+
+			// Missing fourth component is encoded as zero
+			matches &= packedNormal.w == 128;
+
+			for (UINT32 j = sizeof(PackedNormal); j < STRIDE; j++)
+				matches &= packed[i * STRIDE + j] == GUARD_VALUE;
+
+			for (UINT32 j = 0; j < 3; j++)
+				matches &= std::abs(unpacked[i][j] - normals[i][j]) <= PACKED_NORMAL_ERROR;
+		}
+
+		BS_TEST_ASSERT(matches);
+
+		// Ends of the range encode to the smallest and largest values, and decode exactly
+		BS_TEST_ASSERT(Math::approxEquals(unpacked[0].x, 1.0f, 1.0e-6f));
+		BS_TEST_ASSERT(Math::approxEquals(unpacked[1].x, -1.0f, 1.0e-6f));
+
+		// Four component vectors keep their fourth component
+		Vector<Vector4> tangents = { Vector4(1.0f, 0.0f, 0.0f, 1.0f), Vector4(0.0f, 1.0f, 0.0f, -1.0f) };
+
+		Vector<UINT8> packedTangents(tangents.size() * sizeof(PackedNormal));
+		MeshUtility::packNormals(tangents.data(), packedTangents.data(), (UINT32)tangents.size(), sizeof(Vector4),
+			sizeof(PackedNormal));
+
+		Vector<Vector4> unpackedTangents(tangents.size());
+		MeshUtility::unpackNormals(packedTangents.data(), unpackedTangents.data(), (UINT32)tangents.size(),
+			sizeof(PackedNormal));
+
+		BS_TEST_ASSERT(Math::approxEquals(unpackedTangents[0].w, 1.0f, 1.0e-5f));
+		BS_TEST_ASSERT(Math::approxEquals(unpackedTangents[1].w, -1.0f, 1.0e-5f));
+	}
+
+	void MeshUtilityTestSuite::testUnpackNormals()
+	{
+		// Every possible byte value, in each of the components
+		Vector<PackedNormal> packed(256);
+		for (UINT32 i = 0; i < 256; i++)
+		{
+			packed[i].x = (UINT8)i;
+			packed[i].y = (UINT8)(255 - i);
+			packed[i].z = (UINT8)(i ^ 0x55);
+			packed[i].w = (UINT8)(i ^ 0xAA);
+		}
+
+		Vector<Vector4> unpacked(packed.size());
+		MeshUtility::unpackNormals((UINT8*)packed.data(), unpacked.data(), (UINT32)packed.size(), sizeof(PackedNormal));
+
+		// Bytes map linearly to [-1, 1], with 0 and 255 at the ends of the range
+		bool matches = true;
+		for (UINT32 i = 0; i < 256; i++)
+		{
+			const UINT8* bytes = (const UINT8*)&packed[i];
+			for (UINT32 j = 0; j < 4; j++)
+				matches &= Math::approxEquals(unpacked[i][j], bytes[j] / 127.5f - 1.0f, 1.0e-6f);
+		}
+
+		BS_TEST_ASSERT(matches);
+		BS_TEST_ASSERT(Math::approxEquals(unpacked[0].x, -1.0f, 1.0e-6f));
+		BS_TEST_ASSERT(Math::approxEquals(unpacked[255].x, 1.0f, 1.0e-6f));
+
+		// Decoding is the inverse of encoding
+		Vector<PackedNormal> repacked(packed.size());
+		MeshUtility::packNormals(unpacked.data(), (UINT8*)repacked.data(), (UINT32)packed.size(), sizeof(Vector4),
+			sizeof(PackedNormal));
+
+		matches = true;
+		for (UINT32 i = 0; i < 256; i++)
+			matches &= repacked[i].packed == packed[i].packed;
+
+		BS_TEST_ASSERT(matches);
+	}
+
+	void MeshUtilityTestSuite::testCalculateTangents()
+	{
+		Vector3 positions[QUAD_NUM_VERTICES];
+		Vector3 normals[QUAD_NUM_VERTICES];
+		Vector2 uvs[QUAD_NUM_VERTICES];
+		for (UINT32 i = 0; i < QUAD_NUM_VERTICES; i++)
+		{
+			positions[i] = QUAD_POSITIONS[i];
+			normals[i] = Vector3::UNIT_Z;
+			uvs[i] = Vector2(QUAD_POSITIONS[i].x, QUAD_POSITIONS[i].y);
+		}
+
+		UINT16 indices16[QUAD_NUM_INDICES];
+		for (UINT32 i = 0; i < QUAD_NUM_INDICES; i++)
+			indices16[i] = (UINT16)QUAD_INDICES[i];
+
+		// U increases along X and V along Y, for both index sizes
+		for (UINT32 indexSize : { 2U, 4U })
+		{
+			UINT8* indices = indexSize == 2 ? (UINT8*)indices16 : (UINT8*)QUAD_INDICES;
+
+			Vector3 tangents[QUAD_NUM_VERTICES];
+			Vector3 bitangents[QUAD_NUM_VERTICES];
+			MeshUtility::calculateTangents(positions, normals, uvs, indices, QUAD_NUM_VERTICES, QUAD_NUM_INDICES,
+				tangents, bitangents, indexSize);
+
+			bool matches = true;
+			for (UINT32 i = 0; i < QUAD_NUM_VERTICES; i++)
+			{
+				matches &= approxEquals(tangents[i], Vector3::UNIT_X);
+				matches &= approxEquals(bitangents[i], Vector3::UNIT_Y);
+			}
+
+			BS_TEST_ASSERT(matches);
+		}
+
+		// Mirrored U coordinate flips the tangent
+		for (UINT32 i = 0; i < QUAD_NUM_VERTICES; i++)
+			uvs[i].x = -uvs[i].x;
+
+		Vector3 tangents[QUAD_NUM_VERTICES];
+		Vector3 bitangents[QUAD_NUM_VERTICES];
+		MeshUtility::calculateTangents(positions, normals, uvs, (UINT8*)QUAD_INDICES, QUAD_NUM_VERTICES,
+			QUAD_NUM_INDICES, tangents, bitangents);
+
+		bool matches = true;
+		for (UINT32 i = 0; i < QUAD_NUM_VERTICES; i++)
+		{
+			matches &= approxEquals(tangents[i], -Vector3::UNIT_X);
+			matches &= approxEquals(bitangents[i], Vector3::UNIT_Y);
+		}
+
+		BS_TEST_ASSERT(matches);
+	}
+
+	void MeshUtilityTestSuite::testCalculateTangents_degenerate_uv()
+	{
+		// Fourth vertex has the same UV coordinates as the first one, so the UV coordinates of the second triangle are
+		// collinear. The fourth vertex isn't used by any other triangle.
+		Vector3 positions[QUAD_NUM_VERTICES];
+		Vector2 uvs[QUAD_NUM_VERTICES];
+		for (UINT32 i = 0; i < QUAD_NUM_VERTICES; i++)
+		{
+			positions[i] = QUAD_POSITIONS[i];
+			uvs[i] = Vector2(QUAD_POSITIONS[i].x, QUAD_POSITIONS[i].y);
+		}
+
+		uvs[3] = uvs[0];
+
+		Vector3 normals[QUAD_NUM_VERTICES];
+		Vector3 tangents[QUAD_NUM_VERTICES];
+		Vector3 bitangents[QUAD_NUM_VERTICES];
+		MeshUtility::calculateTangentSpace(positions, uvs, (UINT8*)QUAD_INDICES, QUAD_NUM_VERTICES, QUAD_NUM_INDICES,
+			normals, tangents, bitangents);
+
+		bool isValid = true;
+		for (UINT32 i = 0; i < QUAD_NUM_VERTICES; i++)
+		{
+			isValid &= isFinite(normals[i]);
+			isValid &= isFinite(tangents[i]);
+			isValid &= isFinite(bitangents[i]);
+		}
+
+		BS_TEST_ASSERT(isValid);
+
+		// Faces with degenerate UVs don't contribute, so vertices of the valid face get its tangent space
+		BS_TEST_ASSERT(approxEquals(normals[1], Vector3::UNIT_Z));
+		BS_TEST_ASSERT(approxEquals(tangents[1], Vector3::UNIT_X));
+		BS_TEST_ASSERT(approxEquals(bitangents[1], Vector3::UNIT_Y));
+		BS_TEST_ASSERT(approxEquals(tangents[0], Vector3::UNIT_X));
+		BS_TEST_ASSERT(approxEquals(tangents[2], Vector3::UNIT_X));
+
+		// Vertices only used by faces with degenerate UVs get no tangents
+		BS_TEST_ASSERT(approxEquals(tangents[3], Vector3::ZERO));
+		BS_TEST_ASSERT(approxEquals(bitangents[3], Vector3::ZERO));
+	}
+}
\ No newline at end of file
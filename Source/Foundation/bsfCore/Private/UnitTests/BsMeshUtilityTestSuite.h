@@ -0,0 +1,22 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class MeshUtilityTestSuite : public TestSuite
+	{
+	public:
+		MeshUtilityTestSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testPackNormals_round_trip();
+		void testUnpackNormals();
+		void testCalculateTangents();
+		void testCalculateTangents_degenerate_uv();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/UnitTests/BsResourcesTestSuite.h"
+#include "Resources/BsResources.h"
+#include "Resources/BsResourceManifest.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Error/BsException.h"
+#include "Utility/BsUUID.h"
+
+namespace bs
+{
+	const String resourcesTestDirectoryName = "ResourcesTestDirectory/";
+
+	/** Creates a file of the provided size, filled with zeroes. */
+	static void createTestFile(const Path& path, UINT32 size)
+	{
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+
+		Vector<UINT8> data(size, 0);
+		if(size > 0)
+			stream->write(data.data(), size);
+
+		stream->close();
+	}
+
+	ResourcesTestSuite::ResourcesTestSuite()
+	{
+		BS_ADD_TEST(ResourcesTestSuite::testManifestDependencies);
+		BS_ADD_TEST(ResourcesTestSuite::testManifestTransitiveDependencies);
+		BS_ADD_TEST(ResourcesTestSuite::testManifestTransitiveDependencies_cycle);
+		BS_ADD_TEST(ResourcesTestSuite::testPrefetch_release_unclaimed);
+	}
+
+	void ResourcesTestSuite::startUp()
+	{
+		mTestDirectory = FileSystem::getWorkingDirectoryPath() + resourcesTestDirectoryName;
+		if (FileSystem::exists(mTestDirectory))
+		{
+			BS_EXCEPT(InternalErrorException, String("Directory '") + resourcesTestDirectoryName
+				+ "' should not already exist; you should remove it manually.");
+		}
+
+		FileSystem::createDir(mTestDirectory);
+
+		ThreadPool::startUp<TThreadPool<>>(4);
+		TaskScheduler::startUp();
+		Resources::startUp();
+	}
+
+	void ResourcesTestSuite::shutDown()
+	{
+		Resources::shutDown();
+		TaskScheduler::shutDown();
+		ThreadPool::shutDown();
+
+		FileSystem::remove(mTestDirectory, true);
+	}
+
+	void ResourcesTestSuite::testManifestDependencies()
+	{
+		UUID a = UUIDGenerator::generateRandom();
+		UUID b = UUIDGenerator::generateRandom();
+		UUID c = UUIDGenerator::generateRandom();
+
+		SPtr<ResourceManifest> manifest = ResourceManifest::create("DependencyTest");
+		manifest->registerResource(a, mTestDirectory + "A.asset");
+		manifest->registerDependencies(a, { b, c }, 100);
+		manifest->registerDependencies(b, {}, 200);
+
+		Vector<UUID> dependencies;
+		BS_TEST_ASSERT(manifest->getDependencies(a, dependencies));
+		BS_TEST_ASSERT(dependencies == Vector<UUID>({ b, c }));
+		BS_TEST_ASSERT(manifest->getApproximateSize(a) == 100);
+
+		// Registered with no dependencies is different from not registered at all
+		BS_TEST_ASSERT(manifest->getDependencies(b, dependencies));
+		BS_TEST_ASSERT(dependencies.empty());
+		BS_TEST_ASSERT(manifest->getApproximateSize(b) == 200);
+
+		dependencies = { a };
+		BS_TEST_ASSERT(!manifest->getDependencies(c, dependencies));
+		BS_TEST_ASSERT(dependencies.empty());
+		BS_TEST_ASSERT(manifest->getApproximateSize(c) == 0);
+
+		// Re-registering replaces the previous entry
+		manifest->registerDependencies(a, { c }, 50);
+		BS_TEST_ASSERT(manifest->getDependencies(a, dependencies));
+		BS_TEST_ASSERT(dependencies == Vector<UUID>({ c }));
+		BS_TEST_ASSERT(manifest->getApproximateSize(a) == 50);
+
+		manifest->unregisterResource(a);
+		BS_TEST_ASSERT(!manifest->getDependencies(a, dependencies));
+		BS_TEST_ASSERT(manifest->getApproximateSize(a) == 0);
+	}
+
+	void ResourcesTestSuite::testManifestTransitiveDependencies()
+	{
+		UUID a = UUIDGenerator::generateRandom();
+		UUID b = UUIDGenerator::generateRandom();
+		UUID c = UUIDGenerator::generateRandom();
+		UUID d = UUIDGenerator::generateRandom();
+		UUID e = UUIDGenerator::generateRandom();
+
+		// A references B and C, which both reference D. E has no dependency information registered.
+		SPtr<ResourceManifest> manifest = ResourceManifest::create("TransitiveDependencyTest");
+		manifest->registerDependencies(a, { b, c }, 0);
+		manifest->registerDependencies(b, { d }, 0);
+		manifest->registerDependencies(c, { d, e }, 0);
+		manifest->registerDependencies(d, {}, 0);
+
+		// Every resource is output once, after all of its own dependencies, and the root isn't output
+		Vector<UUID> dependencies;
+		BS_TEST_ASSERT(manifest->getTransitiveDependencies(a, dependencies));
+		BS_TEST_ASSERT(dependencies == Vector<UUID>({ d, b, e, c }));
+
+		BS_TEST_ASSERT(manifest->getTransitiveDependencies(c, dependencies));
+		BS_TEST_ASSERT(dependencies == Vector<UUID>({ d, e }));
+
+		BS_TEST_ASSERT(manifest->getTransitiveDependencies(d, dependencies));
+		BS_TEST_ASSERT(dependencies.empty());
+
+		dependencies = { a };
+		BS_TEST_ASSERT(!manifest->getTransitiveDependencies(e, dependencies));
+		BS_TEST_ASSERT(dependencies.empty());
+	}
+
+	void ResourcesTestSuite::testManifestTransitiveDependencies_cycle()
+	{
+		UUID a = UUIDGenerator::generateRandom();
+		UUID b = UUIDGenerator::generateRandom();
+		UUID c = UUIDGenerator::generateRandom();
+
+		SPtr<ResourceManifest> manifest = ResourceManifest::create("CyclicDependencyTest");
+		manifest->registerDependencies(a, { b }, 0);
+		manifest->registerDependencies(b, { c }, 0);
+		manifest->registerDependencies(c, { a, b }, 0);
+
+		Vector<UUID> dependencies;
+		BS_TEST_ASSERT(manifest->getTransitiveDependencies(a, dependencies));
+		BS_TEST_ASSERT(dependencies == Vector<UUID>({ c, b }));
+
+		BS_TEST_ASSERT(manifest->getTransitiveDependencies(b, dependencies));
+		BS_TEST_ASSERT(dependencies == Vector<UUID>({ a, c }));
+	}
+
+	void ResourcesTestSuite::testPrefetch_release_unclaimed()
+	{
+		// The manifest lists dependencies for the root resource, but the root file is empty so its load fails and never
+		// requests them. Their prefetched data should be released once the root is done loading.
+		Path rootPath = mTestDirectory + "Root.asset";
+		Path depAPath = mTestDirectory + "DepA.asset";
+		Path depBPath = mTestDirectory + "DepB.asset";
+
+		createTestFile(rootPath, 0);
+		createTestFile(depAPath, 1024);
+		createTestFile(depBPath, 2048);
+
+		UUID root = UUIDGenerator::generateRandom();
+		UUID depA = UUIDGenerator::generateRandom();
+		UUID depB = UUIDGenerator::generateRandom();
+
+		SPtr<ResourceManifest> manifest = ResourceManifest::create("PrefetchTest");
+		manifest->registerResource(root, rootPath);
+		manifest->registerResource(depA, depAPath);
+		manifest->registerResource(depB, depBPath);
+		manifest->registerDependencies(root, { depA, depB }, 0);
+		manifest->registerDependencies(depA, {}, 1024);
+		manifest->registerDependencies(depB, {}, 2048);
+
+		gResources().registerResourceManifest(manifest);
+
+		{
+			// Reads are blocked on the file lock, so all of them are still in flight
+			Lock fileLock = FileScheduler::getLock(rootPath);
+			gResources().loadAsync(rootPath, ResourceLoadFlag::LoadDependencies);
+
+			BS_TEST_ASSERT(gResources().getResidencyStats().prefetchedMemoryUsage == 1024 + 2048);
+		}
+
+		for(UINT32 i = 0; i < 500; i++)
+		{
+			if (!gResources().isLoaded(root) && gResources().getResidencyStats().prefetchedMemoryUsage == 0)
+				break;
+
+			BS_THREAD_SLEEP(10);
+		}
+
+		BS_TEST_ASSERT(!gResources().isLoaded(root));
+		BS_TEST_ASSERT(!gResources().isLoaded(depA));
+		BS_TEST_ASSERT(!gResources().isLoaded(depB));
+		BS_TEST_ASSERT(gResources().getResidencyStats().prefetchedMemoryUsage == 0);
+
+		gResources().unregisterResourceManifest(manifest);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class ResourcesTestSuite : public TestSuite
+	{
+	public:
+		ResourcesTestSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testManifestDependencies();
+		void testManifestTransitiveDependencies();
+		void testManifestTransitiveDependencies_cycle();
+		void testPrefetch_release_unclaimed();
+
+		Path mTestDirectory;
+	};
+}
\ No newline at end of file
@@ -173,6 +173,20 @@ namespace bs
 		reportSample.numObjectsCreated = (UINT32)(sample.endStats.numObjectsCreated - sample.startStats.numObjectsCreated);
 		reportSample.numObjectsDestroyed = (UINT32)(sample.endStats.numObjectsDestroyed - sample.startStats.numObjectsDestroyed);
 
+		reportSample.numShadowMapCacheHits = (UINT32)(sample.endStats.numShadowMapCacheHits - sample.startStats.numShadowMapCacheHits);
+		reportSample.numShadowMapCacheMisses = (UINT32)(sample.endStats.numShadowMapCacheMisses - sample.startStats.numShadowMapCacheMisses);
+		reportSample.shadowMapCacheMemory = sample.endStats.shadowMapCacheMemory;
+
+		reportSample.numDrawCallsSavedByInstancing = (UINT32)(sample.endStats.numDrawCallsSavedByInstancing -
+			sample.startStats.numDrawCallsSavedByInstancing);
+
+		reportSample.resourcePoolMemory = sample.endStats.resourcePoolMemory;
+		reportSample.resourcePoolPeakUsedMemory = sample.endStats.resourcePoolPeakUsedMemory;
+		reportSample.numResourcePoolCreations = (UINT32)(sample.endStats.numResourcePoolCreations -
+			sample.startStats.numResourcePoolCreations);
+		reportSample.numResourcePoolReuses = (UINT32)(sample.endStats.numResourcePoolReuses -
+			sample.startStats.numResourcePoolReuses);
+
 		mFreeTimerQueries.push(sample.activeTimeQuery);
 		mFreeOcclusionQueries.push(sample.activeOcclusionQuery);
 	}
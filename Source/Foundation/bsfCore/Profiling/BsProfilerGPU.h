@@ -38,6 +38,17 @@ namespace bs
 
 		UINT32 numObjectsCreated; /**< How many GPU objects were created. */
 		UINT32 numObjectsDestroyed; /**< How many GPU objects were destroyed. */
+
+		UINT32 numShadowMapCacheHits; /**< How many shadow maps were re-used from the cache instead of being rendered. */
+		UINT32 numShadowMapCacheMisses; /**< How many cacheable shadow maps had to be rendered. */
+		UINT64 shadowMapCacheMemory; /**< GPU memory used by cached shadow maps at the end of the sample, in bytes. */
+
+		UINT32 numDrawCallsSavedByInstancing; /**< How many draw calls were merged into instanced draws. */
+
+		UINT64 resourcePoolMemory; /**< GPU memory used by pooled render textures and buffers, in bytes. */
+		UINT64 resourcePoolPeakUsedMemory; /**< Peak GPU memory used by pooled resources in the last frame, in bytes. */
+		UINT32 numResourcePoolCreations; /**< How many pooled render textures and buffers had to be created. */
+		UINT32 numResourcePoolReuses; /**< How many pooled render texture and buffer requests re-used existing ones. */
 	};
 
 	/** Profiler report containing information about GPU sampling data from a single frame. */
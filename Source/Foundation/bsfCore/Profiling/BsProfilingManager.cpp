@@ -29,6 +29,9 @@ namespace bs
 #if BS_PROFILING_ENABLED
 		mSavedSimReports[mNextSimReportIdx].cpuReport = gProfilerCPU().generateReport();
 
+		if(Resources::isStarted())
+			mSavedSimReports[mNextSimReportIdx].resourceStats = gResources().getResidencyStats();
+
 		gProfilerCPU().reset();
 
 		mNextSimReportIdx = (mNextSimReportIdx + 1) % NUM_SAVED_FRAMES;
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Profiling/BsProfilerCPU.h"
+#include "Resources/BsResources.h"
 
 namespace bs
 {
@@ -16,6 +17,7 @@ namespace bs
 	struct ProfilerReport
 	{
 		CPUProfilerReport cpuReport;
+		ResourceResidencyStats resourceStats; /**< Only available for the sim thread. */
 	};
 
 	/**	Type of thread used by the profiler. */
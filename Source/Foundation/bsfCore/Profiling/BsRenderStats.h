@@ -29,7 +29,9 @@ namespace bs
 		RenderStatsData()
 		: numDrawCalls(0), numComputeCalls(0), numRenderTargetChanges(0), numPresents(0), numClears(0)
 		, numVertices(0), numPrimitives(0), numPipelineStateChanges(0), numGpuParamBinds(0), numVertexBufferBinds(0)
-		, numIndexBufferBinds(0)
+		, numIndexBufferBinds(0), numShadowMapCacheHits(0), numShadowMapCacheMisses(0), shadowMapCacheMemory(0)
+		, numDrawCallsSavedByInstancing(0), resourcePoolMemory(0), resourcePoolPeakUsedMemory(0)
+		, numResourcePoolCreations(0), numResourcePoolReuses(0)
 		{ }
 
 		UINT64 numDrawCalls;
@@ -52,6 +54,17 @@ namespace bs
 
 		UINT64 numObjectsCreated; 
 		UINT64 numObjectsDestroyed;
+
+		UINT64 numShadowMapCacheHits;
+		UINT64 numShadowMapCacheMisses;
+		UINT64 shadowMapCacheMemory;
+
+		UINT64 numDrawCallsSavedByInstancing;
+
+		UINT64 resourcePoolMemory;
+		UINT64 resourcePoolPeakUsedMemory;
+		UINT64 numResourcePoolCreations;
+		UINT64 numResourcePoolReuses;
 	};
 
 	/**
@@ -137,6 +150,33 @@ namespace bs
 		 */
 		void incResWrite(UINT32 category) { mData.numResourceWrites++; }
 
+		/** Increments the counter of shadow maps that were re-used from the cache instead of being rendered. */
+		void incNumShadowMapCacheHits() { mData.numShadowMapCacheHits++; }
+
+		/** Increments the counter of cached shadow maps that had to be re-rendered because they were out of date. */
+		void incNumShadowMapCacheMisses() { mData.numShadowMapCacheMisses++; }
+
+		/** 
+		 * Adjusts the amount of GPU memory used by cached shadow maps, in bytes. Negative values should be provided 
+		 * when cached shadow maps are released. 
+		 */
+		void addShadowMapCacheMemory(INT64 bytes) { mData.shadowMapCacheMemory += (UINT64)bytes; }
+
+		/** Adds to the counter of draw calls that were avoided by rendering multiple objects in a single draw call. */
+		void addNumDrawCallsSavedByInstancing(UINT32 count) { mData.numDrawCallsSavedByInstancing += count; }
+
+		/** Sets the GPU memory used by all render textures and buffers pooled by the renderer, in bytes. */
+		void setResourcePoolMemory(UINT64 bytes) { mData.resourcePoolMemory = bytes; }
+
+		/** Sets the peak GPU memory used by pooled render textures and buffers during the last frame, in bytes. */
+		void setResourcePoolPeakUsedMemory(UINT64 bytes) { mData.resourcePoolPeakUsedMemory = bytes; }
+
+		/** Adds to the counter of pooled render textures and buffers that had to be created. */
+		void addNumResourcePoolCreations(UINT32 count) { mData.numResourcePoolCreations += count; }
+
+		/** Adds to the counter of requests for pooled render textures and buffers that re-used an existing one. */
+		void addNumResourcePoolReuses(UINT32 count) { mData.numResourcePoolReuses += count; }
+
 		/**
 		 * Returns an object containing various rendering statistics.
 		 *			
@@ -153,10 +193,12 @@ namespace bs
 	#define BS_INC_RENDER_STAT_CAT(Stat, Category) RenderStats::instance().inc##Stat((UINT32)Category)
 	#define BS_INC_RENDER_STAT(Stat) RenderStats::instance().inc##Stat()
 	#define BS_ADD_RENDER_STAT(Stat, Count) RenderStats::instance().add##Stat(Count)
+	#define BS_SET_RENDER_STAT(Stat, Value) RenderStats::instance().set##Stat(Value)
 #else
 	#define BS_INC_RENDER_STAT_CAT(Stat, Category)
 	#define BS_INC_RENDER_STAT(Stat)
 	#define BS_ADD_RENDER_STAT(Stat, Count)
+	#define BS_SET_RENDER_STAT(Stat, Value)
 #endif
 
 	/** @} */
@@ -130,6 +130,7 @@ namespace bs { namespace ct
 		}																													\
 																															\
 		SPtr<GpuParamBlockBuffer> createBuffer() const { return GpuParamBlockBuffer::create(mBlockSize); }					\
+		UINT32 getBufferSize() const { return mBlockSize; }																	\
 																															\
 	private:																												\
 		friend class ParamBlockManager;																						\
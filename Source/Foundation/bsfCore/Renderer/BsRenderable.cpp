@@ -419,7 +419,7 @@ namespace bs
 	namespace ct
 	{
 	Renderable::Renderable() 
-		:mRendererId(0), mAnimationId((UINT64)-1), mMorphShapeVersion(0)
+		:mRendererId(0), mAnimationId((UINT64)-1)
 	{
 	}
 
@@ -528,55 +528,6 @@ namespace bs
 		}
 		else
 			mMorphShapeBuffer = nullptr;
-
-		mMorphShapeVersion = 0;
-	}
-
-	void Renderable::updateAnimationBuffers(const EvaluatedAnimationData& animData)
-	{
-		if (mAnimationId == (UINT64)-1)
-			return;
-
-		const EvaluatedAnimationData::AnimInfo* animInfo = nullptr;
-
-		auto iterFind = animData.infos.find(mAnimationId);
-		if (iterFind != animData.infos.end())
-			animInfo = &iterFind->second;
-
-		if (animInfo == nullptr)
-			return;
-
-		if (mAnimType == RenderableAnimType::Skinned || mAnimType == RenderableAnimType::SkinnedMorph)
-		{
-			const EvaluatedAnimationData::PoseInfo& poseInfo = animInfo->poseInfo;
-
-			// Note: If multiple elements are using the same animation (not possible atm), this buffer should be shared by
-			// all such elements
-			UINT8* dest = (UINT8*)mBoneMatrixBuffer->lock(0, poseInfo.numBones * 3 * sizeof(Vector4), GBL_WRITE_ONLY_DISCARD);
-			for (UINT32 j = 0; j < poseInfo.numBones; j++)
-			{
-				const Matrix4& transform = animData.transforms[poseInfo.startIdx + j];
-				memcpy(dest, &transform, 12 * sizeof(float)); // Assuming row-major format
-
-				dest += 12 * sizeof(float);
-			}
-
-			mBoneMatrixBuffer->unlock();
-		}
-
-		if (mAnimType == RenderableAnimType::Morph || mAnimType == RenderableAnimType::SkinnedMorph)
-		{
-			if (mMorphShapeVersion != animInfo->morphShapeInfo.version)
-			{
-				SPtr<MeshData> meshData = animInfo->morphShapeInfo.meshData;
-
-				UINT32 bufferSize = meshData->getSize();
-				UINT8* data = meshData->getData();
-
-				mMorphShapeBuffer->writeData(0, bufferSize, data, BWT_DISCARD);
-				mMorphShapeVersion = animInfo->morphShapeInfo.version;
-			}
-		}
 	}
 
 	void Renderable::syncToCore(const CoreSyncData& data)
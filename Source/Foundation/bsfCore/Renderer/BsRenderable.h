@@ -12,8 +12,6 @@
 
 namespace bs
 {
-	struct EvaluatedAnimationData;
-
 	/** @addtogroup Implementation
 	 *  @{
 	 */
@@ -245,12 +243,6 @@ namespace bs
 		/** Returns the identifier of the animation, if this object is animated using skeleton or blend shape animation. */
 		UINT64 getAnimationId() const { return mAnimationId; }
 
-		/** 
-		 * Updates internal animation buffers from the contents of the provided animation data object. Does nothing if
-		 * renderable is not affected by animation.
-		 */
-		void updateAnimationBuffers(const EvaluatedAnimationData& animData);
-
 		/** Returns the GPU buffer containing element's bone matrices, if it has any. */
 		const SPtr<GpuBuffer>& getBoneMatrixBuffer() const { return mBoneMatrixBuffer; }
 
@@ -276,7 +268,6 @@ namespace bs
 
 		UINT32 mRendererId;
 		UINT64 mAnimationId;
-		UINT32 mMorphShapeVersion;
 
 		SPtr<GpuBuffer> mBoneMatrixBuffer;
 		SPtr<VertexBuffer> mMorphShapeBuffer;
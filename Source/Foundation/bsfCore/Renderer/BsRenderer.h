@@ -38,6 +38,22 @@ namespace bs
 		return variation;
 	}
 
+	/** 
+	 * Returns a vertex input shader variation used for rendering multiple instances of a non-animated mesh using a
+	 * single draw call. 
+	 */
+	static const ShaderVariation& getInstancedVertexInputVariation()
+	{
+		static ShaderVariation variation = ShaderVariation(
+		Vector<ShaderVariation::Param>{
+			ShaderVariation::Param("SKINNED", false),
+			ShaderVariation::Param("MORPH", false),
+			ShaderVariation::Param("INSTANCED", true),
+		});
+
+		return variation;
+	}
+
 	/** Returns a specific forward rendering shader variation. */
 	template<bool skinned, bool morph, bool clustered>
 	static const ShaderVariation& getForwardRenderingVariation()
@@ -262,6 +278,13 @@ namespace bs
 		 */
 		virtual void notifySkyboxRemoved(Skybox* skybox) { }
 
+		/**
+		 * Called whenever parameters of a material are synced from the simulation thread.
+		 *
+		 * @note	Core thread.
+		 */
+		virtual void notifyMaterialUpdated(Material* material) { }
+
 		/** 
 		 * Captures the scene at the specified location into a cubemap. 
 		 * 
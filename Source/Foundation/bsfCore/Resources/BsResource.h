@@ -49,6 +49,12 @@ namespace bs
 		 */
 		virtual bool isCompressible() const { return true; }
 
+		/** Returns the approximate amount of system memory used by the resource's data, in bytes. */
+		virtual UINT64 getCPUMemoryUsage() const { return 0; }
+
+		/** Returns the approximate amount of GPU memory allocated for the resource, in bytes. */
+		virtual UINT64 getGPUMemoryUsage() const { return 0; }
+
 		UINT32 mSize;
 		SPtr<ResourceMetaData> mMetaData;
 
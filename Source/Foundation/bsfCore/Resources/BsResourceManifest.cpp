@@ -62,6 +62,9 @@ namespace bs
 			mFilePathToUUID.erase(iterFind->second);
 			mUUIDToFilePath.erase(uuid);
 		}
+
+		mDependencies.erase(uuid);
+		mSizes.erase(uuid);
 	}
 
 	bool ResourceManifest::uuidToFilePath(const UUID& uuid, Path& filePath) const
@@ -110,6 +113,82 @@ namespace bs
 		return iterFind != mFilePathToUUID.end();
 	}
 
+	void ResourceManifest::registerDependencies(const UUID& uuid, const Vector<UUID>& dependencies, UINT64 size)
+	{
+		mDependencies[uuid] = dependencies;
+		mSizes[uuid] = size;
+	}
+
+	bool ResourceManifest::getDependencies(const UUID& uuid, Vector<UUID>& dependencies) const
+	{
+		auto iterFind = mDependencies.find(uuid);
+		if(iterFind == mDependencies.end())
+		{
+			dependencies.clear();
+			return false;
+		}
+
+		dependencies = iterFind->second;
+		return true;
+	}
+
+	bool ResourceManifest::getTransitiveDependencies(const UUID& uuid, Vector<UUID>& dependencies) const
+	{
+		dependencies.clear();
+
+		auto iterFind = mDependencies.find(uuid);
+		if(iterFind == mDependencies.end())
+			return false;
+
+		struct StackEntry
+		{
+			UUID uuid;
+			UINT32 nextChild;
+		};
+
+		// Iterative post-order traversal, so resources are output after all their dependencies, and cycles don't recurse
+		UnorderedSet<UUID> visited;
+		Vector<StackEntry> stack;
+
+		visited.insert(uuid);
+		stack.push_back({ uuid, 0 });
+
+		while(!stack.empty())
+		{
+			StackEntry& entry = stack.back();
+
+			const Vector<UUID>* children = nullptr;
+			auto iterChildren = mDependencies.find(entry.uuid);
+			if(iterChildren != mDependencies.end())
+				children = &iterChildren->second;
+
+			if(children != nullptr && entry.nextChild < (UINT32)children->size())
+			{
+				const UUID& child = (*children)[entry.nextChild++];
+				if(visited.insert(child).second)
+					stack.push_back({ child, 0 });
+
+				continue;
+			}
+
+			if(entry.uuid != uuid)
+				dependencies.push_back(entry.uuid);
+
+			stack.pop_back();
+		}
+
+		return true;
+	}
+
+	UINT64 ResourceManifest::getApproximateSize(const UUID& uuid) const
+	{
+		auto iterFind = mSizes.find(uuid);
+		if(iterFind != mSizes.end())
+			return iterFind->second;
+
+		return 0;
+	}
+
 	void ResourceManifest::save(const SPtr<ResourceManifest>& manifest, const Path& path, const Path& relativePath)
 	{
 		SPtr<ResourceManifest> copy = create(manifest->mName);
@@ -140,6 +219,9 @@ namespace bs
 			copy->mUUIDToFilePath[elem.first] = elementRelativePath;
 		}
 
+		copy->mDependencies = manifest->mDependencies;
+		copy->mSizes = manifest->mSizes;
+
 		FileEncoder fs(path);
 		fs.encode(copy.get());
 	}
@@ -163,6 +245,9 @@ namespace bs
 			copy->mUUIDToFilePath[elem.first] = absPath;
 		}
 
+		copy->mDependencies = manifest->mDependencies;
+		copy->mSizes = manifest->mSizes;
+
 		return copy;
 	}
 
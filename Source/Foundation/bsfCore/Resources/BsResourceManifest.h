@@ -55,6 +55,33 @@ namespace bs
 		/**	Checks if the provided path exists in the manifest. */
 		bool filePathExists(const Path& filePath) const;
 
+		/**
+		 * Records the direct dependencies of a resource, along with the approximate size of its file on disk. This allows
+		 * the resource system to determine the full dependency graph of a resource without having to read the resource
+		 * files.
+		 *
+		 * @param[in]	uuid			UUID of the resource to register the dependencies for.
+		 * @param[in]	dependencies	UUIDs of resources directly referenced by the resource.
+		 * @param[in]	size			Size of the resource file, in bytes.
+		 */
+		void registerDependencies(const UUID& uuid, const Vector<UUID>& dependencies, UINT64 size);
+
+		/** 
+		 * Outputs direct dependencies of the resource with the specified UUID. Returns false if no dependency information
+		 * was registered for the resource.
+		 */
+		bool getDependencies(const UUID& uuid, Vector<UUID>& dependencies) const;
+
+		/**
+		 * Outputs all direct and indirect dependencies of the resource with the specified UUID. Dependencies are output in
+		 * load order, meaning each resource appears after all of its own dependencies. The resource itself is not included
+		 * in the output. Returns false if no dependency information was registered for the resource.
+		 */
+		bool getTransitiveDependencies(const UUID& uuid, Vector<UUID>& dependencies) const;
+
+		/** Returns the approximate size of the resource file in bytes, or zero if not known. */
+		UINT64 getApproximateSize(const UUID& uuid) const;
+
 		/**
 		 * Saves the resource manifest to the specified location.
 		 *
@@ -80,6 +107,8 @@ namespace bs
 		String mName;
 		UnorderedMap<UUID, Path> mUUIDToFilePath;
 		UnorderedMap<Path, UUID> mFilePathToUUID;
+		UnorderedMap<UUID, Vector<UUID>> mDependencies;
+		UnorderedMap<UUID, UINT64> mSizes;
 
 		/************************************************************************/
 		/* 								RTTI		                     		*/
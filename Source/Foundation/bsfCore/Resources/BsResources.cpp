@@ -129,6 +129,7 @@ namespace bs
 			{
 				LoadedResourceData& resData = iterFind->second;
 				outputResource = resData.resource.lock();
+				markUsed(uuid, resData);
 
 				// Increase ref. count
 				if (loadFlags.isSet(ResourceLoadFlag::KeepInternalRef))
@@ -305,9 +306,16 @@ namespace bs
 				String fileName = filePath.getFilename();
 				String taskName = "Resource load: " + fileName;
 
+				// If the dependency graph is known, read files of the resource and all its dependencies up front, and 
+				// only deserialize once the file contents are in memory
+				SPtr<Task> readTask;
+				if (loadFlags.isSet(ResourceLoadFlag::LoadDependencies))
+					readTask = prefetch(uuid, filePath);
+
 				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
 				SPtr<Task> task = Task::create(taskName, 
-					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
+					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData), 
+					TaskPriority::Normal, readTask);
 				TaskScheduler::instance().addTask(task);
 			}
 		}
@@ -347,18 +355,29 @@ namespace bs
 
 	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData)
 	{
-		Lock fileLock = FileScheduler::getLock(filePath);
+		// Only hold the file lock while reading, deserialization can proceed in parallel with other reads
+		SPtr<DataStream> stream;
+		{
+			Lock fileLock = FileScheduler::getLock(filePath);
 
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
-		if (stream == nullptr)
-			return nullptr;
+			SPtr<DataStream> fileStream = FileSystem::openFile(filePath, true);
+			if (fileStream == nullptr)
+				return nullptr;
 
-		if (stream->size() > std::numeric_limits<UINT32>::max())
-		{
-			BS_EXCEPT(InternalErrorException,
-				"File size is larger that UINT32 can hold. Ask a programmer to use a bigger data type.");
+			if (fileStream->size() > std::numeric_limits<UINT32>::max())
+			{
+				BS_EXCEPT(InternalErrorException,
+					"File size is larger that UINT32 can hold. Ask a programmer to use a bigger data type.");
+			}
+
+			stream = bs_shared_ptr_new<MemoryDataStream>(fileStream);
 		}
 
+		return deserialize(stream, filePath, loadWithSaveData);
+	}
+
+	SPtr<Resource> Resources::deserialize(const SPtr<DataStream>& stream, const Path& filePath, bool loadWithSaveData)
+	{
 		UnorderedMap<String, UINT64> params;
 		if(loadWithSaveData)
 			params["keepSourceData"] = 1;
@@ -384,11 +403,12 @@ namespace bs
 				UINT32 objectSize = 0;
 				stream->read(&objectSize, sizeof(objectSize));
 
+				SPtr<DataStream> objStream = stream;
 				if (metaData->getCompressionMethod() != 0)
-					stream = Compression::decompress(stream);
+					objStream = Compression::decompress(objStream);
 
 				BinarySerializer bs;
-				loadedData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, params));
+				loadedData = std::static_pointer_cast<SavedResourceData>(bs.decode(objStream, objectSize, params));
 			}
 		}
 
@@ -406,6 +426,260 @@ namespace bs
 		return resource;
 	}
 
+	SPtr<Task> Resources::prefetch(const UUID& uuid, const Path& filePath)
+	{
+		// Resource is already queued as a part of another resource's dependency graph
+		{
+			Lock lock(mPrefetchMutex);
+
+			auto iterFind = mPrefetchedResources.find(uuid);
+			if (iterFind != mPrefetchedResources.end())
+			{
+				iterFind->second.isClaimed = true;
+				return iterFind->second.readTask;
+			}
+		}
+
+		Vector<UUID> dependencies;
+		Vector<UINT64> sizes;
+		if (!getTransitiveDependencies(uuid, dependencies, sizes))
+			return nullptr;
+
+		// The resource itself is read first, as its load is already waiting on the read
+		Vector<PrefetchData> toRead;
+		Vector<UUID> toReadUUIDs;
+
+		PrefetchData rootData;
+		rootData.filePath = filePath;
+		rootData.size = sizes.back();
+		rootData.isClaimed = true;
+		toRead.push_back(rootData);
+		toReadUUIDs.push_back(uuid);
+
+		// Followed by dependencies that aren't already loaded, or being loaded, in load order
+		for(UINT32 i = 0; i < (UINT32)dependencies.size(); i++)
+		{
+			if (isLoaded(dependencies[i], true))
+				continue;
+
+			PrefetchData prefetchData;
+			if (!getFilePathFromUUID(dependencies[i], prefetchData.filePath))
+				continue;
+
+			prefetchData.size = sizes[i];
+			toRead.push_back(prefetchData);
+			toReadUUIDs.push_back(dependencies[i]);
+		}
+
+		SPtr<Task> output;
+		{
+			Lock lock(mPrefetchMutex);
+
+			Vector<UUID>& group = mPrefetchGroups[uuid];
+			for(UINT32 i = 0; i < (UINT32)toRead.size(); i++)
+			{
+				const UUID& entryUUID = toReadUUIDs[i];
+				auto iterFind = mPrefetchedResources.find(entryUUID);
+				if (iterFind != mPrefetchedResources.end())
+				{
+					if(entryUUID == uuid)
+					{
+						iterFind->second.isClaimed = true;
+						output = iterFind->second.readTask;
+					}
+
+					continue;
+				}
+
+				PrefetchData& prefetchData = toRead[i];
+				prefetchData.owner = uuid;
+
+				String taskName = "Resource read: " + prefetchData.filePath.getFilename();
+				prefetchData.readTask = Task::create(taskName, std::bind(&Resources::prefetchCallback, this, entryUUID), 
+					TaskPriority::High);
+
+				if(entryUUID == uuid)
+					output = prefetchData.readTask;
+
+				mPrefetchedResources[entryUUID] = prefetchData;
+				mPendingPrefetchReads.push(entryUUID);
+				group.push_back(entryUUID);
+			}
+
+			issuePrefetchReads();
+		}
+
+		return output;
+	}
+
+	void Resources::issuePrefetchReads()
+	{
+		while(!mPendingPrefetchReads.empty() && mNumActivePrefetchReads < MAX_PREFETCH_READS)
+		{
+			const UUID& uuid = mPendingPrefetchReads.front();
+			PrefetchData& prefetchData = mPrefetchedResources[uuid];
+
+			// Discarded reads still need to run, as loads might be waiting on them, but they don't read anything
+			UINT64 size = prefetchData.discard ? 0 : prefetchData.size;
+
+			// Limit the amount of data being read or waiting in memory. A file larger than the limit can only be read
+			// once nothing else is held.
+			if(size > 0 && mNumPrefetchedBytes > 0 && (mNumPrefetchedBytes + size) > MAX_PREFETCH_BYTES)
+			{
+				// Nothing in flight to free up the memory, and data no load is going to claim won't be released before
+				// its graph is done loading, which might be waiting on this read. Drop such data to avoid a stall.
+				if(mNumActivePrefetchReads > 0 || !evictUnclaimedPrefetchedData())
+					break;
+
+				continue;
+			}
+
+			mNumActivePrefetchReads++;
+			mNumPrefetchedBytes += size;
+			prefetchData.numReservedBytes = size;
+
+			TaskScheduler::instance().addTask(prefetchData.readTask);
+			mPendingPrefetchReads.pop();
+		}
+	}
+
+	void Resources::prefetchCallback(const UUID& uuid)
+	{
+		Path filePath;
+		bool discard;
+		{
+			Lock lock(mPrefetchMutex);
+
+			const PrefetchData& prefetchData = mPrefetchedResources[uuid];
+			filePath = prefetchData.filePath;
+			discard = prefetchData.discard;
+		}
+
+		SPtr<DataStream> data;
+		if(!discard)
+		{
+			Lock fileLock = FileScheduler::getLock(filePath);
+
+			SPtr<DataStream> fileStream = FileSystem::openFile(filePath, true);
+			if (fileStream != nullptr && fileStream->size() <= std::numeric_limits<UINT32>::max())
+				data = bs_shared_ptr_new<MemoryDataStream>(fileStream);
+		}
+
+		{
+			Lock lock(mPrefetchMutex);
+
+			mNumActivePrefetchReads--;
+
+			auto iterFind = mPrefetchedResources.find(uuid);
+			PrefetchData& prefetchData = iterFind->second;
+
+			// Data was requested or released before the read was finished, or the read failed. In both cases the load
+			// will read the file on its own
+			if(prefetchData.discard || data == nullptr)
+			{
+				mNumPrefetchedBytes -= prefetchData.numReservedBytes;
+				mPrefetchedResources.erase(iterFind);
+			}
+			else
+				prefetchData.data = data;
+
+			issuePrefetchReads();
+		}
+	}
+
+	SPtr<DataStream> Resources::takePrefetchedData(const UUID& uuid)
+	{
+		Lock lock(mPrefetchMutex);
+
+		auto iterFind = mPrefetchedResources.find(uuid);
+		if (iterFind == mPrefetchedResources.end())
+			return nullptr;
+
+		SPtr<DataStream> output = iterFind->second.data;
+		evictPrefetchedData(iterFind);
+
+		issuePrefetchReads();
+		return output;
+	}
+
+	void Resources::releasePrefetchGroup(const UUID& uuid)
+	{
+		Lock lock(mPrefetchMutex);
+
+		auto iterFindGroup = mPrefetchGroups.find(uuid);
+		if (iterFindGroup == mPrefetchGroups.end())
+			return;
+
+		// Entries claimed by a load are released by that load. Anything else was never requested (e.g. the load failed,
+		// or the manifest lists a dependency the resource no longer has) and can be dropped now.
+		for(auto& entry : iterFindGroup->second)
+		{
+			auto iterFind = mPrefetchedResources.find(entry);
+			if (iterFind == mPrefetchedResources.end())
+				continue;
+
+			if (iterFind->second.owner == uuid && !iterFind->second.isClaimed)
+				evictPrefetchedData(iterFind);
+		}
+
+		mPrefetchGroups.erase(iterFindGroup);
+		issuePrefetchReads();
+	}
+
+	void Resources::evictPrefetchedData(UnorderedMap<UUID, PrefetchData>::iterator iter)
+	{
+		PrefetchData& prefetchData = iter->second;
+
+		// Read still queued or in progress, the entry will be removed once the read task runs
+		if(prefetchData.data == nullptr)
+		{
+			prefetchData.discard = true;
+			return;
+		}
+
+		mNumPrefetchedBytes -= prefetchData.numReservedBytes;
+		mPrefetchedResources.erase(iter);
+	}
+
+	bool Resources::evictUnclaimedPrefetchedData()
+	{
+		bool anyEvicted = false;
+		for(auto iter = mPrefetchedResources.begin(); iter != mPrefetchedResources.end();)
+		{
+			const PrefetchData& prefetchData = iter->second;
+			if (prefetchData.isClaimed || prefetchData.data == nullptr)
+			{
+				++iter;
+				continue;
+			}
+
+			mNumPrefetchedBytes -= prefetchData.numReservedBytes;
+			iter = mPrefetchedResources.erase(iter);
+			anyEvicted = true;
+		}
+
+		return anyEvicted;
+	}
+
+	bool Resources::getTransitiveDependencies(const UUID& uuid, Vector<UUID>& dependencies, Vector<UINT64>& sizes) const
+	{
+		// Default manifest is at 0th index but all other take priority since Default manifest could contain obsolete data
+		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter)
+		{
+			if(!(*iter)->getTransitiveDependencies(uuid, dependencies))
+				continue;
+
+			sizes.resize(dependencies.size() + 1);
+			for(UINT32 i = 0; i < (UINT32)dependencies.size(); i++)
+				sizes[i] = (*iter)->getApproximateSize(dependencies[i]);
+
+			sizes.back() = (*iter)->getApproximateSize(uuid);
+			return true;
+		}
+
+		return false;
+	}
+
 	void Resources::release(ResourceHandleBase& resource)
 	{
 		const UUID& uuid = resource.getUUID();
@@ -490,6 +764,123 @@ namespace bs
 			destroy(loadedResourcePair.second.resource);
 	}
 
+	void Resources::setMemoryBudget(UINT64 cpuBudget, UINT64 gpuBudget)
+	{
+		Lock lock(mLoadedResourceMutex);
+
+		mCPUMemoryBudget = cpuBudget;
+		mGPUMemoryBudget = gpuBudget;
+	}
+
+	ResourceResidencyStats Resources::getResidencyStats()
+	{
+		Lock lock(mLoadedResourceMutex);
+
+		ResourceResidencyStats stats;
+		stats.numLoadedResources = (UINT32)mLoadedResources.size();
+		stats.cpuMemoryUsage = mCPUMemoryUsage;
+		stats.gpuMemoryUsage = mGPUMemoryUsage;
+		stats.cpuMemoryBudget = mCPUMemoryBudget;
+		stats.gpuMemoryBudget = mGPUMemoryBudget;
+		stats.numEvictedResources = mNumEvictedResources;
+
+		{
+			Lock prefetchLock(mPrefetchMutex);
+			stats.prefetchedMemoryUsage = mNumPrefetchedBytes;
+		}
+
+		return stats;
+	}
+
+	void Resources::_update()
+	{
+		// Only a limited number of resources are checked per frame, so the cost stays bounded when most of the loaded
+		// resources are in use
+		for (UINT32 i = 0; i < MAX_EVICTION_CHECKS; i++)
+		{
+			UUID uuid;
+			HResource resource;
+			{
+				Lock lock(mLoadedResourceMutex);
+				if (!isOverMemoryBudget() || mLRU.empty())
+					break;
+
+				uuid = mLRU.front();
+
+				auto iterFind = mLoadedResources.find(uuid);
+				if (iterFind == mLoadedResources.end())
+				{
+					assert(false); // Every list entry should have a loaded resource, but fail silently in release mode
+					mLRU.pop_front();
+					continue;
+				}
+
+				LoadedResourceData& resData = iterFind->second;
+
+				// Resources referenced outside of the resource system are in use, so treat them as recently used
+				markUsed(uuid, resData);
+
+				std::uint32_t refCount = resData.resource.mData->mRefCount.load(std::memory_order_relaxed);
+				if (refCount != resData.numInternalRefs)
+					continue;
+
+				// Drop the internal references while still holding the lock, same as release(). Once the temporary 
+				// handle goes away the resource is destroyed, unless a load acquired a new reference in the meantime.
+				resource = resData.resource.lock();
+				while (resData.numInternalRefs > 0)
+				{
+					resData.numInternalRefs--;
+					resource.removeInternalRef();
+				}
+			}
+
+			resource = nullptr;
+
+			Lock lock(mLoadedResourceMutex);
+			if (mLoadedResources.find(uuid) == mLoadedResources.end())
+				mNumEvictedResources++;
+		}
+	}
+
+	void Resources::markUsed(const UUID& uuid, LoadedResourceData& resData)
+	{
+		if (resData.isInLRU)
+			mLRU.splice(mLRU.end(), mLRU, resData.lruIter);
+		else
+		{
+			resData.lruIter = mLRU.insert(mLRU.end(), uuid);
+			resData.isInLRU = true;
+		}
+	}
+
+	bool Resources::isOverMemoryBudget() const
+	{
+		bool overCPUBudget = mCPUMemoryBudget > 0 && mCPUMemoryUsage > mCPUMemoryBudget;
+		bool overGPUBudget = mGPUMemoryBudget > 0 && mGPUMemoryUsage > mGPUMemoryBudget;
+
+		return overCPUBudget || overGPUBudget;
+	}
+
+	void Resources::updateMemoryUsage(LoadedResourceData& resData, const SPtr<Resource>& resource)
+	{
+		mCPUMemoryUsage -= resData.cpuMemoryUsage;
+		mGPUMemoryUsage -= resData.gpuMemoryUsage;
+
+		if (resource != nullptr)
+		{
+			resData.cpuMemoryUsage = resource->getCPUMemoryUsage();
+			resData.gpuMemoryUsage = resource->getGPUMemoryUsage();
+		}
+		else
+		{
+			resData.cpuMemoryUsage = 0;
+			resData.gpuMemoryUsage = 0;
+		}
+
+		mCPUMemoryUsage += resData.cpuMemoryUsage;
+		mGPUMemoryUsage += resData.gpuMemoryUsage;
+	}
+
 	void Resources::destroy(ResourceHandleBase& resource)
 	{
 		if (resource.mData == nullptr)
@@ -534,6 +925,11 @@ namespace bs
 					resData.resource.removeInternalRef();
 				}
 
+				updateMemoryUsage(resData, nullptr);
+
+				if (resData.isInLRU)
+					mLRU.erase(resData.lruIter);
+
 				mLoadedResources.erase(iterFind);
 			}
 			else
@@ -664,6 +1060,9 @@ namespace bs
 			FileSystem::remove(filePath);
 			FileSystem::move(savePath, filePath);
 		}
+
+		mDefaultResourceManifest->registerDependencies(resource.getUUID(), dependencyUUIDs, 
+			FileSystem::getFileSize(filePath));
 	}
 
 	void Resources::save(const HResource& resource, bool compress)
@@ -688,7 +1087,12 @@ namespace bs
 			{
 				LoadedResourceData& resData = mLoadedResources[uuid];
 				resData.resource = handle.getWeak();
+				markUsed(uuid, resData);
+
+				updateMemoryUsage(resData, resource);
 			}
+			else
+				updateMemoryUsage(iterFind->second, resource);
 		}
 
 		onResourceModified(handle);
@@ -776,7 +1180,10 @@ namespace bs
 
 			LoadedResourceData& resData = mLoadedResources[UUID];
 			resData.resource = newHandle.getWeak();
+			markUsed(UUID, resData);
 			mHandles[UUID] = newHandle.getWeak();
+
+			updateMemoryUsage(resData, obj);
 		}
 
 		return newHandle;
@@ -859,7 +1266,14 @@ namespace bs
 				{
 					Lock loadedLock(mLoadedResourceMutex);
 
-					mLoadedResources[uuid] = myLoadData->resData;
+					LoadedResourceData& resData = mLoadedResources[uuid];
+					updateMemoryUsage(resData, nullptr);
+
+					resData.resource = myLoadData->resData.resource;
+					resData.numInternalRefs = myLoadData->resData.numInternalRefs;
+					markUsed(uuid, resData);
+					updateMemoryUsage(resData, myLoadData->loadedData);
+
 					resource.setHandleData(myLoadData->loadedData, uuid);
 				}
 
@@ -874,6 +1288,13 @@ namespace bs
 			loadComplete(dependant);
 		}
 
+		// Release any prefetched data that ended up not being used (e.g. if the load failed)
+		if (finishLoad)
+		{
+			takePrefetchedData(uuid);
+			releasePrefetchGroup(uuid);
+		}
+
 		if (finishLoad && myLoadData != nullptr)
 		{
 			onResourceLoaded(resource);
@@ -888,7 +1309,13 @@ namespace bs
 
 	void Resources::loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
 	{
-		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData);
+		SPtr<Resource> rawResource;
+
+		SPtr<DataStream> prefetchedData = takePrefetchedData(resource.getUUID());
+		if (prefetchedData != nullptr)
+			rawResource = deserialize(prefetchedData, filePath, loadWithSaveData);
+		else
+			rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData);
 
 		{
 			Lock lock(mInProgressResourcesMutex);
@@ -39,6 +39,31 @@ namespace bs
 	typedef Flags<ResourceLoadFlag> ResourceLoadFlags;
 	BS_FLAGS_OPERATORS(ResourceLoadFlag);
 
+	/** Information about memory used by resources currently loaded by the resource system. */
+	struct ResourceResidencyStats
+	{
+		/** Number of currently loaded resources. */
+		UINT32 numLoadedResources = 0;
+
+		/** Amount of system memory used by loaded resources, in bytes. */
+		UINT64 cpuMemoryUsage = 0;
+
+		/** Amount of GPU memory used by loaded resources, in bytes. */
+		UINT64 gpuMemoryUsage = 0;
+
+		/** Maximum amount of system memory loaded resources are allowed to use, in bytes. Zero if unlimited. */
+		UINT64 cpuMemoryBudget = 0;
+
+		/** Maximum amount of GPU memory loaded resources are allowed to use, in bytes. Zero if unlimited. */
+		UINT64 gpuMemoryBudget = 0;
+
+		/** Total number of resources that were unloaded in order to satisfy the memory budgets. */
+		UINT32 numEvictedResources = 0;
+
+		/** Amount of resource file data read ahead of deserialization, being read or waiting in memory, in bytes. */
+		UINT64 prefetchedMemoryUsage = 0;
+	};
+
 	/**
 	 * Manager for dealing with all engine resources. It allows you to save new resources and load existing ones.
 	 *
@@ -59,6 +84,11 @@ namespace bs
 
 			WeakResourceHandle<Resource> resource;
 			UINT32 numInternalRefs;
+			UINT64 cpuMemoryUsage = 0;
+			UINT64 gpuMemoryUsage = 0;
+
+			List<UUID>::iterator lruIter; /**< Entry in the least recently used list, valid if isInLRU is true. */
+			bool isInLRU = false;
 		};
 
 		/** Information about a resource that's currently being loaded. */
@@ -75,6 +105,19 @@ namespace bs
 			bool notifyImmediately;
 		};
 
+		/** Information about a resource file that is queued for reading, or has been read ahead of its deserialization. */
+		struct PrefetchData
+		{
+			Path filePath;
+			UINT64 size = 0;
+			SPtr<Task> readTask;
+			SPtr<DataStream> data;
+			UUID owner; /**< Resource whose dependency graph queued the read. */
+			UINT64 numReservedBytes = 0; /**< Bytes counted towards the prefetch limit, while reading or in memory. */
+			bool isClaimed = false; /**< True once a load of this resource has been started. */
+			bool discard = false;
+		};
+
 	public:
 		Resources();
 		~Resources();
@@ -165,6 +208,21 @@ namespace bs
 		/** Forces unload of all resources, whether they are being used or not. */
 		void unloadAll();
 
+		/**
+		 * Sets the maximum amount of memory that loaded resources are allowed to use. When the budget is exceeded, 
+		 * resources that aren't being referenced outside of the resource system are unloaded, least recently used ones 
+		 * first, until the memory usage falls below the budget.
+		 *
+		 * @param[in]	cpuBudget	Maximum amount of system memory to use, in bytes. Zero for unlimited.
+		 * @param[in]	gpuBudget	Maximum amount of GPU memory to use, in bytes. Zero for unlimited.
+		 *
+		 * @see		unloadAllUnused()
+		 */
+		void setMemoryBudget(UINT64 cpuBudget, UINT64 gpuBudget);
+
+		/** Returns information about the number of loaded resources and the memory they use. */
+		ResourceResidencyStats getResidencyStats();
+
 		/**
 		 * Saves the resource at the specified location.
 		 *
@@ -300,6 +358,15 @@ namespace bs
 		/** Returns an existing handle for the specified UUID if one exists, or creates a new one. */
 		HResource _getResourceHandle(const UUID& uuid);
 
+		/** 
+		 * Called once per frame. Unloads least recently used resources if loaded resources are over the memory budget.
+		 * Only resources without references outside of the resource system are unloaded, and only a limited number of
+		 * resources is checked per call.
+		 *
+		 * @note	Sim thread only.
+		 */
+		void _update();
+
 		/** @} */
 	private:
 		friend class ResourceHandleBase;
@@ -314,6 +381,57 @@ namespace bs
 		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
 		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData);
 
+		/** 
+		 * Deserializes a resource from a stream containing the entire contents of a resource file. Called from various
+		 * worker threads.
+		 */
+		SPtr<Resource> deserialize(const SPtr<DataStream>& stream, const Path& filePath, bool loadWithSaveData);
+
+		/** 
+		 * Queues file reads for the provided resource and all of its dependencies, as reported by the resource manifests.
+		 * The resource is read first, followed by its dependencies in load order so they are available for 
+		 * deserialization before the resources referencing them. Returns the task reading the file of the provided 
+		 * resource, or null if no read was queued. Reads queued for dependencies that don't end up being loaded are
+		 * released by releasePrefetchGroup().
+		 */
+		SPtr<Task> prefetch(const UUID& uuid, const Path& filePath);
+
+		/** 
+		 * Starts queued prefetch reads, as long as the number of reads in flight and the amount of data read are below
+		 * their limits. Caller must hold the prefetch mutex.
+		 */
+		void issuePrefetchReads();
+
+		/** Reads the entire resource file into memory. Executed as a task on a worker thread. */
+		void prefetchCallback(const UUID& uuid);
+
+		/** 
+		 * Returns the contents of a prefetched resource file and removes the prefetch entry. Returns null if no data was
+		 * prefetched. If the read is queued but hasn't started yet it will be canceled.
+		 */
+		SPtr<DataStream> takePrefetchedData(const UUID& uuid);
+
+		/** 
+		 * Releases prefetched data queued by prefetch() for the dependency graph of the provided resource, that no load
+		 * has claimed. Called once the resource is done loading, or its load failed.
+		 */
+		void releasePrefetchGroup(const UUID& uuid);
+
+		/** 
+		 * Removes a prefetch entry and its data, or cancels its read if still queued or in progress. Caller must hold
+		 * the prefetch mutex.
+		 */
+		void evictPrefetchedData(UnorderedMap<UUID, PrefetchData>::iterator iter);
+
+		/** 
+		 * Removes all prefetched data that no load has claimed. Returns true if anything was removed. Caller must hold
+		 * the prefetch mutex.
+		 */
+		bool evictUnclaimedPrefetchedData();
+
+		/** Returns the transitive dependencies of the resource, if any of the registered manifests contain them. */
+		bool getTransitiveDependencies(const UUID& uuid, Vector<UUID>& dependencies, Vector<UINT64>& sizes) const;
+
 		/**	Triggered when individual resource has finished loading. */
 		void loadComplete(HResource& resource);
 
@@ -323,6 +441,24 @@ namespace bs
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
 
+		/** 
+		 * Updates the memory usage of a loaded resource entry, and the total memory usage. Caller must hold the 
+		 * loaded resource mutex.
+		 */
+		void updateMemoryUsage(LoadedResourceData& resData, const SPtr<Resource>& resource);
+
+		/** 
+		 * Moves the resource to the end of the least recently used list, adding it to the list if needed. Caller must
+		 * hold the loaded resource mutex.
+		 */
+		void markUsed(const UUID& uuid, LoadedResourceData& resData);
+
+		/** 
+		 * Checks if the currently loaded resources use more memory than allowed by the memory budgets. Caller must hold
+		 * the loaded resource mutex.
+		 */
+		bool isOverMemoryBudget() const;
+
 	private:
 		Vector<SPtr<ResourceManifest>> mResourceManifests;
 		SPtr<ResourceManifest> mDefaultResourceManifest;
@@ -335,6 +471,25 @@ namespace bs
 		UnorderedMap<UUID, LoadedResourceData> mLoadedResources;
 		UnorderedMap<UUID, ResourceLoadData*> mInProgressResources; // Resources that are being asynchronously loaded
 		UnorderedMap<UUID, Vector<ResourceLoadData*>> mDependantLoads; // Allows dependency to be notified when a dependant is loaded
+
+		UINT64 mCPUMemoryBudget = 0;
+		UINT64 mGPUMemoryBudget = 0;
+		UINT64 mCPUMemoryUsage = 0;
+		UINT64 mGPUMemoryUsage = 0;
+		UINT32 mNumEvictedResources = 0;
+		List<UUID> mLRU; // Loaded resources, from least to most recently used
+
+		static constexpr UINT32 MAX_EVICTION_CHECKS = 64; // Maximum number of resources checked for eviction per frame
+
+		static constexpr UINT32 MAX_PREFETCH_READS = 4; // Maximum number of file reads in flight
+		static constexpr UINT64 MAX_PREFETCH_BYTES = 256 * 1024 * 1024; // Maximum amount of prefetched data waiting to be deserialized
+
+		Mutex mPrefetchMutex;
+		UnorderedMap<UUID, PrefetchData> mPrefetchedResources;
+		UnorderedMap<UUID, Vector<UUID>> mPrefetchGroups; // Reads queued by each resource's prefetch() call
+		Queue<UUID> mPendingPrefetchReads;
+		UINT32 mNumActivePrefetchReads = 0;
+		UINT64 mNumPrefetchedBytes = 0; // Bytes being read or waiting in memory
 	};
 
 	/** Provides easier access to Resources manager. */
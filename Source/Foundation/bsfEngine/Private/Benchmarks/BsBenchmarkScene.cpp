@@ -0,0 +1,54 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Benchmarks/BsBenchmarkScene.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	BenchmarkScene::BenchmarkScene(const String& name, UINT32 numObjects, UINT32 seed)
+		:mName(name), mRandomState(seed != 0 ? seed : DEFAULT_SEED)
+	{
+		// Keep around 64 cubic units of space per object
+		mExtent = 2.0f * std::cbrt((float)std::max(numObjects, 1U));
+
+		mObjects.resize(numObjects);
+		for (auto& object : mObjects)
+		{
+			object.position = Vector3(random(-mExtent, mExtent), random(-mExtent, mExtent), random(-mExtent, mExtent));
+
+			Vector3 axis(random(-1.0f, 1.0f), random(-1.0f, 1.0f), random(-1.0f, 1.0f));
+			if (axis.squaredLength() < 0.0001f)
+				axis = Vector3::UNIT_Y;
+
+			object.rotation = Quaternion(Vector3::normalize(axis), Radian(random(0.0f, Math::TWO_PI)));
+			object.scale = Vector3::ONE * random(0.5f, 2.0f);
+
+			AABox box(Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f));
+			box.transformAffine(Matrix4::TRS(object.position, object.rotation, object.scale));
+
+			object.bounds = Bounds(box, Sphere(box.getCenter(), box.getRadius()));
+			object.layer = 1ULL << (random() % NUM_LAYERS);
+			object.materialIdx = random() % NUM_MATERIALS;
+		}
+
+		// View placed on the edge of the scene, looking inwards, sees roughly half of the objects
+		mViewOrigin = Vector3(0.0f, 0.0f, mExtent);
+		mViewMatrix = Matrix4::view(mViewOrigin, Quaternion::IDENTITY);
+		mProjMatrix = Matrix4::projectionPerspective(Degree(90.0f), 16.0f / 9.0f, 0.05f, mExtent * 2.0f);
+	}
+
+	UINT32 BenchmarkScene::random()
+	{
+		mRandomState ^= mRandomState << 13;
+		mRandomState ^= mRandomState >> 17;
+		mRandomState ^= mRandomState << 5;
+
+		return mRandomState;
+	}
+
+	float BenchmarkScene::random(float min, float max)
+	{
+		float t = (random() >> 8) * (1.0f / 16777216.0f);
+		return min + (max - min) * t;
+	}
+}
@@ -0,0 +1,94 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "Math/BsBounds.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsVector3.h"
+#include "Math/BsQuaternion.h"
+
+namespace bs
+{
+	/** Describes a single object in a BenchmarkScene. */
+	struct BenchmarkSceneObject
+	{
+		Vector3 position;
+		Quaternion rotation;
+		Vector3 scale;
+
+		/** World space bounds of the object. */
+		Bounds bounds;
+
+		/** Layer bitfield of the object, with a single layer bit set. */
+		UINT64 layer;
+
+		/** Index of the material the object is rendered with, in range [0, BenchmarkScene::NUM_MATERIALS). */
+		UINT32 materialIdx;
+	};
+
+	/**
+	 * Procedurally generated scene used as a workload for benchmarks. Objects are randomly placed in a cube whose size
+	 * grows with the object count, so object density (and the portion of the scene visible to the view) stays the same
+	 * regardless of the scene scale. Generation is deterministic, and the same object count and seed will always result
+	 * in the same scene, so results can be compared between runs.
+	 */
+	class BenchmarkScene
+	{
+	public:
+		/**
+		 * Generates a new scene.
+		 *
+		 * @param[in]	name		Name of the scene scale, used for identifying results (e.g. "1k").
+		 * @param[in]	numObjects	Number of objects to generate.
+		 * @param[in]	seed		Seed used for the random generator.
+		 */
+		BenchmarkScene(const String& name, UINT32 numObjects, UINT32 seed = DEFAULT_SEED);
+
+		/** Returns the name of the scene scale. */
+		const String& getName() const { return mName; }
+
+		/** Returns the number of objects in the scene. */
+		UINT32 getNumObjects() const { return (UINT32)mObjects.size(); }
+
+		/** Returns all the objects in the scene. */
+		const Vector<BenchmarkSceneObject>& getObjects() const { return mObjects; }
+
+		/** Returns the half-size of the cube the objects are placed in. */
+		float getExtent() const { return mExtent; }
+
+		/** Returns the world position of the view the scene is observed from. */
+		const Vector3& getViewOrigin() const { return mViewOrigin; }
+
+		/** Returns the view matrix of the view the scene is observed from. */
+		const Matrix4& getViewMatrix() const { return mViewMatrix; }
+
+		/** Returns the projection matrix of the view the scene is observed from. */
+		const Matrix4& getProjectionMatrix() const { return mProjMatrix; }
+
+		/** Number of different materials assigned to the scene objects. */
+		static const UINT32 NUM_MATERIALS = 64;
+
+		/** Number of different layers assigned to the scene objects. */
+		static const UINT32 NUM_LAYERS = 4;
+
+		static const UINT32 DEFAULT_SEED = 0x9E3779B9;
+
+	private:
+		/** Returns the next random number in the sequence. Uses xorshift so the sequence is the same on all platforms. */
+		UINT32 random();
+
+		/** Returns a random number in the [min, max] range. */
+		float random(float min, float max);
+
+		String mName;
+		Vector<BenchmarkSceneObject> mObjects;
+		float mExtent = 0.0f;
+
+		Vector3 mViewOrigin;
+		Matrix4 mViewMatrix;
+		Matrix4 mProjMatrix;
+
+		UINT32 mRandomState;
+	};
+}
@@ -0,0 +1,175 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsApplication.h"
+#include "BsEngineConfig.h"
+#include "Testing/BsBenchmarkOutput.h"
+#include "Private/Benchmarks/BsBenchmarkScene.h"
+#include "Private/Benchmarks/BsImageBenchmarkSuite.h"
+#include "Private/Benchmarks/BsSerializationBenchmarkSuite.h"
+#include "Private/Benchmarks/BsCoreBenchmarkSuite.h"
+#include "Private/Benchmarks/BsRendererBenchmarkSuite.h"
+#include "Private/Benchmarks/BsGUIBenchmarkSuite.h"
+#include <iostream>
+
+using namespace bs;
+
+/**
+ * Runs the engine benchmarks headless, using the null render API. Scene-dependent benchmarks are ran once per
+ * requested scene scale.
+ *
+ * Usage: bsfBenchmarks [--scale 1k,100k,1M|all] [--iterations N] [--warmup N] [--filter name] [--output file.json]
+ *                      [--tag name]
+ */
+
+namespace
+{
+	/** Supported scene scales, and the number of objects in each. */
+	const std::pair<const char*, UINT32> SCENE_SCALES[] =
+	{
+		{ "1k", 1000 },
+		{ "100k", 100000 },
+		{ "1M", 1000000 }
+	};
+
+	/** Root suite containing all the engine benchmarks. */
+	class EngineBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		EngineBenchmarkSuite(const Vector<SPtr<BenchmarkScene>>& scenes)
+		{
+			add(BenchmarkSuite::create<ImageBenchmarkSuite>());
+
+			for (auto& scene : scenes)
+			{
+				add(BenchmarkSuite::create<SerializationBenchmarkSuite>(*scene));
+				add(BenchmarkSuite::create<CoreBenchmarkSuite>(*scene));
+				add(BenchmarkSuite::create<RendererBenchmarkSuite>(*scene));
+				add(BenchmarkSuite::create<GUIBenchmarkSuite>(*scene));
+			}
+		}
+	};
+
+	/** Outputs results to the console, and optionally to a JSON file. */
+	class EngineBenchmarkOutput : public BenchmarkOutput
+	{
+	public:
+		EngineBenchmarkOutput(const Path& jsonPath, const Map<String, String>& properties)
+		{
+			if (!jsonPath.isEmpty())
+				mJSONOutput = bs_shared_ptr_new<JSONBenchmarkOutput>(jsonPath, properties);
+		}
+
+		void outputResult(const BenchmarkResult& result) override
+		{
+			mConsoleOutput.outputResult(result);
+
+			if (mJSONOutput != nullptr)
+				mJSONOutput->outputResult(result);
+		}
+
+		void finish() override
+		{
+			if (mJSONOutput != nullptr)
+				mJSONOutput->finish();
+		}
+
+	private:
+		ConsoleBenchmarkOutput mConsoleOutput;
+		SPtr<JSONBenchmarkOutput> mJSONOutput;
+	};
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkSettings settings;
+	String scales = "1k,100k";
+	Path outputPath;
+	String tag;
+
+	for (int i = 1; i < argc; i++)
+	{
+		String arg = argv[i];
+		String value = (i + 1) < argc ? argv[i + 1] : "";
+
+		if (arg == "--scale")
+			scales = value;
+		else if (arg == "--iterations")
+			settings.numIterations = parseUINT32(value, settings.numIterations);
+		else if (arg == "--warmup")
+			settings.numWarmupIterations = parseUINT32(value, settings.numWarmupIterations);
+		else if (arg == "--filter")
+			settings.filter = value;
+		else if (arg == "--output")
+			outputPath = value;
+		else if (arg == "--tag")
+			tag = value;
+		else
+		{
+			std::cout << "Unknown argument: " << arg << std::endl;
+			return 1;
+		}
+
+		i++;
+	}
+
+	Vector<std::pair<String, UINT32>> sceneScales;
+	for (auto& scaleName : StringUtil::split(scales, ","))
+	{
+		bool found = false;
+		for (auto& entry : SCENE_SCALES)
+		{
+			if (scaleName == entry.first || scaleName == "all")
+			{
+				sceneScales.push_back(std::make_pair(String(entry.first), entry.second));
+				found = true;
+			}
+		}
+
+		if (!found)
+		{
+			std::cout << "Unknown scene scale: " << scaleName << ". Supported scales are 1k, 100k, 1M and all." <<
+				std::endl;
+			return 1;
+		}
+	}
+
+	START_UP_DESC desc;
+	desc.renderAPI = "bsfNullRenderAPI";
+	desc.renderer = BS_RENDERER_MODULE;
+	desc.audio = BS_AUDIO_MODULE;
+	desc.physics = BS_PHYSICS_MODULE;
+	desc.primaryWindowDesc.videoMode = VideoMode(1280, 720);
+	desc.primaryWindowDesc.title = "bsfBenchmarks";
+	desc.primaryWindowDesc.hidden = true;
+
+	Application::startUp(desc);
+	{
+		Vector<SPtr<BenchmarkScene>> scenes;
+		String sceneNames;
+		for (auto& entry : sceneScales)
+		{
+			scenes.push_back(bs_shared_ptr_new<BenchmarkScene>(entry.first, entry.second));
+
+			if (!sceneNames.empty())
+				sceneNames += ",";
+
+			sceneNames += entry.first;
+		}
+
+		Map<String, String> properties;
+		properties["tag"] = tag;
+		properties["scales"] = sceneNames;
+		properties["iterations"] = toString(settings.numIterations);
+		properties["warmup"] = toString(settings.numWarmupIterations);
+		properties["filter"] = settings.filter;
+
+		EngineBenchmarkSuite benchmarks(scenes);
+		EngineBenchmarkOutput output(outputPath, properties);
+
+		benchmarks.run(output, settings);
+		output.finish();
+	}
+	Application::shutDown();
+
+	return 0;
+}
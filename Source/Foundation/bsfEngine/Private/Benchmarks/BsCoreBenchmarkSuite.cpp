@@ -0,0 +1,132 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Benchmarks/BsCoreBenchmarkSuite.h"
+#include "Animation/BsAnimation.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationManager.h"
+#include "Animation/BsSkeleton.h"
+#include "Renderer/BsRenderable.h"
+#include "CoreThread/BsCoreThread.h"
+#include "CoreThread/BsCoreObjectManager.h"
+#include "Utility/BsTime.h"
+#include "Resources/BsResources.h"
+
+namespace bs
+{
+	/** Number of scene objects per animated object. */
+	static const UINT32 OBJECTS_PER_ANIMATION = 100;
+
+	/** Number of bones in each animated skeleton. */
+	static const UINT32 NUM_BONES = 64;
+
+	/** Length of the animation clip, in seconds, and the number of keyframes per second. */
+	static const float CLIP_LENGTH = 2.0f;
+	static const UINT32 CLIP_KEYS_PER_SECOND = 10;
+
+	CoreBenchmarkSuite::CoreBenchmarkSuite(const BenchmarkScene& scene)
+		:mScene(scene)
+	{
+		BS_ADD_BENCHMARK(CoreBenchmarkSuite::evaluateAnimation);
+		BS_ADD_BENCHMARK(CoreBenchmarkSuite::syncCoreObjects);
+	}
+
+	void CoreBenchmarkSuite::evaluateAnimation()
+	{
+		UINT32 numAnimations = std::max(mScene.getNumObjects() / OBJECTS_PER_ANIMATION, 1U);
+
+		// Skeleton is a simple chain of bones, and each bone has its own position and rotation curve
+		BONE_DESC bones[NUM_BONES];
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+
+		UINT32 numKeys = (UINT32)(CLIP_LENGTH * CLIP_KEYS_PER_SECOND) + 1;
+		for (UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			bones[i].name = "Bone" + toString(i);
+			bones[i].parent = i == 0 ? (UINT32)-1 : i - 1;
+			bones[i].localTfrm = Transform(Vector3(0.0f, 1.0f, 0.0f), Quaternion::IDENTITY, Vector3::ONE);
+			bones[i].invBindPose = Matrix4::IDENTITY;
+
+			Vector<TKeyframe<Vector3>> positionKeys(numKeys);
+			Vector<TKeyframe<Quaternion>> rotationKeys(numKeys);
+			for (UINT32 j = 0; j < numKeys; j++)
+			{
+				float time = j / (float)CLIP_KEYS_PER_SECOND;
+				float angle = Math::sin(time * Math::PI + i * 0.1f) * 0.5f;
+
+				positionKeys[j] = { Vector3(0.0f, 1.0f + angle * 0.1f, 0.0f), Vector3::ZERO, Vector3::ZERO, time };
+				rotationKeys[j] = { Quaternion(Vector3::UNIT_Z, Radian(angle)), Quaternion::ZERO, Quaternion::ZERO, time };
+			}
+
+			curves->addPositionCurve(bones[i].name, TAnimationCurve<Vector3>(positionKeys));
+			curves->addRotationCurve(bones[i].name, TAnimationCurve<Quaternion>(rotationKeys));
+		}
+
+		SPtr<Skeleton> skeleton = Skeleton::create(bones, NUM_BONES);
+		HAnimationClip clip = AnimationClip::create(curves, false, CLIP_KEYS_PER_SECOND);
+
+		Vector<SPtr<Animation>> animations(numAnimations);
+		for (UINT32 i = 0; i < numAnimations; i++)
+		{
+			animations[i] = Animation::create();
+			animations[i]->setSkeleton(skeleton);
+			animations[i]->setCulling(false);
+			animations[i]->play(clip);
+		}
+
+		// Evaluate on every call to update(), regardless of how little time has passed since the last call
+		AnimationManager::instance().setUpdateRate(std::numeric_limits<UINT32>::max());
+
+		measure(mScene.getName(), numAnimations * NUM_BONES, []()
+		{
+			AnimationManager::instance().update(false);
+		},
+		[]()
+		{
+			gTime()._update();
+		});
+
+		AnimationManager::instance().setUpdateRate(60);
+
+		animations.clear();
+		gResources().release(clip);
+	}
+
+	void CoreBenchmarkSuite::syncCoreObjects()
+	{
+		const Vector<BenchmarkSceneObject>& objects = mScene.getObjects();
+		UINT32 numObjects = (UINT32)objects.size();
+
+		Vector<SPtr<Renderable>> renderables(numObjects);
+		for (UINT32 i = 0; i < numObjects; i++)
+		{
+			renderables[i] = Renderable::create();
+			renderables[i]->setTransform(Transform(objects[i].position, objects[i].rotation, objects[i].scale));
+		}
+
+		// Flush object creation, so only the transform updates are measured
+		CoreObjectManager::instance().syncToCore();
+		gCoreThread().update();
+		gCoreThread().submitAll(true);
+
+		UINT32 frameIdx = 0;
+		measure(mScene.getName(), numObjects, []()
+		{
+			CoreObjectManager::instance().syncToCore();
+			gCoreThread().update();
+			gCoreThread().submitAll(true);
+		},
+		[&renderables, &objects, &frameIdx, numObjects]()
+		{
+			// Move every object, same as when the entire scene is animated
+			Vector3 offset(0.0f, (float)(++frameIdx % 2), 0.0f);
+			for (UINT32 i = 0; i < numObjects; i++)
+			{
+				renderables[i]->setTransform(
+					Transform(objects[i].position + offset, objects[i].rotation, objects[i].scale));
+			}
+		});
+
+		renderables.clear();
+		gCoreThread().submitAll(true);
+	}
+}
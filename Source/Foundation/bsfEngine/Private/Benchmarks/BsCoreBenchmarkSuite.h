@@ -0,0 +1,22 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsBenchmarkSuite.h"
+#include "Private/Benchmarks/BsBenchmarkScene.h"
+
+namespace bs
+{
+	/** Benchmarks for per-frame core systems: animation evaluation and core object sync. */
+	class CoreBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		CoreBenchmarkSuite(const BenchmarkScene& scene);
+
+	private:
+		void evaluateAnimation();
+		void syncCoreObjects();
+
+		const BenchmarkScene& mScene;
+	};
+}
@@ -0,0 +1,71 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Benchmarks/BsGUIBenchmarkSuite.h"
+#include "BsApplication.h"
+#include "Renderer/BsCamera.h"
+#include "RenderAPI/BsViewport.h"
+#include "GUI/BsGUIWidget.h"
+#include "GUI/BsGUIPanel.h"
+#include "GUI/BsGUILayoutX.h"
+#include "GUI/BsGUILayoutY.h"
+#include "GUI/BsGUILabel.h"
+#include "GUI/BsGUIButton.h"
+
+namespace bs
+{
+	/** Number of scene objects per GUI element. */
+	static const UINT32 OBJECTS_PER_ELEMENT = 100;
+
+	/** Number of elements in a single row of the layout. */
+	static const UINT32 ELEMENTS_PER_ROW = 4;
+
+	GUIBenchmarkSuite::GUIBenchmarkSuite(const BenchmarkScene& scene)
+		:mScene(scene)
+	{
+		BS_ADD_BENCHMARK(GUIBenchmarkSuite::updateLayout);
+	}
+
+	void GUIBenchmarkSuite::startUp()
+	{
+		mCamera = Camera::create();
+		mCamera->getViewport()->setTarget(gApplication().getPrimaryWindow());
+
+		mWidget = GUIWidget::create(mCamera);
+		mLayout = mWidget->getPanel()->addNewElement<GUILayoutY>();
+
+		// Rows of alternating labels and buttons, similar to an inspector window
+		mNumElements = std::max(mScene.getNumObjects() / OBJECTS_PER_ELEMENT, ELEMENTS_PER_ROW);
+
+		GUILayoutX* row = nullptr;
+		for (UINT32 i = 0; i < mNumElements; i++)
+		{
+			if ((i % ELEMENTS_PER_ROW) == 0)
+				row = mLayout->addNewElement<GUILayoutX>();
+
+			HString text(L"Element " + toWString(i));
+			if ((i % 2) == 0)
+				row->addElement(GUILabel::create(text));
+			else
+				row->addElement(GUIButton::create(text));
+		}
+	}
+
+	void GUIBenchmarkSuite::shutDown()
+	{
+		mWidget = nullptr;
+		mLayout = nullptr;
+		mCamera = nullptr;
+	}
+
+	void GUIBenchmarkSuite::updateLayout()
+	{
+		measure(mScene.getName(), mNumElements, [this]()
+		{
+			mWidget->_updateLayout();
+		},
+		[this]()
+		{
+			mLayout->_markLayoutAsDirty();
+		});
+	}
+}
@@ -0,0 +1,28 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsBenchmarkSuite.h"
+#include "Private/Benchmarks/BsBenchmarkScene.h"
+
+namespace bs
+{
+	/** Benchmarks for GUI layout. Number of GUI elements scales with the benchmark scene. */
+	class GUIBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		GUIBenchmarkSuite(const BenchmarkScene& scene);
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void updateLayout();
+
+		const BenchmarkScene& mScene;
+
+		SPtr<Camera> mCamera;
+		SPtr<GUIWidget> mWidget;
+		GUILayout* mLayout = nullptr;
+		UINT32 mNumElements = 0;
+	};
+}
@@ -0,0 +1,38 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Benchmarks/BsImageBenchmarkSuite.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+
+namespace bs
+{
+	/** Width and height of the images used for the pixel conversion benchmark, in pixels. */
+	static const UINT32 IMAGE_SIZE = 2048;
+
+	ImageBenchmarkSuite::ImageBenchmarkSuite()
+	{
+		BS_ADD_BENCHMARK(ImageBenchmarkSuite::convertPixels);
+	}
+
+	void ImageBenchmarkSuite::convertPixels()
+	{
+		SPtr<PixelData> rgba8 = PixelData::create(IMAGE_SIZE, IMAGE_SIZE, 1, PF_RGBA8);
+		SPtr<PixelData> bgra8 = PixelData::create(IMAGE_SIZE, IMAGE_SIZE, 1, PF_BGRA8);
+		SPtr<PixelData> rgba16f = PixelData::create(IMAGE_SIZE, IMAGE_SIZE, 1, PF_RGBA16F);
+		SPtr<PixelData> rgba32f = PixelData::create(IMAGE_SIZE, IMAGE_SIZE, 1, PF_RGBA32F);
+
+		// Deterministic noise, so the conversion can't take advantage of uniform data
+		UINT8* data = rgba8->getData();
+		UINT32 numBytes = IMAGE_SIZE * IMAGE_SIZE * 4;
+		for (UINT32 i = 0; i < numBytes; i++)
+			data[i] = (UINT8)((i * 2654435761U) >> 24);
+
+		PixelUtil::bulkPixelConversion(*rgba8, *rgba32f);
+
+		UINT32 numPixels = IMAGE_SIZE * IMAGE_SIZE;
+		measure("RGBA8ToBGRA8", numPixels, [&]() { PixelUtil::bulkPixelConversion(*rgba8, *bgra8); });
+		measure("RGBA8ToRGBA16F", numPixels, [&]() { PixelUtil::bulkPixelConversion(*rgba8, *rgba16f); });
+		measure("RGBA8ToRGBA32F", numPixels, [&]() { PixelUtil::bulkPixelConversion(*rgba8, *rgba32f); });
+		measure("RGBA32FToRGBA8", numPixels, [&]() { PixelUtil::bulkPixelConversion(*rgba32f, *rgba8); });
+	}
+}
@@ -0,0 +1,18 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** Benchmarks for image processing. Workloads are independent of the benchmark scene scale. */
+	class ImageBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		ImageBenchmarkSuite();
+
+	private:
+		void convertPixels();
+	};
+}
@@ -0,0 +1,122 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Benchmarks/BsRendererBenchmarkSuite.h"
+#include "Renderer/BsRenderQueue.h"
+#include "Material/BsMaterial.h"
+#include "Material/BsShader.h"
+#include "Material/BsTechnique.h"
+#include "Material/BsPass.h"
+#include "CoreThread/BsCoreThread.h"
+
+namespace bs
+{
+	/** Layers visible to the benchmark view. One of the scene layers is excluded so the layer test rejects objects. */
+	static const UINT64 VISIBLE_LAYERS = ~(1ULL << (BenchmarkScene::NUM_LAYERS - 1));
+
+	RendererBenchmarkSuite::RendererBenchmarkSuite(const BenchmarkScene& scene)
+		:mScene(scene)
+	{
+		BS_ADD_BENCHMARK(RendererBenchmarkSuite::cullScene);
+		BS_ADD_BENCHMARK(RendererBenchmarkSuite::sortRenderQueue);
+	}
+
+	void RendererBenchmarkSuite::startUp()
+	{
+		mWorldFrustum = ConvexVolume(mScene.getProjectionMatrix() * mScene.getViewMatrix());
+
+		// Materials are core thread objects, so create them there
+		gCoreThread().queueCommand([this]()
+		{
+			for (UINT32 i = 0; i < BenchmarkScene::NUM_MATERIALS; i++)
+			{
+				SPtr<ct::Pass> pass = ct::Pass::create(PASS_DESC());
+				SPtr<ct::Technique> technique = ct::Technique::create("Any", { pass });
+
+				ct::SHADER_DESC shaderDesc;
+				shaderDesc.queueSortType = QueueSortType::FrontToBack;
+				shaderDesc.queuePriority = (INT32)(i % 4);
+				shaderDesc.techniques.push_back(technique);
+
+				SPtr<ct::Shader> shader = ct::Shader::create("BenchmarkShader" + toString(i), shaderDesc);
+				mMaterials.push_back(ct::Material::create(shader));
+			}
+		}, CTQF_InternalQueue | CTQF_BlockUntilComplete);
+
+		mElements.resize(mScene.getNumObjects());
+		for (UINT32 i = 0; i < mScene.getNumObjects(); i++)
+			mElements[i].material = mMaterials[mScene.getObjects()[i].materialIdx];
+	}
+
+	void RendererBenchmarkSuite::shutDown()
+	{
+		mElements.clear();
+
+		gCoreThread().queueCommand([this]()
+		{
+			mMaterials.clear();
+		}, CTQF_InternalQueue | CTQF_BlockUntilComplete);
+	}
+
+	void RendererBenchmarkSuite::cullScene()
+	{
+		const Vector<BenchmarkSceneObject>& objects = mScene.getObjects();
+		UINT32 numObjects = (UINT32)objects.size();
+
+		// Mirrors RendererView::calculateVisibility(), which lives in the renderer plugin and can't be called directly
+		measure(mScene.getName(), numObjects, [this, &objects, numObjects]()
+		{
+			for (UINT32 i = 0; i < numObjects; i++)
+			{
+				if ((objects[i].layer & VISIBLE_LAYERS) == 0)
+					continue;
+
+				const Sphere& boundingSphere = objects[i].bounds.getSphere();
+				if (mWorldFrustum.intersects(boundingSphere))
+				{
+					const AABox& boundingBox = objects[i].bounds.getBox();
+					if (mWorldFrustum.intersects(boundingBox))
+						mVisibility[i] = true;
+				}
+			}
+		},
+		[this, numObjects]()
+		{
+			mVisibility.assign(numObjects, false);
+		});
+	}
+
+	void RendererBenchmarkSuite::sortRenderQueue()
+	{
+		const Vector<BenchmarkSceneObject>& objects = mScene.getObjects();
+		const Vector3& viewOrigin = mScene.getViewOrigin();
+
+		// Sort all objects, rather than just the visible ones, so the queue size matches the scene scale
+		Vector<float> distances(objects.size());
+		for (UINT32 i = 0; i < (UINT32)objects.size(); i++)
+			distances[i] = (viewOrigin - objects[i].bounds.getBox().getCenter()).length();
+
+		static const std::pair<ct::StateReduction, const char*> MODES[] =
+		{
+			{ ct::StateReduction::None, "None" },
+			{ ct::StateReduction::Material, "Material" },
+			{ ct::StateReduction::Distance, "Distance" }
+		};
+
+		for (auto& mode : MODES)
+		{
+			ct::RenderQueue queue(mode.first);
+
+			measure(mScene.getName() + "/" + mode.second, objects.size(), [&queue]()
+			{
+				queue.sort();
+			},
+			[this, &queue, &distances]()
+			{
+				queue.clear();
+
+				for (UINT32 i = 0; i < (UINT32)mElements.size(); i++)
+					queue.add(&mElements[i], distances[i]);
+			});
+		}
+	}
+}
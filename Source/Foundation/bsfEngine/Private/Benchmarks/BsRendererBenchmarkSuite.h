@@ -0,0 +1,31 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsBenchmarkSuite.h"
+#include "Private/Benchmarks/BsBenchmarkScene.h"
+#include "Renderer/BsRenderableElement.h"
+#include "Math/BsConvexVolume.h"
+
+namespace bs
+{
+	/** Benchmarks for the renderer's per-view CPU work: frustum culling and render queue sorting. */
+	class RendererBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		RendererBenchmarkSuite(const BenchmarkScene& scene);
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void cullScene();
+		void sortRenderQueue();
+
+		const BenchmarkScene& mScene;
+
+		ConvexVolume mWorldFrustum;
+		Vector<SPtr<ct::Material>> mMaterials;
+		Vector<ct::RenderableElement> mElements;
+		Vector<bool> mVisibility;
+	};
+}
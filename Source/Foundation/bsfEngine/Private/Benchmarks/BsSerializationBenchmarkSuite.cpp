@@ -0,0 +1,144 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Benchmarks/BsSerializationBenchmarkSuite.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsCompression.h"
+
+namespace bs
+{
+	/** Number of scene objects parented to each intermediate node of the hierarchy. */
+	static const UINT32 NUM_CHILDREN_PER_GROUP = 100;
+
+	SerializationBenchmarkSuite::SerializationBenchmarkSuite(const BenchmarkScene& scene)
+		:mScene(scene)
+	{
+		BS_ADD_BENCHMARK(SerializationBenchmarkSuite::encodeScene);
+		BS_ADD_BENCHMARK(SerializationBenchmarkSuite::decodeScene);
+		BS_ADD_BENCHMARK(SerializationBenchmarkSuite::compressScene);
+		BS_ADD_BENCHMARK(SerializationBenchmarkSuite::decompressScene);
+	}
+
+	void SerializationBenchmarkSuite::startUp()
+	{
+		// Objects are never instantiated, so they aren't part of the active scene and don't affect other benchmarks
+		mRoot = SceneObject::create("BenchmarkRoot", SOF_DontInstantiate);
+
+		HSceneObject group;
+		const Vector<BenchmarkSceneObject>& objects = mScene.getObjects();
+		for (UINT32 i = 0; i < (UINT32)objects.size(); i++)
+		{
+			if ((i % NUM_CHILDREN_PER_GROUP) == 0)
+			{
+				group = SceneObject::create("Group" + toString(i / NUM_CHILDREN_PER_GROUP), SOF_DontInstantiate);
+				group->setParent(mRoot, false);
+			}
+
+			HSceneObject so = SceneObject::create("Object" + toString(i), SOF_DontInstantiate);
+			so->setParent(group, false);
+			so->setPosition(objects[i].position);
+			so->setRotation(objects[i].rotation);
+			so->setScale(objects[i].scale);
+		}
+
+		MemorySerializer serializer;
+		mEncodedData = serializer.encode(mRoot.get(), mEncodedSize);
+	}
+
+	void SerializationBenchmarkSuite::shutDown()
+	{
+		if (mEncodedData != nullptr)
+		{
+			bs_free(mEncodedData);
+			mEncodedData = nullptr;
+		}
+
+		if (mRoot != nullptr)
+			mRoot->destroy(true);
+	}
+
+	void SerializationBenchmarkSuite::encodeScene()
+	{
+		UINT8* data = nullptr;
+
+		measure(mScene.getName(), mScene.getNumObjects(), [this, &data]()
+		{
+			UINT32 size = 0;
+
+			MemorySerializer serializer;
+			data = serializer.encode(mRoot.get(), size);
+		},
+		[&data]()
+		{
+			if (data != nullptr)
+			{
+				bs_free(data);
+				data = nullptr;
+			}
+		});
+
+		if (data != nullptr)
+			bs_free(data);
+	}
+
+	void SerializationBenchmarkSuite::decodeScene()
+	{
+		HSceneObject decodedRoot;
+
+		auto destroyDecoded = [&decodedRoot]()
+		{
+			if (decodedRoot != nullptr)
+				decodedRoot->destroy(true);
+
+			decodedRoot = HSceneObject();
+		};
+
+		measure(mScene.getName(), mScene.getNumObjects(), [this, &decodedRoot]()
+		{
+			MemorySerializer serializer;
+			SPtr<SceneObject> root = std::static_pointer_cast<SceneObject>(serializer.decode(mEncodedData, mEncodedSize));
+
+			decodedRoot = root->getHandle();
+		},
+		[&destroyDecoded]()
+		{
+			destroyDecoded();
+
+			// Same mode as used when cloning, so the decoded objects don't conflict with the originals
+			GameObjectManager::instance().setDeserializationMode(GODM_UseNewIds | GODM_RestoreExternal);
+		});
+
+		destroyDecoded();
+	}
+
+	void SerializationBenchmarkSuite::compressScene()
+	{
+		SPtr<DataStream> input = bs_shared_ptr_new<MemoryDataStream>(mEncodedData, mEncodedSize, false);
+
+		measure(mScene.getName(), mEncodedSize, [&input]()
+		{
+			Compression::compress(input);
+		},
+		[&input]()
+		{
+			input->seek(0);
+		});
+	}
+
+	void SerializationBenchmarkSuite::decompressScene()
+	{
+		SPtr<DataStream> input = bs_shared_ptr_new<MemoryDataStream>(mEncodedData, mEncodedSize, false);
+		SPtr<DataStream> compressed = Compression::compress(input);
+
+		measure(mScene.getName(), mEncodedSize, [&compressed]()
+		{
+			Compression::decompress(compressed);
+		},
+		[&compressed]()
+		{
+			compressed->seek(0);
+		});
+	}
+}
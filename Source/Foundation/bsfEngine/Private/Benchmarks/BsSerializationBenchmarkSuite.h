@@ -0,0 +1,34 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsBenchmarkSuite.h"
+#include "Private/Benchmarks/BsBenchmarkScene.h"
+#include "Scene/BsSceneObject.h"
+
+namespace bs
+{
+	/**
+	 * Benchmarks for binary serialization and compression. The workload is a scene object hierarchy matching the
+	 * benchmark scene, encoded the same way as prefabs and scene object clones are.
+	 */
+	class SerializationBenchmarkSuite : public BenchmarkSuite
+	{
+	public:
+		SerializationBenchmarkSuite(const BenchmarkScene& scene);
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void encodeScene();
+		void decodeScene();
+		void compressScene();
+		void decompressScene();
+
+		const BenchmarkScene& mScene;
+
+		HSceneObject mRoot;
+		UINT8* mEncodedData = nullptr;
+		UINT32 mEncodedSize = 0;
+	};
+}
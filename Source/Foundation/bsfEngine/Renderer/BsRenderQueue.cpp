@@ -24,6 +24,9 @@ namespace bs { namespace ct
 		mElements.clear();
 
 		mSortedRenderElements.clear();
+
+		mInstances.clear();
+		mNumMergedElements = 0;
 	}
 
 	void RenderQueue::add(RenderableElement* element, float distFromCamera)
@@ -146,6 +149,123 @@ namespace bs { namespace ct
 				numPassesInCurrentElement = 0;
 			}			
 		}
+
+		if (mInstancing)
+			mergeInstances();
+	}
+
+	void RenderQueue::mergeInstances()
+	{
+		mInstances.clear();
+		mNumMergedElements = 0;
+
+		UINT32 numElements = (UINT32)mSortedRenderElements.size();
+
+		mInstanceCandidates.clear();
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			if (mSortedRenderElements[i].renderElem->allowInstancing)
+				mInstanceCandidates.push_back(i);
+		}
+
+		auto isSameBatch = [this](UINT32 aIdx, UINT32 bIdx)
+		{
+			const RenderQueueElement& a = mSortedRenderElements[aIdx];
+			const RenderQueueElement& b = mSortedRenderElements[bIdx];
+
+			return a.renderElem->material == b.renderElem->material && a.renderElem->mesh == b.renderElem->mesh &&
+				a.passIdx == b.passIdx && a.renderElem->subMesh.indexOffset == b.renderElem->subMesh.indexOffset &&
+				a.renderElem->subMesh.indexCount == b.renderElem->subMesh.indexCount &&
+				a.renderElem->subMesh.drawOp == b.renderElem->subMesh.drawOp;
+		};
+
+		// Sort the candidates so that elements that can be merged end up next to each other, while preserving queue
+		// order within each batch
+		std::sort(mInstanceCandidates.begin(), mInstanceCandidates.end(), [this](UINT32 aIdx, UINT32 bIdx)
+		{
+			const RenderQueueElement& a = mSortedRenderElements[aIdx];
+			const RenderQueueElement& b = mSortedRenderElements[bIdx];
+
+			if (a.renderElem->material != b.renderElem->material)
+				return a.renderElem->material < b.renderElem->material;
+
+			if (a.renderElem->mesh != b.renderElem->mesh)
+				return a.renderElem->mesh < b.renderElem->mesh;
+
+			if (a.passIdx != b.passIdx)
+				return a.passIdx < b.passIdx;
+
+			const SubMesh& aSubMesh = a.renderElem->subMesh;
+			const SubMesh& bSubMesh = b.renderElem->subMesh;
+			if (aSubMesh.indexOffset != bSubMesh.indexOffset)
+				return aSubMesh.indexOffset < bSubMesh.indexOffset;
+
+			if (aSubMesh.indexCount != bSubMesh.indexCount)
+				return aSubMesh.indexCount < bSubMesh.indexCount;
+
+			if (aSubMesh.drawOp != bSubMesh.drawOp)
+				return aSubMesh.drawOp < bSubMesh.drawOp;
+
+			return aIdx < bIdx;
+		});
+
+		// Merge batches into their first element, and mark the rest for removal
+		UINT32 numCandidates = (UINT32)mInstanceCandidates.size();
+		for (UINT32 i = 0; i < numCandidates; )
+		{
+			UINT32 batchStart = i;
+			UINT32 firstIdx = mInstanceCandidates[batchStart];
+
+			i++;
+			while (i < numCandidates && isSameBatch(firstIdx, mInstanceCandidates[i]))
+				i++;
+
+			UINT32 numInstances = i - batchStart;
+			if (numInstances < 2)
+				continue;
+
+			RenderQueueElement& first = mSortedRenderElements[firstIdx];
+			first.firstInstance = (UINT32)mInstances.size();
+			first.numInstances = numInstances;
+
+			for (UINT32 j = batchStart; j < i; j++)
+				mInstances.push_back(mSortedRenderElements[mInstanceCandidates[j]].renderElem);
+
+			for (UINT32 j = batchStart + 1; j < i; j++)
+				mSortedRenderElements[mInstanceCandidates[j]].renderElem = nullptr;
+
+			mNumMergedElements += numInstances - 1;
+		}
+
+		if (mNumMergedElements == 0)
+			return;
+
+		// Remove merged elements. Pass needs to be re-applied if the previous element changed, or if either of the two
+		// elements is instanced, as instanced elements are rendered using a different pipeline.
+		UINT32 prevShaderId = (UINT32)-1;
+		UINT32 prevPassIdx = (UINT32)-1;
+		bool prevInstanced = false;
+		UINT32 numOutputElements = 0;
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			RenderQueueElement& elem = mSortedRenderElements[i];
+			if (elem.renderElem == nullptr)
+				continue;
+
+			UINT32 shaderId = elem.renderElem->material->getShader()->getId();
+			bool instanced = elem.numInstances > 1;
+
+			if (shaderId != prevShaderId || elem.passIdx != prevPassIdx || instanced || prevInstanced)
+				elem.applyPass = true;
+
+			prevShaderId = shaderId;
+			prevPassIdx = elem.passIdx;
+			prevInstanced = instanced;
+
+			mSortedRenderElements[numOutputElements++] = elem;
+		}
+
+		mSortedRenderElements.resize(numOutputElements);
 	}
 
 	bool RenderQueue::elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
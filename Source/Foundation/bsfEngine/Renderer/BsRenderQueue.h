@@ -26,12 +26,24 @@ namespace bs { namespace ct
 	struct BS_EXPORT RenderQueueElement
 	{
 		RenderQueueElement()
-			:renderElem(nullptr), passIdx(0), applyPass(true)
+			:renderElem(nullptr), passIdx(0), applyPass(true), firstInstance(0), numInstances(1)
 		{ }
 
 		RenderableElement* renderElem;
 		UINT32 passIdx;
 		bool applyPass;
+
+		/** 
+		 * Index of the first element in RenderQueue::getInstances() to render along with this element. Only relevant if
+		 * @p numInstances is larger than one.
+		 */
+		UINT32 firstInstance;
+
+		/** 
+		 * Number of elements to render using a single instanced draw call. If larger than one the elements can be found
+		 * in RenderQueue::getInstances(), starting at @p firstInstance. The first of those is always @p renderElem.
+		 */
+		UINT32 numInstances;
 	};
 
 	/**
@@ -78,7 +90,32 @@ namespace bs { namespace ct
 		 */
 		void setStateReduction(StateReduction mode) { mStateReductionMode = mode; }
 
+		/** 
+		 * Determines if elements that allow instancing, and share the same mesh, sub-mesh, material and pass should be 
+		 * merged into a single queue element that renders them all using an instanced draw call. The merged element
+		 * is placed where the first of the merged elements would have been.
+		 */
+		void setInstancing(bool enable) { mInstancing = enable; }
+
+		/** 
+		 * Returns a list of elements referenced by instanced queue elements, as returned by getSortedElements(). See 
+		 * RenderQueueElement::firstInstance. 
+		 */
+		const Vector<RenderableElement*>& getInstances() const { return mInstances; }
+
+		/** 
+		 * Returns the number of draw calls that were avoided when the queue was last sorted, by merging elements into
+		 * instanced draw calls. 
+		 */
+		UINT32 getNumMergedElements() const { return mNumMergedElements; }
+
 	protected:
+		/** 
+		 * Merges sorted elements that can be rendered using a single instanced draw call. Must be called after
+		 * the sorted element list has been populated. 
+		 */
+		void mergeInstances();
+
 		/**	Callback used for sorting elements with no material grouping. */
 		static bool elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
 
@@ -94,6 +131,11 @@ namespace bs { namespace ct
 
 		Vector<RenderQueueElement> mSortedRenderElements;
 		StateReduction mStateReductionMode;
+
+		bool mInstancing = false;
+		Vector<RenderableElement*> mInstances;
+		Vector<UINT32> mInstanceCandidates;
+		UINT32 mNumMergedElements = 0;
 	};
 
 	/** @} */
@@ -23,6 +23,12 @@ namespace bs { namespace ct
 
 		/**	Material to render the mesh with. */
 		SPtr<Material> material;
+
+		/** 
+		 * True if the element can be rendered together with other elements using the same mesh, sub-mesh and material,
+		 * using a single instanced draw call. Only relevant for render queues with instancing enabled.
+		 */
+		bool allowInstancing = false;
 	};
 
 	/** @} */
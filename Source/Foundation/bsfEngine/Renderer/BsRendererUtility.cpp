@@ -408,7 +408,12 @@ namespace bs { namespace ct
 			}
 		}
 		else
-			return get(getVariation<1, true>());
+		{
+			if(isColor)
+				return get(getVariation<1, true>());
+			else
+				return get(getVariation<1, false>());
+		}
 	}
 
 	ClearParamDef gClearParamDef;
@@ -45,9 +45,10 @@ namespace bs { namespace ct
 		 * @param	msaaCount		Number of MSAA samples in the input texture. If larger than 1 the texture will be resolved
 		 *							before written to the destination.
 		 * @param	isColor			If true the input is assumed to be a 4-component color texture. If false it is assumed
-		 *							the input is a 1-component depth texture. This controls how is the texture resolve and is
-		 *							only relevant if @p msaaCount > 1. Color texture MSAA samples will be averaged, while for
-		 *							depth textures the minimum of all samples will be used.
+		 *							the input is a 1-component depth texture, which will be written to the depth buffer.
+		 *							This also controls how is the texture resolved if @p msaaCount > 1. Color texture
+		 *							MSAA samples will be averaged, while for depth textures the minimum of all samples
+		 *							will be used.
 		 */
 		static BlitMat* getVariation(UINT32 msaaCount, bool isColor);
 	private:
@@ -172,12 +172,16 @@ set(BS_UTILITY_INC_TESTING
 	"bsfUtility/Testing/BsTestSuite.h"
 	"bsfUtility/Testing/BsTestOutput.h"
 	"bsfUtility/Testing/BsConsoleTestOutput.h"
+	"bsfUtility/Testing/BsBenchmarkSuite.h"
+	"bsfUtility/Testing/BsBenchmarkOutput.h"
 )
 
 set(BS_UTILITY_SRC_TESTING
 	"bsfUtility/Testing/BsTestSuite.cpp"
 	"bsfUtility/Testing/BsTestOutput.cpp"
 	"bsfUtility/Testing/BsConsoleTestOutput.cpp"
+	"bsfUtility/Testing/BsBenchmarkSuite.cpp"
+	"bsfUtility/Testing/BsBenchmarkOutput.cpp"
 )
 
 set(BS_UTILITY_SRC_SERIALIZATION
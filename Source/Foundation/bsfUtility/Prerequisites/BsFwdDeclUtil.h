@@ -81,6 +81,8 @@ namespace bs
 	class HThread;
 	class TestSuite;
 	class TestOutput;
+	class BenchmarkSuite;
+	class BenchmarkOutput;
 	class AsyncOpSyncData;
 	struct RTTIField;
 	struct RTTIReflectablePtrFieldBase;
@@ -69,7 +69,7 @@
  */
 
 /** @defgroup Testing Testing
- *  Running unit tests.
+ *  Running unit tests and performance benchmarks.
  */
 
 /** @defgroup Threading Threading
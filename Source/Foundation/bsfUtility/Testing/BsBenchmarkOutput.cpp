@@ -0,0 +1,78 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsBenchmarkOutput.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Debug/BsDebug.h"
+#include "ThirdParty/json.hpp"
+
+#include <iostream>
+#include <iomanip>
+
+using json = nlohmann::json;
+
+namespace bs
+{
+	void ConsoleBenchmarkOutput::outputResult(const BenchmarkResult& result)
+	{
+		std::cout << std::fixed << std::setprecision(3) << result.name << ": median " << result.median << " ms, p90 " <<
+			result.p90 << " ms, p99 " << result.p99 << " ms, min " << result.min << " ms, max " << result.max << " ms";
+
+		if (result.numItems > 0 && result.median > 0.0)
+		{
+			double itemsPerSecond = result.numItems / (result.median / 1000.0);
+			std::cout << ", " << std::setprecision(0) << itemsPerSecond << " items/s";
+		}
+
+		std::cout << std::defaultfloat << std::endl;
+	}
+
+	JSONBenchmarkOutput::JSONBenchmarkOutput(const Path& path, const Map<String, String>& properties)
+		:mPath(path), mProperties(properties)
+	{ }
+
+	void JSONBenchmarkOutput::outputResult(const BenchmarkResult& result)
+	{
+		mResults.push_back(result);
+	}
+
+	void JSONBenchmarkOutput::finish()
+	{
+		json propertiesJSON = json::object();
+		for (auto& entry : mProperties)
+			propertiesJSON[entry.first.c_str()] = entry.second.c_str();
+
+		json resultsJSON = json::array();
+		for (auto& result : mResults)
+		{
+			json resultJSON;
+			resultJSON["name"] = result.name.c_str();
+			resultJSON["iterations"] = result.numIterations;
+			resultJSON["items"] = result.numItems;
+			resultJSON["min"] = result.min;
+			resultJSON["max"] = result.max;
+			resultJSON["mean"] = result.mean;
+			resultJSON["median"] = result.median;
+			resultJSON["p90"] = result.p90;
+			resultJSON["p99"] = result.p99;
+			resultJSON["stdDev"] = result.stdDev;
+
+			resultsJSON.push_back(resultJSON);
+		}
+
+		json outputJSON;
+		outputJSON["properties"] = propertiesJSON;
+		outputJSON["results"] = resultsJSON;
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(mPath);
+		if (stream == nullptr)
+		{
+			LOGERR("Unable to write benchmark results to: " + mPath.toString());
+			return;
+		}
+
+		String jsonString = outputJSON.dump(4).c_str();
+		stream->writeString(jsonString);
+		stream->close();
+	}
+}
@@ -0,0 +1,64 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Testing/BsBenchmarkSuite.h"
+
+namespace bs
+{
+	/** @addtogroup Testing
+	 *  @{
+	 */
+
+	/** Abstract interface used for outputting benchmark results. */
+	class BS_UTILITY_EXPORT BenchmarkOutput
+	{
+	public:
+		virtual ~BenchmarkOutput() = default;
+
+		/** Triggered when a benchmark completes measuring a case. */
+		virtual void outputResult(const BenchmarkResult& result) = 0;
+
+		/** Triggered after all benchmarks have been ran. */
+		virtual void finish() { }
+	};
+
+	/** Outputs benchmark results to stdout, one line per result. */
+	class BS_UTILITY_EXPORT ConsoleBenchmarkOutput : public BenchmarkOutput
+	{
+	public:
+		/** @copydoc BenchmarkOutput::outputResult */
+		void outputResult(const BenchmarkResult& result) override;
+	};
+
+	/**
+	 * Collects benchmark results and writes them to a JSON file when finished, so they can be compared between runs.
+	 * Output contains a "properties" object with user-provided information about the run (e.g. commit or machine name),
+	 * and a "results" array with an entry per result.
+	 */
+	class BS_UTILITY_EXPORT JSONBenchmarkOutput : public BenchmarkOutput
+	{
+	public:
+		/**
+		 * Creates a new JSON output.
+		 *
+		 * @param[in]	path		Path to the file to write the results to. Existing file will be overwritten.
+		 * @param[in]	properties	Additional information about the run to write in the output file.
+		 */
+		JSONBenchmarkOutput(const Path& path, const Map<String, String>& properties = Map<String, String>());
+
+		/** @copydoc BenchmarkOutput::outputResult */
+		void outputResult(const BenchmarkResult& result) override;
+
+		/** @copydoc BenchmarkOutput::finish */
+		void finish() override;
+
+	private:
+		Path mPath;
+		Map<String, String> mProperties;
+		Vector<BenchmarkResult> mResults;
+	};
+
+	/** @} */
+}
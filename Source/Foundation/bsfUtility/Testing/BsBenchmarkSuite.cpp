@@ -0,0 +1,129 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsBenchmarkSuite.h"
+#include "Testing/BsBenchmarkOutput.h"
+#include "Utility/BsTimer.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	BenchmarkSuite::BenchmarkEntry::BenchmarkEntry(Func benchmark, const String& name)
+		:benchmark(benchmark), name(name)
+	{ }
+
+	void BenchmarkSuite::run(BenchmarkOutput& output, const BenchmarkSettings& settings)
+	{
+		mOutput = &output;
+		mSettings = &settings;
+
+		Vector<BenchmarkEntry*> activeBenchmarks;
+		for (auto& entry : mBenchmarks)
+		{
+			if (settings.filter.empty() || entry.name.find(settings.filter) != String::npos)
+				activeBenchmarks.push_back(&entry);
+		}
+
+		// Suite set-up can be expensive (e.g. generating large scenes), so skip it if there is nothing to run
+		if (!activeBenchmarks.empty())
+		{
+			startUp();
+
+			for (auto& entry : activeBenchmarks)
+			{
+				mActiveBenchmarkName = entry->name;
+
+				(this->*(entry->benchmark))();
+			}
+		}
+
+		for (auto& suite : mSuites)
+			suite->run(output, settings);
+
+		if (!activeBenchmarks.empty())
+			shutDown();
+	}
+
+	void BenchmarkSuite::add(const SPtr<BenchmarkSuite>& suite)
+	{
+		mSuites.push_back(suite);
+	}
+
+	void BenchmarkSuite::addBenchmark(Func benchmark, const String& name)
+	{
+		mBenchmarks.push_back(BenchmarkEntry(benchmark, name));
+	}
+
+	void BenchmarkSuite::measure(const String& name, UINT64 numItems, const std::function<void()>& func,
+		const std::function<void()>& prepare)
+	{
+		for (UINT32 i = 0; i < mSettings->numWarmupIterations; i++)
+		{
+			if (prepare)
+				prepare();
+
+			func();
+		}
+
+		UINT32 numIterations = std::max(mSettings->numIterations, 1U);
+
+		Vector<double> times;
+		times.reserve(numIterations);
+
+		Timer timer;
+		for (UINT32 i = 0; i < numIterations; i++)
+		{
+			if (prepare)
+				prepare();
+
+			timer.reset();
+			func();
+
+			times.push_back(timer.getMicroseconds() / 1000.0);
+		}
+
+		BenchmarkResult result = calculateResult(times);
+		result.name = name.empty() ? mActiveBenchmarkName : mActiveBenchmarkName + "/" + name;
+		result.numItems = numItems;
+
+		mOutput->outputResult(result);
+	}
+
+	BenchmarkResult BenchmarkSuite::calculateResult(Vector<double>& times)
+	{
+		BenchmarkResult result;
+		if (times.empty())
+			return result;
+
+		std::sort(times.begin(), times.end());
+
+		UINT32 count = (UINT32)times.size();
+
+		// Nearest-rank percentile
+		auto percentile = [&times, count](double p)
+		{
+			UINT32 rank = (UINT32)std::ceil(p * count);
+			return times[Math::clamp(rank, 1U, count) - 1];
+		};
+
+		double sum = 0.0;
+		for (auto& time : times)
+			sum += time;
+
+		double mean = sum / count;
+
+		double variance = 0.0;
+		for (auto& time : times)
+			variance += (time - mean) * (time - mean);
+
+		result.numIterations = count;
+		result.min = times.front();
+		result.max = times.back();
+		result.mean = mean;
+		result.median = (count % 2) != 0 ? times[count / 2] : (times[count / 2 - 1] + times[count / 2]) * 0.5;
+		result.p90 = percentile(0.90);
+		result.p99 = percentile(0.99);
+		result.stdDev = std::sqrt(variance / count);
+
+		return result;
+	}
+}
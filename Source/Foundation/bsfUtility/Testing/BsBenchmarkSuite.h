@@ -0,0 +1,142 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Testing
+	 *  @{
+	 */
+
+	/** Controls how are benchmarks in a BenchmarkSuite executed. */
+	struct BenchmarkSettings
+	{
+		/** Number of times to run each benchmark before measuring, in order to warm up caches and allocators. */
+		UINT32 numWarmupIterations = 2;
+
+		/** Number of measured runs of each benchmark. Statistics are calculated over all of the measured runs. */
+		UINT32 numIterations = 10;
+
+		/**
+		 * If not empty, only benchmarks whose name contains this string will be ran. Benchmark names are in
+		 * "Suite::benchmark" format.
+		 */
+		String filter;
+	};
+
+	/** Contains timing statistics for a single measured benchmark. All times are in milliseconds. */
+	struct BenchmarkResult
+	{
+		/** Unique name of the benchmark, in "Suite::benchmark/case" format. */
+		String name;
+
+		/** Number of measured iterations the statistics were calculated from. */
+		UINT32 numIterations = 0;
+
+		/** Number of items (e.g. objects, bytes) processed by a single iteration. Used for reporting throughput. */
+		UINT64 numItems = 0;
+
+		double min = 0.0;
+		double max = 0.0;
+		double mean = 0.0;
+		double median = 0.0;
+		double p90 = 0.0;
+		double p99 = 0.0;
+		double stdDev = 0.0;
+	};
+
+	/**
+	 * Primary class for performance benchmarking. Override and register benchmarks in the constructor, then run the
+	 * benchmarks using the desired method of output. Each registered benchmark can measure one or multiple cases by
+	 * calling measure().
+	 */
+	class BS_UTILITY_EXPORT BenchmarkSuite
+	{
+	public:
+		typedef void(BenchmarkSuite::*Func)();
+
+	private:
+		/** Contains data about a single benchmark. */
+		struct BenchmarkEntry
+		{
+			BenchmarkEntry(Func benchmark, const String& name);
+
+			Func benchmark;
+			String name;
+		};
+
+	public:
+		virtual ~BenchmarkSuite() = default;
+
+		/**
+		 * Runs all the benchmarks in the suite (and sub-suites). Results are reported to the provided output class as
+		 * each benchmark completes.
+		 */
+		void run(BenchmarkOutput& output, const BenchmarkSettings& settings);
+
+		/** Adds a new child suite to this suite. This method allows you to group suites and execute them all at once. */
+		void add(const SPtr<BenchmarkSuite>& suite);
+
+		/**	Creates a new suite of a particular type. Any provided arguments are forwarded to the suite's constructor. */
+		template <class T, class... Args>
+		static SPtr<BenchmarkSuite> create(Args&&... args)
+		{
+			static_assert((std::is_base_of<BenchmarkSuite, T>::value),
+				"Invalid benchmark suite type. It needs to derive from bs::BenchmarkSuite.");
+
+			return std::static_pointer_cast<BenchmarkSuite>(bs_shared_ptr_new<T>(std::forward<Args>(args)...));
+		}
+
+	protected:
+		BenchmarkSuite() = default;
+
+		/** Called right before any benchmarks are ran. Not called if all the benchmarks in the suite are filtered out. */
+		virtual void startUp() {}
+
+		/**	Called after all benchmarks and child suite's benchmarks are ran. */
+		virtual void shutDown() {}
+
+		/**
+		 * Register a new benchmark.
+		 *
+		 * @param[in]	benchmark	Function to call in order to execute the benchmark.
+		 * @param[in]	name		Name of the benchmark we can use for referencing it later.
+		 */
+		void addBenchmark(Func benchmark, const String& name);
+
+		/**
+		 * Measures the execution time of the provided function, and reports the results to the active output. Must only
+		 * be called from within a registered benchmark.
+		 *
+		 * @param[in]	name		Name of the measured case, appended to the benchmark name when reporting. Can be
+		 *							empty if the benchmark only measures a single case.
+		 * @param[in]	numItems	Number of items processed by a single call to @p func, used for reporting throughput.
+		 * @param[in]	func		Function to measure. Called once per warm-up and measured iteration.
+		 * @param[in]	prepare		Optional function to call before every call to @p func, whose execution time is not
+		 *							measured. Use it for restoring any state that @p func modifies.
+		 */
+		void measure(const String& name, UINT64 numItems, const std::function<void()>& func,
+			const std::function<void()>& prepare = nullptr);
+
+		/** Returns the settings the suite is currently being ran with. */
+		const BenchmarkSettings& getSettings() const { return *mSettings; }
+
+		/** Calculates timing statistics from a set of per-iteration times, in milliseconds. */
+		static BenchmarkResult calculateResult(Vector<double>& times);
+
+		Vector<BenchmarkEntry> mBenchmarks;
+		Vector<SPtr<BenchmarkSuite>> mSuites;
+
+		// Transient
+		BenchmarkOutput* mOutput = nullptr;
+		const BenchmarkSettings* mSettings = nullptr;
+		String mActiveBenchmarkName;
+	};
+
+/** Registers a new benchmark within an implementation of BenchmarkSuite. */
+#define BS_ADD_BENCHMARK(func) addBenchmark(static_cast<Func>(&func), #func);
+
+	/** @} */
+}
@@ -5,6 +5,28 @@
 
 namespace bs
 {
+	UINT64 hash_data(const void* data, size_t size)
+	{
+		// FNV-1a, processing eight bytes at a time
+		const UINT64 prime = 1099511628211ULL;
+		UINT64 hash = 14695981039346656037ULL;
+
+		const UINT8* bytes = (const UINT8*)data;
+		size_t numWords = size / sizeof(UINT64);
+		for (size_t i = 0; i < numWords; i++)
+		{
+			UINT64 word;
+			memcpy(&word, bytes + i * sizeof(UINT64), sizeof(word));
+
+			hash = (hash ^ word) * prime;
+		}
+
+		for (size_t i = numWords * sizeof(UINT64); i < size; i++)
+			hash = (hash ^ bytes[i]) * prime;
+
+		return hash;
+	}
+
 	String md5(const WString& source)
 	{
 		MD5 md5;
@@ -18,6 +18,12 @@ namespace bs
 		seed ^= hasher(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
 	}
 
+	/** 
+	 * Generates a 64-bit hash of the contents of the provided block of memory. Fast enough to be used for detecting
+	 * changes in per-frame data, but not suitable for cryptographic purposes.
+	 */
+	UINT64 BS_UTILITY_EXPORT hash_data(const void* data, size_t size);
+
 	/** Generates an MD5 hash string for the provided source string. */
 	String BS_UTILITY_EXPORT md5(const WString& source);
 
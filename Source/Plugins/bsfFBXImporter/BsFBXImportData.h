@@ -11,6 +11,7 @@
 #include "Animation/BsAnimationCurve.h"
 #include "RenderAPI/BsSubMesh.h"
 #include "Scene/BsTransform.h"
+#include "Importer/BsMeshImportOptions.h"
 
 namespace bs
 {
@@ -32,6 +33,8 @@ namespace bs
 		float animSampleRate = 1.0f / 60.0f;
 		bool animResample = false;
 		bool reduceKeyframes = true;
+		bool optimizeMeshes = false;
+		MeshOptimizationSettings meshOptimizationSettings;
 	};
 
 	/**	Represents a single node in the FBX transform hierarchy. */
@@ -86,6 +86,85 @@ namespace bs
 		return value;
 	}
 
+	/** Registers per-vertex data with the list of streams used for vertex comparison, if it has an entry per vertex. */
+	template<class T>
+	void addVertexStream(Vector<MeshVertexStream>& streams, const Vector<T>& data, UINT32 numVertices)
+	{
+		if (data.size() == numVertices)
+			streams.push_back(MeshVertexStream((const UINT8*)data.data(), sizeof(T), sizeof(T)));
+	}
+
+	/** Reorders per-vertex data according to the provided remap table, if it has an entry per vertex. */
+	template<class T>
+	void remapVertexData(Vector<T>& data, const Vector<UINT32>& remap, UINT32 numRemappedVertices)
+	{
+		if (data.size() != remap.size())
+			return;
+
+		Vector<T> output(numRemappedVertices);
+		MeshUtility::remapVertices((const UINT8*)data.data(), (UINT8*)output.data(), (UINT32)data.size(), sizeof(T),
+			remap.data());
+
+		data = std::move(output);
+	}
+
+	/** Returns streams for all per-vertex data of the mesh, including blend shapes. */
+	Vector<MeshVertexStream> getVertexStreams(const FBXImportMesh& mesh)
+	{
+		UINT32 numVertices = (UINT32)mesh.positions.size();
+
+		Vector<MeshVertexStream> streams;
+		addVertexStream(streams, mesh.positions, numVertices);
+		addVertexStream(streams, mesh.normals, numVertices);
+		addVertexStream(streams, mesh.tangents, numVertices);
+		addVertexStream(streams, mesh.bitangents, numVertices);
+		addVertexStream(streams, mesh.colors, numVertices);
+
+		for (UINT32 i = 0; i < FBX_IMPORT_MAX_UV_LAYERS; i++)
+			addVertexStream(streams, mesh.UV[i], numVertices);
+
+		addVertexStream(streams, mesh.boneInfluences, numVertices);
+
+		for (auto& shape : mesh.blendShapes)
+		{
+			for (auto& frame : shape.frames)
+			{
+				addVertexStream(streams, frame.positions, numVertices);
+				addVertexStream(streams, frame.normals, numVertices);
+				addVertexStream(streams, frame.tangents, numVertices);
+				addVertexStream(streams, frame.bitangents, numVertices);
+			}
+		}
+
+		return streams;
+	}
+
+	/** Reorders all per-vertex data of the mesh, including blend shapes, according to the provided remap table. */
+	void remapMeshVertices(FBXImportMesh& mesh, const Vector<UINT32>& remap, UINT32 numRemappedVertices)
+	{
+		remapVertexData(mesh.positions, remap, numRemappedVertices);
+		remapVertexData(mesh.normals, remap, numRemappedVertices);
+		remapVertexData(mesh.tangents, remap, numRemappedVertices);
+		remapVertexData(mesh.bitangents, remap, numRemappedVertices);
+		remapVertexData(mesh.colors, remap, numRemappedVertices);
+
+		for (UINT32 i = 0; i < FBX_IMPORT_MAX_UV_LAYERS; i++)
+			remapVertexData(mesh.UV[i], remap, numRemappedVertices);
+
+		remapVertexData(mesh.boneInfluences, remap, numRemappedVertices);
+
+		for (auto& shape : mesh.blendShapes)
+		{
+			for (auto& frame : shape.frames)
+			{
+				remapVertexData(frame.positions, remap, numRemappedVertices);
+				remapVertexData(frame.normals, remap, numRemappedVertices);
+				remapVertexData(frame.tangents, remap, numRemappedVertices);
+				remapVertexData(frame.bitangents, remap, numRemappedVertices);
+			}
+		}
+	}
+
 	FBXImporter::FBXImporter()
 		:SpecificImporter(), mFBXManager(nullptr)
 	{
@@ -186,6 +265,19 @@ namespace bs
 			{
 				SPtr<AnimationClip> clip = AnimationClip::_createPtr(entry.curves, entry.isAdditive, entry.sampleRate, 
 					entry.rootMotion);
+
+				if(meshImportOptions->getAnimationCompression())
+				{
+					AnimationCompressionSettings compressionSettings = meshImportOptions->getAnimationCompressionSettings();
+					if(entry.sampleRate > 1)
+						compressionSettings.sampleRate = entry.sampleRate;
+
+					AnimationCompressionReport report = clip->compress(compressionSettings);
+					LOGDBG("Compressed animation clip \"" + entry.name + "\": " + toString(report.uncompressedSize) + 
+						" -> " + toString(report.compressedSize) + " bytes (ratio " + toString(report.compressionRatio) + 
+						"), max error: position " + toString(report.maxPositionError) + ", rotation " + 
+						toString(report.maxRotationError) + ", scale " + toString(report.maxScaleError) + ".");
+				}
 				
 				for(auto& eventsEntry : events)
 				{
@@ -224,6 +316,8 @@ namespace bs
 		fbxImportOptions.importSkin = meshImportOptions->getImportSkin();
 		fbxImportOptions.importScale = meshImportOptions->getImportScale();
 		fbxImportOptions.reduceKeyframes = meshImportOptions->getKeyFrameReduction();
+		fbxImportOptions.optimizeMeshes = meshImportOptions->getMeshOptimization();
+		fbxImportOptions.meshOptimizationSettings = meshImportOptions->getMeshOptimizationSettings();
 
 		FBXImportScene importedScene;
 		bakeTransforms(fbxScene);
@@ -241,6 +335,9 @@ namespace bs
 		splitMeshVertices(importedScene);
 		generateMissingTangentSpace(importedScene, fbxImportOptions);
 
+		if (fbxImportOptions.optimizeMeshes)
+			optimizeMeshes(importedScene, fbxImportOptions);
+
 		SPtr<RendererMeshData> rendererMeshData = generateMeshData(importedScene, fbxImportOptions, subMeshes);
 
 		skeleton = createSkeleton(importedScene, subMeshes.size() > 1);
@@ -253,7 +350,7 @@ namespace bs
 			convertAnimations(importedScene.clips, splits, skeleton, meshImportOptions->getImportRootMotion(), animation);
 		}
 
-		// TODO - Later: Optimize mesh: Remove bad and degenerate polygons, weld nearby vertices, optimize for vertex cache
+		// TODO - Later: Remove bad and degenerate polygons, weld nearby vertices
 
 		shutDownSdk();
 
@@ -1722,6 +1819,109 @@ namespace bs
 		}
 	}
 
+	void FBXImporter::optimizeMeshes(FBXImportScene& scene, const FBXImportOptions& options)
+	{
+		const MeshOptimizationSettings& settings = options.meshOptimizationSettings;
+
+		for (auto& mesh : scene.meshes)
+		{
+			UINT32 numVertices = (UINT32)mesh->positions.size();
+			UINT32 numIndices = (UINT32)mesh->indices.size();
+			UINT32 numFaces = numIndices / 3;
+
+			if (numFaces == 0 || numIndices != numFaces * 3 || (UINT32)mesh->materials.size() != numIndices)
+				continue;
+
+			// Group triangles by material, so triangles of each sub-mesh can be reordered independently
+			Vector<UINT32> faceOrder(numFaces);
+			for (UINT32 i = 0; i < numFaces; i++)
+				faceOrder[i] = i;
+
+			std::stable_sort(faceOrder.begin(), faceOrder.end(), 
+				[&mesh](UINT32 a, UINT32 b) { return mesh->materials[a * 3] < mesh->materials[b * 3]; });
+
+			Vector<int> sortedIndices(numIndices);
+			Vector<int> sortedMaterials(numIndices);
+			for (UINT32 i = 0; i < numFaces; i++)
+			{
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					sortedIndices[i * 3 + j] = mesh->indices[faceOrder[i] * 3 + j];
+					sortedMaterials[i * 3 + j] = mesh->materials[faceOrder[i] * 3 + j];
+				}
+			}
+
+			mesh->indices = std::move(sortedIndices);
+			mesh->materials = std::move(sortedMaterials);
+
+			// Smoothing groups have already been used for generating normals, and won't match the new triangle order
+			mesh->smoothingGroups.clear();
+
+			UINT32* indices = (UINT32*)mesh->indices.data();
+			UINT32 originalNumVertices = numVertices;
+			VertexCacheStatistics statsBefore = MeshUtility::analyzeVertexCache(indices, numIndices, numVertices, 
+				settings.vertexCacheSize);
+
+			Vector<UINT32> remap;
+			if (settings.deduplicateVertices)
+			{
+				Vector<MeshVertexStream> streams = getVertexStreams(*mesh);
+
+				remap.resize(numVertices);
+				UINT32 numUniqueVertices = MeshUtility::deduplicateVertices(indices, numIndices, numVertices, 
+					streams.data(), (UINT32)streams.size(), remap.data());
+
+				remapMeshVertices(*mesh, remap, numUniqueVertices);
+				numVertices = numUniqueVertices;
+			}
+
+			if (settings.optimizeVertexCache || settings.optimizeOverdraw)
+			{
+				UINT32 rangeStart = 0;
+				while (rangeStart < numIndices)
+				{
+					UINT32 rangeEnd = rangeStart + 3;
+					while (rangeEnd < numIndices && mesh->materials[rangeEnd] == mesh->materials[rangeStart])
+						rangeEnd += 3;
+
+					UINT32* rangeIndices = indices + rangeStart;
+					UINT32 numRangeIndices = rangeEnd - rangeStart;
+
+					if (settings.optimizeVertexCache)
+					{
+						MeshUtility::optimizeVertexCache(rangeIndices, numRangeIndices, numVertices, 
+							settings.vertexCacheSize);
+					}
+
+					if (settings.optimizeOverdraw)
+					{
+						MeshUtility::optimizeOverdraw(rangeIndices, numRangeIndices, mesh->positions.data(), numVertices,
+							settings.overdrawThreshold, settings.vertexCacheSize);
+					}
+
+					rangeStart = rangeEnd;
+				}
+			}
+
+			if (settings.optimizeVertexFetch)
+			{
+				remap.resize(numVertices);
+				UINT32 numUsedVertices = MeshUtility::optimizeVertexFetch(indices, numIndices, numVertices, remap.data());
+
+				remapMeshVertices(*mesh, remap, numUsedVertices);
+				numVertices = numUsedVertices;
+			}
+
+			VertexCacheStatistics statsAfter = MeshUtility::analyzeVertexCache(indices, numIndices, numVertices,
+				settings.vertexCacheSize);
+
+			LOGDBG("Optimized mesh \"" + String(mesh->fbxMesh->GetName()) + "\": vertices " + 
+				toString(originalNumVertices) + " -> " + toString(numVertices) + ", ACMR " + toString(statsBefore.acmr) + 
+				" -> " + toString(statsAfter.acmr) + ", ATVR " + toString(statsBefore.atvr) + " -> " + 
+				toString(statsAfter.atvr) + ".");
+		}
+	}
+
 	void FBXImporter::importAnimations(FbxScene* scene, FBXImportOptions& importOptions, FBXImportScene& importScene)
 	{
 		FbxNode* root = scene->GetRootNode();
@@ -133,6 +133,15 @@ namespace bs
 		 */
 		void generateMissingTangentSpace(FBXImportScene& scene, const FBXImportOptions& options);
 
+		/**
+		 * Traverses over all meshes in the scene and optimizes their geometry for rendering, as specified by the mesh
+		 * optimization settings in the import options. Merges duplicate vertices and reorders triangles and vertices to
+		 * make better use of the GPU vertex cache and reduce overdraw.
+		 *
+		 * @note	This assumes vertices have already been split and shouldn't be called on pre-split meshes.
+		 */
+		void optimizeMeshes(FBXImportScene& scene, const FBXImportOptions& options);
+
 		/** Converts the mesh data from the imported FBX scene into mesh data that can be used for initializing a mesh. */
 		SPtr<RendererMeshData> generateMeshData(const FBXImportScene& scene, const FBXImportOptions& options, 
 			Vector<SubMesh>& outputSubMeshes);
@@ -139,6 +139,9 @@ namespace bs
 			bufferSize = monoBufferSize;
 		}
 
+		// Resample if needed, converting straight to the requested bit depth
+		AudioUtility::resampleForImport(*clipIO, sampleBuffer, bufferSize, info);
+
 		// Convert bit depth if needed
 		if (clipIO->getBitDepth() != info.bitDepth)
 		{
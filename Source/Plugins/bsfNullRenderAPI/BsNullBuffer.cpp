@@ -0,0 +1,50 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullBuffer.h"
+
+namespace bs { namespace ct
+{
+	NullBuffer::~NullBuffer()
+	{
+		if (mData != nullptr)
+			bs_free(mData);
+	}
+
+	void NullBuffer::initialize(UINT32 size)
+	{
+		if (mData != nullptr)
+			bs_free(mData);
+
+		mSize = size;
+		mData = (UINT8*)bs_alloc(size);
+		memset(mData, 0, size);
+	}
+
+	void* NullBuffer::lock(UINT32 offset, UINT32 length, GpuLockOptions options)
+	{
+		assert(offset + length <= mSize && "Lock range out of bounds.");
+
+		return mData + offset;
+	}
+
+	void NullBuffer::readData(UINT32 offset, UINT32 length, void* dest)
+	{
+		assert(offset + length <= mSize && "Read range out of bounds.");
+
+		memcpy(dest, mData + offset, length);
+	}
+
+	void NullBuffer::writeData(UINT32 offset, UINT32 length, const void* source)
+	{
+		assert(offset + length <= mSize && "Write range out of bounds.");
+
+		memcpy(mData + offset, source, length);
+	}
+
+	void NullBuffer::copyData(NullBuffer& dstBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length)
+	{
+		assert(srcOffset + length <= mSize && dstOffset + length <= dstBuffer.mSize && "Copy range out of bounds.");
+
+		memmove(dstBuffer.mData + dstOffset, mData + srcOffset, length);
+	}
+}}
@@ -0,0 +1,47 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/** Block of system memory used as storage for null render API buffers. */
+	class NullBuffer
+	{
+	public:
+		NullBuffer() = default;
+		~NullBuffer();
+
+		/** Allocates the storage. Contents are initialized to zero. */
+		void initialize(UINT32 size);
+
+		/** Returns a pointer to the buffer memory at the specified offset. */
+		void* lock(UINT32 offset, UINT32 length, GpuLockOptions options);
+
+		/** Releases a lock acquired with lock(). */
+		void unlock() { }
+
+		/** Copies data from the buffer into the provided memory. */
+		void readData(UINT32 offset, UINT32 length, void* dest);
+
+		/** Copies data from the provided memory into the buffer. */
+		void writeData(UINT32 offset, UINT32 length, const void* source);
+
+		/** Copies data from this buffer into the provided buffer. */
+		void copyData(NullBuffer& dstBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length);
+
+		/** Returns the size of the buffer, in bytes. */
+		UINT32 getSize() const { return mSize; }
+
+	private:
+		UINT8* mData = nullptr;
+		UINT32 mSize = 0;
+	};
+
+	/** @} */
+}}
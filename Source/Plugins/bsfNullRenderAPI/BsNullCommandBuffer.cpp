@@ -0,0 +1,17 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullCommandBuffer.h"
+
+namespace bs { namespace ct
+{
+	NullCommandBuffer::NullCommandBuffer(GpuQueueType type, UINT32 deviceIdx, UINT32 queueIdx, bool secondary)
+		:CommandBuffer(type, deviceIdx, queueIdx, secondary)
+	{ }
+
+	SPtr<CommandBuffer> NullCommandBufferManager::createInternal(GpuQueueType type, UINT32 deviceIdx,
+		UINT32 queueIdx, bool secondary)
+	{
+		CommandBuffer* buffer = new (bs_alloc<NullCommandBuffer>()) NullCommandBuffer(type, deviceIdx, queueIdx, secondary);
+		return bs_shared_ptr(buffer);
+	}
+}}
@@ -0,0 +1,40 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsCommandBuffer.h"
+#include "Managers/BsCommandBufferManager.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**
+	 * Command buffer implementation for the null render API. Commands have no GPU side effects so they are never
+	 * recorded, the buffer only tracks the state required for keeping render statistics.
+	 */
+	class NullCommandBuffer : public CommandBuffer
+	{
+	private:
+		friend class NullCommandBufferManager;
+		friend class NullRenderAPI;
+
+		NullCommandBuffer(GpuQueueType type, UINT32 deviceIdx, UINT32 queueIdx, bool secondary);
+
+		DrawOperationType mActiveDrawOp = DOT_TRIANGLE_LIST;
+	};
+
+	/** Handles creation of command buffers for the null render API. */
+	class NullCommandBufferManager : public CommandBufferManager
+	{
+	public:
+		/** @copydoc CommandBufferManager::createInternal() */
+		SPtr<CommandBuffer> createInternal(GpuQueueType type, UINT32 deviceIdx = 0, UINT32 queueIdx = 0,
+			bool secondary = false) override;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,70 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullGpuBuffer.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullGpuBuffer::NullGpuBuffer(const GPU_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+		:GpuBuffer(desc, deviceMask)
+	{ }
+
+	NullGpuBuffer::~NullGpuBuffer()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuBuffer);
+	}
+
+	void NullGpuBuffer::initialize()
+	{
+		mBuffer.initialize(mSize);
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuBuffer);
+		GpuBuffer::initialize();
+	}
+
+	void* NullGpuBuffer::map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+#if BS_PROFILING_ENABLED
+		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_GpuBuffer);
+		}
+
+		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD
+			|| options == GBL_WRITE_ONLY_NO_OVERWRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuBuffer);
+		}
+#endif
+
+		return mBuffer.lock(offset, length, options);
+	}
+
+	void NullGpuBuffer::unmap()
+	{
+		mBuffer.unlock();
+	}
+
+	void NullGpuBuffer::readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		mBuffer.readData(offset, length, dest);
+
+		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_GpuBuffer);
+	}
+
+	void NullGpuBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags,
+		UINT32 queueIdx)
+	{
+		mBuffer.writeData(offset, length, source);
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuBuffer);
+	}
+
+	void NullGpuBuffer::copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
+		bool discardWholeBuffer, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Nothing is actually queued on the GPU, so the copy can always execute immediately
+		NullGpuBuffer& nullSrcBuffer = static_cast<NullGpuBuffer&>(srcBuffer);
+		nullSrcBuffer.mBuffer.copyData(mBuffer, srcOffset, dstOffset, length);
+	}
+}}
@@ -0,0 +1,48 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsGpuBuffer.h"
+#include "BsNullBuffer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**	Generic GPU buffer that stores its data in system memory. */
+	class NullGpuBuffer : public GpuBuffer
+	{
+	public:
+		NullGpuBuffer(const GPU_BUFFER_DESC& desc, GpuDeviceFlags deviceMask);
+		~NullGpuBuffer();
+
+		/** @copydoc GpuBuffer::readData */
+		void readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx = 0, UINT32 queueIdx = 0) override;
+
+		/** @copydoc GpuBuffer::writeData */
+		void writeData(UINT32 offset, UINT32 length, const void* source,
+			BufferWriteType writeFlags = BWT_NORMAL, UINT32 queueIdx = 0) override;
+
+		/** @copydoc GpuBuffer::copyData */
+		void copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
+			bool discardWholeBuffer = false, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+	protected:
+		/** @copydoc GpuBuffer::initialize */
+		void initialize() override;
+
+		/** @copydoc GpuBuffer::map */
+		void* map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx, UINT32 queueIdx) override;
+
+		/** @copydoc GpuBuffer::unmap */
+		void unmap() override;
+
+	private:
+		NullBuffer mBuffer;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,31 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullGpuParamBlockBuffer.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullGpuParamBlockBuffer::NullGpuParamBlockBuffer(UINT32 size, GpuParamBlockUsage usage, GpuDeviceFlags deviceMask)
+		:GpuParamBlockBuffer(size, usage, deviceMask)
+	{ }
+
+	NullGpuParamBlockBuffer::~NullGpuParamBlockBuffer()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuParamBuffer);
+	}
+
+	void NullGpuParamBlockBuffer::initialize()
+	{
+		mBuffer.initialize(mSize);
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuParamBuffer);
+		GpuParamBlockBuffer::initialize();
+	}
+
+	void NullGpuParamBlockBuffer::writeToGPU(const UINT8* data, UINT32 queueIdx)
+	{
+		mBuffer.writeData(0, mSize, data);
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
+	}
+}}
@@ -0,0 +1,34 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "BsNullBuffer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**	GPU parameter block buffer that stores its data in system memory. */
+	class NullGpuParamBlockBuffer : public GpuParamBlockBuffer
+	{
+	public:
+		NullGpuParamBlockBuffer(UINT32 size, GpuParamBlockUsage usage, GpuDeviceFlags deviceMask);
+		~NullGpuParamBlockBuffer();
+
+		/** @copydoc GpuParamBlockBuffer::writeToGPU */
+		void writeToGPU(const UINT8* data, UINT32 queueIdx = 0) override;
+
+	protected:
+		/** @copydoc GpuParamBlockBuffer::initialize */
+		void initialize() override;
+
+	private:
+		NullBuffer mBuffer;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,69 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullGpuProgram.h"
+#include "Managers/BsHardwareBufferManager.h"
+#include "RenderAPI/BsVertexDeclaration.h"
+#include "RenderAPI/BsGpuParamDesc.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	static const char* NULL_COMPILER_ID = "Null";
+
+	NullGpuProgram::NullGpuProgram(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask)
+		:GpuProgram(desc, deviceMask)
+	{ }
+
+	NullGpuProgram::~NullGpuProgram()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_GpuProgram);
+	}
+
+	void NullGpuProgram::initialize()
+	{
+		if (mBytecode != nullptr && mBytecode->paramDesc != nullptr)
+			mParametersDesc = mBytecode->paramDesc;
+
+		if (mType == GPT_VERTEX_PROGRAM)
+		{
+			Vector<VertexElement> vertexInput;
+			if (mBytecode != nullptr)
+				vertexInput = mBytecode->vertexInput;
+
+			mInputDeclaration = HardwareBufferManager::instance().createVertexDeclaration(vertexInput);
+		}
+
+		mIsCompiled = true;
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_GpuProgram);
+		GpuProgram::initialize();
+	}
+
+	SPtr<GpuProgram> NullGpuProgramFactory::create(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask)
+	{
+		SPtr<GpuProgram> gpuProg = bs_shared_ptr_new<NullGpuProgram>(desc, deviceMask);
+		gpuProg->_setThisPtr(gpuProg);
+
+		return gpuProg;
+	}
+
+	SPtr<GpuProgram> NullGpuProgramFactory::create(GpuProgramType type, GpuDeviceFlags deviceMask)
+	{
+		GPU_PROGRAM_DESC desc;
+		desc.type = type;
+
+		SPtr<GpuProgram> gpuProg = bs_shared_ptr_new<NullGpuProgram>(desc, deviceMask);
+		gpuProg->_setThisPtr(gpuProg);
+
+		return gpuProg;
+	}
+
+	SPtr<GpuProgramBytecode> NullGpuProgramFactory::compileBytecode(const GPU_PROGRAM_DESC& desc)
+	{
+		SPtr<GpuProgramBytecode> bytecode = bs_shared_ptr_new<GpuProgramBytecode>();
+		bytecode->compilerId = NULL_COMPILER_ID;
+		bytecode->paramDesc = bs_shared_ptr_new<GpuParamDesc>();
+
+		return bytecode;
+	}
+}}
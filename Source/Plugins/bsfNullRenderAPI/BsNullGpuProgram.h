@@ -0,0 +1,46 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsGpuProgram.h"
+#include "Managers/BsGpuProgramManager.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**
+	 * GPU program for the null render API. The source code is never compiled, but if the program was provided with
+	 * bytecode generated by another render API, the parameter and vertex input descriptions are used from it. This
+	 * allows materials to be created and their parameters to be set as they normally would.
+	 */
+	class NullGpuProgram : public GpuProgram
+	{
+	public:
+		NullGpuProgram(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask);
+		~NullGpuProgram();
+
+	protected:
+		/** @copydoc GpuProgram::initialize */
+		void initialize() override;
+	};
+
+	/** Handles creation of GPU programs for the null render API. */
+	class NullGpuProgramFactory : public GpuProgramFactory
+	{
+	public:
+		/** @copydoc GpuProgramFactory::create(const GPU_PROGRAM_DESC&, GpuDeviceFlags) */
+		SPtr<GpuProgram> create(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+		/** @copydoc GpuProgramFactory::create(GpuProgramType, GpuDeviceFlags) */
+		SPtr<GpuProgram> create(GpuProgramType type, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+		/** @copydoc GpuProgramFactory::compileBytecode(const GPU_PROGRAM_DESC&) */
+		SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc) override;
+	};
+
+	/** @} */
+}}
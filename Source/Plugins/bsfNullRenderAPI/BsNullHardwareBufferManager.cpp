@@ -0,0 +1,46 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullHardwareBufferManager.h"
+#include "BsNullVertexBuffer.h"
+#include "BsNullIndexBuffer.h"
+#include "BsNullGpuBuffer.h"
+#include "BsNullGpuParamBlockBuffer.h"
+
+namespace bs { namespace ct
+{
+	SPtr<VertexBuffer> NullHardwareBufferManager::createVertexBufferInternal(const VERTEX_BUFFER_DESC& desc,
+		GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullVertexBuffer> ret = bs_shared_ptr_new<NullVertexBuffer>(desc, deviceMask);
+		ret->_setThisPtr(ret);
+
+		return ret;
+	}
+
+	SPtr<IndexBuffer> NullHardwareBufferManager::createIndexBufferInternal(const INDEX_BUFFER_DESC& desc,
+		GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullIndexBuffer> ret = bs_shared_ptr_new<NullIndexBuffer>(desc, deviceMask);
+		ret->_setThisPtr(ret);
+
+		return ret;
+	}
+
+	SPtr<GpuParamBlockBuffer> NullHardwareBufferManager::createGpuParamBlockBufferInternal(UINT32 size,
+		GpuParamBlockUsage usage, GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullGpuParamBlockBuffer> ret = bs_shared_ptr_new<NullGpuParamBlockBuffer>(size, usage, deviceMask);
+		ret->_setThisPtr(ret);
+
+		return ret;
+	}
+
+	SPtr<GpuBuffer> NullHardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+		GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullGpuBuffer> ret = bs_shared_ptr_new<NullGpuBuffer>(desc, deviceMask);
+		ret->_setThisPtr(ret);
+
+		return ret;
+	}
+}}
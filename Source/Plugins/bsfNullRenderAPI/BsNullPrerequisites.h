@@ -0,0 +1,27 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+/** @addtogroup Plugins
+ *  @{
+ */
+
+/** @defgroup NullRenderAPI BansheeNullRenderAPI
+ *	Render API that doesn't communicate with any GPU. GPU resources are kept in system memory and draw calls do nothing
+ *	apart from updating render statistics. Allows the rest of the framework (e.g. the renderer) to run headless, for
+ *	testing and for measuring CPU-side performance without the GPU driver affecting the results.
+ */
+
+/** @} */
+
+namespace bs { namespace ct
+{
+	class NullRenderAPI;
+	class NullCommandBuffer;
+	class NullTexture;
+	class NullRenderWindow;
+	class NullGpuProgram;
+	class NullGpuProgramFactory;
+}}
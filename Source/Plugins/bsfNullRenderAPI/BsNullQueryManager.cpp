@@ -0,0 +1,108 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullQueryManager.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullEventQuery::NullEventQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Query);
+	}
+
+	NullEventQuery::~NullEventQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Query);
+	}
+
+	void NullEventQuery::begin(const SPtr<CommandBuffer>& cb)
+	{
+		setActive(true);
+		mIssued = true;
+	}
+
+	bool NullEventQuery::isReady() const
+	{
+		return mIssued;
+	}
+
+	NullTimerQuery::NullTimerQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Query);
+	}
+
+	NullTimerQuery::~NullTimerQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Query);
+	}
+
+	void NullTimerQuery::begin(const SPtr<CommandBuffer>& cb)
+	{
+		setActive(true);
+		mEndIssued = false;
+	}
+
+	void NullTimerQuery::end(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = true;
+	}
+
+	bool NullTimerQuery::isReady() const
+	{
+		return mEndIssued;
+	}
+
+	NullOcclusionQuery::NullOcclusionQuery(bool binary)
+		:OcclusionQuery(binary)
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Query);
+	}
+
+	NullOcclusionQuery::~NullOcclusionQuery()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Query);
+	}
+
+	void NullOcclusionQuery::begin(const SPtr<CommandBuffer>& cb)
+	{
+		setActive(true);
+		mEndIssued = false;
+	}
+
+	void NullOcclusionQuery::end(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = true;
+	}
+
+	bool NullOcclusionQuery::isReady() const
+	{
+		return mEndIssued;
+	}
+
+	SPtr<EventQuery> NullQueryManager::createEventQuery(UINT32 deviceIdx) const
+	{
+		SPtr<EventQuery> query = SPtr<NullEventQuery>(bs_new<NullEventQuery>(),
+			&QueryManager::deleteEventQuery, StdAlloc<NullEventQuery>());
+		mEventQueries.push_back(query.get());
+
+		return query;
+	}
+
+	SPtr<TimerQuery> NullQueryManager::createTimerQuery(UINT32 deviceIdx) const
+	{
+		SPtr<TimerQuery> query = SPtr<NullTimerQuery>(bs_new<NullTimerQuery>(),
+			&QueryManager::deleteTimerQuery, StdAlloc<NullTimerQuery>());
+		mTimerQueries.push_back(query.get());
+
+		return query;
+	}
+
+	SPtr<OcclusionQuery> NullQueryManager::createOcclusionQuery(bool binary, UINT32 deviceIdx) const
+	{
+		SPtr<OcclusionQuery> query = SPtr<NullOcclusionQuery>(bs_new<NullOcclusionQuery>(binary),
+			&QueryManager::deleteOcclusionQuery, StdAlloc<NullOcclusionQuery>());
+		mOcclusionQueries.push_back(query.get());
+
+		return query;
+	}
+}}
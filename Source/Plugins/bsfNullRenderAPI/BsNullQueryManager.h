@@ -0,0 +1,95 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "Managers/BsQueryManager.h"
+#include "RenderAPI/BsEventQuery.h"
+#include "RenderAPI/BsTimerQuery.h"
+#include "RenderAPI/BsOcclusionQuery.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/** Event query for the null render API. Since no work is ever queued, it's ready as soon as it's issued. */
+	class NullEventQuery : public EventQuery
+	{
+	public:
+		NullEventQuery();
+		~NullEventQuery();
+
+		/** @copydoc EventQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc EventQuery::isReady */
+		bool isReady() const override;
+
+	private:
+		bool mIssued = false;
+	};
+
+	/** Timer query for the null render API. Always reports zero elapsed time. */
+	class NullTimerQuery : public TimerQuery
+	{
+	public:
+		NullTimerQuery();
+		~NullTimerQuery();
+
+		/** @copydoc TimerQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc TimerQuery::end */
+		void end(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc TimerQuery::isReady */
+		bool isReady() const override;
+
+		/** @copydoc TimerQuery::getTimeMs */
+		float getTimeMs() override { return 0.0f; }
+
+	private:
+		bool mEndIssued = false;
+	};
+
+	/** Occlusion query for the null render API. Always reports zero samples drawn. */
+	class NullOcclusionQuery : public OcclusionQuery
+	{
+	public:
+		NullOcclusionQuery(bool binary);
+		~NullOcclusionQuery();
+
+		/** @copydoc OcclusionQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc OcclusionQuery::end */
+		void end(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc OcclusionQuery::isReady */
+		bool isReady() const override;
+
+		/** @copydoc OcclusionQuery::getNumSamples */
+		UINT32 getNumSamples() override { return 0; }
+
+	private:
+		bool mEndIssued = false;
+	};
+
+	/**	Handles creation of queries for the null render API. */
+	class NullQueryManager : public QueryManager
+	{
+	public:
+		/** @copydoc QueryManager::createEventQuery */
+		SPtr<EventQuery> createEventQuery(UINT32 deviceIdx = 0) const override;
+
+		/** @copydoc QueryManager::createTimerQuery */
+		SPtr<TimerQuery> createTimerQuery(UINT32 deviceIdx = 0) const override;
+
+		/** @copydoc QueryManager::createOcclusionQuery */
+		SPtr<OcclusionQuery> createOcclusionQuery(bool binary, UINT32 deviceIdx = 0) const override;
+	};
+
+	/** @} */
+}}
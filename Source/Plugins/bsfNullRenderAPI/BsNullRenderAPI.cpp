@@ -0,0 +1,388 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderAPI.h"
+#include "BsNullCommandBuffer.h"
+#include "BsNullTextureManager.h"
+#include "BsNullHardwareBufferManager.h"
+#include "BsNullRenderWindow.h"
+#include "BsNullQueryManager.h"
+#include "BsNullGpuProgram.h"
+#include "BsNullVideoModeInfo.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Managers/BsRenderStateManager.h"
+#include "RenderAPI/BsGpuParams.h"
+#include "RenderAPI/BsGpuParamDesc.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "RenderAPI/BsRenderTarget.h"
+#include "RenderAPI/BsRenderAPICapabilities.h"
+#include "Profiling/BsRenderStats.h"
+#include "Math/BsMath.h"
+
+namespace bs { namespace ct
+{
+	const StringID& NullRenderAPI::getName() const
+	{
+		static StringID strName("NullRenderAPI");
+		return strName;
+	}
+
+	void NullRenderAPI::initialize()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mVideoModeInfo = bs_shared_ptr_new<NullVideoModeInfo>();
+
+		GPUInfo gpuInfo;
+		gpuInfo.numGPUs = 1;
+		gpuInfo.names[0] = "Null";
+
+		PlatformUtility::_setGPUInfo(gpuInfo);
+
+		CommandBufferManager::startUp<NullCommandBufferManager>();
+
+		// Create the texture manager for use by others
+		bs::TextureManager::startUp<bs::NullTextureManager>();
+		TextureManager::startUp<NullTextureManager>();
+
+		// Create hardware buffer manager
+		bs::HardwareBufferManager::startUp();
+		HardwareBufferManager::startUp<NullHardwareBufferManager>();
+
+		// Create render window manager
+		bs::RenderWindowManager::startUp<bs::NullRenderWindowManager>();
+		RenderWindowManager::startUp();
+
+		// Create query manager
+		QueryManager::startUp<NullQueryManager>();
+
+		// Create render state manager
+		RenderStateManager::startUp();
+
+		// Register the program factory for HLSL, so techniques written in it are reported as supported
+		mProgramFactory = bs_new<NullGpuProgramFactory>();
+		GpuProgramManager::instance().addFactory("hlsl", mProgramFactory);
+
+		mNumDevices = 1;
+		mCurrentCapabilities = bs_newN<RenderAPICapabilities>(mNumDevices);
+		initCapabilities(mCurrentCapabilities[0]);
+
+		mMainCommandBuffer = std::static_pointer_cast<NullCommandBuffer>(CommandBuffer::create(GQT_GRAPHICS));
+
+		RenderAPI::initialize();
+	}
+
+	void NullRenderAPI::destroyCore()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (mProgramFactory != nullptr)
+		{
+			GpuProgramManager::instance().removeFactory("hlsl");
+
+			bs_delete(mProgramFactory);
+			mProgramFactory = nullptr;
+		}
+
+		mMainCommandBuffer = nullptr;
+
+		QueryManager::shutDown();
+		RenderStateManager::shutDown();
+		RenderWindowManager::shutDown();
+		bs::RenderWindowManager::shutDown();
+		HardwareBufferManager::shutDown();
+		bs::HardwareBufferManager::shutDown();
+		TextureManager::shutDown();
+		bs::TextureManager::shutDown();
+		CommandBufferManager::shutDown();
+
+		RenderAPI::destroyCore();
+	}
+
+	void NullRenderAPI::setGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		BS_INC_RENDER_STAT(NumPipelineStateChanges);
+	}
+
+	void NullRenderAPI::setComputePipeline(const SPtr<ComputePipelineState>& pipelineState,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		BS_INC_RENDER_STAT(NumPipelineStateChanges);
+	}
+
+	void NullRenderAPI::setGpuParams(const SPtr<GpuParams>& gpuParams, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Flush param block buffers, so their CPU side cost matches that of a real render API
+		for (UINT32 i = 0; i < GPT_COUNT; i++)
+		{
+			SPtr<GpuParamDesc> paramDesc = gpuParams->getParamDesc((GpuProgramType)i);
+			if (paramDesc == nullptr)
+				continue;
+
+			for (auto iter = paramDesc->paramBlocks.begin(); iter != paramDesc->paramBlocks.end(); ++iter)
+			{
+				SPtr<GpuParamBlockBuffer> buffer = gpuParams->getParamBlockBuffer(iter->second.set, iter->second.slot);
+
+				if (buffer != nullptr)
+					buffer->flushToGPU();
+			}
+		}
+
+		BS_INC_RENDER_STAT(NumGpuParamBinds);
+	}
+
+	void NullRenderAPI::setViewport(const Rect2& area, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::setStencilRef(UINT32 value, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::setVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		BS_INC_RENDER_STAT(NumVertexBufferBinds);
+	}
+
+	void NullRenderAPI::setIndexBuffer(const SPtr<IndexBuffer>& buffer, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		BS_INC_RENDER_STAT(NumIndexBufferBinds);
+	}
+
+	void NullRenderAPI::setVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::setDrawOperation(DrawOperationType op, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		cb->mActiveDrawOp = op;
+	}
+
+	void NullRenderAPI::draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		UINT32 primCount = vertexCountToPrimCount(cb->mActiveDrawOp, vertexCount);
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+		BS_ADD_RENDER_STAT(NumVertices, vertexCount);
+		BS_ADD_RENDER_STAT(NumPrimitives, primCount);
+	}
+
+	void NullRenderAPI::drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+		UINT32 instanceCount, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullCommandBuffer* cb = getCB(commandBuffer);
+		UINT32 primCount = vertexCountToPrimCount(cb->mActiveDrawOp, indexCount);
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+		BS_ADD_RENDER_STAT(NumVertices, vertexCount);
+		BS_ADD_RENDER_STAT(NumPrimitives, primCount);
+	}
+
+	void NullRenderAPI::dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		BS_INC_RENDER_STAT(NumComputeCalls);
+	}
+
+	void NullRenderAPI::swapBuffers(const SPtr<RenderTarget>& target, UINT32 syncMask)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		target->swapBuffers(syncMask);
+
+		BS_INC_RENDER_STAT(NumPresents);
+	}
+
+	void NullRenderAPI::setRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags,
+		RenderSurfaceMask loadMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		mActiveRenderTarget = target;
+
+		BS_INC_RENDER_STAT(NumRenderTargetChanges);
+	}
+
+	void NullRenderAPI::clearRenderTarget(UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+		UINT8 targetMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		BS_INC_RENDER_STAT(NumClears);
+	}
+
+	void NullRenderAPI::clearViewport(UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+		UINT8 targetMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		BS_INC_RENDER_STAT(NumClears);
+	}
+
+	void NullRenderAPI::addCommands(const SPtr<CommandBuffer>& commandBuffer, const SPtr<CommandBuffer>& secondary)
+	{
+		// Do nothing, commands are never recorded
+	}
+
+	void NullRenderAPI::submitCommandBuffer(const SPtr<CommandBuffer>& commandBuffer, UINT32 syncMask)
+	{
+		// Do nothing, commands are never recorded
+	}
+
+	void NullRenderAPI::convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest)
+	{
+		dest = matrix;
+
+		// Convert depth range from [-1,+1] to [0,1]
+		dest[2][0] = (dest[2][0] + dest[3][0]) / 2;
+		dest[2][1] = (dest[2][1] + dest[3][1]) / 2;
+		dest[2][2] = (dest[2][2] + dest[3][2]) / 2;
+		dest[2][3] = (dest[2][3] + dest[3][3]) / 2;
+	}
+
+	const RenderAPIInfo& NullRenderAPI::getAPIInfo() const
+	{
+		RenderAPIFeatures featureFlags =
+			RenderAPIFeatureFlag::MultiThreadedCB |
+			RenderAPIFeatureFlag::TextureViews |
+			RenderAPIFeatureFlag::Compute |
+			RenderAPIFeatureFlag::LoadStore;
+
+		static RenderAPIInfo info(0.0f, 0.0f, 0.0f, 1.0f, VET_COLOR_ABGR, featureFlags);
+		return info;
+	}
+
+	GpuParamBlockDesc NullRenderAPI::generateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params)
+	{
+		// Uses the same packing rules as HLSL constant buffers, to match the language the null render API accepts
+		GpuParamBlockDesc block;
+		block.blockSize = 0;
+		block.isShareable = true;
+		block.name = name;
+		block.slot = 0;
+		block.set = 0;
+
+		for (auto& param : params)
+		{
+			const GpuParamDataTypeInfo& typeInfo = bs::GpuParams::PARAM_SIZES.lookup[param.type];
+
+			if (param.arraySize > 1)
+			{
+				// Arrays perform no packing and their elements are always padded and aligned to four component vectors
+				UINT32 size;
+				if(param.type == GPDT_STRUCT)
+					size = Math::divideAndRoundUp(param.elementSize, 16U) * 4;
+				else
+					size = Math::divideAndRoundUp(typeInfo.size, 16U) * 4;
+
+				block.blockSize = Math::divideAndRoundUp(block.blockSize, 4U) * 4;
+
+				param.elementSize = size;
+				param.arrayElementStride = size;
+				param.cpuMemOffset = block.blockSize;
+				param.gpuMemOffset = 0;
+
+				// Last array element isn't rounded up to four component vectors unless it's a struct
+				if(param.type != GPDT_STRUCT)
+				{
+					block.blockSize += size * (param.arraySize - 1);
+					block.blockSize += typeInfo.size / 4;
+				}
+				else
+					block.blockSize += param.arraySize * size;
+			}
+			else
+			{
+				UINT32 size;
+				if(param.type == GPDT_STRUCT)
+				{
+					// Structs are always aligned and rounded up to 4 component vectors
+					size = Math::divideAndRoundUp(param.elementSize, 16U) * 4;
+					block.blockSize = Math::divideAndRoundUp(block.blockSize, 4U) * 4;
+				}
+				else
+				{
+					size = typeInfo.baseTypeSize * (typeInfo.numRows * typeInfo.numColumns) / 4;
+
+					// Pack everything as tightly as possible as long as the data doesn't cross 16 byte boundary
+					UINT32 alignOffset = block.blockSize % 4;
+					if (alignOffset != 0 && size > (4 - alignOffset))
+					{
+						UINT32 padding = (4 - alignOffset);
+						block.blockSize += padding;
+					}
+				}
+
+				param.elementSize = size;
+				param.arrayElementStride = size;
+				param.cpuMemOffset = block.blockSize;
+				param.gpuMemOffset = 0;
+
+				block.blockSize += size;
+			}
+
+			param.paramBlockSlot = 0;
+			param.paramBlockSet = 0;
+		}
+
+		// Constant buffer size must always be a multiple of 16
+		if (block.blockSize % 4 != 0)
+			block.blockSize += (4 - (block.blockSize % 4));
+
+		return block;
+	}
+
+	void NullRenderAPI::initCapabilities(RenderAPICapabilities& caps) const
+	{
+		caps.setDriverVersion(DriverVersion());
+		caps.setDeviceName("Null");
+		caps.setVendor(GPU_UNKNOWN);
+		caps.setRenderAPIName(getName());
+
+		caps.setCapability(RSC_TEXTURE_COMPRESSION_BC);
+		caps.setCapability(RSC_TEXTURE_COMPRESSION_ETC2);
+		caps.setCapability(RSC_TEXTURE_COMPRESSION_ASTC);
+		caps.setCapability(RSC_GEOMETRY_PROGRAM);
+		caps.setCapability(RSC_TESSELLATION_PROGRAM);
+		caps.setCapability(RSC_COMPUTE_PROGRAM);
+
+		caps.addShaderProfile("hlsl");
+
+		caps.setMaxBoundVertexBuffers(32);
+		caps.setNumMultiRenderTargets(BS_MAX_MULTIPLE_RENDER_TARGETS);
+		caps.setGeometryProgramNumOutputVertices(1024);
+
+		static const UINT16 NUM_TEXTURE_UNITS = 128;
+		static const UINT16 NUM_PARAM_BLOCKS = 14;
+		static const UINT16 NUM_LOAD_STORE_UNITS = 8;
+
+		for (UINT32 i = 0; i < GPT_COUNT; i++)
+		{
+			caps.setNumTextureUnits((GpuProgramType)i, NUM_TEXTURE_UNITS);
+			caps.setNumGpuParamBlockBuffers((GpuProgramType)i, NUM_PARAM_BLOCKS);
+		}
+
+		caps.setNumLoadStoreTextureUnits(GPT_FRAGMENT_PROGRAM, NUM_LOAD_STORE_UNITS);
+		caps.setNumLoadStoreTextureUnits(GPT_COMPUTE_PROGRAM, NUM_LOAD_STORE_UNITS);
+
+		caps.setNumCombinedTextureUnits(NUM_TEXTURE_UNITS * GPT_COUNT);
+		caps.setNumCombinedGpuParamBlockBuffers(NUM_PARAM_BLOCKS * GPT_COUNT);
+		caps.setNumCombinedLoadStoreTextureUnits(NUM_LOAD_STORE_UNITS * 2);
+	}
+
+	NullCommandBuffer* NullRenderAPI::getCB(const SPtr<CommandBuffer>& buffer)
+	{
+		if (buffer != nullptr)
+			return static_cast<NullCommandBuffer*>(buffer.get());
+
+		return mMainCommandBuffer.get();
+	}
+}}
@@ -0,0 +1,49 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsRenderTexture.h"
+
+namespace bs
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/** Render texture implementation for the null render API. */
+	class NullRenderTexture : public RenderTexture
+	{
+	public:
+		virtual ~NullRenderTexture() { }
+
+	protected:
+		friend class NullTextureManager;
+
+		NullRenderTexture(const RENDER_TEXTURE_DESC& desc);
+
+		/** @copydoc RenderTexture::getPropertiesInternal */
+		const RenderTargetProperties& getPropertiesInternal() const override { return mProperties; }
+
+		RenderTextureProperties mProperties;
+	};
+
+	namespace ct
+	{
+	/** Render texture implementation for the null render API. */
+	class NullRenderTexture : public RenderTexture
+	{
+	public:
+		NullRenderTexture(const RENDER_TEXTURE_DESC& desc, UINT32 deviceIdx);
+		virtual ~NullRenderTexture() { }
+
+	protected:
+		/** @copydoc RenderTexture::getPropertiesInternal */
+		const RenderTargetProperties& getPropertiesInternal() const override { return mProperties; }
+
+		RenderTextureProperties mProperties;
+	};
+	}
+
+	/** @} */
+}
@@ -0,0 +1,163 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderWindow.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs
+{
+	NullRenderWindow::NullRenderWindow(const RENDER_WINDOW_DESC& desc, UINT32 windowId)
+		:RenderWindow(desc, windowId), mProperties(desc)
+	{ }
+
+	Vector2I NullRenderWindow::screenToWindowPos(const Vector2I& screenPos) const
+	{
+		return Vector2I(screenPos.x - mProperties.left, screenPos.y - mProperties.top);
+	}
+
+	Vector2I NullRenderWindow::windowToScreenPos(const Vector2I& windowPos) const
+	{
+		return Vector2I(windowPos.x + mProperties.left, windowPos.y + mProperties.top);
+	}
+
+	SPtr<ct::NullRenderWindow> NullRenderWindow::getCore() const
+	{
+		return std::static_pointer_cast<ct::NullRenderWindow>(mCoreSpecific);
+	}
+
+	SPtr<ct::CoreObject> NullRenderWindow::createCore() const
+	{
+		RENDER_WINDOW_DESC desc = mDesc;
+		SPtr<ct::CoreObject> coreObj = bs_shared_ptr_new<ct::NullRenderWindow>(desc, mWindowId);
+		coreObj->_setThisPtr(coreObj);
+
+		return coreObj;
+	}
+
+	void NullRenderWindow::syncProperties()
+	{
+		ScopedSpinLock lock(getCore()->mLock);
+		mProperties = getCore()->mSyncedProperties;
+	}
+
+	SPtr<RenderWindow> NullRenderWindowManager::createImpl(RENDER_WINDOW_DESC& desc, UINT32 windowId,
+		const SPtr<RenderWindow>& parentWindow)
+	{
+		NullRenderWindow* renderWindow = new (bs_alloc<NullRenderWindow>()) NullRenderWindow(desc, windowId);
+		return bs_core_ptr<NullRenderWindow>(renderWindow);
+	}
+
+	namespace ct
+	{
+	NullRenderWindow::NullRenderWindow(const RENDER_WINDOW_DESC& desc, UINT32 windowId)
+		:RenderWindow(desc, windowId), mProperties(desc), mSyncedProperties(desc)
+	{ }
+
+	void NullRenderWindow::initialize()
+	{
+		RenderWindowProperties& props = mProperties;
+		props.isHidden = mDesc.hideUntilSwap || mDesc.hidden;
+
+		{
+			ScopedSpinLock lock(mLock);
+			mSyncedProperties = props;
+		}
+
+		bs::RenderWindowManager::instance().notifySyncDataDirty(this);
+		RenderWindow::initialize();
+	}
+
+	void NullRenderWindow::move(INT32 left, INT32 top)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (!mProperties.isFullScreen)
+			setArea(left, top, mProperties.width, mProperties.height, false);
+	}
+
+	void NullRenderWindow::resize(UINT32 width, UINT32 height)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (!mProperties.isFullScreen)
+			setArea(mProperties.left, mProperties.top, width, height, false);
+	}
+
+	void NullRenderWindow::setFullscreen(UINT32 width, UINT32 height, float refreshRate, UINT32 monitorIdx)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		setArea(0, 0, width, height, true);
+	}
+
+	void NullRenderWindow::setFullscreen(const VideoMode& videoMode)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		setArea(0, 0, videoMode.getWidth(), videoMode.getHeight(), true);
+	}
+
+	void NullRenderWindow::setWindowed(UINT32 width, UINT32 height)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		setArea(mProperties.left, mProperties.top, width, height, false);
+	}
+
+	void NullRenderWindow::setVSync(bool enabled, UINT32 interval)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mProperties.vsync = enabled;
+		mProperties.vsyncInterval = interval;
+
+		{
+			ScopedSpinLock lock(mLock);
+			mSyncedProperties.vsync = enabled;
+			mSyncedProperties.vsyncInterval = interval;
+		}
+
+		bs::RenderWindowManager::instance().notifySyncDataDirty(this);
+	}
+
+	void NullRenderWindow::swapBuffers(UINT32 syncMask)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		// Nothing is presented, but honor the request to keep the window hidden until the first swap
+		if (mDesc.hideUntilSwap && mProperties.isHidden && !mDesc.hidden)
+			setHidden(false);
+	}
+
+	void NullRenderWindow::setArea(INT32 left, INT32 top, UINT32 width, UINT32 height, bool fullscreen)
+	{
+		bool resized = mProperties.width != width || mProperties.height != height;
+
+		mProperties.left = left;
+		mProperties.top = top;
+		mProperties.width = width;
+		mProperties.height = height;
+		mProperties.isFullScreen = fullscreen;
+
+		{
+			ScopedSpinLock lock(mLock);
+			mSyncedProperties.left = left;
+			mSyncedProperties.top = top;
+			mSyncedProperties.width = width;
+			mSyncedProperties.height = height;
+			mSyncedProperties.isFullScreen = fullscreen;
+		}
+
+		bs::RenderWindowManager::instance().notifySyncDataDirty(this);
+
+		if (resized)
+			bs::RenderWindowManager::instance().notifyMovedOrResized(this);
+	}
+
+	void NullRenderWindow::syncProperties()
+	{
+		ScopedSpinLock lock(mLock);
+		mProperties = mSyncedProperties;
+	}
+	}
+}
@@ -0,0 +1,116 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsRenderWindow.h"
+#include "Managers/BsRenderWindowManager.h"
+
+namespace bs
+{
+	class NullRenderWindow;
+
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**
+	 * Render window implementation for the null render API. No operating system window is created, the window only
+	 * exists as a render target with the requested properties.
+	 */
+	class NullRenderWindow : public RenderWindow
+	{
+	public:
+		~NullRenderWindow() { }
+
+		/** @copydoc RenderWindow::screenToWindowPos */
+		Vector2I screenToWindowPos(const Vector2I& screenPos) const override;
+
+		/** @copydoc RenderWindow::windowToScreenPos */
+		Vector2I windowToScreenPos(const Vector2I& windowPos) const override;
+
+		/** @copydoc RenderWindow::getCore */
+		SPtr<ct::NullRenderWindow> getCore() const;
+
+	protected:
+		friend class NullRenderWindowManager;
+
+		NullRenderWindow(const RENDER_WINDOW_DESC& desc, UINT32 windowId);
+
+		/** @copydoc RenderWindow::getPropertiesInternal */
+		const RenderTargetProperties& getPropertiesInternal() const override { return mProperties; }
+
+		/** @copydoc RenderWindow::syncProperties */
+		void syncProperties() override;
+
+		/** @copydoc RenderWindow::createCore */
+		SPtr<ct::CoreObject> createCore() const override;
+
+	private:
+		RenderWindowProperties mProperties;
+	};
+
+	/**	Handles creation of windows for the null render API. */
+	class NullRenderWindowManager : public RenderWindowManager
+	{
+	protected:
+		/** @copydoc RenderWindowManager::createImpl */
+		SPtr<RenderWindow> createImpl(RENDER_WINDOW_DESC& desc, UINT32 windowId,
+			const SPtr<RenderWindow>& parentWindow) override;
+	};
+
+	namespace ct
+	{
+	/** Core thread counterpart of bs::NullRenderWindow. */
+	class NullRenderWindow : public RenderWindow
+	{
+	public:
+		NullRenderWindow(const RENDER_WINDOW_DESC& desc, UINT32 windowId);
+		~NullRenderWindow() { }
+
+		/** @copydoc RenderWindow::move */
+		void move(INT32 left, INT32 top) override;
+
+		/** @copydoc RenderWindow::resize */
+		void resize(UINT32 width, UINT32 height) override;
+
+		/** @copydoc RenderWindow::setFullscreen(UINT32, UINT32, float, UINT32) */
+		void setFullscreen(UINT32 width, UINT32 height, float refreshRate = 60.0f, UINT32 monitorIdx = 0) override;
+
+		/** @copydoc RenderWindow::setFullscreen(const VideoMode&) */
+		void setFullscreen(const VideoMode& videoMode) override;
+
+		/** @copydoc RenderWindow::setWindowed */
+		void setWindowed(UINT32 width, UINT32 height) override;
+
+		/** @copydoc RenderWindow::setVSync */
+		void setVSync(bool enabled, UINT32 interval = 1) override;
+
+		/** @copydoc RenderWindow::swapBuffers */
+		void swapBuffers(UINT32 syncMask = 0xFFFFFFFF) override;
+
+	protected:
+		friend class bs::NullRenderWindow;
+
+		/** @copydoc CoreObject::initialize */
+		void initialize() override;
+
+		/** @copydoc RenderWindow::getPropertiesInternal */
+		const RenderTargetProperties& getPropertiesInternal() const override { return mProperties; }
+
+		/** @copydoc RenderWindow::getSyncedProperties */
+		RenderWindowProperties& getSyncedProperties() override { return mSyncedProperties; }
+
+		/** @copydoc RenderWindow::syncProperties */
+		void syncProperties() override;
+
+		/** Updates the window size and position and notifies the sim thread of the change. */
+		void setArea(INT32 left, INT32 top, UINT32 width, UINT32 height, bool fullscreen);
+
+		RenderWindowProperties mProperties;
+		RenderWindowProperties mSyncedProperties;
+	};
+	}
+
+	/** @} */
+}
@@ -0,0 +1,105 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullTexture.h"
+#include "Image/BsPixelUtil.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullTexture::NullTexture(const TEXTURE_DESC& desc, const SPtr<PixelData>& initialData, GpuDeviceFlags deviceMask)
+		:Texture(desc, initialData, deviceMask)
+	{ }
+
+	NullTexture::~NullTexture()
+	{
+		clearBufferViews();
+
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_Texture);
+	}
+
+	void NullTexture::initialize()
+	{
+		UINT32 numSubresources = mProperties.getNumFaces() * (mProperties.getNumMipmaps() + 1);
+		mSubresources.resize(numSubresources);
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_Texture);
+		Texture::initialize();
+	}
+
+	const SPtr<PixelData>& NullTexture::getSubresource(UINT32 face, UINT32 mipLevel)
+	{
+		SPtr<PixelData>& subresource = mSubresources[face * (mProperties.getNumMipmaps() + 1) + mipLevel];
+		if (subresource == nullptr)
+		{
+			subresource = mProperties.allocBuffer(face, mipLevel);
+			memset(subresource->getData(), 0, subresource->getSize());
+		}
+
+		return subresource;
+	}
+
+	PixelData NullTexture::lockImpl(GpuLockOptions options, UINT32 mipLevel, UINT32 face, UINT32 deviceIdx,
+		UINT32 queueIdx)
+	{
+#if BS_PROFILING_ENABLED
+		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_Texture);
+		}
+
+		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD
+			|| options == GBL_WRITE_ONLY_NO_OVERWRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_Texture);
+		}
+#endif
+
+		// Returned object references the sub-resource memory directly
+		return *getSubresource(face, mipLevel);
+	}
+
+	void NullTexture::unlockImpl()
+	{
+		// Do nothing
+	}
+
+	void NullTexture::copyImpl(const SPtr<Texture>& target, const TEXTURE_COPY_DESC& desc,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		NullTexture* other = static_cast<NullTexture*>(target.get());
+
+		const SPtr<PixelData>& srcData = getSubresource(desc.srcFace, desc.srcMip);
+		const SPtr<PixelData>& dstData = other->getSubresource(desc.dstFace, desc.dstMip);
+
+		PixelVolume srcVolume = desc.srcVolume;
+		if (srcVolume.getWidth() == 0 || srcVolume.getHeight() == 0 || srcVolume.getDepth() == 0)
+			srcVolume = srcData->getExtents();
+
+		PixelVolume dstVolume(desc.dstPosition.x, desc.dstPosition.y, desc.dstPosition.z,
+			desc.dstPosition.x + srcVolume.getWidth(), desc.dstPosition.y + srcVolume.getHeight(),
+			desc.dstPosition.z + srcVolume.getDepth());
+
+		PixelData srcSubVolume = srcData->getSubVolume(srcVolume);
+		PixelData dstSubVolume = dstData->getSubVolume(dstVolume);
+
+		PixelUtil::bulkPixelConversion(srcSubVolume, dstSubVolume);
+
+		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_Texture);
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_Texture);
+	}
+
+	void NullTexture::readDataImpl(PixelData& dest, UINT32 mipLevel, UINT32 face, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		PixelUtil::bulkPixelConversion(*getSubresource(face, mipLevel), dest);
+
+		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_Texture);
+	}
+
+	void NullTexture::writeDataImpl(const PixelData& src, UINT32 mipLevel, UINT32 face, bool discardWholeBuffer,
+		UINT32 queueIdx)
+	{
+		PixelUtil::bulkPixelConversion(src, *getSubresource(face, mipLevel));
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_Texture);
+	}
+}}
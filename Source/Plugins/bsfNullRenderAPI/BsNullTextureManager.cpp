@@ -0,0 +1,42 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullTextureManager.h"
+#include "BsNullTexture.h"
+#include "BsNullRenderTexture.h"
+
+namespace bs
+{
+	SPtr<RenderTexture> NullTextureManager::createRenderTextureImpl(const RENDER_TEXTURE_DESC& desc)
+	{
+		NullRenderTexture* tex = new (bs_alloc<NullRenderTexture>()) NullRenderTexture(desc);
+
+		return bs_core_ptr<NullRenderTexture>(tex);
+	}
+
+	PixelFormat NullTextureManager::getNativeFormat(TextureType ttype, PixelFormat format, int usage, bool hwGamma)
+	{
+		// Data is only ever kept in system memory, so all formats are supported as-is
+		return format;
+	}
+
+	namespace ct
+	{
+	SPtr<Texture> NullTextureManager::createTextureInternal(const TEXTURE_DESC& desc,
+		const SPtr<PixelData>& initialData, GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullTexture> texPtr = bs_shared_ptr_new<NullTexture>(desc, initialData, deviceMask);
+		texPtr->_setThisPtr(texPtr);
+
+		return texPtr;
+	}
+
+	SPtr<RenderTexture> NullTextureManager::createRenderTextureInternal(const RENDER_TEXTURE_DESC& desc,
+		UINT32 deviceIdx)
+	{
+		SPtr<NullRenderTexture> texPtr = bs_shared_ptr_new<NullRenderTexture>(desc, deviceIdx);
+		texPtr->_setThisPtr(texPtr);
+
+		return texPtr;
+	}
+	}
+}
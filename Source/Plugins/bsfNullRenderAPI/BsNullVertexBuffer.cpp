@@ -0,0 +1,70 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullVertexBuffer.h"
+#include "Profiling/BsRenderStats.h"
+
+namespace bs { namespace ct
+{
+	NullVertexBuffer::NullVertexBuffer(const VERTEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+		:VertexBuffer(desc, deviceMask)
+	{ }
+
+	NullVertexBuffer::~NullVertexBuffer()
+	{
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_VertexBuffer);
+	}
+
+	void NullVertexBuffer::initialize()
+	{
+		mBuffer.initialize(mSize);
+
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_VertexBuffer);
+		VertexBuffer::initialize();
+	}
+
+	void* NullVertexBuffer::map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+#if BS_PROFILING_ENABLED
+		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_VertexBuffer);
+		}
+
+		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD
+			|| options == GBL_WRITE_ONLY_NO_OVERWRITE)
+		{
+			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_VertexBuffer);
+		}
+#endif
+
+		return mBuffer.lock(offset, length, options);
+	}
+
+	void NullVertexBuffer::unmap()
+	{
+		mBuffer.unlock();
+	}
+
+	void NullVertexBuffer::readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		mBuffer.readData(offset, length, dest);
+
+		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_VertexBuffer);
+	}
+
+	void NullVertexBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags,
+		UINT32 queueIdx)
+	{
+		mBuffer.writeData(offset, length, source);
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_VertexBuffer);
+	}
+
+	void NullVertexBuffer::copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
+		bool discardWholeBuffer, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Nothing is actually queued on the GPU, so the copy can always execute immediately
+		NullVertexBuffer& nullSrcBuffer = static_cast<NullVertexBuffer&>(srcBuffer);
+		nullSrcBuffer.mBuffer.copyData(mBuffer, srcOffset, dstOffset, length);
+	}
+}}
@@ -0,0 +1,22 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullVideoModeInfo.h"
+
+namespace bs { namespace ct
+{
+	NullVideoOutputInfo::NullVideoOutputInfo()
+	{
+		mName = "Null";
+
+		mVideoModes.push_back(bs_new<VideoMode>(1280, 720, 60.0f, 0));
+		mVideoModes.push_back(bs_new<VideoMode>(1920, 1080, 60.0f, 0));
+		mVideoModes.push_back(bs_new<VideoMode>(3840, 2160, 60.0f, 0));
+
+		mDesktopVideoMode = bs_new<VideoMode>(1920, 1080, 60.0f, 0);
+	}
+
+	NullVideoModeInfo::NullVideoModeInfo()
+	{
+		mOutputs.push_back(bs_new<NullVideoOutputInfo>());
+	}
+}}
@@ -0,0 +1,29 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsVideoModeInfo.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/** Video output for the null render API. Reports a single virtual display. */
+	class NullVideoOutputInfo : public VideoOutputInfo
+	{
+	public:
+		NullVideoOutputInfo();
+	};
+
+	/** Video mode information for the null render API. Reports a single virtual display. */
+	class NullVideoModeInfo : public VideoModeInfo
+	{
+	public:
+		NullVideoModeInfo();
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,46 @@
+set(BS_NULLRENDERAPI_INC_NOFILTER
+	"BsNullBuffer.h"
+	"BsNullCommandBuffer.h"
+	"BsNullGpuBuffer.h"
+	"BsNullGpuParamBlockBuffer.h"
+	"BsNullGpuProgram.h"
+	"BsNullHardwareBufferManager.h"
+	"BsNullIndexBuffer.h"
+	"BsNullPrerequisites.h"
+	"BsNullQueryManager.h"
+	"BsNullRenderAPI.h"
+	"BsNullRenderAPIFactory.h"
+	"BsNullRenderTexture.h"
+	"BsNullRenderWindow.h"
+	"BsNullTexture.h"
+	"BsNullTextureManager.h"
+	"BsNullVertexBuffer.h"
+	"BsNullVideoModeInfo.h"
+)
+
+set(BS_NULLRENDERAPI_SRC_NOFILTER
+	"BsNullBuffer.cpp"
+	"BsNullCommandBuffer.cpp"
+	"BsNullGpuBuffer.cpp"
+	"BsNullGpuParamBlockBuffer.cpp"
+	"BsNullGpuProgram.cpp"
+	"BsNullHardwareBufferManager.cpp"
+	"BsNullIndexBuffer.cpp"
+	"BsNullPlugin.cpp"
+	"BsNullQueryManager.cpp"
+	"BsNullRenderAPI.cpp"
+	"BsNullRenderAPIFactory.cpp"
+	"BsNullRenderTexture.cpp"
+	"BsNullRenderWindow.cpp"
+	"BsNullTexture.cpp"
+	"BsNullTextureManager.cpp"
+	"BsNullVertexBuffer.cpp"
+	"BsNullVideoModeInfo.cpp"
+)
+
+source_group("" FILES ${BS_NULLRENDERAPI_INC_NOFILTER} ${BS_NULLRENDERAPI_SRC_NOFILTER})
+
+set(BS_NULLRENDERAPI_SRC
+	${BS_NULLRENDERAPI_INC_NOFILTER}
+	${BS_NULLRENDERAPI_SRC_NOFILTER}
+)
\ No newline at end of file
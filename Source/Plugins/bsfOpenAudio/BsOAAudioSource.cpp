@@ -3,14 +3,16 @@
 #include "BsOAAudioSource.h"
 #include "BsOAAudio.h"
 #include "BsOAAudioClip.h"
+#include "Threading/BsTaskScheduler.h"
 #include "AL/al.h"
 
 namespace bs
 {
 	OAAudioSource::OAAudioSource()
 		: mSavedTime(0.0f), mSavedState(AudioSourceState::Stopped), mState(AudioSourceState::Stopped)
-		, mGloballyPaused(false), mStreamBuffers(), mBusyBuffers(), mStreamProcessedPosition(0), mStreamQueuedPosition(0)
-		, mIsStreaming(false)
+		, mGloballyPaused(false), mStreamBuffers(), mBusyBuffers(), mNumStreamBuffers(MinStreamBufferCount)
+		, mStreamBufferDurationMs(MinStreamBufferDurationMs), mStreamProcessedPosition(0), mStreamQueuedPosition(0)
+		, mNumUnderruns(0), mIsStreaming(false), mStreamStarted(false), mStopDecode(false)
 	{
 		gOAAudio()._registerSource(this);
 		rebuild();
@@ -169,10 +171,7 @@ namespace bs
 			Lock lock(mMutex);
 			
 			if (!mIsStreaming)
-			{
 				startStreaming();
-				stream(); // Stream first block on this thread to ensure something can play right away
-			}
 		}
 		
 		auto& contexts = gOAAudio()._getContexts();
@@ -226,11 +225,12 @@ namespace bs
 		{
 			Lock lock(mMutex);
 
-			mStreamProcessedPosition = 0;
-			mStreamQueuedPosition = 0;
-
+			// Must stop first, as the decode task might still be advancing the queued position
 			if (mIsStreaming)
 				stopStreaming();
+
+			mStreamProcessedPosition = 0;
+			mStreamQueuedPosition = 0;
 		}
 	}
 
@@ -435,11 +435,21 @@ namespace bs
 	{
 		assert(!mIsStreaming);
 
-		alGenBuffers(StreamBufferCount, mStreamBuffers);
-		gOAAudio().startStreaming(this);
-
+		alGenBuffers(mNumStreamBuffers, mStreamBuffers);
 		memset(&mBusyBuffers, 0, sizeof(mBusyBuffers));
+
+		mStreamData.clear();
+		mStreamData.resize(2 * mNumStreamBuffers * getStreamBufferSize());
+
+		// Decode and queue the first block on this thread to ensure something can play right away
+		mStopDecode = false;
+		decode();
+
 		mIsStreaming = true;
+		mStreamStarted = false;
+
+		gOAAudio().startStreaming(this);
+		streamInternal();
 	}
 
 	void OAAudioSource::stopStreaming()
@@ -449,6 +459,8 @@ namespace bs
 		mIsStreaming = false;
 		gOAAudio().stopStreaming(this);
 
+		waitForDecode();
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -464,13 +476,22 @@ namespace bs
 				alSourceUnqueueBuffers(mSourceIDs[i], 1, &buffer);
 		}
 
-		alDeleteBuffers(StreamBufferCount, mStreamBuffers);
+		alDeleteBuffers(mNumStreamBuffers, mStreamBuffers);
+		mStreamData.clear();
 	}
 
 	void OAAudioSource::stream()
 	{
 		Lock lock(mMutex);
 
+		if (!mIsStreaming)
+			return;
+
+		streamInternal();
+	}
+
+	void OAAudioSource::streamInternal()
+	{
 		AudioDataInfo info;
 		info.bitDepth = mAudioClip->getBitDepth();
 		info.numChannels = mAudioClip->getNumChannels();
@@ -497,7 +518,7 @@ namespace bs
 				alSourceUnqueueBuffers(mSourceIDs[i], 1, &buffer);
 
 				INT32 bufferIdx = -1;
-				for (UINT32 k = 0; k < StreamBufferCount; k++)
+				for (UINT32 k = 0; k < mNumStreamBuffers; k++)
 				{
 					if (buffer == mStreamBuffers[k])
 					{
@@ -533,12 +554,14 @@ namespace bs
 					mStreamProcessedPosition += bufferSize / bytesPerSample;
 				}
 
-				if (mStreamProcessedPosition == totalNumSamples) // Reached the end
+				// Reached the end. Buffers can straddle the loop point, so wrap around instead of resetting.
+				if (mStreamProcessedPosition >= totalNumSamples)
 				{
-					mStreamProcessedPosition = 0;
+					mStreamProcessedPosition -= totalNumSamples;
 
 					if (!mLoop) // Variable used on both threads and not thread safe, but it doesn't matter
 					{
+						mStreamProcessedPosition = 0;
 						stopStreaming();
 						return;
 					}
@@ -546,49 +569,84 @@ namespace bs
 			}
 		}
 
-		for(UINT32 i = 0; i < StreamBufferCount; i++)
+		// If all buffers were consumed while we're supposed to be playing, the decoder didn't keep up
+		bool anyBusy = false;
+		for (UINT32 i = 0; i < mNumStreamBuffers; i++)
+			anyBusy |= mBusyBuffers[i] != 0;
+
+		bool underrun = mStreamStarted && !anyBusy && mState == AudioSourceState::Playing && !mGloballyPaused;
+		if (underrun)
+		{
+			mNumUnderruns++;
+			growStreamBuffers();
+		}
+
+		bool queuedAny = false;
+		for(UINT32 i = 0; i < mNumStreamBuffers; i++)
 		{
 			if (mBusyBuffers[i] != 0)
 				continue;
 
-			if (fillBuffer(mStreamBuffers[i], info, totalNumSamples))
+			if (fillBuffer(mStreamBuffers[i], info))
 			{
 				for (auto& source : mSourceIDs)
 					alSourceQueueBuffers(source, 1, &mStreamBuffers[i]);
 
 				mBusyBuffers[i] |= 1 << i;
+				queuedAny = true;
 			}
 			else
 				break;
 		}
-	}
 
-	bool OAAudioSource::fillBuffer(UINT32 buffer, AudioDataInfo& info, UINT32 maxNumSamples)
-	{
-		UINT32 numRemainingSamples = maxNumSamples - mStreamQueuedPosition;
-		if (numRemainingSamples == 0) // Reached the end
+		if (queuedAny)
+			mStreamStarted = true;
+
+		// OpenAL stops the source once it runs out of queued buffers, so resume playback once new data is available
+		if (underrun && queuedAny)
 		{
-			if (mLoop)
+			for (UINT32 i = 0; i < numContexts; i++)
 			{
-				mStreamQueuedPosition = 0;
-				numRemainingSamples = maxNumSamples;
+				if (contexts.size() > 1)
+					alcMakeContextCurrent(contexts[i]);
+
+				alSourcePlay(mSourceIDs[i]);
+
+				// Non-3D clips need to play only on a single source
+				if (!is3D())
+					break;
 			}
-			else // If not looping, don't queue any more buffers, we're done
-				return false;
 		}
 
-		// Read audio data
-		UINT32 numSamples = std::min(numRemainingSamples, info.sampleRate * info.numChannels); // 1 second of data
-		UINT32 sampleBufferSize = numSamples * (info.bitDepth / 8);
+		scheduleDecode();
+	}
 
-		UINT8* samples = (UINT8*)bs_stack_alloc(sampleBufferSize);
+	bool OAAudioSource::fillBuffer(UINT32 buffer, AudioDataInfo& info)
+	{
+		UINT32 bytesPerSample = info.bitDepth / 8;
+		UINT32 bytesPerFrame = bytesPerSample * info.numChannels;
 
-		OAAudioClip* audioClip = static_cast<OAAudioClip*>(mAudioClip.get());
+		UINT32 bufferSize = getStreamBufferSize();
+		UINT32 numBytes = std::min(bufferSize, mStreamData.getNumReadable());
+		numBytes -= numBytes % bytesPerFrame;
+
+		if (numBytes == 0)
+			return false;
+
+		// Avoid queuing partial buffers while the decoder is still producing data, unless we reached the end of the clip
+		if (numBytes < bufferSize)
+		{
+			bool decoding = mDecodeTask != nullptr && !mDecodeTask->isComplete();
+			bool reachedEnd = !decoding && !mLoop && mStreamQueuedPosition >= mAudioClip->getNumSamples();
+
+			if (!reachedEnd)
+				return false;
+		}
 
-		audioClip->getSamples(samples, mStreamQueuedPosition, numSamples);
-		mStreamQueuedPosition += numSamples;
+		UINT8* samples = (UINT8*)bs_stack_alloc(numBytes);
+		mStreamData.read(samples, numBytes);
 
-		info.numSamples = numSamples;
+		info.numSamples = numBytes / bytesPerSample;
 		gOAAudio()._writeToOpenALBuffer(buffer, samples, info);
 
 		bs_stack_free(samples);
@@ -596,6 +654,103 @@ namespace bs
 		return true;
 	}
 
+	void OAAudioSource::decode()
+	{
+		OAAudioClip* audioClip = static_cast<OAAudioClip*>(mAudioClip.get());
+
+		UINT32 bytesPerSample = audioClip->getBitDepth() / 8;
+		UINT32 numChannels = audioClip->getNumChannels();
+		UINT32 totalNumSamples = audioClip->getNumSamples();
+
+		UINT32 maxChunkSamples = DecodeChunkFrames * numChannels;
+		UINT8* samples = (UINT8*)bs_stack_alloc(maxChunkSamples * bytesPerSample);
+
+		while (!mStopDecode.load(std::memory_order_relaxed))
+		{
+			UINT32 numWritable = mStreamData.getNumWritable() / (bytesPerSample * numChannels) * numChannels;
+			if (numWritable == 0)
+				break;
+
+			UINT32 numRemainingSamples = totalNumSamples - mStreamQueuedPosition;
+			if (numRemainingSamples == 0) // Reached the end
+			{
+				if (mLoop)
+				{
+					mStreamQueuedPosition = 0;
+					numRemainingSamples = totalNumSamples;
+				}
+				else // If not looping, don't decode any more data, we're done
+					break;
+			}
+
+			UINT32 numSamples = std::min(std::min(numWritable, numRemainingSamples), maxChunkSamples);
+
+			audioClip->getSamples(samples, mStreamQueuedPosition, numSamples);
+			mStreamData.write(samples, numSamples * bytesPerSample);
+
+			mStreamQueuedPosition += numSamples;
+		}
+
+		bs_stack_free(samples);
+	}
+
+	void OAAudioSource::scheduleDecode()
+	{
+		if (mDecodeTask != nullptr && !mDecodeTask->isComplete())
+			return;
+
+		mDecodeTask = nullptr;
+
+		// Safe to resize since the decoder isn't running. Buffers only ever grow so no data will be lost.
+		UINT32 streamBufferSize = getStreamBufferSize();
+		mStreamData.resize(2 * mNumStreamBuffers * streamBufferSize);
+
+		// Decode in batches of at least a single streaming buffer
+		if (mStreamData.getNumWritable() < streamBufferSize)
+			return;
+
+		if (!mLoop && mStreamQueuedPosition >= mAudioClip->getNumSamples())
+			return;
+
+		mStopDecode = false;
+		mDecodeTask = Task::create("AudioDecode", std::bind(&OAAudioSource::decode, this), TaskPriority::VeryHigh);
+		TaskScheduler::instance().addTask(mDecodeTask);
+	}
+
+	void OAAudioSource::waitForDecode()
+	{
+		if (mDecodeTask == nullptr)
+			return;
+
+		mStopDecode = true;
+		mDecodeTask->wait();
+		mDecodeTask = nullptr;
+	}
+
+	void OAAudioSource::growStreamBuffers()
+	{
+		if (mNumStreamBuffers < MaxStreamBufferCount)
+		{
+			alGenBuffers(1, &mStreamBuffers[mNumStreamBuffers]);
+			mBusyBuffers[mNumStreamBuffers] = 0;
+
+			mNumStreamBuffers++;
+		}
+		else
+		{
+			UINT32 maxDurationMs = MaxStreamBufferDurationMs;
+			mStreamBufferDurationMs = std::min(mStreamBufferDurationMs * 2, maxDurationMs);
+		}
+	}
+
+	UINT32 OAAudioSource::getStreamBufferSize() const
+	{
+		UINT32 bytesPerFrame = (mAudioClip->getBitDepth() / 8) * mAudioClip->getNumChannels();
+		UINT32 numFrames = std::max(1U, mAudioClip->getFrequency() * mStreamBufferDurationMs / 1000);
+
+		return numFrames * bytesPerFrame;
+	}
+
 	void OAAudioSource::applyClip()
 	{
 		auto& contexts = gOAAudio()._getContexts();
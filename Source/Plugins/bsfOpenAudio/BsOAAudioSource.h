@@ -4,6 +4,7 @@
 
 #include "BsOAPrerequisites.h"
 #include "Audio/BsAudioSource.h"
+#include "BsOAStreamRingBuffer.h"
 
 namespace bs
 {
@@ -72,9 +73,36 @@ namespace bs
 		/** Rebuilds the internal representation of an audio source. */
 		void rebuild();
 
-		/** Streams new data into the source audio buffer, if needed. */
+		/** 
+		 * Queues decoded data into the source audio buffers, if needed, and schedules decoding of more data. Called from
+		 * the streaming thread.
+		 */
 		void stream();
 
+		/** Performs the actual work of stream(). Caller must hold the source mutex. */
+		void streamInternal();
+
+		/** 
+		 * Decodes audio data from the current clip into the stream ring buffer, until the buffer is full or the end of
+		 * the clip is reached. Called from decode tasks, or during startStreaming().
+		 */
+		void decode();
+
+		/** Starts a decode task if the stream ring buffer needs more data, and no decode task is currently running. */
+		void scheduleDecode();
+
+		/** Blocks until the currently running decode task, if any, finishes. */
+		void waitForDecode();
+
+		/** 
+		 * Increases the number or the size of streaming buffers, in response to the source running out of data during
+		 * playback.
+		 */
+		void growStreamBuffers();
+
+		/** Returns the size of a single streaming buffer, in bytes. */
+		UINT32 getStreamBufferSize() const;
+
 		/** Starts data streaming from the currently attached audio clip. */
 		void startStreaming();
 
@@ -96,8 +124,8 @@ namespace bs
 		 */
 		bool requiresStreaming() const;
 
-		/** Fills the provided buffer with streaming data. */
-		bool fillBuffer(UINT32 buffer, AudioDataInfo& info, UINT32 maxNumSamples);
+		/** Fills the provided buffer with data from the stream ring buffer. */
+		bool fillBuffer(UINT32 buffer, AudioDataInfo& info);
 
 		/** Makes the current audio clip active. Should be called whenever the audio clip changes. */
 		void applyClip();
@@ -111,12 +139,25 @@ namespace bs
 		AudioSourceState mState;
 		bool mGloballyPaused;
 
-		static const UINT32 StreamBufferCount = 3; // Maximum 32
-		UINT32 mStreamBuffers[StreamBufferCount];
-		UINT32 mBusyBuffers[StreamBufferCount];
+		static const UINT32 MinStreamBufferCount = 3;
+		static const UINT32 MaxStreamBufferCount = 8; // Maximum 32
+		static const UINT32 MinStreamBufferDurationMs = 250;
+		static const UINT32 MaxStreamBufferDurationMs = 1000;
+		static const UINT32 DecodeChunkFrames = 4096;
+
+		UINT32 mStreamBuffers[MaxStreamBufferCount];
+		UINT32 mBusyBuffers[MaxStreamBufferCount];
+		UINT32 mNumStreamBuffers;
+		UINT32 mStreamBufferDurationMs;
 		UINT32 mStreamProcessedPosition;
-		UINT32 mStreamQueuedPosition;
+		UINT32 mStreamQueuedPosition; // Owned by the decode task while it's running
+		UINT32 mNumUnderruns;
 		bool mIsStreaming;
+		bool mStreamStarted;
+
+		OAStreamRingBuffer mStreamData;
+		SPtr<Task> mDecodeTask;
+		std::atomic<bool> mStopDecode;
 		mutable Mutex mMutex;
 	};
 
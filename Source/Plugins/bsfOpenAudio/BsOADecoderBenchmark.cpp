@@ -0,0 +1,218 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsOAPrerequisites.h"
+#include "BsOAStreamRingBuffer.h"
+#include "BsWaveDecoder.h"
+#include "BsOggVorbisDecoder.h"
+#include "BsFLACDecoder.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
+#include <iostream>
+
+using namespace bs;
+
+/**
+ * Headless benchmark for the audio stream decoding path. Simulates a number of streamed audio sources, each decoded by
+ * tasks into its own ring buffer, while a simulated audio device consumes the data in real time. No audio device is
+ * required.
+ *
+ * Usage: bsfOADecoderBenchmark <audio file (.wav, .ogg, .flac)> [number of sources] [duration in seconds]
+ */
+
+namespace
+{
+	/** Length of a single simulated device tick. */
+	const UINT32 TICK_MS = 10;
+
+	/** Size of a single decode operation, in frames. Matches OAAudioSource. */
+	const UINT32 DECODE_CHUNK_FRAMES = 4096;
+
+	/** Amount of audio buffered ahead of playback, in milliseconds. */
+	const UINT32 BUFFER_AHEAD_MS = 1500;
+
+	/** Single simulated streaming audio source. */
+	struct BenchmarkSource
+	{
+		SPtr<AudioDecoder> decoder;
+		SPtr<DataStream> stream;
+		OAStreamRingBuffer ringBuffer;
+		SPtr<Task> decodeTask;
+
+		UINT32 position = 0;
+		UINT64 numDecodedBytes = 0;
+		UINT64 decodeTimeUs = 0;
+		UINT32 numUnderruns = 0;
+	};
+
+	/** Creates a decoder appropriate for the provided file, based on its extension. */
+	SPtr<AudioDecoder> createDecoder(const Path& path)
+	{
+		String extension = path.getExtension();
+		StringUtil::toLowerCase(extension);
+
+		if (extension == ".wav")
+			return bs_shared_ptr_new<WaveDecoder>();
+		else if (extension == ".ogg")
+			return bs_shared_ptr_new<OggVorbisDecoder>();
+		else if (extension == ".flac")
+			return bs_shared_ptr_new<FLACDecoder>();
+
+		return nullptr;
+	}
+
+	/** Decodes as much data as fits into the source's ring buffer, looping the audio when the end is reached. */
+	void decode(BenchmarkSource& source, const AudioDataInfo& info)
+	{
+		Timer timer;
+
+		UINT32 bytesPerSample = info.bitDepth / 8;
+		UINT32 maxChunkSamples = DECODE_CHUNK_FRAMES * info.numChannels;
+		UINT8* samples = (UINT8*)bs_stack_alloc(maxChunkSamples * bytesPerSample);
+
+		while (true)
+		{
+			UINT32 numWritable = source.ringBuffer.getNumWritable() / (bytesPerSample * info.numChannels) * info.numChannels;
+			if (numWritable == 0)
+				break;
+
+			if (source.position >= info.numSamples)
+			{
+				source.position = 0;
+				source.decoder->seek(0);
+			}
+
+			UINT32 numSamples = std::min(std::min(numWritable, info.numSamples - source.position), maxChunkSamples);
+			UINT32 numRead = source.decoder->read(samples, numSamples);
+			if (numRead == 0)
+			{
+				source.position = info.numSamples;
+				continue;
+			}
+
+			source.ringBuffer.write(samples, numRead * bytesPerSample);
+			source.position += numRead;
+			source.numDecodedBytes += numRead * bytesPerSample;
+		}
+
+		bs_stack_free(samples);
+		source.decodeTimeUs += timer.getMicroseconds();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: bsfOADecoderBenchmark <audio file> [number of sources] [duration in seconds]" << std::endl;
+		return 1;
+	}
+
+	Path path = argv[1];
+	UINT32 numSources = argc > 2 ? (UINT32)atoi(argv[2]) : 200;
+	UINT32 durationSec = argc > 3 ? (UINT32)atoi(argv[3]) : 10;
+
+	MemStack::beginThread();
+	ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(std::thread::hardware_concurrency());
+	TaskScheduler::startUp();
+
+	int retVal = 0;
+	{
+		SPtr<DataStream> fileStream = FileSystem::openFile(path);
+		if (fileStream == nullptr || createDecoder(path) == nullptr)
+		{
+			std::cout << "Unable to open audio file: " << path.toString() << std::endl;
+			retVal = 1;
+		}
+		else
+		{
+			// Load the file once, and have all sources decode from their own view of the same memory
+			SPtr<MemoryDataStream> fileData = bs_shared_ptr_new<MemoryDataStream>(fileStream);
+
+			AudioDataInfo info;
+			Vector<BenchmarkSource> sources(numSources);
+			for (auto& source : sources)
+			{
+				source.stream = bs_shared_ptr_new<MemoryDataStream>(fileData->getPtr(), fileData->size(), false);
+				source.decoder = createDecoder(path);
+				source.decoder->open(source.stream, info);
+			}
+
+			UINT32 bytesPerFrame = (info.bitDepth / 8) * info.numChannels;
+			UINT32 bytesPerTick = info.sampleRate * TICK_MS / 1000 * bytesPerFrame;
+			UINT32 bufferSize = info.sampleRate * BUFFER_AHEAD_MS / 1000 * bytesPerFrame;
+
+			for (auto& source : sources)
+			{
+				source.ringBuffer.resize(bufferSize);
+				decode(source, info); // Prefill, same as the audio source does when streaming starts
+			}
+
+			UINT8* tickData = (UINT8*)bs_alloc(bytesPerTick);
+
+			Timer timer;
+			UINT64 numTicks = durationSec * 1000 / TICK_MS;
+			for (UINT64 tick = 0; tick < numTicks; tick++)
+			{
+				for (auto& source : sources)
+				{
+					// Consume a tick worth of data, as the device would
+					if (source.ringBuffer.getNumReadable() < bytesPerTick)
+						source.numUnderruns++;
+
+					source.ringBuffer.read(tickData, bytesPerTick);
+
+					// Schedule more decoding once there's room for at least a tick's worth of data
+					if (source.decodeTask != nullptr && !source.decodeTask->isComplete())
+						continue;
+
+					if (source.ringBuffer.getNumWritable() < bytesPerTick)
+						continue;
+
+					BenchmarkSource* sourcePtr = &source;
+					source.decodeTask = Task::create("AudioDecode", [sourcePtr, &info]() { decode(*sourcePtr, info); },
+						TaskPriority::VeryHigh);
+					TaskScheduler::instance().addTask(source.decodeTask);
+				}
+
+				// Sleep until the next device tick
+				UINT64 nextTickUs = (tick + 1) * TICK_MS * 1000;
+				UINT64 elapsedUs = timer.getMicroseconds();
+				if (elapsedUs < nextTickUs)
+					BS_THREAD_SLEEP((UINT32)((nextTickUs - elapsedUs) / 1000));
+			}
+
+			UINT64 totalDecodedBytes = 0;
+			UINT64 totalDecodeTimeUs = 0;
+			UINT32 totalUnderruns = 0;
+			for (auto& source : sources)
+			{
+				if (source.decodeTask != nullptr)
+					source.decodeTask->wait();
+
+				totalDecodedBytes += source.numDecodedBytes;
+				totalDecodeTimeUs += source.decodeTimeUs;
+				totalUnderruns += source.numUnderruns;
+			}
+
+			bs_free(tickData);
+
+			double decodedSeconds = totalDecodedBytes / (double)(info.sampleRate * bytesPerFrame);
+			double decodeSeconds = totalDecodeTimeUs / 1000000.0;
+
+			std::cout << "Sources: " << numSources << ", duration: " << durationSec << "s" << std::endl;
+			std::cout << "Decoded audio: " << decodedSeconds << "s in " << decodeSeconds << "s of decode time ("
+				<< (decodeSeconds > 0.0 ? decodedSeconds / decodeSeconds : 0.0) << "x realtime per thread)" << std::endl;
+			std::cout << "Underruns: " << totalUnderruns << " (" <<
+				totalUnderruns * 100.0 / (double)(numTicks * numSources) << "% of ticks)" << std::endl;
+		}
+	}
+
+	TaskScheduler::shutDown();
+	ThreadPool::shutDown();
+	MemStack::endThread();
+
+	return retVal;
+}
@@ -0,0 +1,96 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsOAStreamRingBuffer.h"
+
+namespace bs
+{
+	OAStreamRingBuffer::~OAStreamRingBuffer()
+	{
+		if (mData != nullptr)
+			bs_free(mData);
+	}
+
+	void OAStreamRingBuffer::resize(UINT32 capacity)
+	{
+		if (capacity == mCapacity)
+			return;
+
+		UINT8* data = nullptr;
+		if (capacity > 0)
+			data = (UINT8*)bs_alloc(capacity);
+
+		UINT32 numPreserved = std::min(getNumReadable(), capacity);
+		if (numPreserved > 0)
+			read(data, numPreserved);
+
+		if (mData != nullptr)
+			bs_free(mData);
+
+		mData = data;
+		mCapacity = capacity;
+
+		mReadPos.store(0, std::memory_order_relaxed);
+		mWritePos.store(numPreserved, std::memory_order_release);
+	}
+
+	void OAStreamRingBuffer::clear()
+	{
+		mReadPos.store(0, std::memory_order_relaxed);
+		mWritePos.store(0, std::memory_order_release);
+	}
+
+	UINT32 OAStreamRingBuffer::write(const UINT8* data, UINT32 size)
+	{
+		UINT64 readPos = mReadPos.load(std::memory_order_acquire);
+		UINT64 writePos = mWritePos.load(std::memory_order_relaxed);
+
+		UINT32 numWritable = mCapacity - (UINT32)(writePos - readPos);
+		size = std::min(size, numWritable);
+
+		if (size == 0)
+			return 0;
+
+		UINT32 start = (UINT32)(writePos % mCapacity);
+		UINT32 numFirst = std::min(size, mCapacity - start);
+
+		memcpy(mData + start, data, numFirst);
+		memcpy(mData, data + numFirst, size - numFirst);
+
+		mWritePos.store(writePos + size, std::memory_order_release);
+		return size;
+	}
+
+	UINT32 OAStreamRingBuffer::read(UINT8* data, UINT32 size)
+	{
+		UINT64 writePos = mWritePos.load(std::memory_order_acquire);
+		UINT64 readPos = mReadPos.load(std::memory_order_relaxed);
+
+		UINT32 numReadable = (UINT32)(writePos - readPos);
+		size = std::min(size, numReadable);
+
+		if (size == 0)
+			return 0;
+
+		UINT32 start = (UINT32)(readPos % mCapacity);
+		UINT32 numFirst = std::min(size, mCapacity - start);
+
+		memcpy(data, mData + start, numFirst);
+		memcpy(data + numFirst, mData, size - numFirst);
+
+		mReadPos.store(readPos + size, std::memory_order_release);
+		return size;
+	}
+
+	UINT32 OAStreamRingBuffer::getNumReadable() const
+	{
+		UINT64 writePos = mWritePos.load(std::memory_order_acquire);
+		UINT64 readPos = mReadPos.load(std::memory_order_acquire);
+
+		return (UINT32)(writePos - readPos);
+	}
+
+	UINT32 OAStreamRingBuffer::getNumWritable() const
+	{
+		return mCapacity - getNumReadable();
+	}
+}
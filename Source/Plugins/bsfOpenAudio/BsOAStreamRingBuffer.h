@@ -0,0 +1,63 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsOAPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup OpenAudio
+	 *  @{
+	 */
+
+	/**
+	 * Lock-free ring buffer used for passing decoded audio samples from a single producer thread (the decode task) to a 
+	 * single consumer thread (the streaming thread), without either of them blocking the other.
+	 */
+	class OAStreamRingBuffer
+	{
+	public:
+		OAStreamRingBuffer() = default;
+		~OAStreamRingBuffer();
+
+		/** 
+		 * Changes the capacity of the buffer, in bytes. Contained data is preserved, as long as it fits into the new
+		 * capacity. Must not be called while the producer thread is writing to the buffer.
+		 */
+		void resize(UINT32 capacity);
+
+		/** Discards all data in the buffer. Must not be called while the producer thread is writing to the buffer. */
+		void clear();
+
+		/** 
+		 * Writes up to @p size bytes into the buffer. Returns the number of bytes that were actually written, which might
+		 * be less than requested if the buffer is full. Producer thread only.
+		 */
+		UINT32 write(const UINT8* data, UINT32 size);
+
+		/** 
+		 * Reads up to @p size bytes from the buffer. Returns the number of bytes that were actually read, which might be
+		 * less than requested if there is not enough data in the buffer. Consumer thread only.
+		 */
+		UINT32 read(UINT8* data, UINT32 size);
+
+		/** Returns the number of bytes currently available for reading. */
+		UINT32 getNumReadable() const;
+
+		/** Returns the number of bytes that can currently be written. */
+		UINT32 getNumWritable() const;
+
+		/** Returns the total size of the buffer, in bytes. */
+		UINT32 getCapacity() const { return mCapacity; }
+
+	private:
+		UINT8* mData = nullptr;
+		UINT32 mCapacity = 0;
+
+		// Both positions only ever increase, and are wrapped to buffer size on access
+		std::atomic<UINT64> mReadPos{0};
+		std::atomic<UINT64> mWritePos{0};
+	};
+
+	/** @} */
+}
@@ -96,7 +96,12 @@ namespace bs
 
 	void OggVorbisDecoder::seek(UINT32 offset)
 	{
-		ov_pcm_seek(&mOggVorbisFile, offset / mChannelCount);
+		// Streaming reads are sequential, so avoid the (expensive) seek when already at the requested position
+		ogg_int64_t frame = offset / mChannelCount;
+		if (ov_pcm_tell(&mOggVorbisFile) == frame)
+			return;
+
+		ov_pcm_seek(&mOggVorbisFile, frame);
 	}
 
 	UINT32 OggVorbisDecoder::read(UINT8* samples, UINT32 numSamples)
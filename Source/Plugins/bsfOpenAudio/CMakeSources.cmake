@@ -10,6 +10,7 @@ set(BS_OPENAUDIO_INC_NOFILTER
 	"BsOAAudio.h"
 	"BsOAAudioSource.h"
 	"BsOAAudioListener.h"
+	"BsOAStreamRingBuffer.h"
 )
 
 set(BS_OPENAUDIO_SRC_NOFILTER
@@ -23,10 +24,19 @@ set(BS_OPENAUDIO_SRC_NOFILTER
 	"BsOAAudio.cpp"
 	"BsOAAudioSource.cpp"
 	"BsOAAudioListener.cpp"
+	"BsOAStreamRingBuffer.cpp"
 )
 
 source_group("" FILES ${BS_OPENAUDIO_INC_NOFILTER} ${BS_OPENAUDIO_SRC_NOFILTER})
 
+set(BS_OPENAUDIO_BENCHMARK_SRC
+	"BsOADecoderBenchmark.cpp"
+	"BsWaveDecoder.cpp"
+	"BsOggVorbisDecoder.cpp"
+	"BsFLACDecoder.cpp"
+	"BsOAStreamRingBuffer.cpp"
+)
+
 set(BS_OPENAUDIO_SRC
 	${BS_OPENAUDIO_INC_NOFILTER}
 	${BS_OPENAUDIO_SRC_NOFILTER}
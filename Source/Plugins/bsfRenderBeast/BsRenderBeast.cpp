@@ -25,6 +25,7 @@
 #include "Renderer/BsRendererUtility.h"
 #include "Utility/BsRendererTextures.h"
 #include "Utility/BsGpuResourcePool.h"
+#include "Utility/BsTransientParamBlockAllocator.h"
 #include "Renderer/BsRendererManager.h"
 #include "Shading/BsShadowRendering.h"
 #include "Shading/BsStandardDeferred.h"
@@ -78,6 +79,7 @@ namespace bs { namespace ct
 
 		RendererUtility::startUp();
 		GpuResourcePool::startUp();
+		TransientParamBlockAllocator::startUp();
 		IBLUtility::startUp<RenderBeastIBLUtility>();
 		RendererTextures::startUp();
 
@@ -124,6 +126,7 @@ namespace bs { namespace ct
 
 		RendererTextures::shutDown();
 		IBLUtility::shutDown();
+		TransientParamBlockAllocator::shutDown();
 		GpuResourcePool::shutDown();
 		RendererUtility::shutDown();
 	}
@@ -213,6 +216,11 @@ namespace bs { namespace ct
 		mScene->unregisterSkybox(skybox);
 	}
 
+	void RenderBeast::notifyMaterialUpdated(Material* material)
+	{
+		mScene->notifyMaterialUpdated(material);
+	}
+
 	void RenderBeast::setOptions(const SPtr<RendererOptions>& options)
 	{
 		mOptions = std::static_pointer_cast<RenderBeastOptions>(options);
@@ -230,15 +238,18 @@ namespace bs { namespace ct
 		if (options.filtering == RenderBeastFiltering::Anisotropic)
 			filteringChanged |= mCoreOptions->anisotropyMax != options.anisotropyMax;
 
-		if (filteringChanged)
-			mScene->refreshSamplerOverrides(true);
-
 		*mCoreOptions = options;
 
 		mScene->setOptions(mCoreOptions);
 
+		// Overrides are generated from the scene options, so they must be refreshed after they are assigned
+		if (filteringChanged)
+			mScene->refreshSamplerOverrides(true);
+
 		ShadowRendering& shadowRenderer = mMainViewGroup->getShadowRenderer();
 		shadowRenderer.setShadowMapSize(mCoreOptions->shadowMapSize);
+
+		mMainViewGroup->setCPULightGrid(mCoreOptions->cpuLightGrid);
 	}
 
 	ShaderExtensionPointInfo RenderBeast::getShaderExtensionPointInfo(const String& name)
@@ -316,11 +327,21 @@ namespace bs { namespace ct
 		gProfilerGPU().beginFrame();
 		gProfilerCPU().beginSample("renderAllCore");
 
+		TransientParamBlockAllocator::instance().beginFrame();
+
+		GpuResourcePool& resourcePool = GpuResourcePool::instance();
+		resourcePool.beginFrame();
+
+		// Report pooled resource usage of the previous frame
+		const GpuResourcePoolStats& resourcePoolStats = resourcePool.getLastFrameStats();
+		BS_SET_RENDER_STAT(ResourcePoolMemory, resourcePoolStats.totalMemory);
+		BS_SET_RENDER_STAT(ResourcePoolPeakUsedMemory, resourcePoolStats.peakUsedMemory);
+		BS_ADD_RENDER_STAT(NumResourcePoolCreations, resourcePoolStats.numCreated);
+		BS_ADD_RENDER_STAT(NumResourcePoolReuses, resourcePoolStats.numReused);
+
 		const SceneInfo& sceneInfo = mScene->getSceneInfo();
 
-		// Note: I'm iterating over all sampler states every frame. If this ends up being a performance
-		// issue consider handling this internally in ct::Material which can only do it when sampler states
-		// are actually modified after sync
+		// Update sampler overrides of materials whose sampler states changed since last frame
 		mScene->refreshSamplerOverrides();
 
 		// Update global per-frame hardware buffers
@@ -377,14 +398,20 @@ namespace bs { namespace ct
 		shadowRenderer.renderShadowMaps(*mScene, viewGroup, frameInfo);
 
 		// Update various buffers required by each renderable
-		UINT32 numRenderables = (UINT32)sceneInfo.renderables.size();
-		for (UINT32 i = 0; i < numRenderables; i++)
+		bs_frame_mark();
 		{
-			if (!visibility.renderables[i])
-				continue;
+			UINT32 numRenderables = (UINT32)sceneInfo.renderables.size();
 
-			mScene->prepareRenderable(i, frameInfo);
+			FrameVector<UINT32> visibleRenderables;
+			for (UINT32 i = 0; i < numRenderables; i++)
+			{
+				if (visibility.renderables[i])
+					visibleRenderables.push_back(i);
+			}
+
+			mScene->prepareRenderables(visibleRenderables.data(), (UINT32)visibleRenderables.size(), frameInfo);
 		}
+		bs_frame_clear();
 
 		UINT32 numViews = viewGroup.getNumViews();
 		for (UINT32 i = 0; i < numViews; i++)
@@ -140,6 +140,9 @@ namespace bs
 		/** @copydoc Renderer::notifySkyboxRemoved */
 		void notifySkyboxRemoved(Skybox* skybox) override;
 
+		/** @copydoc Renderer::notifyMaterialUpdated */
+		void notifyMaterialUpdated(Material* material) override;
+
 		/**
 		 * Updates the render options on the core thread.
 		 *
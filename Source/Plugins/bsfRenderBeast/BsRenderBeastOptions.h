@@ -43,6 +43,12 @@ namespace bs { namespace ct
 		 * shadows far away, but will never increase the resolution past the provided value.
 		 */
 		UINT32 shadowMapSize = 2048;
+
+		/**
+		 * If true, lights and reflection probes are assigned to the light grid cells used for clustered forward
+		 * rendering on the CPU, instead of on the GPU. Can be faster on GPUs with weak compute performance.
+		 */
+		bool cpuLightGrid = false;
 	};
 
 	/** @} */
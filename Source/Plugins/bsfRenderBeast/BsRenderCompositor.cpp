@@ -9,8 +9,11 @@
 #include "Utility/BsBitwise.h"
 #include "Mesh/BsMesh.h"
 #include "Material/BsGpuParamsSet.h"
+#include "Profiling/BsRenderStats.h"
+#include "Profiling/BsProfilerCPU.h"
 #include "Utility/BsGpuResourcePool.h"
 #include "Utility/BsRendererTextures.h"
+#include "Utility/BsTransientParamBlockAllocator.h"
 #include "Shading/BsStandardDeferred.h"
 #include "Shading/BsTiledDeferred.h"
 #include "Shading/BsLightProbes.h"
@@ -83,6 +86,7 @@ namespace bs { namespace ct
 					processedNodes[nodeId] = curIdx;
 
 					NodeInfo& nodeInfo = mNodeInfos.back();
+					nodeInfo.id = nodeId;
 					nodeInfo.node = nodeType->create();
 					nodeInfo.lastUseIdx = -1;
 
@@ -144,7 +148,10 @@ namespace bs { namespace ct
 			for (auto& entry : mNodeInfos)
 			{
 				inputs.inputNodes = entry.inputs;
+
+				gProfilerCPU().beginSample(entry.id.cstr());
 				entry.node->render(inputs);
+				gProfilerCPU().endSample(entry.id.cstr());
 
 				activeNodes.push_back(&entry);
 
@@ -315,6 +322,7 @@ namespace bs { namespace ct
 		}
 
 		// Render all visible opaque elements that use the deferred pipeline
+		TransientParamBlockAllocator& paramBlockAllocator = TransientParamBlockAllocator::instance();
 		const Vector<RenderQueueElement>& opaqueElements = inputs.view.getOpaqueQueue(false)->getSortedElements();
 		for (auto iter = opaqueElements.begin(); iter != opaqueElements.end(); ++iter)
 		{
@@ -322,6 +330,42 @@ namespace bs { namespace ct
 
 			SPtr<Material> material = renderElem->material;
 
+			// Render all elements merged into this one with a single draw call, using the first element's parameters
+			// and per-instance data from the view's instance buffer
+			if (iter->numInstances > 1)
+			{
+				SPtr<GpuParamBlockBuffer> perInstanceBuffer = paramBlockAllocator.alloc(gPerInstanceParamDef);
+				gPerInstanceParamDef.gInstanceOffset.set(perInstanceBuffer, (INT32)iter->firstInstance);
+				perInstanceBuffer->flushToGPU();
+
+				SPtr<GpuParams> gpuParams = renderElem->instancedParams->getGpuParams();
+				for(UINT32 j = 0; j < GPT_COUNT; j++)
+				{
+					const GpuParamBinding& perCameraBinding = renderElem->instancedPerCameraBindings[j];
+					if(perCameraBinding.slot != (UINT32)-1)
+					{
+						gpuParams->setParamBlockBuffer(perCameraBinding.set, perCameraBinding.slot, 
+							inputs.view.getPerViewBuffer());
+					}
+
+					const GpuParamBinding& perInstanceBinding = renderElem->perInstanceBindings[j];
+					if(perInstanceBinding.slot != (UINT32)-1)
+					{
+						gpuParams->setParamBlockBuffer(perInstanceBinding.set, perInstanceBinding.slot, 
+							perInstanceBuffer);
+					}
+				}
+
+				renderElem->instanceDataParam.set(inputs.view.getInstanceDataBuffer());
+
+				gRendererUtility().setPass(material, iter->passIdx, renderElem->instancedTechniqueIdx);
+				gRendererUtility().setPassParams(renderElem->instancedParams, iter->passIdx);
+				gRendererUtility().draw(renderElem->mesh, renderElem->subMesh, iter->numInstances);
+
+				BS_ADD_RENDER_STAT(NumDrawCallsSavedByInstancing, iter->numInstances - 1);
+				continue;
+			}
+
 			if (iter->applyPass)
 				gRendererUtility().setPass(material, iter->passIdx, renderElem->techniqueIdx);
 
@@ -933,7 +977,7 @@ namespace bs { namespace ct
 
 			const VisibleReflProbeData& probeData = inputs.viewGroup.getVisibleReflProbeData();
 
-			ReflProbeParamBuffer reflProbeParams;
+			ReflProbeParamBuffer reflProbeParams(true);
 			reflProbeParams.populate(inputs.scene.skybox, probeData.getNumProbes(), inputs.scene.reflProbeCubemapsTex,
 				viewProps.capturingReflections);
 
@@ -1067,14 +1111,14 @@ namespace bs { namespace ct
 		}
 		else
 		{
-			// Note: Store these instead of creating them every time?
-			lightsParamBlock = gLightsParamDef.createBuffer();
-			reflProbesParamBlock = gReflProbesParamDef.createBuffer();
-			lightAndReflProbeParamsParamBlock = gLightAndReflProbeParamsParamDef.createBuffer();
+			TransientParamBlockAllocator& paramBlockAllocator = TransientParamBlockAllocator::instance();
+			lightsParamBlock = paramBlockAllocator.alloc(gLightsParamDef);
+			reflProbesParamBlock = paramBlockAllocator.alloc(gReflProbesParamDef);
+			lightAndReflProbeParamsParamBlock = paramBlockAllocator.alloc(gLightAndReflProbeParamsParamDef);
 		}
 
 		// Prepare refl. probe param buffer
-		ReflProbeParamBuffer reflProbeParamBuffer;
+		ReflProbeParamBuffer reflProbeParamBuffer(true);
 		reflProbeParamBuffer.populate(sceneInfo.skybox, visibleReflProbeData.getNumProbes(), sceneInfo.reflProbeCubemapsTex, 
 			viewProps.capturingReflections);
 
@@ -2110,7 +2154,15 @@ namespace bs { namespace ct
 
 	SmallVector<StringID, 4> RCNodeSSAO::getDependencies(const RendererView& view)
 	{
-		return { RCNodeResolvedSceneDepth::getNodeId(), RCNodeGBuffer::getNodeId() };
+		// When disabled the node just outputs a white texture, so avoid pulling in the depth resolve
+		SmallVector<StringID, 4> deps;
+		if (view.getRenderSettings().ambientOcclusion.enabled)
+		{
+			deps.push_back(RCNodeResolvedSceneDepth::getNodeId());
+			deps.push_back(RCNodeGBuffer::getNodeId());
+		}
+
+		return deps;
 	}
 
 	RCNodeSSR::~RCNodeSSR()
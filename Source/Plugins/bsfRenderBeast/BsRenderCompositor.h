@@ -50,7 +50,9 @@ namespace ct
 	 * can depend on other nodes in the hierarchy.
 	 * 
 	 * @note	Implementations must provide a getNodeId() and getDependencies() static method, which are expected to
-	 *			return a unique name for the implemented node, as well as a set of nodes it depends on.
+	 *			return a unique name for the implemented node, as well as a set of nodes it depends on. Dependencies
+	 *			should only include nodes required by the current view settings, so that nodes used only by disabled
+	 *			features are never created or executed.
 	 */
 	class RenderCompositorNode
 	{
@@ -80,6 +82,7 @@ namespace ct
 		/** Contains internal information about a single render node. */
 		struct NodeInfo
 		{
+			StringID id;
 			RenderCompositorNode* node;
 			UINT32 lastUseIdx;
 			SmallVector<RenderCompositorNode*, 4> inputs;
@@ -98,7 +101,10 @@ namespace ct
 		 */
 		void build(const RendererView& view, const StringID& finalNode);
 
-		/** Performs rendering using the current render node hierarchy. This is expected to be called once per frame. */
+		/** 
+		 * Performs rendering using the current render node hierarchy. This is expected to be called once per frame. 
+		 * Time spent in each node is reported to the CPU profiler.
+		 */
 		void execute(RenderCompositorNodeInputs& inputs) const;
 
 	private:
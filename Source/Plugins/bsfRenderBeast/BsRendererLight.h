@@ -141,6 +141,9 @@ namespace ct
 
 		/** Returns a list of all visible lights of the specified type. */
 		const Vector<const RendererLight*>& getLights(LightType type) const { return mVisibleLights[(UINT32)type]; }
+
+		/** Returns information about a light at the specified index. Lights are ordered directional, radial, spot. */
+		const LightData& getLightData(UINT32 idx) const { return mVisibleLightData[idx]; }
 	private:
 		SPtr<GpuBuffer> mLightBuffer;
 
@@ -1,11 +1,13 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsRendererObject.h"
+#include "RenderAPI/BsRenderAPI.h"
 
 namespace bs { namespace ct
 {
 	PerObjectParamDef gPerObjectParamDef;
 	PerCallParamDef gPerCallParamDef;
+	PerInstanceParamDef gPerInstanceParamDef;
 
 	RendererObject::RendererObject()
 	{
@@ -18,11 +20,33 @@ namespace bs { namespace ct
 		Matrix4 worldTransform = renderable->getMatrix();
 		Matrix4 worldNoScaleTransform = renderable->getMatrixNoScale();
 
+		Matrix4 transforms[] = { worldTransform, worldNoScaleTransform };
+		UINT64 hash = hash_data(transforms, sizeof(transforms));
+		if (hash == perObjectHash)
+			return;
+
+		perObjectHash = hash;
+
 		gPerObjectParamDef.gMatWorld.set(perObjectParamBuffer, worldTransform);
 		gPerObjectParamDef.gMatInvWorld.set(perObjectParamBuffer, worldTransform.inverseAffine());
 		gPerObjectParamDef.gMatWorldNoScale.set(perObjectParamBuffer, worldNoScaleTransform);
 		gPerObjectParamDef.gMatInvWorldNoScale.set(perObjectParamBuffer, worldNoScaleTransform.inverseAffine());
 		gPerObjectParamDef.gWorldDeterminantSign.set(perObjectParamBuffer, worldTransform.determinant3x3() >= 0.0f ? 1.0f : -1.0f);
+
+		instanceData.matWorld = worldTransform;
+		instanceData.matInvWorld = worldTransform.inverseAffine();
+		instanceData.matWorldNoScale = worldNoScaleTransform;
+		instanceData.matInvWorldNoScale = worldNoScaleTransform.inverseAffine();
+		instanceData.worldDeterminantSign = Vector4::ZERO;
+		instanceData.worldDeterminantSign.x = worldTransform.determinant3x3() >= 0.0f ? 1.0f : -1.0f;
+
+		if (RenderAPI::instance().getAPIInfo().isFlagSet(RenderAPIFeatureFlag::ColumnMajorMatrices))
+		{
+			instanceData.matWorld = instanceData.matWorld.transpose();
+			instanceData.matInvWorld = instanceData.matInvWorld.transpose();
+			instanceData.matWorldNoScale = instanceData.matWorldNoScale.transpose();
+			instanceData.matInvWorldNoScale = instanceData.matInvWorldNoScale.transpose();
+		}
 	}
 
 	void RendererObject::updatePerCallBuffer(const Matrix4& viewProj, bool flush)
@@ -32,6 +32,25 @@ namespace bs { namespace ct
 
 	extern PerCallParamDef gPerCallParamDef;
 
+	BS_PARAM_BLOCK_BEGIN(PerInstanceParamDef)
+		BS_PARAM_BLOCK_ENTRY(INT32, gInstanceOffset)
+	BS_PARAM_BLOCK_END
+
+	extern PerInstanceParamDef gPerInstanceParamDef;
+
+	/** 
+	 * Per-object data used when the object is rendered as part of an instanced draw call. Stored in the layout expected
+	 * by the GPU, matching the PerInstanceData structure in VertexInput.bslinc. 
+	 */
+	struct PerInstanceData
+	{
+		Matrix4 matWorld;
+		Matrix4 matInvWorld;
+		Matrix4 matWorldNoScale;
+		Matrix4 matInvWorldNoScale;
+		Vector4 worldDeterminantSign;
+	};
+
 	struct MaterialSamplerOverrides;
 
 	/**
@@ -113,6 +132,27 @@ namespace bs { namespace ct
 
 		/** Version of the morph shape vertices in the buffer. */
 		mutable UINT32 morphShapeVersion;
+
+		/** 
+		 * GPU parameters used when the element is rendered along with other elements sharing its mesh and material,
+		 * using a single instanced draw call. Null if the element cannot be instanced.
+		 */
+		SPtr<GpuParamsSet> instancedParams;
+
+		/** Index of the technique in the material to render the element with, when using instanced rendering. */
+		UINT32 instancedTechniqueIdx = (UINT32)-1;
+
+		/** Sampler state overrides for @p instancedParams. */
+		MaterialSamplerOverrides* instancedSamplerOverrides = nullptr;
+
+		/** Binding indices where the per-camera param block buffer should be bound to, for @p instancedParams. */
+		GpuParamBinding instancedPerCameraBindings[GPT_COUNT];
+
+		/** Binding indices where the param block containing the offset of the first instance should be bound to. */
+		GpuParamBinding perInstanceBindings[GPT_COUNT];
+
+		/** Parameter to which to bind the buffer containing per-instance data, for @p instancedParams. */
+		GpuParamBuffer instanceDataParam;
 	};
 
 	 /** Contains information about a Renderable, used by the Renderer. */
@@ -120,7 +160,10 @@ namespace bs { namespace ct
 	{
 		RendererObject();
 
-		/** Updates the per-object GPU buffer according to the currently set properties. */
+		/** 
+		 * Updates the per-object GPU buffer according to the currently set properties. The buffer is left untouched if
+		 * the properties it depends on haven't changed since the last update, so it doesn't need to be uploaded again.
+		 */
 		void updatePerObjectBuffer();
 
 		/** 
@@ -134,8 +177,20 @@ namespace bs { namespace ct
 		Renderable* renderable;
 		Vector<BeastRenderableElement> elements;
 
+		/** Data used when the object's elements are rendered using an instanced draw call. */
+		PerInstanceData instanceData;
+
 		SPtr<GpuParamBlockBuffer> perObjectParamBuffer;
 		SPtr<GpuParamBlockBuffer> perCallParamBuffer;
+
+		/** Hash of the transforms the per-object buffer was last updated with. */
+		UINT64 perObjectHash = 0;
+
+		/** Hash of the bone matrices last uploaded to the renderable's bone matrix buffer. */
+		UINT64 boneMatrixHash = 0;
+
+		/** Version of the morph shape vertices last uploaded to the renderable's morph shape buffer. */
+		UINT32 morphShapeVersion = 0;
 	};
 
 	/** @} */
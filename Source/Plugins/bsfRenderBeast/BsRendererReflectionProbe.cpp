@@ -7,6 +7,7 @@
 #include "BsRenderBeast.h"
 #include "Renderer/BsRendererUtility.h"
 #include "Renderer/BsSkybox.h"
+#include "Utility/BsTransientParamBlockAllocator.h"
 
 namespace bs { namespace ct
 {
@@ -152,9 +153,12 @@ namespace bs { namespace ct
 		);
 	}
 
-	ReflProbeParamBuffer::ReflProbeParamBuffer()
+	ReflProbeParamBuffer::ReflProbeParamBuffer(bool transient)
 	{
-		buffer = gReflProbeParamsParamDef.createBuffer();
+		if(transient)
+			buffer = TransientParamBlockAllocator::instance().alloc(gReflProbeParamsParamDef);
+		else
+			buffer = gReflProbeParamsParamDef.createBuffer();
 	}
 
 	void ReflProbeParamBuffer::populate(const Skybox* sky, UINT32 numProbes, const SPtr<Texture>& reflectionCubemaps, 
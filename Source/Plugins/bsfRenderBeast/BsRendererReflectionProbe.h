@@ -120,7 +120,11 @@ namespace bs { namespace ct
 	/** Parameter buffer containing information about reflection probes. */
 	struct ReflProbeParamBuffer
 	{
-		ReflProbeParamBuffer();
+		/** 
+		 * Creates the parameter buffer. If @p transient is true the buffer is provided by the 
+		 * TransientParamBlockAllocator and must only be used during the current frame.
+		 */
+		ReflProbeParamBuffer(bool transient = false);
 
 		/** Updates the parameter buffer contents with required refl. probe data. */
 		void populate(const Skybox* sky, UINT32 numProbes, const SPtr<Texture>& reflectionCubemaps, 
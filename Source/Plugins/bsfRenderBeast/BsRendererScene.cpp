@@ -9,6 +9,11 @@
 #include "Mesh/BsMesh.h"
 #include "Material/BsPass.h"
 #include "Material/BsGpuParamsSet.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsGpuBuffer.h"
+#include "RenderAPI/BsVertexBuffer.h"
+#include "Animation/BsAnimationManager.h"
+#include "Threading/BsTaskScheduler.h"
 #include "Utility/BsSamplerOverrides.h"
 #include "BsRenderBeastOptions.h"
 #include "BsRenderBeast.h"
@@ -17,6 +22,14 @@ namespace bs {	namespace ct
 {
 	PerFrameParamDef gPerFrameParamDef;
 
+	const UINT32 RendererScene::MAX_STATIC_CHANGES = 1024;
+
+	/** Minimum number of renderables worth preparing on a separate task. */
+	static constexpr UINT32 MIN_RENDERABLES_PER_TASK = 128;
+
+	/** Number of floats used for storing a single bone matrix in the bone matrix buffer. */
+	static constexpr UINT32 BONE_MATRIX_NUM_FLOATS = 12;
+
 	RendererScene::RendererScene(const SPtr<RenderBeastOptions>& options)
 		:mOptions(options)
 	{
@@ -226,6 +239,8 @@ namespace bs {	namespace ct
 		mInfo.renderables.push_back(bs_new<RendererObject>());
 		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
 
+		notifyStaticChange(renderable, renderable->getBounds().getSphere());
+
 		RendererObject* rendererObject = mInfo.renderables.back();
 		rendererObject->renderable = renderable;
 		rendererObject->updatePerObjectBuffer();
@@ -357,23 +372,30 @@ namespace bs {	namespace ct
 				renElement.material->updateParamsSet(renElement.params, true);
 
 				// Generate or assign sampler state overrides
-				SamplerOverrideKey samplerKey(renElement.material, techniqueIdx);
-				auto iterFind = mSamplerOverrides.find(samplerKey);
-				if (iterFind != mSamplerOverrides.end())
-				{
-					renElement.samplerOverrides = iterFind->second;
-					iterFind->second->refCount++;
-				}
-				else
+				renElement.samplerOverrides = acquireSamplerOverrides(renElement.material, techniqueIdx, 
+					renElement.params);
+
+				// Non-animated elements using the deferred pipeline can be rendered along with other elements using the
+				// same mesh and material, as a single instanced draw call. Per-instance data is provided through a
+				// structured buffer, so this requires the desktop feature set.
+				bool supportsInstancing = !useForwardRendering && animType == RenderableAnimType::None &&
+					gRenderBeast()->getFeatureSet() == RenderBeastFeatureSet::Desktop;
+
+				if (supportsInstancing)
 				{
-					SPtr<Shader> shader = renElement.material->getShader();
-					MaterialSamplerOverrides* samplerOverrides = SamplerOverrideUtility::generateSamplerOverrides(shader,
-						renElement.material->_getInternalParams(), renElement.params, mOptions);
+					FIND_TECHNIQUE_DESC instancedFindDesc;
+					instancedFindDesc.variation = &getInstancedVertexInputVariation();
 
-					mSamplerOverrides[samplerKey] = samplerOverrides;
+					UINT32 instancedTechniqueIdx = renElement.material->findTechnique(instancedFindDesc);
+					if (instancedTechniqueIdx != (UINT32)-1)
+					{
+						renElement.instancedTechniqueIdx = instancedTechniqueIdx;
+						renElement.instancedParams = renElement.material->createParamsSet(instancedTechniqueIdx);
+						renElement.material->updateParamsSet(renElement.instancedParams, true);
 
-					renElement.samplerOverrides = samplerOverrides;
-					samplerOverrides->refCount++;
+						renElement.instancedSamplerOverrides = acquireSamplerOverrides(renElement.material, 
+							instancedTechniqueIdx, renElement.instancedParams);
+					}
 				}
 			}
 		}
@@ -405,6 +427,32 @@ namespace bs {	namespace ct
 			if (gpuParams->hasBuffer(GPT_VERTEX_PROGRAM, "boneMatrices"))
 				gpuParams->setBuffer(GPT_VERTEX_PROGRAM, "boneMatrices", element.boneMatrixBuffer);
 
+			if (element.instancedParams != nullptr)
+			{
+				SPtr<GpuParams> instancedGpuParams = element.instancedParams->getGpuParams();
+				instancedGpuParams->setParamBlockBuffer("PerFrame", mPerFrameParamBuffer);
+
+				instancedGpuParams->getParamInfo()->getBindings(
+					GpuPipelineParamInfoBase::ParamType::ParamBlock,
+					"PerCamera",
+					element.instancedPerCameraBindings
+				);
+
+				instancedGpuParams->getParamInfo()->getBindings(
+					GpuPipelineParamInfoBase::ParamType::ParamBlock,
+					"PerInstance",
+					element.perInstanceBindings
+				);
+
+				if (instancedGpuParams->hasBuffer(GPT_VERTEX_PROGRAM, "gPerInstanceData"))
+				{
+					instancedGpuParams->getBufferParam(GPT_VERTEX_PROGRAM, "gPerInstanceData", 
+						element.instanceDataParam);
+
+					element.allowInstancing = true;
+				}
+			}
+
 			ShaderFlags shaderFlags = shader->getFlags();
 			bool useForwardRendering = shaderFlags.isSet(ShaderFlag::Forward) || shaderFlags.isSet(ShaderFlag::Transparent);
 
@@ -461,6 +509,11 @@ namespace bs {	namespace ct
 		UINT32 renderableId = renderable->getRendererId();
 
 		mInfo.renderables[renderableId]->updatePerObjectBuffer();
+
+		// Both the area the renderable left and the area it moved to are affected
+		notifyStaticChange(renderable, mInfo.renderableCullInfos[renderableId].bounds.getSphere());
+		notifyStaticChange(renderable, renderable->getBounds().getSphere());
+
 		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
 	}
 
@@ -470,24 +523,20 @@ namespace bs {	namespace ct
 		Renderable* lastRenerable = mInfo.renderables.back()->renderable;
 		UINT32 lastRenderableId = lastRenerable->getRendererId();
 
+		notifyStaticChange(renderable, mInfo.renderableCullInfos[renderableId].bounds.getSphere());
+
 		RendererObject* rendererObject = mInfo.renderables[renderableId];
 		Vector<BeastRenderableElement>& elements = rendererObject->elements;
 		for (auto& element : elements)
 		{
-			SamplerOverrideKey samplerKey(element.material, element.techniqueIdx);
-
-			auto iterFind = mSamplerOverrides.find(samplerKey);
-			assert(iterFind != mSamplerOverrides.end());
+			releaseSamplerOverrides(element.material, element.techniqueIdx);
+			element.samplerOverrides = nullptr;
 
-			MaterialSamplerOverrides* samplerOverrides = iterFind->second;
-			samplerOverrides->refCount--;
-			if (samplerOverrides->refCount == 0)
+			if (element.instancedSamplerOverrides != nullptr)
 			{
-				SamplerOverrideUtility::destroySamplerOverrides(samplerOverrides);
-				mSamplerOverrides.erase(iterFind);
+				releaseSamplerOverrides(element.material, element.instancedTechniqueIdx);
+				element.instancedSamplerOverrides = nullptr;
 			}
-
-			element.samplerOverrides = nullptr;
 		}
 
 		if (renderableId != lastRenderableId)
@@ -767,14 +816,59 @@ namespace bs {	namespace ct
 		}
 	}
 
+	void RendererScene::notifyStaticChange(const Renderable* renderable, const Sphere& bounds)
+	{
+		if (renderable->getMobility() != ObjectMobility::Static)
+			return;
+
+		// Discard the older half of the changes once the limit is reached. Consumers that haven't seen the discarded
+		// changes are expected to invalidate everything.
+		if (mInfo.staticChanges.size() >= MAX_STATIC_CHANGES)
+			mInfo.staticChanges.erase(mInfo.staticChanges.begin(), mInfo.staticChanges.begin() + MAX_STATIC_CHANGES / 2);
+
+		mInfo.staticChanges.push_back(bounds);
+		mInfo.numStaticChanges++;
+	}
+
+	/** Assigns the sampler state overrides to the sampler states of all passes in the provided parameter set. */
+	static void applySamplerOverrides(const MaterialSamplerOverrides* overrides, const SPtr<GpuParamsSet>& paramsSet)
+	{
+		UINT32 numPasses = paramsSet->getNumPasses();
+		for(UINT32 i = 0; i < numPasses; i++)
+		{
+			SPtr<GpuParams> params = paramsSet->getGpuParams(i);
+
+			for (UINT32 j = 0; j < GpuParamsSet::NUM_STAGES; j++)
+			{
+				GpuProgramType type = (GpuProgramType)j;
+
+				SPtr<GpuParamDesc> paramDesc = params->getParamDesc(type);
+				if (paramDesc == nullptr)
+					continue;
+
+				for (auto& samplerDesc : paramDesc->samplers)
+				{
+					UINT32 set = samplerDesc.second.set;
+					UINT32 slot = samplerDesc.second.slot;
+
+					UINT32 overrideIndex = overrides->passes[i].stateOverrides[set][slot];
+					if (overrideIndex == (UINT32)-1)
+						continue;
+
+					params->setSamplerState(set, slot, overrides->overrides[overrideIndex].state);
+				}
+			}
+		}
+	}
+
 	void RendererScene::refreshSamplerOverrides(bool force)
 	{
 		bool anyDirty = false;
-		for (auto& entry : mSamplerOverrides)
+		auto refreshOverrides = [this, force, &anyDirty](const Material* material, 
+			MaterialSamplerOverrides* materialOverrides)
 		{
-			SPtr<MaterialParams> materialParams = entry.first.material->_getInternalParams();
+			SPtr<MaterialParams> materialParams = material->_getInternalParams();
 
-			MaterialSamplerOverrides* materialOverrides = entry.second;
 			for(UINT32 i = 0; i < materialOverrides->numOverrides; i++)
 			{
 				SamplerOverride& override = materialOverrides->overrides[i];
@@ -783,72 +877,142 @@ namespace bs {	namespace ct
 				SPtr<SamplerState> samplerState;
 				materialParams->getSamplerState(*materialParamData, samplerState);
 
-				UINT64 hash = 0;
-				if (samplerState != nullptr)
-					hash = samplerState->getProperties().getHash();
+				if (samplerState == nullptr)
+					samplerState = SamplerState::getDefault();
 
+				UINT64 hash = samplerState->getProperties().getHash();
 				if (hash != override.originalStateHash || force)
 				{
-					if (samplerState != nullptr)
+					if (SamplerOverrideUtility::checkNeedsOverride(samplerState, mOptions))
 						override.state = SamplerOverrideUtility::generateSamplerOverride(samplerState, mOptions);
 					else
-						override.state = SamplerOverrideUtility::generateSamplerOverride(SamplerState::getDefault(), mOptions);
+						override.state = samplerState;
 
-					override.originalStateHash = override.state->getProperties().getHash();
+					override.originalStateHash = hash;
 					materialOverrides->isDirty = true;
 				}
+			}
+
+			// Dirty flag can also be set externally, so check here even though we assign it above
+			if (materialOverrides->isDirty)
+				anyDirty = true;
+		};
+
+		// Only materials whose parameters were synced since the last call can have modified sampler states, unless
+		// the overrides themselves changed
+		if (force)
+		{
+			for (auto& entry : mSamplerOverridesPerMaterial)
+			{
+				for (auto& materialOverrides : entry.second)
+					refreshOverrides(entry.first, materialOverrides);
+			}
+		}
+		else
+		{
+			for (auto& material : mDirtySamplerMaterials)
+			{
+				// Material might have stopped being used since it was updated
+				auto iterFind = mSamplerOverridesPerMaterial.find(material);
+				if (iterFind == mSamplerOverridesPerMaterial.end())
+					continue;
 
-				// Dirty flag can also be set externally, so check here even though we assign it above
-				if (materialOverrides->isDirty)
-					anyDirty = true;
+				for (auto& materialOverrides : iterFind->second)
+					refreshOverrides(material, materialOverrides);
 			}
 		}
 
+		mDirtySamplerMaterials.clear();
+
 		// Early exit if possible
 		if (!anyDirty)
 			return;
 
+		auto updateElement = [](const SPtr<Material>& material, MaterialSamplerOverrides* overrides, 
+			const SPtr<GpuParamsSet>& paramsSet)
+		{
+			if(overrides == nullptr || !overrides->isDirty)
+				return;
+
+			// Transfer any changed sampler states from the material first, so they don't overwrite the overrides later
+			material->updateParamsSet(paramsSet);
+			applySamplerOverrides(overrides, paramsSet);
+		};
+
 		UINT32 numRenderables = (UINT32)mInfo.renderables.size();
 		for (UINT32 i = 0; i < numRenderables; i++)
 		{
 			for(auto& element : mInfo.renderables[i]->elements)
 			{
-				MaterialSamplerOverrides* overrides = element.samplerOverrides;
-				if(overrides != nullptr && overrides->isDirty)
-				{
-					UINT32 numPasses = element.material->getNumPasses();
-					for(UINT32 j = 0; j < numPasses; j++)
-					{
-						SPtr<GpuParams> params = element.params->getGpuParams(j);
+				updateElement(element.material, element.samplerOverrides, element.params);
 
-						const UINT32 numStages = 6;
-						for (UINT32 k = 0; k < numStages; k++)
-						{
-							GpuProgramType type = (GpuProgramType)k;
+				if(element.instancedParams != nullptr)
+					updateElement(element.material, element.instancedSamplerOverrides, element.instancedParams);
+			}
+		}
 
-							SPtr<GpuParamDesc> paramDesc = params->getParamDesc(type);
-							if (paramDesc == nullptr)
-								continue;
+		for (auto& entry : mSamplerOverrides)
+			entry.second->isDirty = false;
+	}
 
-							for (auto& samplerDesc : paramDesc->samplers)
-							{
-								UINT32 set = samplerDesc.second.set;
-								UINT32 slot = samplerDesc.second.slot;
+	void RendererScene::notifyMaterialUpdated(const Material* material)
+	{
+		// Only materials used by renderables have sampler overrides
+		if (mSamplerOverridesPerMaterial.find(material) != mSamplerOverridesPerMaterial.end())
+			mDirtySamplerMaterials.push_back(material);
+	}
 
-								UINT32 overrideIndex = overrides->passes[j].stateOverrides[set][slot];
-								if (overrideIndex == (UINT32)-1)
-									continue;
+	MaterialSamplerOverrides* RendererScene::acquireSamplerOverrides(const SPtr<Material>& material, 
+		UINT32 techniqueIdx, const SPtr<GpuParamsSet>& params)
+	{
+		SamplerOverrideKey samplerKey(material, techniqueIdx);
+		auto iterFind = mSamplerOverrides.find(samplerKey);
+		if (iterFind != mSamplerOverrides.end())
+		{
+			MaterialSamplerOverrides* samplerOverrides = iterFind->second;
+			samplerOverrides->refCount++;
 
-								params->setSamplerState(set, slot, overrides->overrides[overrideIndex].state);
-							}
-						}
-					}
-				}
-			}
+			applySamplerOverrides(samplerOverrides, params);
+			return samplerOverrides;
 		}
 
-		for (auto& entry : mSamplerOverrides)
-			entry.second->isDirty = false;
+		MaterialSamplerOverrides* samplerOverrides = SamplerOverrideUtility::generateSamplerOverrides(
+			material->getShader(), material->_getInternalParams(), params, mOptions);
+
+		mSamplerOverrides[samplerKey] = samplerOverrides;
+		mSamplerOverridesPerMaterial[material.get()].push_back(samplerOverrides);
+		samplerOverrides->refCount++;
+
+		// Overrides are freshly generated from the current material state, so there is nothing else to refresh
+		applySamplerOverrides(samplerOverrides, params);
+		samplerOverrides->isDirty = false;
+
+		return samplerOverrides;
+	}
+
+	void RendererScene::releaseSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx)
+	{
+		SamplerOverrideKey samplerKey(material, techniqueIdx);
+
+		auto iterFind = mSamplerOverrides.find(samplerKey);
+		assert(iterFind != mSamplerOverrides.end());
+
+		MaterialSamplerOverrides* samplerOverrides = iterFind->second;
+		samplerOverrides->refCount--;
+		if (samplerOverrides->refCount == 0)
+		{
+			auto iterFindMaterial = mSamplerOverridesPerMaterial.find(material.get());
+			assert(iterFindMaterial != mSamplerOverridesPerMaterial.end());
+
+			Vector<MaterialSamplerOverrides*>& materialOverrides = iterFindMaterial->second;
+			materialOverrides.erase(std::find(materialOverrides.begin(), materialOverrides.end(), samplerOverrides));
+
+			if (materialOverrides.empty())
+				mSamplerOverridesPerMaterial.erase(iterFindMaterial);
+
+			SamplerOverrideUtility::destroySamplerOverrides(samplerOverrides);
+			mSamplerOverrides.erase(iterFind);
+		}
 	}
 
 	void RendererScene::setParamFrameParams(float time)
@@ -858,19 +1022,176 @@ namespace bs {	namespace ct
 
 	void RendererScene::prepareRenderable(UINT32 idx, const FrameInfo& frameInfo)
 	{
-		if (mInfo.renderableReady[idx])
+		prepareRenderables(&idx, 1, frameInfo);
+	}
+
+	void RendererScene::prepareRenderables(const UINT32* indices, UINT32 count, const FrameInfo& frameInfo)
+	{
+		// Find renderables that weren't prepared yet this frame, and reserve staging memory for their data
+		mPrepareInfos.clear();
+
+		UINT32 numBoneMatrixFloats = 0;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			UINT32 idx = indices[i];
+			if (mInfo.renderableReady[idx])
+				continue;
+
+			mInfo.renderableReady[idx] = true;
+
+			RenderablePrepareInfo info;
+			info.renderableIdx = idx;
+			info.poseStartIdx = 0;
+			info.numBones = 0;
+			info.boneMatrixOffset = 0;
+			info.uploadBoneMatrices = false;
+			info.morphShapeData = nullptr;
+			info.morphShapeVersion = 0;
+
+			RendererObject* rendererObject = mInfo.renderables[idx];
+			const Renderable* renderable = rendererObject->renderable;
+
+			UINT64 animationId = renderable->getAnimationId();
+			if (frameInfo.animData != nullptr && animationId != (UINT64)-1)
+			{
+				auto iterFind = frameInfo.animData->infos.find(animationId);
+				if (iterFind != frameInfo.animData->infos.end())
+				{
+					const EvaluatedAnimationData::AnimInfo& animInfo = iterFind->second;
+
+					RenderableAnimType animType = renderable->getAnimType();
+					if (animType == RenderableAnimType::Skinned || animType == RenderableAnimType::SkinnedMorph)
+					{
+						info.poseStartIdx = animInfo.poseInfo.startIdx;
+						info.numBones = animInfo.poseInfo.numBones;
+						info.boneMatrixOffset = numBoneMatrixFloats;
+
+						numBoneMatrixFloats += info.numBones * BONE_MATRIX_NUM_FLOATS;
+					}
+
+					if (animType == RenderableAnimType::Morph || animType == RenderableAnimType::SkinnedMorph)
+					{
+						if (rendererObject->morphShapeVersion != animInfo.morphShapeInfo.version)
+						{
+							info.morphShapeData = animInfo.morphShapeInfo.meshData.get();
+							info.morphShapeVersion = animInfo.morphShapeInfo.version;
+						}
+					}
+				}
+			}
+
+			mPrepareInfos.push_back(info);
+		}
+
+		UINT32 numRenderables = (UINT32)mPrepareInfos.size();
+		if (numRenderables == 0)
 			return;
-		
-		// Note: Before uploading bone matrices perhaps check if they has actually been changed since last frame
-		if(frameInfo.animData != nullptr)
-			mInfo.renderables[idx]->renderable->updateAnimationBuffers(*frameInfo.animData);
-		
+
+		mBoneMatrixStaging.resize(numBoneMatrixFloats);
+
+		// Perform the CPU side work, split over multiple tasks if there are enough renderables
+		auto worker = [this, &frameInfo](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+				prepareRenderableCPU(mPrepareInfos[i], frameInfo);
+		};
+
+		UINT32 numTasks = 1;
+		if (TaskScheduler::isStarted())
+		{
+			UINT32 maxTasks = TaskScheduler::instance().getNumWorkers() + 1;
+			numTasks = std::min(maxTasks, numRenderables / MIN_RENDERABLES_PER_TASK);
+		}
+
+		if (numTasks <= 1)
+			worker(0, numRenderables);
+		else
+		{
+			UINT32 rangeSize = Math::divideAndRoundUp(numRenderables, numTasks);
+
+			Vector<SPtr<Task>> tasks;
+			for (UINT32 start = rangeSize; start < numRenderables; start += rangeSize)
+			{
+				UINT32 end = std::min(start + rangeSize, numRenderables);
+				tasks.push_back(Task::create("PrepareRenderables", [&worker, start, end]() { worker(start, end); }));
+
+				TaskScheduler::instance().addTask(tasks.back());
+			}
+
+			worker(0, rangeSize);
+
+			for (auto& task : tasks)
+				task->wait();
+		}
+
+		// Upload modified data to the GPU
+		for (auto& info : mPrepareInfos)
+			uploadRenderable(info);
+	}
+
+	void RendererScene::prepareRenderableCPU(RenderablePrepareInfo& info, const FrameInfo& frameInfo)
+	{
+		RendererObject* rendererObject = mInfo.renderables[info.renderableIdx];
+
 		// Note: Could this step be moved in notifyRenderableUpdated, so it only triggers when material actually gets
 		// changed? Although it shouldn't matter much because if the internal versions keeping track of dirty params.
-		for (auto& element : mInfo.renderables[idx]->elements)
+		for (auto& element : rendererObject->elements)
+		{
 			element.material->updateParamsSet(element.params);
-		
-		mInfo.renderables[idx]->perObjectParamBuffer->flushToGPU();
-		mInfo.renderableReady[idx] = true;
+
+			if (element.instancedParams != nullptr)
+				element.material->updateParamsSet(element.instancedParams);
+		}
+
+		// Only stage bone matrices if they changed since they were last uploaded
+		if (info.numBones > 0)
+		{
+			const Matrix4* transforms = &frameInfo.animData->transforms[info.poseStartIdx];
+
+			UINT64 hash = hash_data(transforms, info.numBones * sizeof(Matrix4));
+			if (hash != rendererObject->boneMatrixHash)
+			{
+				float* dest = &mBoneMatrixStaging[info.boneMatrixOffset];
+				for (UINT32 i = 0; i < info.numBones; i++)
+				{
+					memcpy(dest, &transforms[i], BONE_MATRIX_NUM_FLOATS * sizeof(float)); // Assuming row-major format
+					dest += BONE_MATRIX_NUM_FLOATS;
+				}
+
+				rendererObject->boneMatrixHash = hash;
+				info.uploadBoneMatrices = true;
+			}
+		}
+	}
+
+	void RendererScene::uploadRenderable(const RenderablePrepareInfo& info)
+	{
+		RendererObject* rendererObject = mInfo.renderables[info.renderableIdx];
+		Renderable* renderable = rendererObject->renderable;
+
+		if (info.uploadBoneMatrices)
+		{
+			const SPtr<GpuBuffer>& boneMatrixBuffer = renderable->getBoneMatrixBuffer();
+			if (boneMatrixBuffer != nullptr)
+			{
+				UINT32 size = info.numBones * BONE_MATRIX_NUM_FLOATS * sizeof(float);
+				boneMatrixBuffer->writeData(0, size, &mBoneMatrixStaging[info.boneMatrixOffset], BWT_DISCARD);
+			}
+		}
+
+		if (info.morphShapeData != nullptr)
+		{
+			const SPtr<VertexBuffer>& morphShapeBuffer = renderable->getMorphShapeBuffer();
+			if (morphShapeBuffer != nullptr)
+			{
+				morphShapeBuffer->writeData(0, info.morphShapeData->getSize(), info.morphShapeData->getData(),
+					BWT_DISCARD);
+			}
+
+			rendererObject->morphShapeVersion = info.morphShapeVersion;
+		}
+
+		// Only performs the upload if the buffer contents changed
+		rendererObject->perObjectParamBuffer->flushToGPU();
 	}
 }}
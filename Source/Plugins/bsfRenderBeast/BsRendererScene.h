@@ -54,6 +54,12 @@ namespace bs
 		// Sky
 		Skybox* skybox = nullptr;
 
+		// Bounds of static renderables that were added, moved or removed. Only the most recent changes are kept, while
+		// the counter keeps the total number of changes ever recorded. Used for invalidating data cached for static
+		// geometry.
+		Vector<Sphere> staticChanges;
+		UINT64 numStaticChanges = 0;
+
 		// Buffers for various transient data that gets rebuilt every frame
 		//// Rebuilt every frame
 		mutable Vector<bool> renderableReady;
@@ -133,13 +139,17 @@ namespace bs
 		void setOptions(const SPtr<RenderBeastOptions>& options);
 
 		/**
-		 * Checks all sampler overrides in case material sampler states changed, and updates them.
+		 * Checks sampler overrides of materials updated since the last call in case their sampler states changed, and
+		 * updates them.
 		 *
 		 * @param[in]	force	If true, all sampler overrides will be updated, regardless of a change in the material
 		 *						was detected or not.
 		 */
 		void refreshSamplerOverrides(bool force = false);
 
+		/** Notifies the scene that parameters of the provided material changed. */
+		void notifyMaterialUpdated(const Material* material);
+
 		/** Updates global per frame parameter buffers with new values. To be called at the start of every frame. */
 		void setParamFrameParams(float time);
 
@@ -153,6 +163,17 @@ namespace bs
 		 */
 		void prepareRenderable(UINT32 idx, const FrameInfo& frameInfo);
 
+		/**
+		 * Performs necessary steps to make a set of renderables ready for rendering. Equivalent to calling 
+		 * prepareRenderable() for each of the renderables, except that the work that doesn't require GPU access is
+		 * performed in parallel, followed by a single pass that uploads any modified data.
+		 * 
+		 * @param[in]	indices		Indices of the renderables to prepare.
+		 * @param[in]	count		Number of entries in the @p indices array.
+		 * @param[in]	frameInfo	Global information describing the current frame.
+		 */
+		void prepareRenderables(const UINT32* indices, UINT32 count, const FrameInfo& frameInfo);
+
 		/** Returns a modifiable version of SceneInfo. Only to be used by friends who know what they are doing. */
 		SceneInfo& _getSceneInfo() { return mInfo; }
 	private:
@@ -165,9 +186,60 @@ namespace bs
 		 */
 		void updateCameraRenderTargets(Camera* camera, bool remove = false);
 
+		/** 
+		 * Records a change of static geometry within the provided bounds, if the provided renderable is static. See
+		 * SceneInfo::staticChanges.
+		 */
+		void notifyStaticChange(const Renderable* renderable, const Sphere& bounds);
+
+		/** 
+		 * Returns sampler state overrides for the specified material technique, creating them if they don't exist.
+		 * Each call must be paired with a call to releaseSamplerOverrides().
+		 */
+		MaterialSamplerOverrides* acquireSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx,
+			const SPtr<GpuParamsSet>& params);
+
+		/** Releases sampler state overrides acquired through acquireSamplerOverrides(). */
+		void releaseSamplerOverrides(const SPtr<Material>& material, UINT32 techniqueIdx);
+
+		/** Information about a renderable being prepared for rendering by prepareRenderables(). */
+		struct RenderablePrepareInfo
+		{
+			UINT32 renderableIdx;
+
+			/** Index of the first bone transform in EvaluatedAnimationData::transforms. */
+			UINT32 poseStartIdx;
+			UINT32 numBones;
+
+			/** Offset into the bone matrix staging buffer at which to write the bone matrices, in floats. */
+			UINT32 boneMatrixOffset;
+			bool uploadBoneMatrices;
+
+			/** Morph shape vertices to upload, or null if the previously uploaded ones are still up to date. */
+			MeshData* morphShapeData;
+			UINT32 morphShapeVersion;
+		};
+
+		/**
+		 * Performs the part of renderable preparation that doesn't require GPU access, writing any data that needs to
+		 * be uploaded into staging memory. Can be called in parallel for different renderables.
+		 */
+		void prepareRenderableCPU(RenderablePrepareInfo& info, const FrameInfo& frameInfo);
+
+		/** Uploads data written by prepareRenderableCPU() to the GPU, if it changed since it was last uploaded. */
+		void uploadRenderable(const RenderablePrepareInfo& info);
+
+		/** Maximum number of entries to keep in SceneInfo::staticChanges. */
+		static const UINT32 MAX_STATIC_CHANGES;
+
 		SceneInfo mInfo;
 		SPtr<GpuParamBlockBuffer> mPerFrameParamBuffer;
 		UnorderedMap<SamplerOverrideKey, MaterialSamplerOverrides*> mSamplerOverrides;
+		UnorderedMap<const Material*, Vector<MaterialSamplerOverrides*>> mSamplerOverridesPerMaterial;
+		Vector<const Material*> mDirtySamplerMaterials;
+
+		Vector<RenderablePrepareInfo> mPrepareInfos;
+		Vector<float> mBoneMatrixStaging;
 
 		SPtr<RenderBeastOptions> mOptions;
 	};
@@ -7,6 +7,7 @@
 #include "Material/BsMaterial.h"
 #include "Material/BsShader.h"
 #include "Material/BsGpuParamsSet.h"
+#include "RenderAPI/BsGpuBuffer.h"
 #include "BsRendererLight.h"
 #include "BsRendererScene.h"
 #include "BsRenderBeast.h"
@@ -87,6 +88,8 @@ namespace bs { namespace ct
 	void RendererView::setStateReductionMode(StateReduction reductionMode)
 	{
 		mDeferredOpaqueQueue = bs_shared_ptr_new<RenderQueue>(reductionMode);
+		mDeferredOpaqueQueue->setInstancing(true);
+
 		mForwardOpaqueQueue = bs_shared_ptr_new<RenderQueue>(reductionMode);
 
 		StateReduction transparentStateReduction = reductionMode;
@@ -204,6 +207,42 @@ namespace bs { namespace ct
 		mForwardOpaqueQueue->sort();
 		mDeferredOpaqueQueue->sort();
 		mTransparentQueue->sort();
+
+		updateInstanceData(renderables);
+	}
+
+	void RendererView::updateInstanceData(const Vector<RendererObject*>& renderables)
+	{
+		static const UINT32 BUFFER_INCREMENT = 256;
+
+		const Vector<RenderableElement*>& instances = mDeferredOpaqueQueue->getInstances();
+		UINT32 numInstances = (UINT32)instances.size();
+		if (numInstances == 0)
+			return;
+
+		mInstanceData.resize(numInstances);
+		for (UINT32 i = 0; i < numInstances; i++)
+		{
+			const BeastRenderableElement* element = static_cast<const BeastRenderableElement*>(instances[i]);
+			mInstanceData[i] = renderables[element->renderableId]->instanceData;
+		}
+
+		UINT32 curNumElements = 0;
+		if (mInstanceDataBuffer != nullptr)
+			curNumElements = mInstanceDataBuffer->getProperties().getElementCount();
+
+		if (numInstances > curNumElements)
+		{
+			GPU_BUFFER_DESC bufferDesc;
+			bufferDesc.type = GBT_STRUCTURED;
+			bufferDesc.elementCount = Math::divideAndRoundUp(numInstances, BUFFER_INCREMENT) * BUFFER_INCREMENT;
+			bufferDesc.elementSize = sizeof(PerInstanceData);
+			bufferDesc.format = BF_UNKNOWN;
+
+			mInstanceDataBuffer = GpuBuffer::create(bufferDesc);
+		}
+
+		mInstanceDataBuffer->writeData(0, numInstances * sizeof(PerInstanceData), mInstanceData.data(), BWT_DISCARD);
 	}
 
 	void RendererView::determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, 
@@ -503,9 +542,9 @@ namespace bs { namespace ct
 	}
 
 	void RendererView::updateLightGrid(const VisibleLightData& visibleLightData, 
-		const VisibleReflProbeData& visibleReflProbeData)
+		const VisibleReflProbeData& visibleReflProbeData, bool onCPU)
 	{
-		mLightGrid.updateGrid(*this, visibleLightData, visibleReflProbeData, !mRenderSettings->enableLighting);
+		mLightGrid.updateGrid(*this, visibleLightData, visibleReflProbeData, !mRenderSettings->enableLighting, onCPU);
 	}
 
 	RendererViewGroup::RendererViewGroup()
@@ -608,7 +647,7 @@ namespace bs { namespace ct
 				if (mViews[i]->getRenderSettings().overlayOnly)
 					continue;
 
-				mViews[i]->updateLightGrid(mVisibleLightData, mVisibleReflProbeData);
+				mViews[i]->updateLightGrid(mVisibleLightData, mVisibleReflProbeData, mCPULightGrid);
 			}
 		}
 	}
@@ -259,6 +259,13 @@ namespace bs { namespace ct
 		 */
 		const SPtr<RenderQueue>& getTransparentQueue() const { return mTransparentQueue; }
 
+		/** 
+		 * Returns a buffer containing PerInstanceData of all elements rendered using instanced draw calls by the
+		 * deferred opaque queue, in the same order as returned by RenderQueue::getInstances(). Populated by
+		 * determineVisible().
+		 */
+		const SPtr<GpuBuffer>& getInstanceDataBuffer() const { return mInstanceDataBuffer; }
+
 		/** Returns the compositor in charge of rendering for this view. */
 		const RenderCompositor& getCompositor() const { return mCompositor; }
 
@@ -339,8 +346,12 @@ namespace bs { namespace ct
 		 */
 		const LightGrid& getLightGrid() const { return mLightGrid; }
 
-		/** Updates the light grid used for forward rendering. */
-		void updateLightGrid(const VisibleLightData& visibleLightData, const VisibleReflProbeData& visibleReflProbeData);
+		/** 
+		 * Updates the light grid used for forward rendering. If @p onCPU is true the grid is built on the CPU instead
+		 * of the GPU.
+		 */
+		void updateLightGrid(const VisibleLightData& visibleLightData, const VisibleReflProbeData& visibleReflProbeData,
+			bool onCPU);
 
 		/**
 		 * Returns a value that can be used for transforming x, y coordinates from NDC into UV coordinates that can be used
@@ -382,6 +393,9 @@ namespace bs { namespace ct
 		 */
 		static Vector2 getNDCZToDeviceZ();
 	private:
+		/** Populates the instance data buffer with data for all instanced elements in the deferred opaque queue. */
+		void updateInstanceData(const Vector<RendererObject*>& renderables);
+
 		RendererViewProperties mProperties;
 		RENDERER_VIEW_TARGET_DESC mTargetDesc;
 		Camera* mCamera;
@@ -390,6 +404,9 @@ namespace bs { namespace ct
 		SPtr<RenderQueue> mForwardOpaqueQueue;
 		SPtr<RenderQueue> mTransparentQueue;
 
+		SPtr<GpuBuffer> mInstanceDataBuffer;
+		Vector<PerInstanceData> mInstanceData;
+
 		RenderCompositor mCompositor;
 		SPtr<RenderSettings> mRenderSettings;
 		UINT32 mRenderSettingsHash;
@@ -444,6 +461,9 @@ namespace bs { namespace ct
 		/** Returns the object responsible for rendering shadows for this view group. */
 		const ShadowRendering& getShadowRenderer() const { return mShadowRenderer; }
 
+		/** Determines if light grids of views in this group are built on the CPU instead of the GPU. */
+		void setCPULightGrid(bool enabled) { mCPULightGrid = enabled; }
+
 		/** 
 		 * Updates visibility information for the provided scene objects, from the perspective of all views in this group,
 		 * and updates the render queues of each individual view. Use getVisibilityInfo() to retrieve the calculated
@@ -463,6 +483,7 @@ namespace bs { namespace ct
 		// multiple times. Since non-primary view groups are used for pre-processing tasks exclusively (at the moment) 
 		// this isn't an issue right now.
 		ShadowRendering mShadowRenderer;
+		bool mCPULightGrid = false;
 	};
 
 	/** @} */
@@ -29,6 +29,7 @@ set(BS_RENDERBEAST_INC_SHADING
 	"Shading/BsTiledDeferred.h"
 	"Shading/BsStandardDeferred.h"
 	"Shading/BsLightGrid.h"
+	"Shading/BsLightGridCPU.h"
 	"Shading/BsLightProbes.h"
 	"Shading/BsShadowRendering.h"
 	"Shading/BsPostProcessing.h"
@@ -38,6 +39,7 @@ set(BS_RENDERBEAST_SRC_SHADING
 	"Shading/BsTiledDeferred.cpp"
 	"Shading/BsStandardDeferred.cpp"
 	"Shading/BsLightGrid.cpp"
+	"Shading/BsLightGridCPU.cpp"
 	"Shading/BsLightProbes.cpp"
 	"Shading/BsShadowRendering.cpp"
 	"Shading/BsPostProcessing.cpp"
@@ -47,12 +49,14 @@ set(BS_RENDERBEAST_INC_UTILITY
 	"Utility/BsGpuResourcePool.h"
 	"Utility/BsSamplerOverrides.h"
 	"Utility/BsRendererTextures.h"
+	"Utility/BsTransientParamBlockAllocator.h"
 )
 
 set(BS_RENDERBEAST_SRC_UTILITY
 	"Utility/BsGpuResourcePool.cpp"
 	"Utility/BsSamplerOverrides.cpp"
 	"Utility/BsRendererTextures.cpp"
+	"Utility/BsTransientParamBlockAllocator.cpp"
 )
 
 source_group("" FILES ${BS_RENDERBEAST_INC_NOFILTER} ${BS_RENDERBEAST_SRC_NOFILTER})
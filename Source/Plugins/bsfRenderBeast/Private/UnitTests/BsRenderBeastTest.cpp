@@ -0,0 +1,16 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsConsoleTestOutput.h"
+#include "Private/UnitTests/BsRenderBeastTestSuite.h"
+
+using namespace bs;
+
+int main()
+{
+	SPtr<TestSuite> tests = RenderBeastTestSuite::create<RenderBeastTestSuite>();
+
+	ConsoleTestOutput testOutput;
+	tests->run(testOutput);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/UnitTests/BsRenderBeastTestSuite.h"
+#include "Shading/BsLightGridCPU.h"
+#include "Math/BsDegree.h"
+
+namespace bs
+{
+	/** 
+	 * Grid used by the light grid tests: 2x2 cells split into 4 depth slices, for a view looking down negative Z from
+	 * the origin. With the quadratic slice distribution the slices end at view depths of 7.25, 26, 57.25 and 101.
+	 */
+	static const Vector3I TEST_GRID_SIZE(2, 2, 4);
+	static const float TEST_NEAR_PLANE = 1.0f;
+	static const float TEST_FAR_PLANE = 101.0f;
+
+	/** Index of the first radial light in the light buffer, as if three directional lights preceded it. */
+	static const UINT32 TEST_LIGHT_START = 3;
+
+	/** Returns the index of the light grid cell at the provided position. Row 0 is at the top of the view. */
+	static UINT32 getTestCellIdx(UINT32 x, UINT32 y, UINT32 slice)
+	{
+		return (slice * TEST_GRID_SIZE[1] + y) * TEST_GRID_SIZE[0] + x;
+	}
+
+	/** Prepares a light grid for a 90 degree view with the test grid's clip planes. */
+	static void resetTestLightGrid(ct::LightGridCPU& grid, UINT32 numLights, UINT32 numProbes)
+	{
+		Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, TEST_NEAR_PLANE, TEST_FAR_PLANE);
+		grid.reset(Matrix4::IDENTITY, proj, TEST_NEAR_PLANE, TEST_FAR_PLANE, numLights, numProbes);
+	}
+
+	RenderBeastTestSuite::RenderBeastTestSuite()
+	{
+		BS_ADD_TEST(RenderBeastTestSuite::testLightGridCPU);
+		BS_ADD_TEST(RenderBeastTestSuite::testLightGridCPU_max_per_cell);
+	}
+
+	void RenderBeastTestSuite::startUp()
+	{
+	}
+
+	void RenderBeastTestSuite::shutDown()
+	{
+	}
+
+	void RenderBeastTestSuite::testLightGridCPU()
+	{
+		ct::LightGridCPU grid;
+		resetTestLightGrid(grid, 3, 1);
+
+		// Covers all cells of the first slice
+		grid.addRadialLight(Vector3(0.0f, 0.0f, -4.0f), 1.0f);
+
+		// Top right cell of the third slice
+		grid.addRadialLight(Vector3(20.0f, 20.0f, -40.0f), 2.0f);
+
+		// Bottom left cell of the third slice
+		grid.addSpotLight(Vector3(-20.0f, -20.0f, -40.0f), Vector3(-20.0f, -20.0f, -40.0f), -Vector3::UNIT_Z, 0.5f,
+			5.0f);
+
+		// Covers all cells of the last slice
+		grid.addProbe(Vector3(0.0f, 0.0f, -80.0f), 5.0f);
+
+		grid.build(TEST_GRID_SIZE, TEST_LIGHT_START, 32);
+
+		UINT32 numCells = TEST_GRID_SIZE[0] * TEST_GRID_SIZE[1] * TEST_GRID_SIZE[2];
+		const Vector<UINT32>& lightOffsetsAndSize = grid.getLightOffsetsAndSize();
+		const Vector<UINT32>& lightIndices = grid.getLightIndices();
+		const Vector<UINT32>& probeOffsetsAndSize = grid.getProbeOffsetsAndSize();
+		const Vector<UINT32>& probeIndices = grid.getProbeIndices();
+
+		BS_TEST_ASSERT(lightOffsetsAndSize.size() == numCells * 4);
+		BS_TEST_ASSERT(probeOffsetsAndSize.size() == numCells * 2);
+
+		// Expected number of radial lights, spot lights and probes, and the expected light and probe, if any, per cell
+		UINT32 expectedNumRadial[16] = { };
+		UINT32 expectedNumSpot[16] = { };
+		UINT32 expectedNumProbes[16] = { };
+		UINT32 expectedLight[16] = { };
+
+		for(UINT32 y = 0; y < 2; y++)
+		{
+			for(UINT32 x = 0; x < 2; x++)
+			{
+				UINT32 cellIdx = getTestCellIdx(x, y, 0);
+				expectedNumRadial[cellIdx] = 1;
+				expectedLight[cellIdx] = TEST_LIGHT_START + 0;
+
+				expectedNumProbes[getTestCellIdx(x, y, 3)] = 1;
+			}
+		}
+
+		expectedNumRadial[getTestCellIdx(1, 0, 2)] = 1;
+		expectedLight[getTestCellIdx(1, 0, 2)] = TEST_LIGHT_START + 1;
+
+		expectedNumSpot[getTestCellIdx(0, 1, 2)] = 1;
+		expectedLight[getTestCellIdx(0, 1, 2)] = TEST_LIGHT_START + 2;
+
+		// Each cell's lights and probes must start right after the previous cell's
+		UINT32 lightOffset = 0;
+		UINT32 probeOffset = 0;
+		for(UINT32 i = 0; i < numCells; i++)
+		{
+			UINT32 numLights = expectedNumRadial[i] + expectedNumSpot[i];
+
+			BS_TEST_ASSERT(lightOffsetsAndSize[i * 4 + 0] == lightOffset);
+			BS_TEST_ASSERT(lightOffsetsAndSize[i * 4 + 1] == expectedNumRadial[i]);
+			BS_TEST_ASSERT(lightOffsetsAndSize[i * 4 + 2] == expectedNumSpot[i]);
+			BS_TEST_ASSERT(probeOffsetsAndSize[i * 2 + 0] == probeOffset);
+			BS_TEST_ASSERT(probeOffsetsAndSize[i * 2 + 1] == expectedNumProbes[i]);
+
+			if(numLights > 0 && lightOffset < lightIndices.size())
+				BS_TEST_ASSERT(lightIndices[lightOffset] == expectedLight[i]);
+
+			if(expectedNumProbes[i] > 0 && probeOffset < probeIndices.size())
+				BS_TEST_ASSERT(probeIndices[probeOffset] == 0);
+
+			lightOffset += numLights;
+			probeOffset += expectedNumProbes[i];
+		}
+
+		BS_TEST_ASSERT(lightIndices.size() == lightOffset);
+		BS_TEST_ASSERT(probeIndices.size() == probeOffset);
+	}
+
+	void RenderBeastTestSuite::testLightGridCPU_max_per_cell()
+	{
+		static const UINT32 MAX_PER_CELL = 8;
+		static const UINT32 NUM_LIGHTS = MAX_PER_CELL + 5;
+
+		// More lights than fit into a cell, all covering every cell of the first slice
+		ct::LightGridCPU grid;
+		resetTestLightGrid(grid, NUM_LIGHTS, 0);
+
+		for(UINT32 i = 0; i < NUM_LIGHTS; i++)
+			grid.addRadialLight(Vector3(0.0f, 0.0f, -4.0f), 1.0f);
+
+		grid.build(TEST_GRID_SIZE, TEST_LIGHT_START, MAX_PER_CELL);
+
+		const Vector<UINT32>& lightOffsetsAndSize = grid.getLightOffsetsAndSize();
+		const Vector<UINT32>& lightIndices = grid.getLightIndices();
+
+		UINT32 numCellsPerSlice = TEST_GRID_SIZE[0] * TEST_GRID_SIZE[1];
+		for(UINT32 i = 0; i < numCellsPerSlice; i++)
+		{
+			BS_TEST_ASSERT(lightOffsetsAndSize[i * 4 + 0] == i * MAX_PER_CELL);
+			BS_TEST_ASSERT(lightOffsetsAndSize[i * 4 + 1] == MAX_PER_CELL);
+			BS_TEST_ASSERT(lightOffsetsAndSize[i * 4 + 2] == 0);
+		}
+
+		BS_TEST_ASSERT(lightIndices.size() == numCellsPerSlice * MAX_PER_CELL);
+		BS_TEST_ASSERT(lightOffsetsAndSize[numCellsPerSlice * 4 + 0] == numCellsPerSlice * MAX_PER_CELL);
+	}
+}
\ No newline at end of file
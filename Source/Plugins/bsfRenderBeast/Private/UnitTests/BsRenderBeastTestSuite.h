@@ -0,0 +1,20 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsTestSuite.h"
+
+namespace bs
+{
+	class RenderBeastTestSuite : public TestSuite
+	{
+	public:
+		RenderBeastTestSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void testLightGridCPU();
+		void testLightGridCPU_max_per_cell();
+	};
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "BsRendererView.h"
 #include "BsRendererLight.h"
 #include "BsRendererReflectionProbe.h"
+#include "Profiling/BsProfilerCPU.h"
 
 namespace bs { namespace ct
 {
@@ -234,7 +235,7 @@ namespace bs { namespace ct
 	}
 
 	void LightGrid::updateGrid(const RendererView& view, const VisibleLightData& lightData, const VisibleReflProbeData& probeData,
-		bool noLighting)
+		bool noLighting, bool onCPU)
 	{
 		const RendererViewProperties& viewProps = view.getProperties();
 
@@ -279,6 +280,13 @@ namespace bs { namespace ct
 		gLightGridParamDefDef.gMaxNumLightsPerCell.set(mGridParamBuffer, MAX_LIGHTS_PER_CELL);
 		gLightGridParamDefDef.gGridPixelSize.set(mGridParamBuffer, Vector2I(CELL_XY_SIZE, CELL_XY_SIZE));
 
+		mBuiltOnCPU = onCPU;
+		if(onCPU)
+		{
+			updateGridCPU(view, gridSize, lightData, probeData, lightCount, lightStrides);
+			return;
+		}
+
 		LightGridLLCreationMat* creationMat = LightGridLLCreationMat::get();
 		creationMat->setParams(gridSize, mGridParamBuffer, lightData.getLightBuffer(), probeData.getProbeBuffer());
 		creationMat->execute(view);
@@ -298,8 +306,105 @@ namespace bs { namespace ct
 		SPtr<GpuBuffer>& gridProbeOffsetsAndSize, SPtr<GpuBuffer>& gridProbeIndices, 
 		SPtr<GpuParamBlockBuffer>& gridParams) const
 	{
-		LightGridLLReductionMat* reductionMat = LightGridLLReductionMat::get();
-		reductionMat->getOutputs(gridLightOffsetsAndSize, gridLightIndices, gridProbeOffsetsAndSize, gridProbeIndices);
+		if(mBuiltOnCPU)
+		{
+			gridLightOffsetsAndSize = mGridLightOffsetAndSize;
+			gridLightIndices = mGridLightIndices;
+			gridProbeOffsetsAndSize = mGridProbeOffsetAndSize;
+			gridProbeIndices = mGridProbeIndices;
+		}
+		else
+		{
+			LightGridLLReductionMat* reductionMat = LightGridLLReductionMat::get();
+			reductionMat->getOutputs(gridLightOffsetsAndSize, gridLightIndices, gridProbeOffsetsAndSize, 
+				gridProbeIndices);
+		}
+
 		gridParams = mGridParamBuffer;
 	}
-}}
+
+	void LightGrid::updateGridCPU(const RendererView& view, const Vector3I& gridSize, 
+		const VisibleLightData& lightData, const VisibleReflProbeData& probeData, const Vector4I& lightCounts, 
+		const Vector2I& lightStrides)
+	{
+		gProfilerCPU().beginSample("LightGridCPU");
+
+		const RendererViewProperties& viewProps = view.getProperties();
+
+		// Radial and spot lights are placed sequentially in the light buffer, with radial lights first
+		UINT32 numRadialLights = lightCounts[1];
+		UINT32 numLights = lightCounts[1] + lightCounts[2];
+		UINT32 lightStart = lightStrides[0];
+		UINT32 numProbes = probeData.getNumProbes();
+
+		mCPUGrid.reset(viewProps.viewTransform, viewProps.projTransform, viewProps.nearPlane, viewProps.farPlane,
+			numLights, numProbes);
+
+		for(UINT32 i = 0; i < numLights; i++)
+		{
+			const LightData& light = lightData.getLightData(lightStart + i);
+
+			if(i < numRadialLights)
+				mCPUGrid.addRadialLight(light.position, light.attRadius);
+			else
+			{
+				mCPUGrid.addSpotLight(light.position, light.shiftedLightPosition, light.direction, light.spotAngles.x,
+					light.attRadius);
+			}
+		}
+
+		for(UINT32 i = 0; i < numProbes; i++)
+		{
+			const ReflProbeData& probe = probeData.getProbeData(i);
+			mCPUGrid.addProbe(probe.position, probe.radius);
+		}
+
+		mCPUGrid.build(gridSize, lightStart, MAX_LIGHTS_PER_CELL);
+
+		// Create output buffers, matching the ones created by LightGridLLReductionMat
+		UINT32 numCells = gridSize[0] * gridSize[1] * gridSize[2];
+		if(numCells > mBufferNumCells || mBufferNumCells == 0)
+		{
+			GPU_BUFFER_DESC desc;
+			desc.elementCount = numCells;
+			desc.format = BF_32X4U;
+			desc.usage = GBU_DYNAMIC;
+			desc.type = GBT_STANDARD;
+			desc.elementSize = 0;
+
+			mGridLightOffsetAndSize = GpuBuffer::create(desc);
+
+			desc.format = BF_32X2U;
+			mGridProbeOffsetAndSize = GpuBuffer::create(desc);
+
+			desc.format = BF_32X1U;
+			desc.elementCount = numCells * MAX_LIGHTS_PER_CELL;
+			mGridLightIndices = GpuBuffer::create(desc);
+			mGridProbeIndices = GpuBuffer::create(desc);
+
+			mBufferNumCells = numCells;
+		}
+
+		const Vector<UINT32>& lightOffsetsAndSize = mCPUGrid.getLightOffsetsAndSize();
+		mGridLightOffsetAndSize->writeData(0, numCells * 4 * sizeof(UINT32), lightOffsetsAndSize.data(), BWT_DISCARD);
+
+		const Vector<UINT32>& lightIndices = mCPUGrid.getLightIndices();
+		if(!lightIndices.empty())
+		{
+			UINT32 size = (UINT32)lightIndices.size() * sizeof(UINT32);
+			mGridLightIndices->writeData(0, size, lightIndices.data(), BWT_DISCARD);
+		}
+
+		const Vector<UINT32>& probeOffsetsAndSize = mCPUGrid.getProbeOffsetsAndSize();
+		mGridProbeOffsetAndSize->writeData(0, numCells * 2 * sizeof(UINT32), probeOffsetsAndSize.data(), BWT_DISCARD);
+
+		const Vector<UINT32>& probeIndices = mCPUGrid.getProbeIndices();
+		if(!probeIndices.empty())
+		{
+			UINT32 size = (UINT32)probeIndices.size() * sizeof(UINT32);
+			mGridProbeIndices->writeData(0, size, probeIndices.data(), BWT_DISCARD);
+		}
+
+		gProfilerCPU().endSample("LightGridCPU");
+	}
+}}
\ No newline at end of file
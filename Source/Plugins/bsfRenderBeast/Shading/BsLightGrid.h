@@ -5,6 +5,7 @@
 #include "BsRenderBeastPrerequisites.h"
 #include "Renderer/BsRendererMaterial.h"
 #include "Renderer/BsParamBlocks.h"
+#include "Shading/BsLightGridCPU.h"
 
 namespace bs { namespace ct
 {
@@ -126,9 +127,18 @@ namespace bs { namespace ct
 	public:
 		LightGrid();
 
-		/** Updates the light grid from the provided view. */
+		/** 
+		 * Updates the light grid from the provided view. 
+		 *
+		 * @param[in]	view		View whose frustum to subdivide into the grid.
+		 * @param[in]	lightData	Lights visible from the view.
+		 * @param[in]	probeData	Reflection probes visible from the view.
+		 * @param[in]	noLighting	If true no lights will be assigned to grid cells.
+		 * @param[in]	onCPU		If true, lights and probes are assigned to grid cells on the CPU and the results
+		 *							are uploaded to the GPU, instead of being computed on the GPU.
+		 */
 		void updateGrid(const RendererView& view, const VisibleLightData& lightData, const VisibleReflProbeData& probeData, 
-			bool noLighting);
+			bool noLighting, bool onCPU);
 
 		/** 
 		 * Returns the buffers containing light indices per grid cell and global grid parameters. 
@@ -151,7 +161,25 @@ namespace bs { namespace ct
 			SPtr<GpuParamBlockBuffer>& gridParams) const;
 
 	private:
+		/** 
+		 * Assigns lights and reflection probes to grid cells on the CPU and writes the results into buffers in the same
+		 * format as produced by LightGridLLReductionMat.
+		 */
+		void updateGridCPU(const RendererView& view, const Vector3I& gridSize, const VisibleLightData& lightData, 
+			const VisibleReflProbeData& probeData, const Vector4I& lightCounts, const Vector2I& lightStrides);
+
 		SPtr<GpuParamBlockBuffer> mGridParamBuffer;
+
+		// Outputs of the CPU path, in the same format as the outputs of LightGridLLReductionMat
+		bool mBuiltOnCPU = false;
+		UINT32 mBufferNumCells = 0;
+		SPtr<GpuBuffer> mGridLightOffsetAndSize;
+		SPtr<GpuBuffer> mGridLightIndices;
+		SPtr<GpuBuffer> mGridProbeOffsetAndSize;
+		SPtr<GpuBuffer> mGridProbeIndices;
+
+		// Builds the grid for the CPU path, kept around to avoid re-allocating its temporary data every frame
+		LightGridCPU mCPUGrid;
 	};
 
 	/** @} */
@@ -0,0 +1,376 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Shading/BsLightGridCPU.h"
+#include "Math/BsMath.h"
+#include "Math/BsVector2.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs { namespace ct
+{
+	/** Number of spheres tested against a grid cell at once. */
+	static constexpr UINT32 SIMD_WIDTH = 4;
+
+	/** Minimum number of cell vs. sphere tests worth running on a separate task. */
+	static constexpr UINT32 MIN_TESTS_PER_TASK = 16384;
+
+	void LightGridCPU::CullSpheres::reset(UINT32 count)
+	{
+		UINT32 capacity = Math::divideAndRoundUp(count, SIMD_WIDTH) * SIMD_WIDTH;
+
+		x.clear();
+		y.clear();
+		z.clear();
+		radiusSqrd.clear();
+
+		x.reserve(capacity);
+		y.reserve(capacity);
+		z.reserve(capacity);
+		radiusSqrd.reserve(capacity);
+
+		this->count = 0;
+	}
+
+	void LightGridCPU::CullSpheres::add(const Vector3& center, float radius)
+	{
+		x.push_back(center.x);
+		y.push_back(center.y);
+		z.push_back(center.z);
+		radiusSqrd.push_back(radius * radius);
+
+		count++;
+	}
+
+	void LightGridCPU::CullSpheres::pad()
+	{
+		// Negative squared radius fails the intersection test, since the squared distance is never negative
+		while(x.size() % SIMD_WIDTH != 0)
+		{
+			x.push_back(0.0f);
+			y.push_back(0.0f);
+			z.push_back(0.0f);
+			radiusSqrd.push_back(-1.0f);
+		}
+	}
+
+	/** Returns the view space depth of a depth slice boundary. Matches calcViewZFromCellZ in LightGridCommon.bslinc. */
+	static float calcViewZFromCellZ(UINT32 cellZ, UINT32 numSlices, float nearPlane, float farPlane)
+	{
+		float slice = cellZ / (float)numSlices;
+		return -(slice * slice * (farPlane - nearPlane) + nearPlane);
+	}
+
+	/** Converts normalized device XY coordinates at the provided view space depth into view space XY coordinates. */
+	static Vector2 ndcToViewXY(const Matrix4& proj, float ndcX, float ndcY, float viewZ)
+	{
+		float w = proj[3][2] * viewZ + proj[3][3];
+
+		Vector2 output;
+		output.x = (ndcX * w - proj[0][2] * viewZ - proj[0][3]) / proj[0][0];
+		output.y = (ndcY * w - proj[1][2] * viewZ - proj[1][3]) / proj[1][1];
+
+		return output;
+	}
+
+	/** Checks if a spot light cone intersects a sphere. */
+	static bool intersects(const Vector3& center, float radius, const Vector3& apex, const Vector3& direction, 
+		float cosAngle, float sinAngle, float range)
+	{
+		Vector3 toCenter = center - apex;
+		float distSqrd = toCenter.squaredLength();
+		float distAlongAxis = toCenter.dot(direction);
+
+		if(distAlongAxis > radius + range || distAlongAxis < -radius)
+			return false;
+
+		float distFromAxis = std::sqrt(std::max(distSqrd - distAlongAxis * distAlongAxis, 0.0f));
+		float distFromCone = cosAngle * distFromAxis - distAlongAxis * sinAngle;
+
+		return distFromCone <= radius;
+	}
+
+	/** 
+	 * Tests an axis aligned box against a list of spheres, SIMD_WIDTH spheres at a time, and appends the indices of the
+	 * intersecting spheres, offset by @p indexOffset, to @p output. Returns the number of appended indices, which is
+	 * at most @p maxCount. Indices for which @p filter returns false are skipped.
+	 */
+	template<class T>
+	static UINT32 cullSpheres(const simd::AABox& box, const Vector<float>& x, const Vector<float>& y, 
+		const Vector<float>& z, const Vector<float>& radiusSqrd, UINT32 indexOffset, UINT32 maxCount,
+		Vector<UINT32>& output, T filter)
+	{
+		simd::float32x4 centerX = simd::splat<simd::float32x4>(box.center.x);
+		simd::float32x4 centerY = simd::splat<simd::float32x4>(box.center.y);
+		simd::float32x4 centerZ = simd::splat<simd::float32x4>(box.center.z);
+
+		simd::float32x4 extentX = simd::splat<simd::float32x4>(box.extents.x);
+		simd::float32x4 extentY = simd::splat<simd::float32x4>(box.extents.y);
+		simd::float32x4 extentZ = simd::splat<simd::float32x4>(box.extents.z);
+
+		simd::float32x4 zero = simd::splat<simd::float32x4>(0.0f);
+
+		UINT32 numAdded = 0;
+		UINT32 numSpheres = (UINT32)x.size();
+		for(UINT32 i = 0; i < numSpheres && numAdded < maxCount; i += SIMD_WIDTH)
+		{
+			// Distance from the sphere center to the box, per axis
+			simd::float32x4 sphereX = simd::load_u<simd::float32x4>(&x[i]);
+			simd::float32x4 sphereY = simd::load_u<simd::float32x4>(&y[i]);
+			simd::float32x4 sphereZ = simd::load_u<simd::float32x4>(&z[i]);
+
+			simd::float32x4 distX = simd::sub(simd::abs(simd::sub(sphereX, centerX)), extentX);
+			simd::float32x4 distY = simd::sub(simd::abs(simd::sub(sphereY, centerY)), extentY);
+			simd::float32x4 distZ = simd::sub(simd::abs(simd::sub(sphereZ, centerZ)), extentZ);
+
+			distX = simd::max(distX, zero);
+			distY = simd::max(distY, zero);
+			distZ = simd::max(distZ, zero);
+
+			simd::float32x4 distSqrd = simd::add(simd::add(simd::mul(distX, distX), simd::mul(distY, distY)), 
+				simd::mul(distZ, distZ));
+
+			simd::uint32x4 mask = simd::bit_cast<simd::uint32x4>(
+				simd::cmp_le(distSqrd, simd::load_u<simd::float32x4>(&radiusSqrd[i])));
+
+			if(!simd::test_bits_any(mask))
+				continue;
+
+			SIMDPP_ALIGN(16) UINT32 results[SIMD_WIDTH];
+			simd::store(results, mask);
+
+			for(UINT32 j = 0; j < SIMD_WIDTH && numAdded < maxCount; j++)
+			{
+				if(results[j] == 0 || !filter(i + j))
+					continue;
+
+				output.push_back(indexOffset + i + j);
+				numAdded++;
+			}
+		}
+
+		return numAdded;
+	}
+
+	void LightGridCPU::reset(const Matrix4& viewTfrm, const Matrix4& projTfrm, float nearPlane, float farPlane,
+		UINT32 numLights, UINT32 numProbes)
+	{
+		mViewTfrm = viewTfrm;
+		mProjTfrm = projTfrm;
+		mNearPlane = nearPlane;
+		mFarPlane = farPlane;
+
+		mLightSpheres.reset(numLights);
+		mProbeSpheres.reset(numProbes);
+		mSpotCones.clear();
+		mNumRadialLights = 0;
+	}
+
+	void LightGridCPU::addRadialLight(const Vector3& position, float radius)
+	{
+		assert(mSpotCones.empty());
+
+		mLightSpheres.add(mViewTfrm.multiplyAffine(position), radius);
+		mNumRadialLights++;
+	}
+
+	void LightGridCPU::addSpotLight(const Vector3& position, const Vector3& shiftedPosition, const Vector3& direction,
+		float angle, float radius)
+	{
+		mLightSpheres.add(mViewTfrm.multiplyAffine(position), radius);
+
+		// Area spot lights are shifted back along their direction, extend the cone to cover the shift
+		SpotCone cone;
+		cone.apex = mViewTfrm.multiplyAffine(shiftedPosition);
+		cone.direction = mViewTfrm.multiplyDirection(direction);
+		cone.cosAngle = Math::cos(angle);
+		cone.sinAngle = Math::sin(angle);
+		cone.range = radius + position.distance(shiftedPosition);
+
+		mSpotCones.push_back(cone);
+	}
+
+	void LightGridCPU::addProbe(const Vector3& position, float radius)
+	{
+		mProbeSpheres.add(mViewTfrm.multiplyAffine(position), radius);
+	}
+
+	void LightGridCPU::build(const Vector3I& gridSize, UINT32 lightStart, UINT32 maxPerCell)
+	{
+		mLightSpheres.pad();
+		mProbeSpheres.pad();
+
+		// Assign lights and probes to cells, in parallel over depth slices
+		UINT32 numSlices = (UINT32)gridSize[2];
+		if(mSlices.size() < numSlices)
+			mSlices.resize(numSlices);
+
+		auto worker = [this, &gridSize, lightStart, maxPerCell](UINT32 start, UINT32 end)
+		{
+			for(UINT32 i = start; i < end; i++)
+				buildSlice(gridSize, i, lightStart, maxPerCell);
+		};
+
+		UINT32 numCells = gridSize[0] * gridSize[1] * gridSize[2];
+		UINT32 numTests = numCells * (mLightSpheres.count + mProbeSpheres.count);
+
+		UINT32 numTasks = 1;
+		if(TaskScheduler::isStarted())
+		{
+			UINT32 maxTasks = TaskScheduler::instance().getNumWorkers() + 1;
+			numTasks = std::min(std::min(maxTasks, numSlices), numTests / MIN_TESTS_PER_TASK);
+		}
+
+		if(numTasks <= 1)
+			worker(0, numSlices);
+		else
+		{
+			UINT32 rangeSize = Math::divideAndRoundUp(numSlices, numTasks);
+
+			Vector<SPtr<Task>> tasks;
+			for(UINT32 start = rangeSize; start < numSlices; start += rangeSize)
+			{
+				UINT32 end = std::min(start + rangeSize, numSlices);
+				tasks.push_back(Task::create("LightGridCPU", [&worker, start, end]() { worker(start, end); }));
+
+				TaskScheduler::instance().addTask(tasks.back());
+			}
+
+			worker(0, rangeSize);
+
+			for(auto& task : tasks)
+				task->wait();
+		}
+
+		// Concatenate the per-slice lists. Cells are ordered slice by slice, so slice lists are appended one after
+		// another.
+		UINT32 numCellsPerSlice = gridSize[0] * gridSize[1];
+
+		mLightOffsetsAndSize.resize(numCells * 4);
+		mLightIndices.clear();
+		mProbeOffsetsAndSize.resize(numCells * 2);
+		mProbeIndices.clear();
+
+		UINT32 cellIdx = 0;
+		for(UINT32 i = 0; i < numSlices; i++)
+		{
+			const Slice& slice = mSlices[i];
+
+			UINT32 lightOffset = (UINT32)mLightIndices.size();
+			UINT32 probeOffset = (UINT32)mProbeIndices.size();
+			for(UINT32 j = 0; j < numCellsPerSlice; j++)
+			{
+				UINT32 numRadial = slice.lightCounts[j * 2 + 0];
+				UINT32 numSpot = slice.lightCounts[j * 2 + 1];
+
+				mLightOffsetsAndSize[cellIdx * 4 + 0] = lightOffset;
+				mLightOffsetsAndSize[cellIdx * 4 + 1] = numRadial;
+				mLightOffsetsAndSize[cellIdx * 4 + 2] = numSpot;
+				mLightOffsetsAndSize[cellIdx * 4 + 3] = 0;
+
+				UINT32 numProbes = slice.probeCounts[j];
+
+				mProbeOffsetsAndSize[cellIdx * 2 + 0] = probeOffset;
+				mProbeOffsetsAndSize[cellIdx * 2 + 1] = numProbes;
+
+				lightOffset += numRadial + numSpot;
+				probeOffset += numProbes;
+				cellIdx++;
+			}
+
+			mLightIndices.insert(mLightIndices.end(), slice.lightIndices.begin(), slice.lightIndices.end());
+			mProbeIndices.insert(mProbeIndices.end(), slice.probeIndices.begin(), slice.probeIndices.end());
+		}
+	}
+
+	void LightGridCPU::buildSlice(const Vector3I& gridSize, UINT32 sliceIdx, UINT32 lightStart, UINT32 maxPerCell)
+	{
+		const Matrix4& proj = mProjTfrm;
+
+		UINT32 numCellsPerSlice = gridSize[0] * gridSize[1];
+
+		Slice& slice = mSlices[sliceIdx];
+		slice.lightCounts.resize(numCellsPerSlice * 2);
+		slice.lightIndices.clear();
+		slice.probeCounts.resize(numCellsPerSlice);
+		slice.probeIndices.clear();
+
+		// Because we're viewing along negative Z, farther end is the minimum
+		float viewZMin = calcViewZFromCellZ(sliceIdx + 1, gridSize[2], mNearPlane, mFarPlane);
+		float viewZMax = calcViewZFromCellZ(sliceIdx, gridSize[2], mNearPlane, mFarPlane);
+
+		// Flip Y depending on render API, same as calcCellAABB in LightGridLLCreation.bsl, so the origin is top left
+		float flipY = -Math::sign(proj[1][1]);
+
+		auto isInSpotCone = [this](UINT32 idx, const Vector3& center, float radius)
+		{
+			if(idx < mNumRadialLights)
+				return true;
+
+			const SpotCone& cone = mSpotCones[idx - mNumRadialLights];
+			return intersects(center, radius, cone.apex, cone.direction, cone.cosAngle, cone.sinAngle, cone.range);
+		};
+
+		for(INT32 y = 0; y < gridSize[1]; y++)
+		{
+			for(INT32 x = 0; x < gridSize[0]; x++)
+			{
+				// Calculate the cell bounds in view space, same as calcCellAABB in LightGridLLCreation.bsl
+				float ndcMinX = x * 2.0f / gridSize[0] - 1.0f;
+				float ndcMaxX = (x + 1) * 2.0f / gridSize[0] - 1.0f;
+				float ndcMinY = (y * 2.0f / gridSize[1] - 1.0f) * flipY;
+				float ndcMaxY = ((y + 1) * 2.0f / gridSize[1] - 1.0f) * flipY;
+
+				Vector2 viewMin(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+				Vector2 viewMax(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+				for(float viewZ : { viewZMin, viewZMax })
+				{
+					Vector2 corners[] =
+					{
+						ndcToViewXY(proj, ndcMinX, ndcMinY, viewZ),
+						ndcToViewXY(proj, ndcMaxX, ndcMinY, viewZ),
+						ndcToViewXY(proj, ndcMaxX, ndcMaxY, viewZ),
+						ndcToViewXY(proj, ndcMinX, ndcMaxY, viewZ)
+					};
+
+					for(auto& corner : corners)
+					{
+						viewMin = Vector2::min(viewMin, corner);
+						viewMax = Vector2::max(viewMax, corner);
+					}
+				}
+
+				Vector3 extents((viewMax.x - viewMin.x) * 0.5f, (viewMax.y - viewMin.y) * 0.5f, 
+					(viewZMax - viewZMin) * 0.5f);
+				Vector3 center(viewMin.x + extents.x, viewMin.y + extents.y, viewZMin + extents.z);
+
+				simd::AABox box;
+				box.center = Vector4(center);
+				box.extents = Vector4(extents);
+
+				float boundingRadius = extents.length();
+				UINT32 cellIdx = y * gridSize[0] + x;
+
+				// Radial lights are tested first, so their indices end up before spot light indices, as is the
+				// convention. Spot lights additionally get tested against their cone.
+				UINT32 firstLight = (UINT32)slice.lightIndices.size();
+				UINT32 numLights = cullSpheres(box, mLightSpheres.x, mLightSpheres.y, mLightSpheres.z, 
+					mLightSpheres.radiusSqrd, lightStart, maxPerCell, slice.lightIndices,
+					[&](UINT32 idx) { return isInSpotCone(idx, center, boundingRadius); });
+
+				UINT32 numRadial = 0;
+				for(UINT32 i = 0; i < numLights; i++)
+				{
+					if(slice.lightIndices[firstLight + i] - lightStart < mNumRadialLights)
+						numRadial++;
+				}
+
+				slice.lightCounts[cellIdx * 2 + 0] = numRadial;
+				slice.lightCounts[cellIdx * 2 + 1] = numLights - numRadial;
+
+				slice.probeCounts[cellIdx] = cullSpheres(box, mProbeSpheres.x, mProbeSpheres.y, mProbeSpheres.z,
+					mProbeSpheres.radiusSqrd, 0, maxPerCell, slice.probeIndices,
+					[](UINT32 idx) { return true; });
+			}
+		}
+	}
+}}
\ No newline at end of file
@@ -0,0 +1,151 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsVector3I.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/**
+	 * Assigns lights and reflection probes to light grid cells on the CPU. Outputs are stored in system memory, in the
+	 * same format as the outputs of LightGridLLReductionMat. Doesn't depend on views or GPU resources, so it can be
+	 * used outside of the renderer.
+	 */
+	class LightGridCPU
+	{
+	public:
+		/**
+		 * Removes all lights and reflection probes and sets up the view the grid is built for.
+		 *
+		 * @param[in]	viewTfrm		Transform from world to view space.
+		 * @param[in]	projTfrm		Projection transform of the view.
+		 * @param[in]	nearPlane		Distance to the view's near clip plane.
+		 * @param[in]	farPlane		Distance to the view's far clip plane.
+		 * @param[in]	numLights		Number of radial and spot lights that will be added.
+		 * @param[in]	numProbes		Number of reflection probes that will be added.
+		 */
+		void reset(const Matrix4& viewTfrm, const Matrix4& projTfrm, float nearPlane, float farPlane, UINT32 numLights,
+			UINT32 numProbes);
+
+		/** Adds a radial light, in world space. All radial lights must be added before any spot lights. */
+		void addRadialLight(const Vector3& position, float radius);
+
+		/**
+		 * Adds a spot light, in world space.
+		 *
+		 * @param[in]	position		Position of the light.
+		 * @param[in]	shiftedPosition	Position the light cone starts at. Differs from @p position for area lights.
+		 * @param[in]	direction		Direction the light is pointing at.
+		 * @param[in]	angle			Angle of the light cone, in radians.
+		 * @param[in]	radius			Radius of the light's influence.
+		 */
+		void addSpotLight(const Vector3& position, const Vector3& shiftedPosition, const Vector3& direction,
+			float angle, float radius);
+
+		/** Adds a reflection probe, in world space. */
+		void addProbe(const Vector3& position, float radius);
+
+		/**
+		 * Assigns the added lights and reflection probes to the grid cells. Depth slices are processed in parallel if
+		 * the task scheduler is running and there is enough work.
+		 *
+		 * @param[in]	gridSize		Number of cells along the view's width, height and depth.
+		 * @param[in]	lightStart		Index of the first radial light in the light buffer. Added to the output
+		 *								light indices.
+		 * @param[in]	maxPerCell		Maximum number of lights, and separately of reflection probes, in a single
+		 *								cell.
+		 */
+		void build(const Vector3I& gridSize, UINT32 lightStart, UINT32 maxPerCell);
+
+		/**
+		 * Returns four entries per grid cell: offset into the light index list, number of radial lights, number of spot
+		 * lights, and an unused entry. Cells are ordered by depth slice, then by row, then by column.
+		 */
+		const Vector<UINT32>& getLightOffsetsAndSize() const { return mLightOffsetsAndSize; }
+
+		/** Returns indices of the lights affecting the grid cells. Radial lights come first in each cell. */
+		const Vector<UINT32>& getLightIndices() const { return mLightIndices; }
+
+		/**
+		 * Returns two entries per grid cell: offset into the reflection probe index list, and number of reflection
+		 * probes. Cells are in the same order as in getLightOffsetsAndSize().
+		 */
+		const Vector<UINT32>& getProbeOffsetsAndSize() const { return mProbeOffsetsAndSize; }
+
+		/** Returns indices of the reflection probes affecting the grid cells. */
+		const Vector<UINT32>& getProbeIndices() const { return mProbeIndices; }
+
+	private:
+		/** Bounding spheres in view space, stored in a layout suitable for SIMD testing. */
+		struct CullSpheres
+		{
+			/** Clears all spheres and reserves space for @p count spheres, including padding. */
+			void reset(UINT32 count);
+
+			/** Appends a new sphere. */
+			void add(const Vector3& center, float radius);
+
+			/** Pads the sphere list so its size is a multiple of the SIMD width, with spheres that never intersect. */
+			void pad();
+
+			Vector<float> x;
+			Vector<float> y;
+			Vector<float> z;
+			Vector<float> radiusSqrd;
+			UINT32 count = 0;
+		};
+
+		/** Cone of influence of a spot light in view space. */
+		struct SpotCone
+		{
+			Vector3 apex;
+			Vector3 direction;
+			float cosAngle;
+			float sinAngle;
+			float range;
+		};
+
+		/** Lights and reflection probes affecting the cells of a single depth slice of the grid. */
+		struct Slice
+		{
+			/** Number of radial and spot lights affecting each cell, two entries per cell. */
+			Vector<UINT32> lightCounts;
+
+			/** Indices of lights affecting each cell, placed sequentially in cell order. */
+			Vector<UINT32> lightIndices;
+
+			/** Number of reflection probes affecting each cell. */
+			Vector<UINT32> probeCounts;
+
+			/** Indices of reflection probes affecting each cell, placed sequentially in cell order. */
+			Vector<UINT32> probeIndices;
+		};
+
+		/** Assigns lights and reflection probes to the cells of the depth slice at index @p sliceIdx. */
+		void buildSlice(const Vector3I& gridSize, UINT32 sliceIdx, UINT32 lightStart, UINT32 maxPerCell);
+
+		Matrix4 mViewTfrm = Matrix4::IDENTITY;
+		Matrix4 mProjTfrm = Matrix4::IDENTITY;
+		float mNearPlane = 0.0f;
+		float mFarPlane = 0.0f;
+
+		CullSpheres mLightSpheres;
+		CullSpheres mProbeSpheres;
+		Vector<SpotCone> mSpotCones;
+		UINT32 mNumRadialLights = 0;
+		Vector<Slice> mSlices;
+
+		Vector<UINT32> mLightOffsetsAndSize;
+		Vector<UINT32> mLightIndices;
+		Vector<UINT32> mProbeOffsetsAndSize;
+		Vector<UINT32> mProbeIndices;
+	};
+
+	/** @} */
+}}
\ No newline at end of file
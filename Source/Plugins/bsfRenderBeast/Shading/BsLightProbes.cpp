@@ -11,6 +11,7 @@
 #include "Renderer/BsRendererUtility.h"
 #include "Renderer/BsSkybox.h"
 #include "Utility/BsRendererTextures.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs { namespace ct 
 {
@@ -210,10 +211,44 @@ namespace bs { namespace ct
 		float padding[3];
 	};
 
+	/** Input and output of a single tetrahedralization of the light probe volume, performed on a worker thread. */
+	struct LightProbes::TetrahedronBuild
+	{
+		/** World positions of all active probes. Extended with extrapolation volume vertices during the build. */
+		Vector<Vector3> positions;
+
+		/** Index of the SH coefficients of each probe in @p positions. */
+		Vector<UINT32> bufferIndices;
+
+		/** Location of the SH coefficients of each probe in @p positions, within the coefficient texture. */
+		Vector<Vector2I> bufferOffsets;
+
+		/** Mesh representing the entire light probe volume. */
+		SPtr<MeshData> meshData;
+
+		/** Data to upload to the tetrahedron buffer. Valid tetrahedra followed by outer faces. */
+		Vector<TetrahedronDataGPU> tetrahedra;
+
+		/** Data to upload to the tetrahedron face buffer. */
+		Vector<TetrahedronFaceDataGPU> faces;
+
+		/** Number of valid tetrahedra at the start of @p tetrahedra. */
+		UINT32 numValidTetrahedra = 0;
+	};
+
 	LightProbes::LightProbes()
-		:mTetrahedronVolumeDirty(false), mMaxCoefficientRows(0), mMaxTetrahedra(0), mMaxFaces(0), mNumValidTetrahedra(0)
+		:mTetrahedronVolumeDirty(false), mCoefficientsDirty(false), mVolumesChanged(false)
+		, mCoefficientRowsChanged(false), mMaxCoefficientRows(0), mMaxTetrahedra(0), mMaxFaces(0)
+		, mNumValidTetrahedra(0)
 	{ }
 
+	LightProbes::~LightProbes()
+	{
+		// Build task references the data owned by this object
+		if (mBuildTask != nullptr)
+			mBuildTask->wait();
+	}
+
 	void LightProbes::notifyAdded(LightProbeVolume* volume)
 	{
 		UINT32 handle = (UINT32)mVolumes.size();
@@ -221,10 +256,15 @@ namespace bs { namespace ct
 		VolumeInfo info;
 		info.volume = volume;
 		info.isDirty = true;
+		info.coefficientRow = (UINT32)-1;
+		info.numCoefficientRows = 0;
+		info.geometryHash = 0;
 
 		mVolumes.push_back(info);
 		volume->setRendererId(handle);
 
+		mVolumesChanged = true;
+		mTetrahedronVolumeDirty = true;
 		notifyDirty(volume);
 	}
 
@@ -233,7 +273,7 @@ namespace bs { namespace ct
 		UINT32 handle = volume->getRendererId();
 		mVolumes[handle].isDirty = true;
 
-		mTetrahedronVolumeDirty = true;
+		mCoefficientsDirty = true;
 	}
 
 	void LightProbes::notifyRemoved(LightProbeVolume* volume)
@@ -253,40 +293,118 @@ namespace bs { namespace ct
 		// Erase last (empty) element
 		mVolumes.erase(mVolumes.end() - 1);
 
+		mVolumesChanged = true;
+		mCoefficientsDirty = true;
 		mTetrahedronVolumeDirty = true;
 	}
 
 	void LightProbes::updateProbes()
 	{
-		if (!mTetrahedronVolumeDirty)
+		if (mCoefficientsDirty)
+			updateCoefficients();
+
+		// When volumes are added or removed the probe buffer indices shift, and when volumes move to different rows of
+		// the coefficient texture the coefficient offsets change. In both cases the current tetrahedra (and any pending
+		// ones) reference the old layout and can no longer be used, so we must wait for the new ones. Same if there are
+		// no tetrahedra yet. Otherwise keep using the current tetrahedra until the new ones are ready.
+		bool mustWait = mVolumesChanged || mCoefficientRowsChanged || mVolumeMesh == nullptr;
+
+		if (mPendingBuild != nullptr && (mustWait || mBuildTask->isComplete()))
+			finishTetrahedronBuild();
+
+		if (!mTetrahedronVolumeDirty || mPendingBuild != nullptr)
 			return;
 
-		// Move all coefficients into the global buffer
+		startTetrahedronBuild();
+
+		if (mustWait || mBuildTask == nullptr)
+			finishTetrahedronBuild();
+
+		mVolumesChanged = false;
+		mCoefficientRowsChanged = false;
+	}
+
+	/** Returns a hash of all the information about the probes in the volume that affects the tetrahedra. */
+	static size_t getProbeGeometryHash(const LightProbeVolume& volume)
+	{
+		const Vector<LightProbeInfo>& infos = volume.getLightProbeInfos();
+		const Vector<Vector3>& positions = volume.getLightProbePositions();
+		UINT32 numProbes = volume.getNumActiveProbes();
+
+		const Transform& tfrm = volume.getTransform();
+		Vector3 position = tfrm.getPosition();
+		Quaternion rotation = tfrm.getRotation();
+
+		size_t hash = 0;
+		hash_combine(hash, hash_data(&position, sizeof(position)));
+		hash_combine(hash, hash_data(&rotation, sizeof(rotation)));
+		hash_combine(hash, (UINT32)positions.size());
+		hash_combine(hash, numProbes);
+		hash_combine(hash, hash_data(positions.data(), numProbes * sizeof(Vector3)));
+
+		for (UINT32 i = 0; i < numProbes; i++)
+			hash_combine(hash, infos[i].bufferIdx);
+
+		return hash;
+	}
+
+	void LightProbes::updateCoefficients()
+	{
+		// Assign rows in the global buffer to each volume. Volumes whose rows moved need to be copied again.
 		UINT32 numRows = 0;
 		for(auto& entry : mVolumes)
 		{
 			SPtr<Texture> localTexture = entry.volume->getCoefficientsTexture();
-			numRows += localTexture->getProperties().getHeight();
+			UINT32 height = localTexture->getProperties().getHeight();
+
+			if (entry.coefficientRow != numRows || entry.numCoefficientRows != height)
+			{
+				entry.coefficientRow = numRows;
+				entry.numCoefficientRows = height;
+				entry.isDirty = true;
+
+				// Tetrahedra reference coefficients by their position in the global texture
+				mCoefficientRowsChanged = true;
+				mTetrahedronVolumeDirty = true;
+			}
+
+			numRows += height;
 		}
 
 		if(numRows > mMaxCoefficientRows)
 			resizeCoefficientTexture(numRows + 4);
 
-		UINT32 rowIdx = 0;
+		// Move coefficients of dirty volumes into the global buffer, and check if their probes moved
 		for(auto& entry : mVolumes)
 		{
+			if (!entry.isDirty)
+				continue;
+
 			TEXTURE_COPY_DESC copyDesc;
-			copyDesc.dstPosition = Vector3I(0, rowIdx, 0);
+			copyDesc.dstPosition = Vector3I(0, entry.coefficientRow, 0);
 
 			SPtr<Texture> localTexture = entry.volume->getCoefficientsTexture();
 			localTexture->copy(mProbeCoefficientsGPU, copyDesc);
-			
-			rowIdx += localTexture->getProperties().getHeight();
+
+			size_t geometryHash = getProbeGeometryHash(*entry.volume);
+			if (geometryHash != entry.geometryHash)
+			{
+				entry.geometryHash = geometryHash;
+				mTetrahedronVolumeDirty = true;
+			}
+
+			entry.isDirty = false;
 		}
 
+		mCoefficientsDirty = false;
+	}
+
+	void LightProbes::startTetrahedronBuild()
+	{
+		mPendingBuild = bs_shared_ptr_new<TetrahedronBuild>();
+
 		// Gather all positions
 		UINT32 bufferOffset = 0;
-		rowIdx = 0;
 		for(auto& entry : mVolumes)
 		{
 			const Vector<LightProbeInfo>& infos = entry.volume->getLightProbeInfos();
@@ -305,265 +423,224 @@ namespace bs { namespace ct
 			{
 				Vector3 localPos = positions[i];
 				Vector3 transformedPos = rotation.rotate(localPos) + offset;
-				mTempTetrahedronPositions.push_back(transformedPos);
+				mPendingBuild->positions.push_back(transformedPos);
 
-				mTempTetrahedronBufferIndices.push_back(bufferOffset + infos[i].bufferIdx);
+				mPendingBuild->bufferIndices.push_back(bufferOffset + infos[i].bufferIdx);
 
 				Vector2I offset = IBLUtility::getSHCoeffXYFromIdx(infos[i].bufferIdx, 3);
-				mTempTetrahedronBufferOffsets.push_back(offset);
+				offset.y += entry.coefficientRow;
+
+				mPendingBuild->bufferOffsets.push_back(offset);
 			}
 
-			SPtr<Texture> localTexture = entry.volume->getCoefficientsTexture();
-			rowIdx += localTexture->getProperties().getHeight();
 			bufferOffset += (UINT32)positions.size();
 		}
 
-		mTetrahedronInfos.clear();
-
-		Vector<TetrahedronFaceData> outerFaces;
-		generateTetrahedronData(mTempTetrahedronPositions, mTetrahedronInfos, outerFaces, true);
-
-		// Find valid tetrahedrons
-		UINT32 numTetrahedra = (UINT32)mTetrahedronInfos.size();
+		mTetrahedronVolumeDirty = false;
 
-		bool* validTets = (bool*)bs_stack_alloc(sizeof(bool) * numTetrahedra);
-		mNumValidTetrahedra = 0;
-		for (UINT32 i = 0; i < (UINT32)mTetrahedronInfos.size(); i++)
+		// Tetrahedralization only touches the build data, so it can run on a worker thread
+		if (TaskScheduler::isStarted())
 		{
-			const TetrahedronData& entry = mTetrahedronInfos[i];
-
-			const Vector3& P1 = mTempTetrahedronPositions[entry.volume.vertices[0]];
-			const Vector3& P2 = mTempTetrahedronPositions[entry.volume.vertices[1]];
-			const Vector3& P3 = mTempTetrahedronPositions[entry.volume.vertices[2]];
-			const Vector3& P4 = mTempTetrahedronPositions[entry.volume.vertices[3]];
+			SPtr<TetrahedronBuild> build = mPendingBuild;
+			mBuildTask = Task::create("LightProbeTetrahedralize", [build]() { buildTetrahedronVolume(*build); });
 
-			Vector3 E1 = P1 - P4;
-			Vector3 E2 = P2 - P4;
-			Vector3 E3 = P3 - P4;
-
-			// If tetrahedron is co-planar just ignore it, shader will use some other nearby one instead. We can't
-			// handle coplanar tetrahedrons because the matrix is not invertible, and for nearly co-planar ones the
-			// math breaks down because of precision issues.
-			validTets[i] = fabs(Vector3::dot(Vector3::normalize(Vector3::cross(E1, E2)), E3)) > 0.0001f;
-
-			if (validTets[i])
-				mNumValidTetrahedra++;
+			TaskScheduler::instance().addTask(mBuildTask);
 		}
+		else
+			buildTetrahedronVolume(*mPendingBuild);
+	}
 
-		UINT32 numValidFaces = 0;
-		for(auto& entry : outerFaces)
-		{
-			if (validTets[entry.tetrahedron])
-				numValidFaces++;
-		}
-
-		// Generate a mesh out of all the tetrahedron triangles
-		// Note: Currently the entire volume is rendered as a single large mesh, which will isn't optimal as we can't
-		// perform frustum culling. A better option would be to split the mesh into multiple smaller volumes, do
-		// frustum culling and possibly even sort by distance from camera.
-		UINT32 numVertices = mNumValidTetrahedra * 4 * 3 + numValidFaces * 9 * 3;
-
-		SPtr<VertexDataDesc> vertexDesc = bs_shared_ptr_new<VertexDataDesc>();
-		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
-		vertexDesc->addVertElem(VET_UINT1, VES_TEXCOORD);
-
-		SPtr<MeshData> meshData = MeshData::create(numVertices, numVertices, vertexDesc);
-		auto posIter = meshData->getVec3DataIter(VES_POSITION);
-		auto idIter = meshData->getDWORDDataIter(VES_TEXCOORD);
-		UINT32* indices = meshData->getIndices32();
+	void LightProbes::buildTetrahedronVolume(TetrahedronBuild& build)
+	{
+		Vector<Vector3>& positions = build.positions;
 
-		// Insert inner tetrahedron triangles
-		UINT32 tetIdx = 0;
-		for (UINT32 i = 0; i < (UINT32)mTetrahedronInfos.size(); i++)
+		bs_frame_mark();
 		{
-			if (!validTets[i])
-				continue;
-
-			const Tetrahedron& volume = mTetrahedronInfos[i].volume;
+			Vector<TetrahedronData> tetrahedra;
+			Vector<TetrahedronFaceData> outerFaces;
+			generateTetrahedronData(positions, tetrahedra, outerFaces, true);
 
-			Vector3 center(BsZero);
-			for(UINT32 j = 0; j < 4; j++)
-				center += mTempTetrahedronPositions[volume.vertices[j]];
-
-			center /= 4.0f;
-
-			static const UINT32 Permutations[4][3] = 
-			{
-				{ 0, 1, 2 },
-				{ 0, 1, 3 },
-				{ 0, 2, 3 },
-				{ 1, 2, 3 }
-			};
+			// Find valid tetrahedrons
+			UINT32 numTetrahedra = (UINT32)tetrahedra.size();
 
-			for(UINT32 j = 0; j < 4; j++)
+			Vector<bool> validTets(numTetrahedra);
+			build.numValidTetrahedra = 0;
+			for (UINT32 i = 0; i < (UINT32)tetrahedra.size(); i++)
 			{
-				Vector3 A = mTempTetrahedronPositions[volume.vertices[Permutations[j][0]]];
-				Vector3 B = mTempTetrahedronPositions[volume.vertices[Permutations[j][1]]];
-				Vector3 C = mTempTetrahedronPositions[volume.vertices[Permutations[j][2]]];
+				const TetrahedronData& entry = tetrahedra[i];
 
-				// Make sure the triangle is clockwise, facing away from the center
-				Vector3 e0 = A - C;
-				Vector3 e1 = B - C;
-
-				Vector3 normal = e0.cross(e1);
-				if (normal.dot(A - center) > 0.0f)
-					std::swap(B, C);
+				const Vector3& P1 = positions[entry.volume.vertices[0]];
+				const Vector3& P2 = positions[entry.volume.vertices[1]];
+				const Vector3& P3 = positions[entry.volume.vertices[2]];
+				const Vector3& P4 = positions[entry.volume.vertices[3]];
 
-				posIter.addValue(A);
-				posIter.addValue(B);
-				posIter.addValue(C);
+				Vector3 E1 = P1 - P4;
+				Vector3 E2 = P2 - P4;
+				Vector3 E3 = P3 - P4;
 
-				idIter.addValue(tetIdx);
-				idIter.addValue(tetIdx);
-				idIter.addValue(tetIdx);
+				// If tetrahedron is co-planar just ignore it, shader will use some other nearby one instead. We can't
+				// handle coplanar tetrahedrons because the matrix is not invertible, and for nearly co-planar ones the
+				// math breaks down because of precision issues.
+				validTets[i] = fabs(Vector3::dot(Vector3::normalize(Vector3::cross(E1, E2)), E3)) > 0.0001f;
 
-				indices[0] = tetIdx * 4 * 3 + j * 3 + 0;
-				indices[1] = tetIdx * 4 * 3 + j * 3 + 1;
-				indices[2] = tetIdx * 4 * 3 + j * 3 + 2;
+				if (validTets[i])
+					build.numValidTetrahedra++;
+			}
 
-				indices += 3;
+			UINT32 numValidFaces = 0;
+			for(auto& entry : outerFaces)
+			{
+				if (validTets[entry.tetrahedron])
+					numValidFaces++;
 			}
 
-			tetIdx++;
-		}
+			// Generate a mesh out of all the tetrahedron triangles
+			// Note: Currently the entire volume is rendered as a single large mesh, which will isn't optimal as we
+			// can't perform frustum culling. A better option would be to split the mesh into multiple smaller volumes,
+			// do frustum culling and possibly even sort by distance from camera.
+			UINT32 numVertices = build.numValidTetrahedra * 4 * 3 + numValidFaces * 9 * 3;
 
-		// Generate an edge map for outer faces (required for step below)
-		struct Edge
-		{
-			UINT32 vertInner[2];
-			UINT32 vertOuter[2];
-			UINT32 face[2];
-		};
+			SPtr<VertexDataDesc> vertexDesc = bs_shared_ptr_new<VertexDataDesc>();
+			vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+			vertexDesc->addVertElem(VET_UINT1, VES_TEXCOORD);
 
-		FrameUnorderedMap<std::pair<INT32, INT32>, Edge, pair_hash> edgeMap;
-		for(UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
-		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
+			SPtr<MeshData> meshData = MeshData::create(numVertices, numVertices, vertexDesc);
+			auto posIter = meshData->getVec3DataIter(VES_POSITION);
+			auto idIter = meshData->getDWORDDataIter(VES_TEXCOORD);
+			UINT32* indices = meshData->getIndices32();
 
-			for (UINT32 j = 0; j < 3; ++j)
+			// Insert inner tetrahedron triangles
+			UINT32 tetIdx = 0;
+			for (UINT32 i = 0; i < (UINT32)tetrahedra.size(); i++)
 			{
-				UINT32 v0 = outerFaces[i].innerVertices[j];
-				UINT32 v1 = outerFaces[i].innerVertices[(j + 1) % 3];
+				if (!validTets[i])
+					continue;
 
-				// Keep the same ordering so other faces can find the same edge
-				if (v0 > v1)
-					std::swap(v0, v1);
+				const Tetrahedron& volume = tetrahedra[i].volume;
 
-				auto iterFind = edgeMap.find(std::make_pair((INT32)v0, (INT32)v1));
-				if (iterFind != edgeMap.end())
-				{
-					iterFind->second.face[1] = i;
-				}
-				else
+				Vector3 center(BsZero);
+				for(UINT32 j = 0; j < 4; j++)
+					center += positions[volume.vertices[j]];
+
+				center /= 4.0f;
+
+				static const UINT32 Permutations[4][3] = 
 				{
-					Edge edge;
-					edge.vertInner[0] = outerFaces[i].innerVertices[j];
-					edge.vertInner[1] = outerFaces[i].innerVertices[(j + 1) % 3];
-					edge.vertOuter[0] = outerFaces[i].outerVertices[j];
-					edge.vertOuter[1] = outerFaces[i].outerVertices[(j + 1) % 3];
-					edge.face[0] = i;
-					edge.face[1] = -1;
-
-					edgeMap.insert(std::make_pair(std::make_pair((INT32)v0, (INT32)v1), edge));
-				}
-			}
-		}
+					{ 0, 1, 2 },
+					{ 0, 1, 3 },
+					{ 0, 2, 3 },
+					{ 1, 2, 3 }
+				};
 
-		// Generate front and back triangles for extruded outer faces
-		UINT32 faceIdx = 0;
-		for(UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
-		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
+				for(UINT32 j = 0; j < 4; j++)
+				{
+					Vector3 A = positions[volume.vertices[Permutations[j][0]]];
+					Vector3 B = positions[volume.vertices[Permutations[j][1]]];
+					Vector3 C = positions[volume.vertices[Permutations[j][2]]];
 
-			const TetrahedronFaceData& entry = outerFaces[i];
+					// Make sure the triangle is clockwise, facing away from the center
+					Vector3 e0 = A - C;
+					Vector3 e1 = B - C;
 
-			static const UINT32 Permutations[2][3] = { {0, 1, 2 }, { 3, 4, 5} };
+					Vector3 normal = e0.cross(e1);
+					if (normal.dot(A - center) > 0.0f)
+						std::swap(B, C);
 
-			// Make sure the triangle is clockwise, facing away from the center
-			Vector3 center(BsZero);
-			for (UINT32 k = 0; k < 3; k++)
-			{
-				center += mTempTetrahedronPositions[entry.innerVertices[k]];
-				center += mTempTetrahedronPositions[entry.outerVertices[k]];
-			}
+					posIter.addValue(A);
+					posIter.addValue(B);
+					posIter.addValue(C);
 
-			center /= 6.0f;
+					idIter.addValue(tetIdx);
+					idIter.addValue(tetIdx);
+					idIter.addValue(tetIdx);
 
-			for(UINT32 j = 0; j < 2; ++j)
-			{
-				UINT32 idxA = Permutations[j][0];
-				UINT32 idxB = Permutations[j][1];
-				UINT32 idxC = Permutations[j][2];
+					indices[0] = tetIdx * 4 * 3 + j * 3 + 0;
+					indices[1] = tetIdx * 4 * 3 + j * 3 + 1;
+					indices[2] = tetIdx * 4 * 3 + j * 3 + 2;
 
-				idxA = idxA > 2 ? entry.outerVertices[idxA - 3] : entry.innerVertices[idxA];
-				idxB = idxB > 2 ? entry.outerVertices[idxB - 3] : entry.innerVertices[idxB];
-				idxC = idxC > 2 ? entry.outerVertices[idxC - 3] : entry.innerVertices[idxC];
-				
-				Vector3 A = mTempTetrahedronPositions[idxA];
-				Vector3 B = mTempTetrahedronPositions[idxB];
-				Vector3 C = mTempTetrahedronPositions[idxC];
+					indices += 3;
+				}
 
-				Vector3 e0 = A - C;
-				Vector3 e1 = B - C;
+				tetIdx++;
+			}
 
-				Vector3 normal = e0.cross(e1);
-				if (normal.dot(A - center) > 0.0f)
-					std::swap(A, B);
+			// Generate an edge map for outer faces (required for step below)
+			struct Edge
+			{
+				UINT32 vertInner[2];
+				UINT32 vertOuter[2];
+				UINT32 face[2];
+			};
 
-				posIter.addValue(A);
-				posIter.addValue(B);
-				posIter.addValue(C);
+			FrameUnorderedMap<std::pair<INT32, INT32>, Edge, pair_hash> edgeMap;
+			for(UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
+			{
+				if (!validTets[outerFaces[i].tetrahedron])
+					continue;
 
-				idIter.addValue(tetIdx + faceIdx);
-				idIter.addValue(tetIdx + faceIdx);
-				idIter.addValue(tetIdx + faceIdx);
+				for (UINT32 j = 0; j < 3; ++j)
+				{
+					UINT32 v0 = outerFaces[i].innerVertices[j];
+					UINT32 v1 = outerFaces[i].innerVertices[(j + 1) % 3];
 
-				indices[0] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + j * 3 + 0;
-				indices[1] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + j * 3 + 1;
-				indices[2] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + j * 3 + 2;
+					// Keep the same ordering so other faces can find the same edge
+					if (v0 > v1)
+						std::swap(v0, v1);
 
-				indices += 3;
+					auto iterFind = edgeMap.find(std::make_pair((INT32)v0, (INT32)v1));
+					if (iterFind != edgeMap.end())
+					{
+						iterFind->second.face[1] = i;
+					}
+					else
+					{
+						Edge edge;
+						edge.vertInner[0] = outerFaces[i].innerVertices[j];
+						edge.vertInner[1] = outerFaces[i].innerVertices[(j + 1) % 3];
+						edge.vertOuter[0] = outerFaces[i].outerVertices[j];
+						edge.vertOuter[1] = outerFaces[i].outerVertices[(j + 1) % 3];
+						edge.face[0] = i;
+						edge.face[1] = -1;
+
+						edgeMap.insert(std::make_pair(std::make_pair((INT32)v0, (INT32)v1), edge));
+					}
+				}
 			}
 
-			faceIdx++;
-		}
+			// Generate front and back triangles for extruded outer faces
+			UINT32 faceIdx = 0;
+			for(UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
+			{
+				if (!validTets[outerFaces[i].tetrahedron])
+					continue;
 
-		// Generate sides for extruded outer faces
-		UINT32 sideIdx = 0;
-		for(auto& entry : edgeMap)
-		{
-			const Edge& edge = entry.second;
+				const TetrahedronFaceData& entry = outerFaces[i];
 
-			for (UINT32 i = 0; i < 2; i++)
-			{
-				const TetrahedronFaceData& face = outerFaces[edge.face[i]];
+				static const UINT32 Permutations[2][3] = { {0, 1, 2 }, { 3, 4, 5} };
 
 				// Make sure the triangle is clockwise, facing away from the center
 				Vector3 center(BsZero);
 				for (UINT32 k = 0; k < 3; k++)
 				{
-					center += mTempTetrahedronPositions[face.innerVertices[k]];
-					center += mTempTetrahedronPositions[face.outerVertices[k]];
+					center += positions[entry.innerVertices[k]];
+					center += positions[entry.outerVertices[k]];
 				}
 
 				center /= 6.0f;
 
-				static const UINT32 Permutations[2][3] = { {0, 1, 2 }, { 1, 2, 3} };
 				for(UINT32 j = 0; j < 2; ++j)
 				{
 					UINT32 idxA = Permutations[j][0];
 					UINT32 idxB = Permutations[j][1];
 					UINT32 idxC = Permutations[j][2];
 
-					idxA = idxA > 1 ? edge.vertOuter[idxA - 2] : edge.vertInner[idxA];
-					idxB = idxB > 1 ? edge.vertOuter[idxB - 2] : edge.vertInner[idxB];
-					idxC = idxC > 1 ? edge.vertOuter[idxC - 2] : edge.vertInner[idxC];
-					
-					Vector3 A = mTempTetrahedronPositions[idxA];
-					Vector3 B = mTempTetrahedronPositions[idxB];
-					Vector3 C = mTempTetrahedronPositions[idxC];
+					idxA = idxA > 2 ? entry.outerVertices[idxA - 3] : entry.innerVertices[idxA];
+					idxB = idxB > 2 ? entry.outerVertices[idxB - 3] : entry.innerVertices[idxB];
+					idxC = idxC > 2 ? entry.outerVertices[idxC - 3] : entry.innerVertices[idxC];
+				
+					Vector3 A = positions[idxA];
+					Vector3 B = positions[idxB];
+					Vector3 C = positions[idxC];
 
 					Vector3 e0 = A - C;
 					Vector3 e1 = B - C;
@@ -576,161 +653,226 @@ namespace bs { namespace ct
 					posIter.addValue(B);
 					posIter.addValue(C);
 
-					idIter.addValue(tetIdx + edge.face[i]);
-					idIter.addValue(tetIdx + edge.face[i]);
-					idIter.addValue(tetIdx + edge.face[i]);
+					idIter.addValue(tetIdx + faceIdx);
+					idIter.addValue(tetIdx + faceIdx);
+					idIter.addValue(tetIdx + faceIdx);
 
-					indices[0] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + sideIdx * 2 * 3 + j * 3 + 0;
-					indices[1] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + sideIdx * 2 * 3 + j * 3 + 1;
-					indices[2] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + sideIdx * 2 * 3 + j * 3 + 2;
+					indices[0] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + j * 3 + 0;
+					indices[1] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + j * 3 + 1;
+					indices[2] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + j * 3 + 2;
 
 					indices += 3;
 				}
 
-				sideIdx++;
+				faceIdx++;
 			}
-		}
 
-		// Generate "caps" on the end of the extruded volume
-		UINT32 capIdx = 0;
-		for(UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
-		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
+			// Generate sides for extruded outer faces
+			UINT32 sideIdx = 0;
+			for(auto& entry : edgeMap)
+			{
+				const Edge& edge = entry.second;
 
-			const TetrahedronFaceData& entry = outerFaces[i];
+				for (UINT32 i = 0; i < 2; i++)
+				{
+					const TetrahedronFaceData& face = outerFaces[edge.face[i]];
 
-			Vector3 A = mTempTetrahedronPositions[entry.outerVertices[0]];
-			Vector3 B = mTempTetrahedronPositions[entry.outerVertices[1]];
-			Vector3 C = mTempTetrahedronPositions[entry.outerVertices[2]];
+					// Make sure the triangle is clockwise, facing away from the center
+					Vector3 center(BsZero);
+					for (UINT32 k = 0; k < 3; k++)
+					{
+						center += positions[face.innerVertices[k]];
+						center += positions[face.outerVertices[k]];
+					}
 
-			// Make sure the triangle is clockwise, facing toward the center
-			const Tetrahedron& tet = mTetrahedronInfos[entry.tetrahedron].volume;
+					center /= 6.0f;
 
-			Vector3 center(BsZero);
-			for(UINT32 j = 0; j < 4; j++)
-				center += mTempTetrahedronPositions[tet.vertices[j]];
+					static const UINT32 Permutations[2][3] = { {0, 1, 2 }, { 1, 2, 3} };
+					for(UINT32 j = 0; j < 2; ++j)
+					{
+						UINT32 idxA = Permutations[j][0];
+						UINT32 idxB = Permutations[j][1];
+						UINT32 idxC = Permutations[j][2];
 
-			center /= 4.0f;
+						idxA = idxA > 1 ? edge.vertOuter[idxA - 2] : edge.vertInner[idxA];
+						idxB = idxB > 1 ? edge.vertOuter[idxB - 2] : edge.vertInner[idxB];
+						idxC = idxC > 1 ? edge.vertOuter[idxC - 2] : edge.vertInner[idxC];
+					
+						Vector3 A = positions[idxA];
+						Vector3 B = positions[idxB];
+						Vector3 C = positions[idxC];
 
-			Vector3 e0 = A - C;
-			Vector3 e1 = B - C;
+						Vector3 e0 = A - C;
+						Vector3 e1 = B - C;
 
-			Vector3 normal = e0.cross(e1);
-			if (normal.dot(A - center) < 0.0f)
-				std::swap(B, C);
+						Vector3 normal = e0.cross(e1);
+						if (normal.dot(A - center) > 0.0f)
+							std::swap(A, B);
 
-			posIter.addValue(A);
-			posIter.addValue(B);
-			posIter.addValue(C);
+						posIter.addValue(A);
+						posIter.addValue(B);
+						posIter.addValue(C);
 
-			idIter.addValue(-1);
-			idIter.addValue(-1);
-			idIter.addValue(-1);
+						idIter.addValue(tetIdx + edge.face[i]);
+						idIter.addValue(tetIdx + edge.face[i]);
+						idIter.addValue(tetIdx + edge.face[i]);
 
-			indices[0] = tetIdx * 4 * 3 + faceIdx * 8 * 3 + capIdx * 3 + 0;
-			indices[1] = tetIdx * 4 * 3 + faceIdx * 8 * 3 + capIdx * 3 + 1;
-			indices[2] = tetIdx * 4 * 3 + faceIdx * 8 * 3 + capIdx * 3 + 2;
+						indices[0] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + sideIdx * 2 * 3 + j * 3 + 0;
+						indices[1] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + sideIdx * 2 * 3 + j * 3 + 1;
+						indices[2] = tetIdx * 4 * 3 + faceIdx * 2 * 3 + sideIdx * 2 * 3 + j * 3 + 2;
 
-			indices += 3;
-			capIdx++;
-		}
+						indices += 3;
+					}
 
-		mVolumeMesh = Mesh::create(meshData);
+					sideIdx++;
+				}
+			}
 
-		// Map vertices to actual SH coefficient indices, and write GPU buffer with tetrahedron information
-		if ((mNumValidTetrahedra + numValidFaces) > mMaxTetrahedra)
-		{
-			UINT32 newSize = Math::divideAndRoundUp(mNumValidTetrahedra + numValidFaces, 64U) * 64U;
-			resizeTetrahedronBuffer(newSize);
-		}
+			// Generate "caps" on the end of the extruded volume
+			UINT32 capIdx = 0;
+			for(UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
+			{
+				if (!validTets[outerFaces[i].tetrahedron])
+					continue;
 
-		TetrahedronDataGPU* dst = (TetrahedronDataGPU*)mTetrahedronInfosGPU->lock(0, mTetrahedronInfosGPU->getSize(), 
-			GBL_WRITE_ONLY_DISCARD);
+				const TetrahedronFaceData& entry = outerFaces[i];
 
-		// Write inner tetrahedron data
-		for (UINT32 i = 0; i < (UINT32)mTetrahedronInfos.size(); i++)
-		{
-			if (!validTets[i])
-				continue;
+				Vector3 A = positions[entry.outerVertices[0]];
+				Vector3 B = positions[entry.outerVertices[1]];
+				Vector3 C = positions[entry.outerVertices[2]];
 
-			TetrahedronData& entry = mTetrahedronInfos[i];
+				// Make sure the triangle is clockwise, facing toward the center
+				const Tetrahedron& tet = tetrahedra[entry.tetrahedron].volume;
 
-			Vector2I offsets[4];
-			for(UINT32 j = 0; j < 4; ++j)
-			{
-				entry.volume.vertices[j] = mTempTetrahedronBufferIndices[entry.volume.vertices[j]];
-				offsets[j] = mTempTetrahedronBufferOffsets[entry.volume.vertices[j]];
-			}
+				Vector3 center(BsZero);
+				for(UINT32 j = 0; j < 4; j++)
+					center += positions[tet.vertices[j]];
 
-			memcpy(dst->indices, entry.volume.vertices, sizeof(UINT32) * 4);
-			memcpy(dst->offsets, &offsets, sizeof(offsets));
-			memcpy(&dst->transform, &entry.transform, sizeof(float) * 12);
+				center /= 4.0f;
 
-			dst++;
-		}
+				Vector3 e0 = A - C;
+				Vector3 e1 = B - C;
 
-		// Write extruded face data
-		for (UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
-		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
+				Vector3 normal = e0.cross(e1);
+				if (normal.dot(A - center) < 0.0f)
+					std::swap(B, C);
+
+				posIter.addValue(A);
+				posIter.addValue(B);
+				posIter.addValue(C);
+
+				idIter.addValue(-1);
+				idIter.addValue(-1);
+				idIter.addValue(-1);
+
+				indices[0] = tetIdx * 4 * 3 + faceIdx * 8 * 3 + capIdx * 3 + 0;
+				indices[1] = tetIdx * 4 * 3 + faceIdx * 8 * 3 + capIdx * 3 + 1;
+				indices[2] = tetIdx * 4 * 3 + faceIdx * 8 * 3 + capIdx * 3 + 2;
 
-			const TetrahedronFaceData& entry = outerFaces[i];
+				indices += 3;
+				capIdx++;
+			}
+
+			build.meshData = meshData;
+
+			// Map vertices to actual SH coefficient indices, and generate tetrahedron information for the GPU
+			build.tetrahedra.reserve(build.numValidTetrahedra + numValidFaces);
 
-			UINT32 indices[4];
-			Vector2I offsets[4];
-			for(UINT32 j = 0; j < 3; j++)
+			// Inner tetrahedron data
+			for (UINT32 i = 0; i < (UINT32)tetrahedra.size(); i++)
 			{
-				indices[j] = mTempTetrahedronBufferIndices[entry.innerVertices[j]];
-				offsets[j] = mTempTetrahedronBufferOffsets[entry.innerVertices[j]];
+				if (!validTets[i])
+					continue;
+
+				const TetrahedronData& entry = tetrahedra[i];
+
+				TetrahedronDataGPU gpuEntry;
+				for(UINT32 j = 0; j < 4; ++j)
+				{
+					gpuEntry.indices[j] = build.bufferIndices[entry.volume.vertices[j]];
+					gpuEntry.offsets[j] = build.bufferOffsets[entry.volume.vertices[j]];
+				}
+
+				memcpy(&gpuEntry.transform, &entry.transform, sizeof(float) * 12);
+				build.tetrahedra.push_back(gpuEntry);
 			}
 
-			indices[3] = -1;
+			// Extruded face data
+			build.faces.reserve(numValidFaces);
+			for (UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
+			{
+				if (!validTets[outerFaces[i].tetrahedron])
+					continue;
 
-			memcpy(dst->indices, indices, sizeof(UINT32) * 4);
-			memcpy(dst->offsets, offsets, sizeof(offsets));
-			memcpy(&dst->transform, &entry.transform, sizeof(float) * 12);
+				const TetrahedronFaceData& entry = outerFaces[i];
 
-			dst++;
-		}
+				TetrahedronDataGPU gpuEntry;
+				for(UINT32 j = 0; j < 3; j++)
+				{
+					gpuEntry.indices[j] = build.bufferIndices[entry.innerVertices[j]];
+					gpuEntry.offsets[j] = build.bufferOffsets[entry.innerVertices[j]];
+				}
 
-		mTetrahedronInfosGPU->unlock();
+				gpuEntry.indices[3] = -1;
+				gpuEntry.offsets[3] = Vector2I(0, 0);
 
-		// Write data specific to faces
-		if (numValidFaces > mMaxFaces)
-		{
-			UINT32 newSize = Math::divideAndRoundUp(numValidFaces, 64U) * 64U;
-			resizeTetrahedronFaceBuffer(newSize);
+				memcpy(&gpuEntry.transform, &entry.transform, sizeof(float) * 12);
+				build.tetrahedra.push_back(gpuEntry);
+
+				TetrahedronFaceDataGPU gpuFace;
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					gpuFace.corners[j] = positions[entry.innerVertices[j]];
+					gpuFace.normals[j] = entry.normals[j];
+				}
+
+				gpuFace.isQuadratic = entry.quadratic ? 1 : 0;
+				build.faces.push_back(gpuFace);
+			}
 		}
+		bs_frame_clear();
+	}
 
-		TetrahedronFaceDataGPU* faceDst = (TetrahedronFaceDataGPU*)mTetrahedronFaceInfosGPU->lock(0, 
-			mTetrahedronFaceInfosGPU->getSize(), GBL_WRITE_ONLY_DISCARD);
+	void LightProbes::finishTetrahedronBuild()
+	{
+		if (mBuildTask != nullptr)
+			mBuildTask->wait();
 
-		for (UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
-		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
+		const TetrahedronBuild& build = *mPendingBuild;
 
-			const TetrahedronFaceData& entry = outerFaces[i];
+		mVolumeMesh = Mesh::create(build.meshData);
+		mNumValidTetrahedra = build.numValidTetrahedra;
 
-			for (UINT32 j = 0; j < 3; j++)
-			{
-				faceDst->corners[j] = mTempTetrahedronPositions[entry.innerVertices[j]];
-				faceDst->normals[j] = entry.normals[j];
-			}
+		// Write GPU buffer with tetrahedron information
+		UINT32 numTetrahedra = (UINT32)build.tetrahedra.size();
+		if (numTetrahedra > mMaxTetrahedra)
+		{
+			UINT32 newSize = Math::divideAndRoundUp(numTetrahedra, 64U) * 64U;
+			resizeTetrahedronBuffer(newSize);
+		}
 
-			faceDst->isQuadratic = entry.quadratic ? 1 : 0;
-			faceDst++;
+		if (numTetrahedra > 0)
+		{
+			UINT32 size = numTetrahedra * (UINT32)sizeof(TetrahedronDataGPU);
+			mTetrahedronInfosGPU->writeData(0, size, build.tetrahedra.data(), BWT_DISCARD);
 		}
 
-		mTetrahedronFaceInfosGPU->unlock();
+		// Write data specific to faces
+		UINT32 numFaces = (UINT32)build.faces.size();
+		if (numFaces > mMaxFaces)
+		{
+			UINT32 newSize = Math::divideAndRoundUp(numFaces, 64U) * 64U;
+			resizeTetrahedronFaceBuffer(newSize);
+		}
 
-		bs_stack_free(validTets);
+		if (numFaces > 0)
+		{
+			UINT32 size = numFaces * (UINT32)sizeof(TetrahedronFaceDataGPU);
+			mTetrahedronFaceInfosGPU->writeData(0, size, build.faces.data(), BWT_DISCARD);
+		}
 
-		mTempTetrahedronPositions.clear();
-		mTempTetrahedronBufferIndices.clear();
-		mTetrahedronVolumeDirty = false;
+		mBuildTask = nullptr;
+		mPendingBuild = nullptr;
 	}
 
 	bool LightProbes::hasAnyProbes() const
@@ -187,8 +187,16 @@ namespace bs { namespace ct
 			LightProbeVolume* volume;
 			/** Remains true as long as there are dirty probes in the volume. */
 			bool isDirty;
+			/** First row of the global coefficient texture the volume's coefficients are copied to. */
+			UINT32 coefficientRow;
+			/** Number of rows in the global coefficient texture occupied by the volume's coefficients. */
+			UINT32 numCoefficientRows;
+			/** Hash of the probe positions when the volume was last copied. Used for detecting moved probes. */
+			size_t geometryHash;
 		};
 
+		struct TetrahedronBuild;
+
 		/** 
 		 * Information about a single tetrahedron, including neighbor information. Neighbor 4th index will be set to -1
 		 * if the tetrahedron represents an outer face (which is not actually a tetrahedron, but a triangle, but is stored
@@ -215,6 +223,7 @@ namespace bs { namespace ct
 		};
 	public:
 		LightProbes();
+		~LightProbes();
 
 		/** Notifies sthe manager that the provided light probe volume has been added. */
 		void notifyAdded(LightProbeVolume* volume);
@@ -225,7 +234,12 @@ namespace bs { namespace ct
 		/** Notifies the manager that all the probes in the provided volume have been removed. */
 		void notifyRemoved(LightProbeVolume* volume);
 
-		/** Updates light probe tetrahedron data after probes changed (added/removed/moved). */
+		/** 
+		 * Updates light probe coefficients and tetrahedron data after probes changed (added/removed/moved/re-rendered).
+		 * Tetrahedron data is only regenerated if probes were added, removed or moved. This happens on a worker thread
+		 * and the previous tetrahedron data remains in use until it completes, unless volumes were added or removed, or
+		 * their coefficients moved within the global coefficient texture.
+		 */
 		void updateProbes();
 
 		/** Returns true if there are any registered light probes. */
@@ -253,9 +267,32 @@ namespace bs { namespace ct
 		 * @param[in]		generateExtrapolationVolume	If true, the tetrahedron volume will be surrounded with points
 		 *												at "infinity" (technically just far away).
 		 */
-		void generateTetrahedronData(Vector<Vector3>& positions, Vector<TetrahedronData>& tetrahedra, 
+		static void generateTetrahedronData(Vector<Vector3>& positions, Vector<TetrahedronData>& tetrahedra, 
 			Vector<TetrahedronFaceData>& faces, bool generateExtrapolationVolume = false);
 
+		/** 
+		 * Copies the coefficients of all dirty volumes into the global coefficient texture, and marks the tetrahedron
+		 * volume as dirty if any of their probes were added, removed or moved, or if any volume was assigned different
+		 * rows in the global texture. 
+		 */
+		void updateCoefficients();
+
+		/** 
+		 * Gathers the positions of all probes and starts generating the tetrahedron volume from them. If possible
+		 * the generation is performed asynchronously, in which case finishTetrahedronBuild() must be called before its
+		 * results are available.
+		 */
+		void startTetrahedronBuild();
+
+		/** 
+		 * Generates the tetrahedron volume mesh and GPU data for the probes in @p build. Does not access any GPU 
+		 * objects and is safe to call from worker threads.
+		 */
+		static void buildTetrahedronVolume(TetrahedronBuild& build);
+
+		/** Waits until the build started by startTetrahedronBuild() completes, and uploads its results to the GPU. */
+		void finishTetrahedronBuild();
+
 		/** Resizes the GPU buffer used for holding tetrahedron data, to the specified size (in number of tetraheda). */
 		void resizeTetrahedronBuffer(UINT32 count);
 
@@ -270,23 +307,22 @@ namespace bs { namespace ct
 
 		Vector<VolumeInfo> mVolumes;
 		bool mTetrahedronVolumeDirty;
+		bool mCoefficientsDirty;
+		bool mVolumesChanged;
+		bool mCoefficientRowsChanged;
 
 		UINT32 mMaxCoefficientRows;
 		UINT32 mMaxTetrahedra;
 		UINT32 mMaxFaces;
 
-		Vector<TetrahedronData> mTetrahedronInfos;
-
 		SPtr<Texture> mProbeCoefficientsGPU;
 		SPtr<GpuBuffer> mTetrahedronInfosGPU;
 		SPtr<GpuBuffer> mTetrahedronFaceInfosGPU;
 		SPtr<Mesh> mVolumeMesh;
 		UINT32 mNumValidTetrahedra;
 
-		// Temporary buffers
-		Vector<Vector3> mTempTetrahedronPositions;
-		Vector<UINT32> mTempTetrahedronBufferIndices;
-		Vector<Vector2I> mTempTetrahedronBufferOffsets;
+		SPtr<TetrahedronBuild> mPendingBuild;
+		SPtr<Task> mBuildTask;
 	};
 
 	/** @} */
@@ -11,6 +11,9 @@
 #include "Utility/BsBitwise.h"
 #include "RenderAPI/BsVertexDataDesc.h"
 #include "Renderer/BsRenderer.h"
+#include "Math/BsSIMD.h"
+#include "Profiling/BsRenderStats.h"
+#include "Utility/BsTransientParamBlockAllocator.h"
 
 namespace bs { namespace ct
 {
@@ -400,8 +403,7 @@ namespace bs { namespace ct
 
 	/** 
 	 * Provides a common way for all types of shadow depth rendering to render the relevant objects into the depth map. 
-	 * Iterates over all relevant objects in the scene, binds the relevant materials and renders the objects into the depth
-	 * map.
+	 * Iterates over the provided shadow casters, binds the relevant materials and renders the objects into the depth map.
 	 */
 	class ShadowRenderQueue
 	{
@@ -427,7 +429,8 @@ namespace bs { namespace ct
 		};
 
 		template<class Options>
-		static void execute(RendererScene& scene, const FrameInfo& frameInfo, const Options& opt)
+		static void execute(RendererScene& scene, const FrameInfo& frameInfo, const Vector<ShadowCaster>& casters,
+			const Options& opt)
 		{
 			static_assert((UINT32)RenderableAnimType::Count == 4, "RenderableAnimType is expected to have four sequential entries.");
 
@@ -437,24 +440,26 @@ namespace bs { namespace ct
 			{
 				FrameVector<Command> commands[4];
 
-				// Make a list of relevant renderables and prepare them for rendering
-				for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
-				{
-					const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
-					if (!opt.intersects(bounds))
-						continue;
+				// Prepare the casters for rendering
+				FrameVector<UINT32> casterIndices;
+				casterIndices.reserve(casters.size());
+
+				for (auto& caster : casters)
+					casterIndices.push_back(caster.renderableIdx);
 
-					scene.prepareRenderable(i, frameInfo);
+				scene.prepareRenderables(casterIndices.data(), (UINT32)casterIndices.size(), frameInfo);
+
+				for (auto& caster : casters)
+				{
+					UINT32 i = caster.renderableIdx;
 
 					Command renderableCommand;
-					renderableCommand.mask = 0;
+					renderableCommand.mask = caster.faceMask;
 
 					RendererObject* renderable = sceneInfo.renderables[i];
 					renderableCommand.isElement = false;
 					renderableCommand.renderable = renderable;
 
-					opt.prepare(renderableCommand, bounds);
-
 					bool renderableBound[4];
 					bs_zero_out(renderableBound);
 
@@ -507,26 +512,13 @@ namespace bs { namespace ct
 	struct ShadowRenderQueueCubeOptions
 	{
 		ShadowRenderQueueCubeOptions(
-			const ConvexVolume (&frustums)[6], 
-			const ConvexVolume& boundingVolume, 
 			const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer, 
 			const SPtr<GpuParamBlockBuffer>& shadowCubeMatricesBuffer,
 			const SPtr<GpuParamBlockBuffer>& shadowCubeMasksBuffer)
-			: frustums(frustums), boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
-			, shadowCubeMatricesBuffer(shadowCubeMatricesBuffer), shadowCubeMasksBuffer(shadowCubeMasksBuffer)
+			: shadowParamsBuffer(shadowParamsBuffer), shadowCubeMatricesBuffer(shadowCubeMatricesBuffer)
+			, shadowCubeMasksBuffer(shadowCubeMasksBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
-		{
-			return boundingVolume.intersects(bounds);
-		}
-
-		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
-		{
-			for (UINT32 j = 0; j < 6; j++)
-				command.mask |= (frustums[j].intersects(bounds) ? 1 : 0) << j;
-		}
-
 		void bindMaterial(const ShaderVariation& variation) const
 		{
 			material = ShadowDepthCubeMat::get(variation);
@@ -543,8 +535,6 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer, shadowCubeMasksBuffer);
 		}
 		
-		const ConvexVolume (&frustums)[6];
-		const ConvexVolume& boundingVolume;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 		const SPtr<GpuParamBlockBuffer>& shadowCubeMatricesBuffer;
 		const SPtr<GpuParamBlockBuffer>& shadowCubeMasksBuffer;
@@ -555,21 +545,10 @@ namespace bs { namespace ct
 	/** Specialization used for ShadowRenderQueue when rendering spot light shadow maps. */
 	struct ShadowRenderQueueSpotOptions
 	{
-		ShadowRenderQueueSpotOptions(
-			const ConvexVolume& boundingVolume, 
-			const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
-			: boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
+		ShadowRenderQueueSpotOptions(const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
+			: shadowParamsBuffer(shadowParamsBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
-		{
-			return boundingVolume.intersects(bounds);
-		}
-
-		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
-		{
-		}
-
 		void bindMaterial(const ShaderVariation& variation) const
 		{
 			material = ShadowDepthNormalMat::get(variation);
@@ -583,7 +562,6 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer);
 		}
 		
-		const ConvexVolume& boundingVolume;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 
 		mutable ShadowDepthNormalMat* material = nullptr;
@@ -592,21 +570,10 @@ namespace bs { namespace ct
 	/** Specialization used for ShadowRenderQueue when rendering directional light shadow maps. */
 	struct ShadowRenderQueueDirOptions
 	{
-		ShadowRenderQueueDirOptions(
-			const ConvexVolume& boundingVolume, 
-			const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
-			: boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
+		ShadowRenderQueueDirOptions(const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
+			: shadowParamsBuffer(shadowParamsBuffer)
 		{ }
 
-		bool intersects(const Sphere& bounds) const
-		{
-			return boundingVolume.intersects(bounds);
-		}
-
-		void prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
-		{
-		}
-
 		void bindMaterial(const ShaderVariation& variation) const
 		{
 			material = ShadowDepthDirectionalMat::get(variation);
@@ -620,7 +587,6 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer);
 		}
 		
-		const ConvexVolume& boundingVolume;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 
 		mutable ShadowDepthDirectionalMat* material = nullptr;
@@ -688,6 +654,11 @@ namespace bs { namespace ct
 		}
 	}
 
+	ShadowRendering::~ShadowRendering()
+	{
+		clearStaticShadowMaps();
+	}
+
 	void ShadowRendering::setShadowMapSize(UINT32 size)
 	{
 		if (mShadowMapSize == size)
@@ -696,6 +667,7 @@ namespace bs { namespace ct
 		mCascadedShadowMaps.clear();
 		mDynamicShadowMaps.clear();
 		mShadowCubemaps.clear();
+		clearStaticShadowMaps();
 
 		mShadowMapSize = size;
 	}
@@ -703,10 +675,9 @@ namespace bs { namespace ct
 	void ShadowRendering::renderShadowMaps(RendererScene& scene, const RendererViewGroup& viewGroup, 
 		const FrameInfo& frameInfo)
 	{
-		// Note: Currently all shadows are dynamic and are rebuilt every frame. I should later added support for static
-		// shadow maps which can be used for immovable lights. Such a light can then maintain a set of shadow maps,
-		// one of which is static and only effects the static geometry, while the rest are per-object shadow maps used
-		// for dynamic objects. Then only a small subset of geometry needs to be redrawn, instead of everything.
+		// Note: Static spot and radial lights keep a cached shadow map containing only the static geometry, which is
+		// then used as a starting point onto which the dynamic geometry is drawn. Cascaded shadow maps depend on the
+		// view and are always rebuilt from scratch.
 
 		// Note: Add support for per-object shadows and a way to force a renderable to use per-object shadows. This can be
 		// used for adding high quality shadows on specific objects (e.g. important characters during cinematics).
@@ -723,6 +694,7 @@ namespace bs { namespace ct
 
 		mSpotLightShadowOptions.clear();
 		mRadialLightShadowOptions.clear();
+		mRenderJobs.clear();
 
 		// Clear all dynamic light atlases
 		for (auto& entry : mCascadedShadowMaps)
@@ -821,32 +793,40 @@ namespace bs { namespace ct
 				++iter;
 		}
 
-		// Render shadow maps
+		updateStaticShadowMaps(scene);
+
+		// Set up shadow maps
 		for (UINT32 i = 0; i < (UINT32)sceneInfo.directionalLights.size(); ++i)
 		{
 			const RendererLight& light = sceneInfo.directionalLights[i];
 
 			if (!light.internal->getCastsShadow())
-				return;
+				continue;
 
 			UINT32 numViews = viewGroup.getNumViews();
 			mDirectionalLightShadows[i].viewShadows.resize(numViews);
 
 			for (UINT32 j = 0; j < numViews; ++j)
-				renderCascadedShadowMaps(*viewGroup.getView(j), i, scene, frameInfo);
+				prepareCascadedShadowMaps(*viewGroup.getView(j), i, scene);
 		}
 
 		for(auto& entry : mSpotLightShadowOptions)
 		{
 			UINT32 lightIdx = entry.lightIdx;
-			renderSpotShadowMap(sceneInfo.spotLights[lightIdx], entry, scene, frameInfo);
+			prepareSpotShadowMap(sceneInfo.spotLights[lightIdx], entry);
 		}
 
 		for (auto& entry : mRadialLightShadowOptions)
 		{
 			UINT32 lightIdx = entry.lightIdx;
-			renderRadialShadowMap(sceneInfo.radialLights[lightIdx], entry, scene, frameInfo);
+			prepareRadialShadowMap(sceneInfo.radialLights[lightIdx], entry);
 		}
+
+		// Find casters for all shadow maps at once, then render them
+		cullShadowCasters(scene);
+
+		for (auto& job : mRenderJobs)
+			renderShadowMap(job, scene, frameInfo);
 	}
 
 	/**
@@ -951,8 +931,9 @@ namespace bs { namespace ct
 		const RenderAPIInfo& rapiInfo = rapi.getAPIInfo();
 		// TODO - Calculate and set a scissor rectangle for the light
 
-		SPtr<GpuParamBlockBuffer> shadowParamBuffer = gShadowProjectParamsDef.createBuffer();
-		SPtr<GpuParamBlockBuffer> shadowOmniParamBuffer = gShadowProjectOmniParamsDef.createBuffer();
+		TransientParamBlockAllocator& paramBlockAllocator = TransientParamBlockAllocator::instance();
+		SPtr<GpuParamBlockBuffer> shadowParamBuffer = paramBlockAllocator.alloc(gShadowProjectParamsDef);
+		SPtr<GpuParamBlockBuffer> shadowOmniParamBuffer = paramBlockAllocator.alloc(gShadowProjectOmniParamsDef);
 
 		UINT32 viewIdx = view.getViewIdx();
 		Vector<const ShadowInfo*> shadowInfos;
@@ -1132,8 +1113,8 @@ namespace bs { namespace ct
 		}
 	}
 
-	void ShadowRendering::renderCascadedShadowMaps(const RendererView& view, UINT32 lightIdx, RendererScene& scene, 
-		const FrameInfo& frameInfo)
+	void ShadowRendering::prepareCascadedShadowMaps(const RendererView& view, UINT32 lightIdx, 
+		const RendererScene& scene)
 	{
 		UINT32 viewIdx = view.getViewIdx();
 		LightShadows& lightShadows = mDirectionalLightShadows[lightIdx].viewShadows[viewIdx];
@@ -1155,11 +1136,8 @@ namespace bs { namespace ct
 		const RendererLight& rendererLight = sceneInfo.directionalLights[lightIdx];
 		Light* light = rendererLight.internal;
 
-		RenderAPI& rapi = RenderAPI::instance();
-
 		const Transform& tfrm = light->getTransform();
 		Vector3 lightDir = -tfrm.getRotation().zAxis();
-		SPtr<GpuParamBlockBuffer> shadowParamsBuffer = gShadowParamsDef.createBuffer();
 
 		ShadowInfo shadowInfo;
 		shadowInfo.lightIdx = lightIdx;
@@ -1250,23 +1228,22 @@ namespace bs { namespace ct
 			shadowInfo.depthFar = shadowInfo.depthFade + shadowInfo.fadeRange;
 			shadowInfo.depthBias = getDepthBias(*light, frustumBounds.getRadius(), shadowInfo.depthRange, mapSize);
 
+			// Note: Each cascade requires its own buffer, as cascades are rendered after all of them are set up
+			SPtr<GpuParamBlockBuffer> shadowParamsBuffer = 
+				TransientParamBlockAllocator::instance().alloc(gShadowParamsDef);
 			gShadowParamsDef.gDepthBias.set(shadowParamsBuffer, shadowInfo.depthBias);
 			gShadowParamsDef.gInvDepthRange.set(shadowParamsBuffer, 1.0f / shadowInfo.depthRange);
 			gShadowParamsDef.gMatViewProj.set(shadowParamsBuffer, shadowInfo.shadowVPTransform);
 			gShadowParamsDef.gNDCZToDeviceZ.set(shadowParamsBuffer, RendererView::getNDCZToDeviceZ());
 
-			rapi.setRenderTarget(shadowMap.getTarget(i));
-			rapi.clearRenderTarget(FBT_DEPTH);
-
-			ShadowDepthDirectionalMat* depthDirMat = ShadowDepthDirectionalMat::get();
-			depthDirMat->bind(shadowParamsBuffer);
-
-			// Render all renderables into the shadow map
-			ShadowRenderQueueDirOptions dirOptions(
-				cascadeCullVolume,
-				shadowParamsBuffer);
-			
-			ShadowRenderQueue::execute(scene, frameInfo, dirOptions);
+			mRenderJobs.push_back(ShadowMapRenderJob());
+			ShadowMapRenderJob& job = mRenderJobs.back();
+			job.type = ShadowMapType::Directional;
+			job.texture = shadowMap.getTexture();
+			job.target = shadowMap.getTarget(i);
+			job.viewport = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
+			job.shadowParamsBuffer = shadowParamsBuffer;
+			job.cullVolume = cascadeCullVolume;
 
 			shadowMap.setShadowInfo(i, shadowInfo);
 		}
@@ -1275,12 +1252,11 @@ namespace bs { namespace ct
 		lightShadows.numShadows = 1;
 	}
 
-	void ShadowRendering::renderSpotShadowMap(const RendererLight& rendererLight, const ShadowMapOptions& options,
-		RendererScene& scene, const FrameInfo& frameInfo)
+	void ShadowRendering::prepareSpotShadowMap(const RendererLight& rendererLight, const ShadowMapOptions& options)
 	{
 		Light* light = rendererLight.internal;
 
-		SPtr<GpuParamBlockBuffer> shadowParamsBuffer = gShadowParamsDef.createBuffer();
+		SPtr<GpuParamBlockBuffer> shadowParamsBuffer = TransientParamBlockAllocator::instance().alloc(gShadowParamsDef);
 
 		ShadowInfo mapInfo;
 		mapInfo.fadePerView = options.fadePercents;
@@ -1313,11 +1289,6 @@ namespace bs { namespace ct
 		mapInfo.updateNormArea(MAX_ATLAS_SIZE);
 		ShadowMapAtlas& atlas = mDynamicShadowMaps[mapInfo.textureIdx];
 
-		RenderAPI& rapi = RenderAPI::instance();
-		rapi.setRenderTarget(atlas.getTarget());
-		rapi.setViewport(mapInfo.normArea);
-		rapi.clearViewport(FBT_DEPTH);
-
 		mapInfo.depthNear = 0.05f;
 		mapInfo.depthFar = light->getAttenuationRadius();
 		mapInfo.depthFade = mapInfo.depthFar;
@@ -1353,17 +1324,17 @@ namespace bs { namespace ct
 			j++;
 		}
 
-		ConvexVolume worldFrustum(worldPlanes);
+		mRenderJobs.push_back(ShadowMapRenderJob());
+		ShadowMapRenderJob& job = mRenderJobs.back();
+		job.type = ShadowMapType::Spot;
+		job.texture = atlas.getTexture();
+		job.target = atlas.getTarget();
+		job.viewport = mapInfo.normArea;
+		job.shadowParamsBuffer = shadowParamsBuffer;
+		job.cullVolume = ConvexVolume(worldPlanes);
 
-		// Render all renderables into the shadow map
-		ShadowRenderQueueSpotOptions spotOptions(
-			worldFrustum,
-			shadowParamsBuffer);
-
-		ShadowRenderQueue::execute(scene, frameInfo, spotOptions);
-
-		// Restore viewport
-		rapi.setViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f));
+		if (light->getMobility() == ObjectMobility::Static)
+			job.staticMap = getStaticShadowMap(*light, options.mapSize, mapInfo.depthBias, mapInfo.shadowVPTransform);
 
 		LightShadows& lightShadows = mSpotLightShadows[options.lightIdx];
 
@@ -1371,14 +1342,14 @@ namespace bs { namespace ct
 		lightShadows.numShadows++;
 	}
 
-	void ShadowRendering::renderRadialShadowMap(const RendererLight& rendererLight, 
-		const ShadowMapOptions& options, RendererScene& scene, const FrameInfo& frameInfo)
+	void ShadowRendering::prepareRadialShadowMap(const RendererLight& rendererLight, const ShadowMapOptions& options)
 	{
 		Light* light = rendererLight.internal;
 
-		SPtr<GpuParamBlockBuffer> shadowParamsBuffer = gShadowParamsDef.createBuffer();
-		SPtr<GpuParamBlockBuffer> shadowCubeMatricesBuffer = gShadowCubeMatricesDef.createBuffer();
-		SPtr<GpuParamBlockBuffer> shadowCubeMasksBuffer = gShadowCubeMasksDef.createBuffer();
+		TransientParamBlockAllocator& paramBlockAllocator = TransientParamBlockAllocator::instance();
+		SPtr<GpuParamBlockBuffer> shadowParamsBuffer = paramBlockAllocator.alloc(gShadowParamsDef);
+		SPtr<GpuParamBlockBuffer> shadowCubeMatricesBuffer = paramBlockAllocator.alloc(gShadowCubeMatricesDef);
+		SPtr<GpuParamBlockBuffer> shadowCubeMasksBuffer = paramBlockAllocator.alloc(gShadowCubeMasksDef);
 
 		ShadowInfo mapInfo;
 		mapInfo.lightIdx = options.lightIdx;
@@ -1447,7 +1418,16 @@ namespace bs { namespace ct
 		gShadowParamsDef.gMatViewProj.set(shadowParamsBuffer, Matrix4::IDENTITY);
 		gShadowParamsDef.gNDCZToDeviceZ.set(shadowParamsBuffer, RendererView::getNDCZToDeviceZ());
 
-		ConvexVolume frustums[6];
+		mRenderJobs.push_back(ShadowMapRenderJob());
+		ShadowMapRenderJob& job = mRenderJobs.back();
+		job.type = ShadowMapType::Radial;
+		job.texture = cubemap.getTexture();
+		job.target = cubemap.getTarget();
+		job.viewport = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
+		job.shadowParamsBuffer = shadowParamsBuffer;
+		job.shadowCubeMatricesBuffer = shadowCubeMatricesBuffer;
+		job.shadowCubeMasksBuffer = shadowCubeMasksBuffer;
+
 		Vector<Plane> boundingPlanes;
 		for (UINT32 i = 0; i < 6; i++)
 		{
@@ -1504,25 +1484,19 @@ namespace bs { namespace ct
 				j++;
 			}
 
-			frustums[i] = ConvexVolume(worldPlanes);
+			job.faceVolumes[i] = ConvexVolume(worldPlanes);
 
 			// Register far plane of all frustums
 			boundingPlanes.push_back(worldPlanes.back());
 		}
 
-		rapi.setRenderTarget(cubemap.getTarget());
-		rapi.clearRenderTarget(FBT_DEPTH);
-
-		// Render all renderables into the shadow map
-		ConvexVolume boundingVolume(boundingPlanes);
-		ShadowRenderQueueCubeOptions cubeOptions(
-			frustums,
-			boundingVolume,
-			shadowParamsBuffer,
-			shadowCubeMatricesBuffer,
-			shadowCubeMasksBuffer);
+		job.cullVolume = ConvexVolume(boundingPlanes);
 
-		ShadowRenderQueue::execute(scene, frameInfo, cubeOptions);
+		if (light->getMobility() == ObjectMobility::Static)
+		{
+			job.staticMap = getStaticShadowMap(*light, options.mapSize, mapInfo.depthBias, 
+				mapInfo.shadowVPTransforms[0]);
+		}
 
 		LightShadows& lightShadows = mRadialLightShadows[options.lightIdx];
 
@@ -1530,6 +1504,292 @@ namespace bs { namespace ct
 		lightShadows.numShadows++;
 	}
 
+	/** 
+	 * Tests four spheres against a convex volume. Returns a mask with a bit set for each sphere that intersects the
+	 * volume.
+	 *
+	 * @param[in]	volume		Volume to test the spheres against.
+	 * @param[in]	center		X, Y and Z components of the sphere centers.
+	 * @param[in]	negRadius	Negated sphere radii.
+	 */
+	static UINT32 getIntersectionMask(const ConvexVolume& volume, const simd::float32x4 (&center)[3], 
+		const simd::float32x4& negRadius)
+	{
+		simd::uint32x4 intersects = simd::splat<simd::uint32x4>(0xFFFFFFFF);
+		for (auto& plane : volume.getPlanes())
+		{
+			simd::float32x4 dist = simd::mul(center[0], simd::splat<simd::float32x4>(plane.normal.x));
+			dist = simd::add(dist, simd::mul(center[1], simd::splat<simd::float32x4>(plane.normal.y)));
+			dist = simd::add(dist, simd::mul(center[2], simd::splat<simd::float32x4>(plane.normal.z)));
+			dist = simd::sub(dist, simd::splat<simd::float32x4>(plane.d));
+
+			intersects = simd::bit_and(intersects, simd::bit_cast<simd::uint32x4>(simd::cmp_ge(dist, negRadius)));
+		}
+
+		UINT32 lanes[4];
+		simd::store_u(lanes, intersects);
+
+		return (lanes[0] & 0x1) | (lanes[1] & 0x2) | (lanes[2] & 0x4) | (lanes[3] & 0x8);
+	}
+
+	void ShadowRendering::cullShadowCasters(const RendererScene& scene)
+	{
+		if (mRenderJobs.empty())
+			return;
+
+		const SceneInfo& sceneInfo = scene.getSceneInfo();
+		UINT32 numRenderables = (UINT32)sceneInfo.renderables.size();
+
+		// Store bounds in structure-of-arrays layout, so four renderables can be tested against a plane at once. Padding
+		// entries have a radius that never intersects anything.
+		UINT32 paddedCount = Math::divideAndRoundUp(numRenderables, 4U) * 4;
+		mCasterBounds.resize(paddedCount * 4);
+
+		float* centerX = mCasterBounds.data();
+		float* centerY = centerX + paddedCount;
+		float* centerZ = centerY + paddedCount;
+		float* negRadius = centerZ + paddedCount;
+
+		for (UINT32 i = 0; i < numRenderables; i++)
+		{
+			const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
+			const Vector3& center = bounds.getCenter();
+
+			centerX[i] = center.x;
+			centerY[i] = center.y;
+			centerZ[i] = center.z;
+			negRadius[i] = -bounds.getRadius();
+		}
+
+		for (UINT32 i = numRenderables; i < paddedCount; i++)
+		{
+			centerX[i] = centerY[i] = centerZ[i] = 0.0f;
+			negRadius[i] = std::numeric_limits<float>::max();
+		}
+
+		// Test each group of renderables against the volumes of all the shadow maps, while its bounds are loaded
+		for (UINT32 i = 0; i < paddedCount; i += 4)
+		{
+			simd::float32x4 center[3];
+			center[0] = simd::load_u<simd::float32x4>(centerX + i);
+			center[1] = simd::load_u<simd::float32x4>(centerY + i);
+			center[2] = simd::load_u<simd::float32x4>(centerZ + i);
+
+			simd::float32x4 radius = simd::load_u<simd::float32x4>(negRadius + i);
+
+			for (auto& job : mRenderJobs)
+			{
+				UINT32 mask = getIntersectionMask(job.cullVolume, center, radius);
+				if (mask == 0)
+					continue;
+
+				UINT32 faceMasks[4] = { 0, 0, 0, 0 };
+				if (job.type == ShadowMapType::Radial)
+				{
+					for (UINT32 j = 0; j < 6; j++)
+					{
+						UINT32 faceMask = getIntersectionMask(job.faceVolumes[j], center, radius);
+						for (UINT32 k = 0; k < 4; k++)
+							faceMasks[k] |= ((faceMask >> k) & 0x1) << j;
+					}
+				}
+
+				for (UINT32 k = 0; k < 4; k++)
+				{
+					if ((mask & (1 << k)) == 0)
+						continue;
+
+					// Static casters of cached shadow maps only need to be drawn when the cached map is out of date
+					if (job.staticMap != nullptr && 
+						sceneInfo.renderables[i + k]->renderable->getMobility() == ObjectMobility::Static)
+					{
+						if (!job.staticMap->isValid)
+							job.staticCasters.push_back({ i + k, faceMasks[k] });
+					}
+					else
+						job.casters.push_back({ i + k, faceMasks[k] });
+				}
+			}
+		}
+	}
+
+	void ShadowRendering::renderShadowMap(const ShadowMapRenderJob& job, RendererScene& scene, 
+		const FrameInfo& frameInfo)
+	{
+		RenderAPI& rapi = RenderAPI::instance();
+
+		StaticShadowMap* staticMap = job.staticMap;
+		if (staticMap != nullptr)
+		{
+			if (!staticMap->isValid)
+			{
+				rapi.setRenderTarget(staticMap->texture->renderTexture);
+				rapi.clearRenderTarget(FBT_DEPTH);
+
+				drawShadowCasters(job, job.staticCasters, scene, frameInfo);
+				staticMap->isValid = true;
+			}
+
+			// Initialize the shadow map with the static depth, so only dynamic casters need to be drawn on top
+			if (job.type == ShadowMapType::Spot)
+			{
+				rapi.setRenderTarget(job.target);
+				rapi.setViewport(job.viewport);
+
+				gRendererUtility().blit(staticMap->texture->texture, Rect2I::EMPTY, false, true);
+			}
+			else
+			{
+				for (UINT32 i = 0; i < 6; i++)
+				{
+					TEXTURE_COPY_DESC copyDesc;
+					copyDesc.srcFace = i;
+					copyDesc.dstFace = i;
+
+					staticMap->texture->texture->copy(job.texture, copyDesc);
+				}
+
+				rapi.setRenderTarget(job.target);
+			}
+		}
+		else
+		{
+			rapi.setRenderTarget(job.target);
+
+			// Spot light shadow maps share an atlas, so only their own area is cleared
+			if (job.type == ShadowMapType::Spot)
+			{
+				rapi.setViewport(job.viewport);
+				rapi.clearViewport(FBT_DEPTH);
+			}
+			else
+				rapi.clearRenderTarget(FBT_DEPTH);
+		}
+
+		drawShadowCasters(job, job.casters, scene, frameInfo);
+
+		// Restore viewport
+		if (job.type == ShadowMapType::Spot)
+			rapi.setViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f));
+	}
+
+	void ShadowRendering::drawShadowCasters(const ShadowMapRenderJob& job, const Vector<ShadowCaster>& casters, 
+		RendererScene& scene, const FrameInfo& frameInfo) const
+	{
+		if (job.type == ShadowMapType::Directional)
+		{
+			ShadowRenderQueueDirOptions dirOptions(job.shadowParamsBuffer);
+			ShadowRenderQueue::execute(scene, frameInfo, casters, dirOptions);
+		}
+		else if (job.type == ShadowMapType::Spot)
+		{
+			ShadowRenderQueueSpotOptions spotOptions(job.shadowParamsBuffer);
+			ShadowRenderQueue::execute(scene, frameInfo, casters, spotOptions);
+		}
+		else
+		{
+			ShadowRenderQueueCubeOptions cubeOptions(
+				job.shadowParamsBuffer,
+				job.shadowCubeMatricesBuffer,
+				job.shadowCubeMasksBuffer);
+
+			ShadowRenderQueue::execute(scene, frameInfo, casters, cubeOptions);
+		}
+	}
+
+	ShadowRendering::StaticShadowMap* ShadowRendering::getStaticShadowMap(const Light& light, UINT32 mapSize, 
+		float depthBias, const Matrix4& shadowVPTransform)
+	{
+		bool isCube = light.getType() == LightType::Radial;
+
+		StaticShadowMap& staticMap = mStaticShadowMaps[&light];
+		staticMap.lastUsedCounter = 0;
+		staticMap.bounds = light.getBounds();
+
+		if (staticMap.mapSize != mapSize)
+		{
+			if (staticMap.texture != nullptr)
+				BS_ADD_RENDER_STAT(ShadowMapCacheMemory, -(INT64)staticMap.memorySize);
+
+			POOLED_RENDER_TEXTURE_DESC desc = isCube ?
+				POOLED_RENDER_TEXTURE_DESC::createCube(SHADOW_MAP_FORMAT, mapSize, mapSize, TU_DEPTHSTENCIL) :
+				POOLED_RENDER_TEXTURE_DESC::create2D(SHADOW_MAP_FORMAT, mapSize, mapSize, TU_DEPTHSTENCIL);
+
+			staticMap.texture = GpuResourcePool::instance().get(desc);
+			staticMap.mapSize = mapSize;
+			staticMap.memorySize = PixelUtil::getMemorySize(mapSize, mapSize, 1, SHADOW_MAP_FORMAT) * (isCube ? 6 : 1);
+			staticMap.isValid = false;
+
+			BS_ADD_RENDER_STAT(ShadowMapCacheMemory, (INT64)staticMap.memorySize);
+		}
+
+		if (staticMap.depthBias != depthBias || staticMap.shadowVPTransform != shadowVPTransform)
+		{
+			staticMap.depthBias = depthBias;
+			staticMap.shadowVPTransform = shadowVPTransform;
+			staticMap.isValid = false;
+		}
+
+		if (staticMap.isValid)
+			BS_INC_RENDER_STAT(NumShadowMapCacheHits);
+		else
+			BS_INC_RENDER_STAT(NumShadowMapCacheMisses);
+
+		return &staticMap;
+	}
+
+	void ShadowRendering::updateStaticShadowMaps(const RendererScene& scene)
+	{
+		const SceneInfo& sceneInfo = scene.getSceneInfo();
+
+		// Changes that were discarded before we had a chance to see them could have affected any of the shadow maps
+		UINT64 numChanges = sceneInfo.numStaticChanges - mNumSeenStaticChanges;
+		bool invalidateAll = numChanges > sceneInfo.staticChanges.size();
+
+		UINT32 firstChange = (UINT32)(sceneInfo.staticChanges.size() - std::min(numChanges, 
+			(UINT64)sceneInfo.staticChanges.size()));
+
+		for(auto iter = mStaticShadowMaps.begin(); iter != mStaticShadowMaps.end();)
+		{
+			StaticShadowMap& staticMap = iter->second;
+			if (staticMap.lastUsedCounter >= MAX_UNUSED_FRAMES)
+			{
+				BS_ADD_RENDER_STAT(ShadowMapCacheMemory, -(INT64)staticMap.memorySize);
+
+				iter = mStaticShadowMaps.erase(iter);
+				continue;
+			}
+
+			staticMap.lastUsedCounter++;
+
+			if (invalidateAll)
+				staticMap.isValid = false;
+			else if (staticMap.isValid)
+			{
+				for (UINT32 i = firstChange; i < (UINT32)sceneInfo.staticChanges.size(); i++)
+				{
+					if (staticMap.bounds.intersects(sceneInfo.staticChanges[i]))
+					{
+						staticMap.isValid = false;
+						break;
+					}
+				}
+			}
+
+			++iter;
+		}
+
+		mNumSeenStaticChanges = sceneInfo.numStaticChanges;
+	}
+
+	void ShadowRendering::clearStaticShadowMaps()
+	{
+		for (auto& entry : mStaticShadowMaps)
+			BS_ADD_RENDER_STAT(ShadowMapCacheMemory, -(INT64)entry.second.memorySize);
+
+		mStaticShadowMaps.clear();
+	}
+
 	void ShadowRendering::calcShadowMapProperties(const RendererLight& light, const RendererViewGroup& viewGroup, 
 		UINT32 border, UINT32& size, SmallVector<float, 6>& fadePercents, float& maxFadePercent) const
 	{
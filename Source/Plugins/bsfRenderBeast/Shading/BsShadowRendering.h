@@ -364,6 +364,16 @@ namespace bs { namespace ct
 		SmallVector<float, 6> fadePerView;
 	};
 
+	/** Renderable that needs to be rendered into a particular shadow map. */
+	struct ShadowCaster
+	{
+		/** Index of the renderable in the scene. */
+		UINT32 renderableIdx;
+
+		/** Mask with a bit set for each cubemap face the renderable needs to be rendered to. Only relevant for cubemaps. */
+		UINT32 faceMask;
+	};
+
 	/** 
 	 * Contains a texture that serves as an atlas for one or multiple shadow maps. Provides methods for inserting new maps
 	 * in the atlas. 
@@ -496,8 +506,80 @@ namespace bs { namespace ct
 		{
 			SmallVector<LightShadows, 6> viewShadows;
 		};
+
+		/** Types of shadow maps that can be rendered. */
+		enum class ShadowMapType
+		{
+			Directional,
+			Spot,
+			Radial
+		};
+
+		/** 
+		 * Shadow map of a static light, containing only the depth of static shadow casters. Persists between frames and
+		 * only needs to be re-rendered when the light, or static geometry within its bounds, changes.
+		 */
+		struct StaticShadowMap
+		{
+			SPtr<PooledRenderTexture> texture;
+			UINT32 mapSize = 0;
+			UINT32 memorySize = 0;
+
+			/** Parameters the shadow map was rendered with. Any change requires the shadow map to be re-rendered. */
+			Matrix4 shadowVPTransform = Matrix4::IDENTITY;
+			float depthBias = 0.0f;
+
+			/** Bounds of the light the shadow map belongs to. */
+			Sphere bounds;
+
+			/** False if the shadow map is out of date and needs to be re-rendered before use. */
+			bool isValid = false;
+
+			UINT32 lastUsedCounter = 0;
+		};
+
+		/** 
+		 * Shadow map whose render target and parameters have been set up, but whose casters still need to be determined
+		 * before it can be rendered. 
+		 */
+		struct ShadowMapRenderJob
+		{
+			ShadowMapType type;
+			SPtr<Texture> texture;
+			SPtr<RenderTexture> target;
+			Rect2 viewport;
+
+			SPtr<GpuParamBlockBuffer> shadowParamsBuffer;
+			SPtr<GpuParamBlockBuffer> shadowCubeMatricesBuffer;
+			SPtr<GpuParamBlockBuffer> shadowCubeMasksBuffer;
+
+			/** Volume containing all the objects that can cast a shadow onto the shadow map. */
+			ConvexVolume cullVolume;
+
+			/** Volumes of individual cubemap faces. Only relevant for radial lights. */
+			ConvexVolume faceVolumes[6];
+
+			/** 
+			 * Renderables that intersect the cull volume. Populated by cullShadowCasters(). Contains only the dynamic 
+			 * renderables if the shadow map has a static shadow map.
+			 */
+			Vector<ShadowCaster> casters;
+
+			/** 
+			 * Cached depth of the static casters, to be used as a starting point for the shadow map. Null if the light
+			 * isn't static.
+			 */
+			StaticShadowMap* staticMap = nullptr;
+
+			/** 
+			 * Static renderables that intersect the cull volume. Only populated if the static shadow map is out of date
+			 * and needs to be re-rendered.
+			 */
+			Vector<ShadowCaster> staticCasters;
+		};
 	public:
 		ShadowRendering(UINT32 shadowMapSize);
+		~ShadowRendering();
 
 		/** For each visible shadow casting light, renders a shadow map from its point of view. */
 		void renderShadowMaps(RendererScene& scene, const RendererViewGroup& viewGroup, const FrameInfo& frameInfo);
@@ -511,17 +593,57 @@ namespace bs { namespace ct
 		/** Changes the default shadow map size. Will cause all shadow maps to be rebuilt. */
 		void setShadowMapSize(UINT32 size);
 	private:
-		/** Renders cascaded shadow maps for the provided directional light viewed from the provided view. */
-		void renderCascadedShadowMaps(const RendererView& view, UINT32 lightIdx, RendererScene& scene, 
-			const FrameInfo& frameInfo);
+		/** 
+		 * Allocates and sets up cascaded shadow maps for the provided directional light viewed from the provided view,
+		 * and queues them for rendering.
+		 */
+		void prepareCascadedShadowMaps(const RendererView& view, UINT32 lightIdx, const RendererScene& scene);
+
+		/** Allocates and sets up a shadow map for the provided spot light, and queues it for rendering. */
+		void prepareSpotShadowMap(const RendererLight& light, const ShadowMapOptions& options);
+
+		/** Allocates and sets up a shadow cubemap for the provided radial light, and queues it for rendering. */
+		void prepareRadialShadowMap(const RendererLight& light, const ShadowMapOptions& options);
 
-		/** Renders shadow maps for the provided spot light. */
-		void renderSpotShadowMap(const RendererLight& light, const ShadowMapOptions& options, RendererScene& scene,
-			const FrameInfo& frameInfo);
+		/** 
+		 * Determines which renderables need to be rendered into each of the queued shadow maps. All renderables are 
+		 * tested against all shadow maps in a single pass.
+		 */
+		void cullShadowCasters(const RendererScene& scene);
+
+		/** 
+		 * Renders all the casters of the provided shadow map job into its shadow map. If the job has a static shadow map
+		 * its contents are used as a starting point, and the static map is re-rendered first if out of date.
+		 */
+		void renderShadowMap(const ShadowMapRenderJob& job, RendererScene& scene, const FrameInfo& frameInfo);
 
-		/** Renders shadow maps for the provided radial light. */
-		void renderRadialShadowMap(const RendererLight& light, const ShadowMapOptions& options, RendererScene& scene, 
-			const FrameInfo& frameInfo);
+		/** Draws the provided casters into the currently bound render target, using the parameters from @p job. */
+		void drawShadowCasters(const ShadowMapRenderJob& job, const Vector<ShadowCaster>& casters, RendererScene& scene,
+			const FrameInfo& frameInfo) const;
+
+		/** 
+		 * Returns a static shadow map for the provided light, creating one if it doesn't exist. If the provided 
+		 * parameters don't match the ones the existing shadow map was rendered with, the shadow map is marked as out of
+		 * date.
+		 *
+		 * @param[in]	light				Light to retrieve the static shadow map for. Must be a spot or radial light.
+		 * @param[in]	mapSize				Size of the shadow map (of a single face, for cubemaps), in pixels.
+		 * @param[in]	depthBias			Depth bias the shadow map is rendered with.
+		 * @param[in]	shadowVPTransform	View-projection matrix the shadow map is rendered with. For radial lights
+		 *									matrix of any single face can be provided.
+		 * @return							Static shadow map, valid until the next call to updateStaticShadowMaps().
+		 */
+		StaticShadowMap* getStaticShadowMap(const Light& light, UINT32 mapSize, float depthBias, 
+			const Matrix4& shadowVPTransform);
+
+		/** 
+		 * Marks static shadow maps affected by static geometry changes in the scene as out of date, and releases static
+		 * shadow maps that haven't been used in a while.
+		 */
+		void updateStaticShadowMaps(const RendererScene& scene);
+
+		/** Releases all static shadow maps. */
+		void clearStaticShadowMaps();
 
 		/** 
 		 * Calculates optimal shadow map size, taking into account all views in the scene. Also calculates a fade value
@@ -633,6 +755,9 @@ namespace bs { namespace ct
 		Vector<ShadowCascadedMap> mCascadedShadowMaps;
 		Vector<ShadowCubemap> mShadowCubemaps;
 
+		UnorderedMap<const Light*, StaticShadowMap> mStaticShadowMaps;
+		UINT64 mNumSeenStaticChanges = 0;
+
 		Vector<ShadowInfo> mShadowInfos;
 
 		Vector<LightShadows> mSpotLightShadows;
@@ -652,6 +777,8 @@ namespace bs { namespace ct
 		Vector<bool> mRenderableVisibility; // Transient
 		Vector<ShadowMapOptions> mSpotLightShadowOptions; // Transient
 		Vector<ShadowMapOptions> mRadialLightShadowOptions; // Transient
+		Vector<ShadowMapRenderJob> mRenderJobs; // Transient
+		Vector<float> mCasterBounds; // Transient
 	};
 
 	/* @} */
@@ -8,7 +8,7 @@
 namespace bs { namespace ct
 {
 	PooledRenderTexture::PooledRenderTexture(GpuResourcePool* pool)
-		:mPool(pool), mIsFree(false)
+		:mPool(pool), mMemorySize(0), mIsFree(false)
 	{ }
 
 	PooledRenderTexture::~PooledRenderTexture()
@@ -18,7 +18,7 @@ namespace bs { namespace ct
 	}
 
 	PooledStorageBuffer::PooledStorageBuffer(GpuResourcePool* pool)
-		:mPool(pool), mIsFree(false)
+		:mPool(pool), mMemorySize(0), mIsFree(false)
 	{ }
 
 	PooledStorageBuffer::~PooledStorageBuffer()
@@ -51,6 +51,10 @@ namespace bs { namespace ct
 			if (matches(textureData->texture, desc))
 			{
 				textureData->mIsFree = false;
+
+				mStats.numReused++;
+				notifyUsed(textureData->mMemorySize);
+
 				return textureData;
 			}
 		}
@@ -73,6 +77,29 @@ namespace bs { namespace ct
 			texDesc.numArraySlices = desc.arraySize;
 
 		newTextureData->texture = Texture::create(texDesc);
+
+		// Estimate the GPU memory used by all faces, mip levels and samples of the texture
+		const TextureProperties& texProps = newTextureData->texture->getProperties();
+		UINT32 mipWidth = desc.width;
+		UINT32 mipHeight = desc.height;
+		UINT32 mipDepth = desc.depth;
+
+		UINT64 faceMemorySize = 0;
+		for (UINT32 i = 0; i <= texProps.getNumMipmaps(); i++)
+		{
+			faceMemorySize += PixelUtil::getMemorySize(mipWidth, mipHeight, mipDepth, desc.format);
+
+			mipWidth = std::max(1U, mipWidth / 2);
+			mipHeight = std::max(1U, mipHeight / 2);
+			mipDepth = std::max(1U, mipDepth / 2);
+		}
+
+		UINT32 numSamples = std::max(1U, texProps.getNumSamples());
+		newTextureData->mMemorySize = faceMemorySize * texProps.getNumFaces() * numSamples;
+
+		mStats.totalMemory += newTextureData->mMemorySize;
+		mStats.numCreated++;
+		notifyUsed(newTextureData->mMemorySize);
 		
 		if ((desc.flag & (TU_RENDERTARGET | TU_DEPTHSTENCIL)) != 0)
 		{
@@ -115,6 +142,10 @@ namespace bs { namespace ct
 			if (matches(bufferData->buffer, desc))
 			{
 				bufferData->mIsFree = false;
+
+				mStats.numReused++;
+				notifyUsed(bufferData->mMemorySize);
+
 				return bufferData;
 			}
 		}
@@ -130,6 +161,11 @@ namespace bs { namespace ct
 		bufferDesc.randomGpuWrite = true;
 
 		newBufferData->buffer = GpuBuffer::create(bufferDesc);
+		newBufferData->mMemorySize = newBufferData->buffer->getSize();
+
+		mStats.totalMemory += newBufferData->mMemorySize;
+		mStats.numCreated++;
+		notifyUsed(newBufferData->mMemorySize);
 
 		return newBufferData;
 	}
@@ -137,13 +173,40 @@ namespace bs { namespace ct
 	void GpuResourcePool::release(const SPtr<PooledRenderTexture>& texture)
 	{
 		auto iterFind = mTextures.find(texture.get());
-		iterFind->second.lock()->mIsFree = true;
+		SPtr<PooledRenderTexture> textureData = iterFind->second.lock();
+
+		if (textureData->mIsFree)
+			return;
+
+		textureData->mIsFree = true;
+		mStats.usedMemory -= textureData->mMemorySize;
 	}
 
 	void GpuResourcePool::release(const SPtr<PooledStorageBuffer>& buffer)
 	{
 		auto iterFind = mBuffers.find(buffer.get());
-		iterFind->second.lock()->mIsFree = true;
+		SPtr<PooledStorageBuffer> bufferData = iterFind->second.lock();
+
+		if (bufferData->mIsFree)
+			return;
+
+		bufferData->mIsFree = true;
+		mStats.usedMemory -= bufferData->mMemorySize;
+	}
+
+	void GpuResourcePool::beginFrame()
+	{
+		mLastFrameStats = mStats;
+
+		mStats.peakUsedMemory = mStats.usedMemory;
+		mStats.numCreated = 0;
+		mStats.numReused = 0;
+	}
+
+	void GpuResourcePool::notifyUsed(UINT64 memorySize)
+	{
+		mStats.usedMemory += memorySize;
+		mStats.peakUsedMemory = std::max(mStats.peakUsedMemory, mStats.usedMemory);
 	}
 
 	bool GpuResourcePool::matches(const SPtr<Texture>& texture, const POOLED_RENDER_TEXTURE_DESC& desc)
@@ -193,6 +256,10 @@ namespace bs { namespace ct
 
 	void GpuResourcePool::_unregisterTexture(PooledRenderTexture* texture)
 	{
+		mStats.totalMemory -= texture->mMemorySize;
+		if (!texture->mIsFree)
+			mStats.usedMemory -= texture->mMemorySize;
+
 		mTextures.erase(texture);
 	}
 
@@ -203,6 +270,10 @@ namespace bs { namespace ct
 
 	void GpuResourcePool::_unregisterBuffer(PooledStorageBuffer* buffer)
 	{
+		mStats.totalMemory -= buffer->mMemorySize;
+		if (!buffer->mIsFree)
+			mStats.usedMemory -= buffer->mMemorySize;
+
 		mBuffers.erase(buffer);
 	}
 
@@ -30,6 +30,7 @@ namespace bs { namespace ct
 		friend class GpuResourcePool;
 
 		GpuResourcePool* mPool;
+		UINT64 mMemorySize;
 		bool mIsFree;
 	};
 
@@ -45,9 +46,29 @@ namespace bs { namespace ct
 		friend class GpuResourcePool;
 
 		GpuResourcePool* mPool;
+		UINT64 mMemorySize;
 		bool mIsFree;
 	};
 
+	/** Information about GPU memory used by resources in the GPU resource pool. */
+	struct GpuResourcePoolStats
+	{
+		/** Memory used by all textures and buffers in the pool, whether in use or not, in bytes. */
+		UINT64 totalMemory = 0;
+
+		/** Memory used by textures and buffers that are currently in use (retrieved and not yet released), in bytes. */
+		UINT64 usedMemory = 0;
+
+		/** Highest value of @p usedMemory reached during the frame, in bytes. */
+		UINT64 peakUsedMemory = 0;
+
+		/** Number of textures and buffers that had to be created during the frame. */
+		UINT32 numCreated = 0;
+
+		/** Number of requests during the frame that were satisfied by an existing texture or buffer. */
+		UINT32 numReused = 0;
+	};
+
 	/** 
 	 * Contains a pool of textures and buffers meant to accommodate reuse of such resources for the main purpose of using
 	 * them as write targets on the GPU.
@@ -93,6 +114,15 @@ namespace bs { namespace ct
 		 */
 		void release(const SPtr<PooledStorageBuffer>& buffer);
 
+		/** 
+		 * Notifies the pool a new frame is starting. Finalizes the statistics of the previous frame, retrievable 
+		 * through getLastFrameStats(). 
+		 */
+		void beginFrame();
+
+		/** Returns memory statistics about the last completed frame. */
+		const GpuResourcePoolStats& getLastFrameStats() const { return mLastFrameStats; }
+
 	private:
 		friend struct PooledRenderTexture;
 		friend struct PooledStorageBuffer;
@@ -125,8 +155,14 @@ namespace bs { namespace ct
 		 */
 		static bool matches(const SPtr<GpuBuffer>& buffer, const POOLED_STORAGE_BUFFER_DESC& desc);
 
+		/** Records that a resource of the specified size was handed out by the pool. */
+		void notifyUsed(UINT64 memorySize);
+
 		Map<PooledRenderTexture*, std::weak_ptr<PooledRenderTexture>> mTextures;
 		Map<PooledStorageBuffer*, std::weak_ptr<PooledStorageBuffer>> mBuffers;
+
+		GpuResourcePoolStats mStats;
+		GpuResourcePoolStats mLastFrameStats;
 	};
 
 	/** Structure used for creating a new pooled render texture. */
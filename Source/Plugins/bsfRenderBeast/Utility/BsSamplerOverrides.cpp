@@ -55,7 +55,7 @@ namespace bs { namespace ct
 				else
 					override.state = samplerState;
 
-				override.originalStateHash = override.state->getProperties().getHash();
+				override.originalStateHash = samplerState->getProperties().getHash();
 
 				overrideLookup[samplerParam.first] = overrideIdx;
 			}
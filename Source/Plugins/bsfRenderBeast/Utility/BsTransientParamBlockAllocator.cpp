@@ -0,0 +1,35 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsTransientParamBlockAllocator.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+
+namespace bs { namespace ct
+{
+	SPtr<GpuParamBlockBuffer> TransientParamBlockAllocator::alloc(UINT32 size)
+	{
+		SPtr<GpuParamBlockBuffer> buffer;
+
+		auto iterFind = mFreeBuffers.find(size);
+		if (iterFind != mFreeBuffers.end() && !iterFind->second.empty())
+		{
+			buffer = iterFind->second.back();
+			iterFind->second.pop_back();
+		}
+		else
+			buffer = GpuParamBlockBuffer::create(size);
+
+		mUsedBuffers[mFrameIdx].push_back(buffer);
+		return buffer;
+	}
+
+	void TransientParamBlockAllocator::beginFrame()
+	{
+		mFrameIdx = (mFrameIdx + 1) % NUM_FRAMES;
+
+		// The GPU is done with the frame that last used this slot, so its buffers can be safely overwritten
+		for (auto& buffer : mUsedBuffers[mFrameIdx])
+			mFreeBuffers[buffer->getSize()].push_back(buffer);
+
+		mUsedBuffers[mFrameIdx].clear();
+	}
+}}
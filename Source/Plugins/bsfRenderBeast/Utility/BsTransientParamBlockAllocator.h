@@ -0,0 +1,51 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Utility/BsModule.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/** 
+	 * Provides parameter block buffers for data that is only needed during a single frame. Buffers are recycled once the
+	 * frame they were used in is no longer being processed by the GPU, instead of being created and destroyed every time
+	 * they are needed.
+	 */
+	class TransientParamBlockAllocator : public Module<TransientParamBlockAllocator>
+	{
+	public:
+		/** 
+		 * Returns a parameter block buffer of the specified size. Contents of the buffer are undefined. The buffer must
+		 * not be used, or referenced, after the current frame ends.
+		 */
+		SPtr<GpuParamBlockBuffer> alloc(UINT32 size);
+
+		/** 
+		 * Returns a parameter block buffer large enough to store the parameter block with the provided definition. See
+		 * alloc(UINT32).
+		 */
+		template<class T>
+		SPtr<GpuParamBlockBuffer> alloc(const T& paramBlockDef) { return alloc(paramBlockDef.getBufferSize()); }
+
+		/** 
+		 * Notifies the allocator a new frame has started. Buffers allocated NUM_FRAMES frames ago become available for
+		 * re-use.
+		 */
+		void beginFrame();
+
+	private:
+		/** Number of frames the buffers are kept for, before they are re-used. */
+		static const UINT32 NUM_FRAMES = 3;
+
+		UnorderedMap<UINT32, Vector<SPtr<GpuParamBlockBuffer>>> mFreeBuffers;
+		Vector<SPtr<GpuParamBlockBuffer>> mUsedBuffers[NUM_FRAMES];
+		UINT32 mFrameIdx = 0;
+	};
+
+	/** @} */
+}}
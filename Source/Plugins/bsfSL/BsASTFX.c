@@ -251,8 +251,34 @@ char* getCurrentFilename(ParseState* parseState)
 	return parseState->includeStack->data->filename;
 }
 
+void markDefineUsed(ParseState* parseState, const char* value)
+{
+	for (int i = 0; i < parseState->numUsedDefines; i++)
+	{
+		if (strcmp(parseState->usedDefines[i], value) == 0)
+			return;
+	}
+
+	if(parseState->numUsedDefines >= parseState->usedDefineCapacity)
+	{
+		int newCapacity = parseState->usedDefineCapacity * 2;
+		char** newUsedDefines = mmalloc(parseState->memContext, newCapacity * sizeof(char*));
+
+		memcpy(newUsedDefines, parseState->usedDefines, parseState->usedDefineCapacity * sizeof(char*));
+
+		mmfree(parseState->usedDefines);
+		parseState->usedDefines = newUsedDefines;
+		parseState->usedDefineCapacity = newCapacity;
+	}
+
+	parseState->usedDefines[parseState->numUsedDefines] = mmalloc_strdup(parseState->memContext, value);
+	parseState->numUsedDefines++;
+}
+
 void addDefine(ParseState* parseState, const char* value)
 {
+	markDefineUsed(parseState, value);
+
 	int defineIdx = parseState->numDefines;
 	parseState->numDefines++;
 
@@ -286,6 +312,8 @@ void addDefineExpr(ParseState* parseState, const char* value)
 
 int hasDefine(ParseState* parseState, const char* value)
 {
+	markDefineUsed(parseState, value);
+
 	for (int i = 0; i < parseState->numDefines; i++)
 	{
 		if (strcmp(parseState->defines[i].name, value) == 0)
@@ -297,6 +325,8 @@ int hasDefine(ParseState* parseState, const char* value)
 
 int isDefineEnabled(ParseState* parseState, const char* value)
 {
+	markDefineUsed(parseState, value);
+
 	for (int i = 0; i < parseState->numDefines; i++)
 	{
 		if (strcmp(parseState->defines[i].name, value) == 0)
@@ -314,6 +344,8 @@ int isDefineEnabled(ParseState* parseState, const char* value)
 
 void removeDefine(ParseState* parseState, const char* value)
 {
+	markDefineUsed(parseState, value);
+
 	for (int i = 0; i < parseState->numDefines; i++)
 	{
 		if (strcmp(parseState->defines[i].name, value) == 0)
@@ -402,6 +434,10 @@ ParseState* parseStateCreate()
 	parseState->numDefines = 0;
 	parseState->defines = mmalloc(parseState->memContext, parseState->defineCapacity * sizeof(DefineEntry));
 
+	parseState->usedDefineCapacity = 10;
+	parseState->numUsedDefines = 0;
+	parseState->usedDefines = mmalloc(parseState->memContext, parseState->usedDefineCapacity * sizeof(char*));
+
 	nodePush(parseState, parseState->rootNode);
 
 	return parseState;
@@ -219,6 +219,10 @@ struct tagParseState
 	int numDefines;
 	int defineCapacity;
 	ConditionalData* conditionalStack;
+
+	char** usedDefines;
+	int numUsedDefines;
+	int usedDefineCapacity;
 };
 
 struct tagOptionInfo
@@ -281,6 +285,7 @@ void addDefineExpr(ParseState* parseState, const char* value);
 int hasDefine(ParseState* parseState, const char* value);
 int isDefineEnabled(ParseState* parseState, const char* value);
 void removeDefine(ParseState* parseState, const char* value);
+void markDefineUsed(ParseState* parseState, const char* value);
 
 int pushConditional(ParseState* parseState, int state);
 int switchConditional(ParseState* parseState);
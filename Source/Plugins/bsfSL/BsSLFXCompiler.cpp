@@ -18,6 +18,7 @@
 #include "Renderer/BsRendererManager.h"
 #include "FileSystem/BsFileSystem.h"
 #include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
 
 #define XSC_ENABLE_LANGUAGE_EXT 1
 #include "Xsc/Xsc.h"
@@ -535,7 +536,8 @@ namespace bs
 	};
 
 	String crossCompile(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, bool optionalEntry, 
-		UINT32& startBindingSlot, SHADER_DESC* shaderDesc = nullptr, Vector<GpuProgramType>* detectedTypes = nullptr)
+		UINT32& startBindingSlot, Xsc::Reflection::ReflectionData* reflection = nullptr, 
+		Vector<GpuProgramType>* detectedTypes = nullptr)
 	{
 		SPtr<StringStream> input = bs_shared_ptr_new<StringStream>();
 
@@ -680,22 +682,82 @@ namespace bs
 			}
 		}
 
-		if (shaderDesc != nullptr)
-			parseParameters(reflectionData, *shaderDesc);
+		if (reflection != nullptr)
+			*reflection = std::move(reflectionData);
 
 		return output.str();
 	}
 
-	// Convert HLSL code to GLSL
+	/** 
+	 * Version of the cross-compiled program cache. Increment whenever cross-compilation output changes (e.g. when 
+	 * XShaderCompiler is updated), so any previously cached programs are ignored.
+	 */
+	constexpr UINT32 CROSS_COMPILE_CACHE_VERSION = 1;
+
+	/** Returns the folder in which cross-compiled GPU programs are cached in between shader imports. */
+	Path getCrossCompileCacheFolder()
+	{
+		Path folder = FileSystem::getTempDirectoryPath();
+		folder.append("bsf/ShaderCache/");
+
+		return folder;
+	}
+
+	// Convert HLSL code to GLSL, re-using the output of a previous conversion of the same code if one is cached on disk
 	String HLSLtoGLSL(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, UINT32& startBindingSlot)
 	{
-		return crossCompile(hlsl, type, outputType, false, startBindingSlot);
+		// Defines are part of the code blocks, so the code, program type, output and first binding slot fully determine 
+		// the output
+		StringStream key;
+		key << CROSS_COMPILE_CACHE_VERSION << " " << (UINT32)type << " " << (UINT32)outputType << " " << 
+			startBindingSlot << "\n" << hlsl;
+
+		Path cachePath = getCrossCompileCacheFolder();
+		cachePath.setFilename(md5(key.str()) + ".glsl");
+
+		{
+			Lock fileLock = FileScheduler::getLock(cachePath);
+
+			if (FileSystem::isFile(cachePath))
+			{
+				SPtr<DataStream> stream = FileSystem::openFile(cachePath);
+				String cachedOutput = stream != nullptr ? stream->getAsString() : "";
+
+				// First line contains the binding slot following the last slot used by the program
+				size_t codeStart = cachedOutput.find('\n');
+				if (codeStart != String::npos)
+				{
+					startBindingSlot = parseUINT32(cachedOutput.substr(0, codeStart), startBindingSlot);
+					return cachedOutput.substr(codeStart + 1);
+				}
+			}
+		}
+
+		String output = crossCompile(hlsl, type, outputType, false, startBindingSlot);
+
+		// Failures are not cached, so the error gets reported on every import
+		if (!output.empty())
+		{
+			String cachedOutput = toString(startBindingSlot) + "\n" + output;
+
+			Lock fileLock = FileScheduler::getLock(cachePath);
+
+			if (!FileSystem::exists(cachePath.getParent()))
+				FileSystem::createDir(cachePath.getParent());
+
+			SPtr<DataStream> stream = FileSystem::createAndOpenFile(cachePath);
+			if (stream != nullptr)
+				stream->write(cachedOutput.data(), cachedOutput.size());
+		}
+
+		return output;
 	}
 
-	void reflectHLSL(const String& hlsl, SHADER_DESC& shaderDesc, Vector<GpuProgramType>& entryPoints)
+	void reflectHLSL(const String& hlsl, Xsc::Reflection::ReflectionData& reflection, 
+		Vector<GpuProgramType>& entryPoints)
 	{
 		UINT32 dummy = 0;
-		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &shaderDesc, &entryPoints);
+		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &reflection, &entryPoints);
 	}
 
 	BSLFXCompileResult BSLFXCompiler::compile(const String& name, const String& source, 
@@ -1652,14 +1714,58 @@ namespace bs
 		return output;
 	}
 
+	/**
+	 * Executes the provided workers in parallel on the task scheduler and returns once all of them complete. If the
+	 * task scheduler isn't running (e.g. when compiling offline) the workers are executed sequentially on the calling
+	 * thread instead.
+	 */
+	static void runWorkers(const String& name, const Vector<std::function<void()>>& workers)
+	{
+		if (!TaskScheduler::isStarted())
+		{
+			for (auto& worker : workers)
+				worker();
+
+			return;
+		}
+
+		Vector<SPtr<Task>> tasks;
+		for (auto& worker : workers)
+		{
+			tasks.push_back(Task::create(name, worker));
+			TaskScheduler::instance().addTask(tasks.back());
+		}
+
+		for (auto& task : tasks)
+			task->wait();
+	}
+
+	/** Returns the contents of all the raw code blocks of the specified type, ordered by their index. */
+	Vector<String> getCodeBlocks(ParseState* parseState, RawCodeType type)
+	{
+		Vector<String> codeBlocks;
+		RawCode* rawCode = parseState->rawCodeBlock[type];
+		while (rawCode != nullptr)
+		{
+			while ((INT32)codeBlocks.size() <= rawCode->index)
+				codeBlocks.push_back(String());
+
+			codeBlocks[rawCode->index] = String(rawCode->code, rawCode->size);
+			rawCode = rawCode->next;
+		}
+
+		return codeBlocks;
+	}
+
 	BSLFXCompileResult BSLFXCompiler::compileTechniques(
 		const Vector<std::pair<ASTFXNode*, ShaderMetaData>>& shaderMetaData, const String& source, 
-		const UnorderedMap<String, String>& defines, SHADER_DESC& shaderDesc, Vector<String>& includes)
+		const UnorderedMap<String, String>& defines, ParseState* parseState, SHADER_DESC& shaderDesc, 
+		Vector<String>& includes)
 	{
 		BSLFXCompileResult output;
 
-		// Build a list of different variations and re-parse the source using the relevant defines
-		UnorderedSet<String> includeSet;
+		// Build a list of different variations
+		Vector<VariationCompileData> variationData;
 		for (auto& entry : shaderMetaData)
 		{
 			const ShaderMetaData& metaData = entry.second;
@@ -1742,42 +1848,150 @@ namespace bs
 				}
 			}
 
-			// For every variation, re-parse the file with relevant defines
 			for (auto& variation : variations)
 			{
-				UnorderedMap<String, String> globalDefines = defines;
-				UnorderedMap<String, String> variationDefines = variation.getDefines().getAll();
+				VariationCompileData data;
+				data.name = metaData.name;
+				data.variation = variation;
+
+				variationData.push_back(data);
+			}
+		}
+
+		// Defines checked by the BSL pre-processor when parsing the source without any variation defines. Variations that
+		// don't set any of these generate the same AST, and only differ in the defines inserted into code blocks.
+		UnorderedSet<String> usedDefines;
+		for (int i = 0; i < parseState->numUsedDefines; i++)
+			usedDefines.insert(parseState->usedDefines[i]);
 
+		Vector<String> codeBlocks = getCodeBlocks(parseState, RCT_CodeBlock);
+
+		// For every variation, parse the shaders using the relevant defines, re-parsing the file only if needed
+		Vector<std::function<void()>> workers;
+		for (auto& entry : variationData)
+		{
+			VariationCompileData* data = &entry;
+			auto parseWorker = [data, &source, &defines, &usedDefines, &codeBlocks, parseState]()
+			{
+				UnorderedMap<String, String> variationDefines = data->variation.getDefines().getAll();
+
+				bool affectsAST = false;
 				for (auto& define : variationDefines)
-					globalDefines[define.first] = define.second;
+				{
+					if (usedDefines.find(define.first) != usedDefines.end())
+					{
+						affectsAST = true;
+						break;
+					}
+				}
+
+				if (!affectsAST)
+				{
+					// Insert variation defines into code blocks, same as the parser would
+					String variationCode;
+					for (auto& define : variationDefines)
+					{
+						variationCode += "#define " + define.first;
 
-				ParseState* variationParseState = parseStateCreate();
-				output = parseFX(variationParseState, source.c_str(), globalDefines);
+						if (!define.second.empty())
+							variationCode += " " + define.second;
 
-				if (!output.errorMessage.empty())
-					parseStateDelete(variationParseState);
+						variationCode += "\n";
+					}
+
+					Vector<String> variationCodeBlocks(codeBlocks.size());
+					for (UINT32 i = 0; i < (UINT32)codeBlocks.size(); i++)
+						variationCodeBlocks[i] = variationCode + codeBlocks[i];
+
+					parseVariation(parseState, variationCodeBlocks, *data);
+				}
 				else
 				{
-					Vector<String> codeBlocks;
-					RawCode* rawCode = variationParseState->rawCodeBlock[RCT_CodeBlock];
-					while (rawCode != nullptr)
-					{
-						while ((INT32)codeBlocks.size() <= rawCode->index)
-							codeBlocks.push_back(String());
+					UnorderedMap<String, String> globalDefines = defines;
+					for (auto& define : variationDefines)
+						globalDefines[define.first] = define.second;
 
-						codeBlocks[rawCode->index] = String(rawCode->code, rawCode->size);
-						rawCode = rawCode->next;
+					ParseState* variationParseState = parseStateCreate();
+					data->output = parseFX(variationParseState, source.c_str(), globalDefines);
+
+					if (data->output.errorMessage.empty())
+					{
+						Vector<String> variationCodeBlocks = getCodeBlocks(variationParseState, RCT_CodeBlock);
+						parseVariation(variationParseState, variationCodeBlocks, *data);
 					}
 
-					output = compileTechniques(variationParseState, entry.second.name, codeBlocks, variation, includeSet, 
-						shaderDesc);
+					parseStateDelete(variationParseState);
+				}
+			};
 
-					if (!output.errorMessage.empty())
-						return output;
+			workers.push_back(parseWorker);
+		}
+
+		runWorkers("BSLParseVariation", workers);
+
+		// Convert the parsed HLSL code to GLSL/VKSL. Every pass and backend is cross-compiled as a separate task. Programs
+		// within a pass are compiled sequentially as their binding slots depend on each other.
+		workers.clear();
+		for (auto& data : variationData)
+		{
+			if (!data.output.errorMessage.empty())
+				continue;
+
+			for (auto& shader : data.shaders)
+			{
+				CrossCompileOutput outputType;
+				if (shader.metaData.language == "glsl")
+					outputType = CrossCompileOutput::GLSL45;
+				else if (shader.metaData.language == "glsl4_1")
+					outputType = CrossCompileOutput::GLSL41;
+				else if (shader.metaData.language == "vksl")
+					outputType = CrossCompileOutput::VKSL45;
+				else
+					continue;
+
+				for (auto& entry : shader.passes)
+				{
+					PassData* passData = &entry;
+					auto crossCompileWorker = [passData, outputType]()
+					{
+						UINT32 binding = 0;
+						for (auto& type : passData->programTypes)
+						{
+							String code = HLSLtoGLSL(passData->code, type, outputType, binding);
+
+							switch (type)
+							{
+							case GPT_VERTEX_PROGRAM: passData->vertexCode = code; break;
+							case GPT_FRAGMENT_PROGRAM: passData->fragmentCode = code; break;
+							case GPT_GEOMETRY_PROGRAM: passData->geometryCode = code; break;
+							case GPT_HULL_PROGRAM: passData->hullCode = code; break;
+							case GPT_DOMAIN_PROGRAM: passData->domainCode = code; break;
+							case GPT_COMPUTE_PROGRAM: passData->computeCode = code; break;
+							default: break;
+							}
+						}
+					};
+
+					workers.push_back(crossCompileWorker);
 				}
 			}
 		}
 
+		runWorkers("BSLCrossCompile", workers);
+
+		// Generate techniques in a fixed order, so parameters are registered the same regardless of task execution order
+		UnorderedSet<String> includeSet;
+		for (auto& data : variationData)
+		{
+			if (!data.output.errorMessage.empty())
+				return data.output;
+
+			for (auto& entry : data.includes)
+				includeSet.insert(entry);
+
+			createTechniques(data, shaderDesc);
+		}
+
 		// Generate a shader from the parsed techniques
 		for (auto& entry : includeSet)
 			includes.push_back(entry);
@@ -1865,25 +2079,18 @@ namespace bs
 		}
 
 		// Parse sub-shader code blocks
-		Vector<String> subShaderCodeBlocks;
-		RawCode* rawCode = parseState->rawCodeBlock[RCT_SubShaderBlock];
-		while (rawCode != nullptr)
-		{
-			while ((INT32)subShaderCodeBlocks.size() <= rawCode->index)
-				subShaderCodeBlocks.push_back(String());
-
-			subShaderCodeBlocks[rawCode->index] = String(rawCode->code, rawCode->size);
-			rawCode = rawCode->next;
-		}
-
-		parseStateDelete(parseState);
+		Vector<String> subShaderCodeBlocks = getCodeBlocks(parseState, RCT_SubShaderBlock);
 
 		output = populateVariations(shaderMetaData);
 
 		if (!output.errorMessage.empty())
+		{
+			parseStateDelete(parseState);
 			return output;
+		}
 
-		output = compileTechniques(shaderMetaData, source, defines, shaderDesc, includes);
+		output = compileTechniques(shaderMetaData, source, defines, parseState, shaderDesc, includes);
+		parseStateDelete(parseState);
 
 		if (!output.errorMessage.empty())
 			return output;
@@ -1940,18 +2147,13 @@ namespace bs
 		return output;
 	}
 
-	BSLFXCompileResult BSLFXCompiler::compileTechniques(ParseState* parseState, const String& name, 
-		const Vector<String>& codeBlocks, const ShaderVariation& variation, UnorderedSet<String>& includes, 
-		SHADER_DESC& shaderDesc)
+	void BSLFXCompiler::parseVariation(ParseState* parseState, const Vector<String>& codeBlocks, 
+		VariationCompileData& data)
 	{
-		BSLFXCompileResult output;
-
 		if (parseState->rootNode == nullptr || parseState->rootNode->type != NT_Root)
 		{
-			parseStateDelete(parseState);
-
-			output.errorMessage = "Root is null or not a shader.";
-			return output;
+			data.output.errorMessage = "Root is null or not a shader.";
+			return;
 		}
 
 		Vector<pair<ASTFXNode*, ShaderData>> shaderData;
@@ -1969,12 +2171,12 @@ namespace bs
 				ShaderMetaData metaData = parseShaderMetaData(option->value.nodePtr);
 
 				// Skip all techniques except the one we're parsing
-				if(metaData.name != name && !metaData.isMixin)
+				if(metaData.name != data.name && !metaData.isMixin)
 					continue;
 
 				shaderData.push_back(std::make_pair(option->value.nodePtr, ShaderData()));
-				ShaderData& data = shaderData.back().second;
-				data.metaData = metaData;
+				ShaderData& shader = shaderData.back().second;
+				shader.metaData = metaData;
 
 				break;
 			}
@@ -2028,7 +2230,7 @@ namespace bs
 				}
 				else
 				{
-					output.errorMessage = "Mixin \"" + includes + "\" cannot be found.";
+					data.output.errorMessage = "Mixin \"" + includes + "\" cannot be found.";
 					return false;
 				}
 			}
@@ -2046,9 +2248,8 @@ namespace bs
 			bs_zero_out(mixinWasParsed, shaderData.size());
 			if (!parseInherited(metaData, entry.second))
 			{
-				parseStateDelete(parseState);
 				bs_stack_free(mixinWasParsed);
-				return output;
+				return;
 			}
 
 			parseShader(entry.first, codeBlocks, entry.second);
@@ -2059,40 +2260,29 @@ namespace bs
 		IncludeLink* includeLink = parseState->includes;
 		while(includeLink != nullptr)
 		{
-			String includeFilename = includeLink->data->filename;
-
-			auto iterFind = std::find(includes.begin(), includes.end(), includeFilename);
-			if (iterFind == includes.end())
-				includes.insert(includeFilename);
-
+			data.includes.insert(includeLink->data->filename);
 			includeLink = includeLink->next;
 		}
 
-		parseStateDelete(parseState);
-
-		// Parse extended HLSL code and generate per-program code, also convert to GLSL/VKSL
-		UINT32 end = (UINT32)shaderData.size();
-		for(UINT32 i = 0; i < end; i++)
+		// Parse extended HLSL code and generate per-program code, GLSL/VKSL code is cross-compiled afterwards
+		Vector<ShaderData> crossCompiledShaders;
+		for(auto& entry : shaderData)
 		{
-			const ShaderMetaData& metaData = shaderData[i].second.metaData;
+			const ShaderMetaData& metaData = entry.second.metaData;
 			if (metaData.isMixin)
 				continue;
 
-			ShaderData& hlslTechnique = shaderData[i].second;
+			ShaderData& hlslTechnique = entry.second;
 
-			ShaderData glslTechnique = shaderData[i].second;
+			ShaderData glslTechnique = entry.second;
 
 			// When working with OpenGL, lower-end feature sets are supported. For other backends, high-end is always assumed.
-			CrossCompileOutput glslVersion = CrossCompileOutput::GLSL41;
 			if(glslTechnique.metaData.featureSet == "HighEnd")
-			{
 				glslTechnique.metaData.language = "glsl";
-				glslVersion = CrossCompileOutput::GLSL45;
-			}
 			else
 				glslTechnique.metaData.language = "glsl4_1";
 
-			ShaderData vkslTechnique = shaderData[i].second;
+			ShaderData vkslTechnique = entry.second;
 			vkslTechnique.metaData.language = "vksl";
 
 			UINT32 numPasses = (UINT32)hlslTechnique.passes.size();
@@ -2111,61 +2301,37 @@ namespace bs
 				// Note: XShaderCompiler needs to do a full pass when doing reflection, and for each individual program
 				// type. If performance is ever important here it could be good to update XShaderCompiler so it can
 				// somehow save the AST and then re-use it for multiple actions.
-				Vector<GpuProgramType> types;
-				reflectHLSL(glslPassData.code, shaderDesc, types);
+				SPtr<Xsc::Reflection::ReflectionData> reflection = bs_shared_ptr_new<Xsc::Reflection::ReflectionData>();
+				reflectHLSL(glslPassData.code, *reflection, glslPassData.programTypes);
+				data.reflection.push_back(reflection);
 
-				UINT32 glslBinding = 0;
-				UINT32 vkslBinding = 0;
+				hlslPassData.programTypes = glslPassData.programTypes;
+				vkslPassData.programTypes = glslPassData.programTypes;
 
-				// Cross-compile for all detected shader types
 				// Note: I'm just copying HLSL code as-is. This code will contain all entry points which could have
 				// an effect on compile time. It would be ideal to remove dead code depending on program type. This would
 				// involve adding a HLSL code generator to XShaderCompiler.
-				for(auto& type : types)
+				for(auto& type : hlslPassData.programTypes)
 				{
 					switch(type)
 					{
 					case GPT_VERTEX_PROGRAM:
 						hlslPassData.vertexCode = hlslPassData.code;
-						glslPassData.vertexCode = HLSLtoGLSL(glslPassData.code, GPT_VERTEX_PROGRAM, 
-							glslVersion, glslBinding);
-						vkslPassData.vertexCode = HLSLtoGLSL(glslPassData.code, GPT_VERTEX_PROGRAM, 
-							CrossCompileOutput::VKSL45, vkslBinding);
 						break;
 					case GPT_FRAGMENT_PROGRAM:
 						hlslPassData.fragmentCode = hlslPassData.code;
-						glslPassData.fragmentCode = HLSLtoGLSL(glslPassData.code, GPT_FRAGMENT_PROGRAM, 
-							glslVersion, glslBinding);
-						vkslPassData.fragmentCode = HLSLtoGLSL(glslPassData.code, GPT_FRAGMENT_PROGRAM, 
-							CrossCompileOutput::VKSL45, vkslBinding);
 						break;
 					case GPT_GEOMETRY_PROGRAM:
 						hlslPassData.geometryCode = hlslPassData.code;
-						glslPassData.geometryCode = HLSLtoGLSL(glslPassData.code, GPT_GEOMETRY_PROGRAM, 
-							glslVersion, glslBinding);
-						vkslPassData.geometryCode = HLSLtoGLSL(glslPassData.code, GPT_GEOMETRY_PROGRAM, 
-							CrossCompileOutput::VKSL45, vkslBinding);
 						break;
 					case GPT_HULL_PROGRAM:
 						hlslPassData.hullCode = hlslPassData.code;
-						glslPassData.hullCode = HLSLtoGLSL(glslPassData.code, GPT_HULL_PROGRAM, 
-							glslVersion, glslBinding);
-						vkslPassData.hullCode = HLSLtoGLSL(glslPassData.code, GPT_HULL_PROGRAM, 
-							CrossCompileOutput::VKSL45, vkslBinding);
 						break;
 					case GPT_DOMAIN_PROGRAM:
 						hlslPassData.domainCode = hlslPassData.code;
-						glslPassData.domainCode = HLSLtoGLSL(glslPassData.code, GPT_DOMAIN_PROGRAM, 
-							glslVersion, glslBinding);
-						vkslPassData.domainCode = HLSLtoGLSL(glslPassData.code, GPT_DOMAIN_PROGRAM, 
-							CrossCompileOutput::VKSL45, vkslBinding);
 						break;
 					case GPT_COMPUTE_PROGRAM:
 						hlslPassData.computeCode = hlslPassData.code;
-						glslPassData.computeCode = HLSLtoGLSL(glslPassData.code, GPT_COMPUTE_PROGRAM, 
-							glslVersion, glslBinding);
-						vkslPassData.computeCode = HLSLtoGLSL(glslPassData.code, GPT_COMPUTE_PROGRAM, 
-							CrossCompileOutput::VKSL45, vkslBinding);
 						break;
 					default:
 						break;
@@ -2173,18 +2339,26 @@ namespace bs
 				}
 			}
 
-			shaderData.push_back(std::make_pair(nullptr, glslTechnique));
-			shaderData.push_back(std::make_pair(nullptr, vkslTechnique));
+			data.shaders.push_back(hlslTechnique);
+			crossCompiledShaders.push_back(glslTechnique);
+			crossCompiledShaders.push_back(vkslTechnique);
 		}
 
-		for(auto& entry : shaderData)
+		for(auto& entry : crossCompiledShaders)
+			data.shaders.push_back(entry);
+	}
+
+	void BSLFXCompiler::createTechniques(const VariationCompileData& data, SHADER_DESC& shaderDesc)
+	{
+		for(auto& entry : data.reflection)
+			parseParameters(*entry, shaderDesc);
+
+		for(auto& entry : data.shaders)
 		{
-			const ShaderMetaData& metaData = entry.second.metaData;
-			if (metaData.isMixin)
-				continue;
+			const ShaderMetaData& metaData = entry.metaData;
 
 			Map<UINT32, SPtr<Pass>, std::greater<UINT32>> passes;
-			for (auto& passData : entry.second.passes)
+			for (auto& passData : entry.passes)
 			{
 				PASS_DESC passDesc;
 				passDesc.blendStateDesc = passData.blendDesc;
@@ -2253,12 +2427,11 @@ namespace bs
 
 			if (orderedPasses.size() > 0)
 			{
-				SPtr<Technique> technique = Technique::create(metaData.language, metaData.tags, variation, orderedPasses);
+				SPtr<Technique> technique = Technique::create(metaData.language, metaData.tags, data.variation, 
+					orderedPasses);
 				shaderDesc.techniques.push_back(technique);
 			}
 		}
-
-		return output;
 	}
 
 	String BSLFXCompiler::removeQuotes(const char* input)
@@ -13,6 +13,8 @@ extern "C" {
 #include "BsASTFX.h"
 }
 
+namespace Xsc { namespace Reflection { struct ReflectionData; } }
+
 namespace bs
 {
 	/** @addtogroup BansheeSL
@@ -52,6 +54,7 @@ namespace bs
 			bool depthStencilIsDefault = true;
 
 			String code; // Parsed code block
+			Vector<GpuProgramType> programTypes; // Types of programs with entry points in the code block
 
 			String vertexCode;
 			String fragmentCode;
@@ -96,6 +99,22 @@ namespace bs
 			UINT32 codeBlockIndex;
 		};
 
+		/** 
+		 * Intermediate results of compiling a single shader variation. Generated on worker threads and then turned into 
+		 * techniques on the calling thread.
+		 */
+		struct VariationCompileData
+		{
+			String name;
+			ShaderVariation variation;
+
+			Vector<ShaderData> shaders;
+			Vector<SPtr<Xsc::Reflection::ReflectionData>> reflection;
+			UnorderedSet<String> includes;
+
+			BSLFXCompileResult output;
+		};
+
 	public:
 		/**	Transforms a source file written in BSL FX syntax into a Shader object. */
 		static BSLFXCompileResult compile(const String& name, const String& source, 
@@ -251,7 +270,7 @@ namespace bs
 
 		/**
 		 * Uses the provided list of shaders/mixins to generate a list of techniques. A technique is generated for
-		 * every variation and render backend.
+		 * every variation and render backend. Variations are parsed and cross-compiled in parallel.
 		 * 
 		 * @param[in]	shaderMetaData		A list of mixins and shaders. Shaders should contain a list of variations to
 		 *									generate (usually populated via a previous call to populateVariations()).
@@ -259,32 +278,42 @@ namespace bs
 		 *									needs to be re-parsed due to variations.
 		 * @param[in]	defines				An optional set of defines to set before parsing the source, that is to be
 		 *									applied to all variations.
+		 * @param[in]	parseState			Parser state containing the AST of @p source parsed using only @p defines. 
+		 *									Re-used for variations whose defines are never referenced by the BSL 
+		 *									pre-processor, instead of re-parsing the source.
 		 * @param[out]	shaderDesc			Shader descriptor that resulting techniques, and non-internal parameters will be
 		 *									registered with.
 		 * @param[out]	includes			A list of all include files included by the BSL source.
 		 * @return							A result object containing an error message if not successful.
 		 */
 		static BSLFXCompileResult compileTechniques(const Vector<std::pair<ASTFXNode*, ShaderMetaData>>& shaderMetaData,
-			const String& source, const UnorderedMap<String, String>& defines, SHADER_DESC& shaderDesc, 
-			Vector<String>& includes);
+			const String& source, const UnorderedMap<String, String>& defines, ParseState* parseState, 
+			SHADER_DESC& shaderDesc, Vector<String>& includes);
 
 		/**
-		 * Generates a set of techniques for a single variation. Uses AST parse state as input, which must be created using
-		 * the defines of the relevant variation.
+		 * Parses the shaders for a single variation, generating HLSL code for every pass, along with reflection data and
+		 * GLSL/VKSL counterparts that still need to be cross-compiled. Only reads from the provided AST, and can therefore
+		 * be called from multiple threads using the same parse state.
 		 *
-		 * @param[in, out]	parseState	Parser state object that has previously been initialized with the AST using 
+		 * @param[in]	parseState		Parser state object that has previously been initialized with the AST using 
 		 *								parseFX().
-		 * @param[in]	name			Name of the shader to generate the variation for.
 		 * @param[in]	codeBlocks		Blocks containing GPU program source code that are referenced by the AST.
-		 * @param[in]	variation		Shader variation the AST was parsed with.
-		 * @param[out]	includes		Set to append newly found includes to.
+		 * @param[in, out]	data		Variation to parse. Outputs the parsed shaders, reflection data and includes, or
+		 *								an error message.
+		 */
+		static void parseVariation(ParseState* parseState, const Vector<String>& codeBlocks, 
+			VariationCompileData& data);
+
+		/**
+		 * Generates a set of techniques for a single variation, whose code has been previously generated through 
+		 * parseVariation() and cross-compiled. Must be called in the same order for every variation, so parameters get
+		 * registered deterministically.
+		 *
+		 * @param[in]	data			Parsed variation to generate the techniques from.
 		 * @param[out]	shaderDesc		Shader descriptor that resulting techniques, and non-internal parameters will be
 		 *								registered with.
-		 * @return						A result object containing an error message if not successful.
 		 */
-		static BSLFXCompileResult compileTechniques(ParseState* parseState, const String& name, 
-			const Vector<String>& codeBlocks, const ShaderVariation& variation, UnorderedSet<String>& includes, 
-			SHADER_DESC& shaderDesc);
+		static void createTechniques(const VariationCompileData& data, SHADER_DESC& shaderDesc);
 
 		/**
 		 * Converts a null-terminated string into a standard string, and eliminates quotes that are assumed to be at the 
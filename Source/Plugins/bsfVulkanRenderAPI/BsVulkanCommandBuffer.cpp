@@ -1256,7 +1256,7 @@ namespace bs { namespace ct
 		SPtr<VulkanVertexInput> vertexInput = VulkanVertexInputManager::instance().getVertexInfo(mVertexDecl, inputDecl);
 
 		VulkanPipeline* pipeline = mGraphicsPipeline->getPipeline(mDevice.getIndex(), mFramebuffer,
-			mRenderTargetReadOnlyFlags, mDrawOp, vertexInput);
+			mRenderTargetReadOnlyFlags, mDrawOp, mVertexDecl, vertexInput);
 
 		if (pipeline == nullptr)
 			return false;
@@ -5,6 +5,7 @@
 #include "BsVulkanCommandBuffer.h"
 #include "Managers/BsVulkanDescriptorManager.h"
 #include "Managers/BsVulkanQueryManager.h"
+#include "Managers/BsVulkanPipelineCacheManager.h"
 
 #define VMA_IMPLEMENTATION
 #include "ThirdParty/vk_mem_alloc.h"
@@ -159,6 +160,7 @@ namespace bs { namespace ct
 		mQueryPool = bs_new<VulkanQueryPool>(*this);
 		mDescriptorManager = bs_new<VulkanDescriptorManager>(*this);
 		mResourceManager = bs_new<VulkanResourceManager>(*this);
+		mPipelineCacheManager = bs_new<VulkanPipelineCacheManager>(*this);
 	}
 
 	VulkanDevice::~VulkanDevice()
@@ -175,10 +177,13 @@ namespace bs { namespace ct
 			}
 		}
 
-		bs_delete(mDescriptorManager);
+		bs_delete(mPipelineCacheManager);
 		bs_delete(mQueryPool);
 		bs_delete(mCommandBufferPool);
 
+		// Needs to happen after any resource destruction that could notify the descriptor manager
+		bs_delete(mDescriptorManager);
+
 		// Needs to happen after query pool & command buffer pool shutdown, to ensure their resources are destroyed
 		bs_delete(mResourceManager);
 		
@@ -81,6 +81,9 @@ namespace bs { namespace ct
 		/** Returns a manager that can be used for allocating descriptor layouts and sets. */
 		VulkanDescriptorManager& getDescriptorManager() const { return *mDescriptorManager; }
 
+		/** Returns a manager that persists pipeline data between runs, and tracks pipeline creation statistics. */
+		VulkanPipelineCacheManager& getPipelineCacheManager() const { return *mPipelineCacheManager; }
+
 		/** Returns a manager that can be used for allocating Vulkan objects wrapped as managed resources. */
 		VulkanResourceManager& getResourceManager() const { return *mResourceManager; }
 
@@ -120,6 +123,7 @@ namespace bs { namespace ct
 		VulkanQueryPool* mQueryPool;
 		VulkanDescriptorManager* mDescriptorManager;
 		VulkanResourceManager* mResourceManager;
+		VulkanPipelineCacheManager* mPipelineCacheManager;
 		VmaAllocator mAllocator;
 
 		VkPhysicalDeviceProperties mDeviceProperties;
@@ -4,9 +4,47 @@
 #include "BsVulkanTexture.h"
 #include "BsVulkanUtility.h"
 #include "BsVulkanDevice.h"
+#include "Managers/BsVulkanPipelineCacheManager.h"
 
 namespace bs { namespace ct
 {
+	/** Fills out subpass dependencies used by all frame-buffer render passes. */
+	static void getSubpassDependencies(VkSubpassDependency (&dependencies)[2])
+	{
+		// Subpass dependencies for layout transitions
+		dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[0].dstSubpass = 0;
+		dependencies[0].srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+		dependencies[0].dstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+		dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | 
+			VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+		dependencies[0].dependencyFlags = 0;
+
+		dependencies[1].srcSubpass = 0;
+		dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[1].srcStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		dependencies[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+		dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | 
+			VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+		dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+		dependencies[1].dependencyFlags = 0;
+	}
+
+	bool VulkanFramebufferLayout::operator==(const VulkanFramebufferLayout& rhs) const
+	{
+		if (numColorAttachments != rhs.numColorAttachments || hasDepth != rhs.hasDepth || sampleFlags != rhs.sampleFlags)
+			return false;
+
+		for (UINT32 i = 0; i < numColorAttachments; i++)
+		{
+			if (colorFormats[i] != rhs.colorFormats[i])
+				return false;
+		}
+
+		return !hasDepth || depthFormat == rhs.depthFormat;
+	}
+
 	VulkanFramebuffer::VariantKey::VariantKey(RenderSurfaceMask loadMask, RenderSurfaceMask readMask, 
 		ClearMask clearMask)
 		:loadMask(loadMask), readMask(readMask), clearMask(clearMask)
@@ -60,6 +98,8 @@ namespace bs { namespace ct
 			else
 				attachmentDesc.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
+			mLayout.colorFormats[attachmentIdx] = attachmentDesc.format;
+
 			mColorAttachments[attachmentIdx].baseLayer = desc.color[i].baseLayer;
 			mColorAttachments[attachmentIdx].image = desc.color[i].image;
 			mColorAttachments[attachmentIdx].finalLayout = attachmentDesc.finalLayout;
@@ -94,6 +134,8 @@ namespace bs { namespace ct
 			attachmentDesc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 			attachmentDesc.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
+			mLayout.depthFormat = attachmentDesc.format;
+
 			mDepthStencilAttachment.baseLayer = desc.depth.baseLayer;
 			mDepthStencilAttachment.image = desc.depth.image;
 			mDepthStencilAttachment.finalLayout = attachmentDesc.finalLayout;
@@ -133,24 +175,7 @@ namespace bs { namespace ct
 		else
 			mSubpassDesc.pDepthStencilAttachment = nullptr;
 
-		// Subpass dependencies for layout transitions
-		mDependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-		mDependencies[0].dstSubpass = 0;
-		mDependencies[0].srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-		mDependencies[0].dstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-		mDependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
-		mDependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | 
-			VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
-		mDependencies[0].dependencyFlags = 0;
-
-		mDependencies[1].srcSubpass = 0;
-		mDependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
-		mDependencies[1].srcStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-		mDependencies[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-		mDependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | 
-			VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
-		mDependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
-		mDependencies[1].dependencyFlags = 0;
+		getSubpassDependencies(mDependencies);
 
 		// Create render pass and frame buffer create infos
 		mRenderPassCI.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
@@ -173,7 +198,13 @@ namespace bs { namespace ct
 		mFramebufferCI.height = desc.height;
 		mFramebufferCI.layers = desc.layers;
 
-		mDefault = createVariant(RT_NONE, RT_NONE, CLEAR_NONE);		
+		mDefault = createVariant(RT_NONE, RT_NONE, CLEAR_NONE);
+
+		mLayout.numColorAttachments = mNumColorAttachments;
+		mLayout.hasDepth = mHasDepth;
+		mLayout.sampleFlags = mSampleFlags;
+
+		mLayoutId = mOwner->getDevice().getPipelineCacheManager().getLayoutId(mLayout);
 	}
 
 	VulkanFramebuffer::~VulkanFramebuffer()
@@ -279,6 +310,86 @@ namespace bs { namespace ct
 		return variant;
 	}
 
+	VkRenderPass VulkanFramebuffer::createCompatibleRenderPass(VkDevice device, const VulkanFramebufferLayout& layout)
+	{
+		// Only formats, sample counts and the subpass structure need to match for render passes to be compatible, so load
+		// and store operations and layouts are just set to any valid values
+		VkAttachmentDescription attachments[BS_MAX_MULTIPLE_RENDER_TARGETS + 1];
+		VkAttachmentReference colorReferences[BS_MAX_MULTIPLE_RENDER_TARGETS];
+		VkAttachmentReference depthReference;
+
+		UINT32 attachmentIdx = 0;
+		for (UINT32 i = 0; i < layout.numColorAttachments; i++)
+		{
+			VkAttachmentDescription& attachmentDesc = attachments[attachmentIdx];
+			attachmentDesc.flags = 0;
+			attachmentDesc.format = layout.colorFormats[i];
+			attachmentDesc.samples = layout.sampleFlags;
+			attachmentDesc.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDesc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+			attachmentDesc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDesc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachmentDesc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			attachmentDesc.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+			colorReferences[i].attachment = attachmentIdx;
+			colorReferences[i].layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+			attachmentIdx++;
+		}
+
+		if (layout.hasDepth)
+		{
+			VkAttachmentDescription& attachmentDesc = attachments[attachmentIdx];
+			attachmentDesc.flags = 0;
+			attachmentDesc.format = layout.depthFormat;
+			attachmentDesc.samples = layout.sampleFlags;
+			attachmentDesc.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDesc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+			attachmentDesc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachmentDesc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
+			attachmentDesc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			attachmentDesc.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+			depthReference.attachment = attachmentIdx;
+			depthReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+			attachmentIdx++;
+		}
+
+		VkSubpassDescription subpassDesc;
+		subpassDesc.flags = 0;
+		subpassDesc.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpassDesc.colorAttachmentCount = layout.numColorAttachments;
+		subpassDesc.pColorAttachments = layout.numColorAttachments > 0 ? colorReferences : nullptr;
+		subpassDesc.inputAttachmentCount = 0;
+		subpassDesc.pInputAttachments = nullptr;
+		subpassDesc.preserveAttachmentCount = 0;
+		subpassDesc.pPreserveAttachments = nullptr;
+		subpassDesc.pResolveAttachments = nullptr;
+		subpassDesc.pDepthStencilAttachment = layout.hasDepth ? &depthReference : nullptr;
+
+		VkSubpassDependency dependencies[2];
+		getSubpassDependencies(dependencies);
+
+		VkRenderPassCreateInfo renderPassCI;
+		renderPassCI.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		renderPassCI.pNext = nullptr;
+		renderPassCI.flags = 0;
+		renderPassCI.attachmentCount = attachmentIdx;
+		renderPassCI.pAttachments = attachments;
+		renderPassCI.subpassCount = 1;
+		renderPassCI.pSubpasses = &subpassDesc;
+		renderPassCI.dependencyCount = 2;
+		renderPassCI.pDependencies = dependencies;
+
+		VkRenderPass renderPass;
+		VkResult result = vkCreateRenderPass(device, &renderPassCI, gVulkanAllocator, &renderPass);
+		assert(result == VK_SUCCESS);
+
+		return renderPass;
+	}
+
 	VkRenderPass VulkanFramebuffer::getRenderPass(RenderSurfaceMask loadMask, RenderSurfaceMask readMask,
 												  ClearMask clearMask) const
 	{
@@ -62,6 +62,22 @@ namespace bs { namespace ct
 		UINT32 index = 0;
 	};
 
+	/** 
+	 * Describes formats and sample counts of frame-buffer attachments. Render passes of frame-buffers with equal layouts
+	 * are compatible, meaning a pipeline created for one of them can be used with any of them.
+	 */
+	struct VulkanFramebufferLayout
+	{
+		/** Compares two layouts. */
+		bool operator==(const VulkanFramebufferLayout& rhs) const;
+
+		VkFormat colorFormats[BS_MAX_MULTIPLE_RENDER_TARGETS] = {};
+		VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+		UINT32 numColorAttachments = 0;
+		bool hasDepth = false;
+		VkSampleCountFlagBits sampleFlags = VK_SAMPLE_COUNT_1_BIT;
+	};
+
 	/** Vulkan frame buffer containing one or multiple color surfaces, and an optional depth surface. */
 	class VulkanFramebuffer : public VulkanResource
 	{
@@ -77,6 +93,15 @@ namespace bs { namespace ct
 		/** Returns a unique ID of this framebuffer. */
 		UINT32 getId() const { return mId; }
 
+		/** 
+		 * Returns an ID shared by all frame-buffers with the same attachment layout (formats and sample counts). Pipelines 
+		 * created for one frame-buffer can be used with any other frame-buffer with the same layout ID.
+		 */
+		UINT32 getLayoutId() const { return mLayoutId; }
+
+		/** Returns formats and sample counts of the frame-buffer attachments. */
+		const VulkanFramebufferLayout& getLayout() const { return mLayout; }
+
 		/** 
 		 * Gets internal Vulkan render pass object. 
 		 * 
@@ -126,6 +151,12 @@ namespace bs { namespace ct
 		 * the clear mask and the attachments on the framebuffer. 
 		 */
 		UINT32 getNumClearEntries(ClearMask clearMask) const;
+
+		/** 
+		 * Creates a render pass compatible with the render passes of all frame-buffers with the provided layout. Caller is
+		 * responsible for destroying the render pass.
+		 */
+		static VkRenderPass createCompatibleRenderPass(VkDevice device, const VulkanFramebufferLayout& layout);
 	private:
 		/** Information about a single frame-buffer variant. */
 		struct Variant
@@ -160,6 +191,8 @@ namespace bs { namespace ct
 		Variant createVariant(RenderSurfaceMask loadMask, RenderSurfaceMask readMask, ClearMask clearMask) const;
 
 		UINT32 mId;
+		UINT32 mLayoutId;
+		VulkanFramebufferLayout mLayout;
 
 		Variant mDefault;
 		mutable UnorderedMap<VariantKey, Variant, VariantKey::HashFunction, VariantKey::EqualFunction> mVariants;
@@ -13,6 +13,7 @@
 #include "BsVulkanSamplerState.h"
 #include "BsVulkanGpuPipelineParamInfo.h"
 #include "BsVulkanCommandBuffer.h"
+#include "Managers/BsVulkanDescriptorManager.h"
 #include "Managers/BsVulkanTextureManager.h"
 #include "Managers/BsVulkanHardwareBufferManager.h"
 #include "RenderAPI/BsGpuParamDesc.h"
@@ -37,10 +38,9 @@ namespace bs { namespace ct
 
 			for (UINT32 j = 0; j < numSets; j++)
 			{
-				for (auto& entry : mPerDeviceData[i].perSetData[j].sets)
-					entry->destroy();
-
-				mPerDeviceData[i].perSetData[j].sets.~Vector<VulkanDescriptorSet*>();
+				VulkanCachedDescriptorSet* cachedSet = mPerDeviceData[i].perSetData[j].cachedSet;
+				if (cachedSet != nullptr)
+					mPerDeviceData[i].descriptorManager->releaseSet(cachedSet);
 			}
 		}
 	}
@@ -78,6 +78,7 @@ namespace bs { namespace ct
 			.reserve<PerSetData>(numSets * numDevices)
 			.reserve<VkWriteDescriptorSet>(numBindings * numDevices)
 			.reserve<WriteInfo>(numBindings * numDevices)
+			.reserve<UINT64>(numBindings * numDevices * KEY_WORDS_PER_BINDING)
 			.reserve<VkImage>(numTextures * numDevices)
 			.reserve<VkImage>(numStorageTextures * numDevices)
 			.reserve<VkBuffer>(numParamBlocks * numDevices)
@@ -87,8 +88,10 @@ namespace bs { namespace ct
 
 		Lock lock(mMutex); // Set write operations need to be thread safe
 
+		// Sets are acquired on first bind
 		mSetsDirty = mAlloc.alloc<bool>(numSets);
-		bs_zero_out(mSetsDirty, numSets);
+		for (UINT32 i = 0; i < numSets; i++)
+			mSetsDirty[i] = true;
 
 		VulkanSamplerState* defaultSampler = static_cast<VulkanSamplerState*>(SamplerState::getDefault().get());
 		VulkanTextureManager& vkTexManager = static_cast<VulkanTextureManager&>(TextureManager::instance());
@@ -100,6 +103,7 @@ namespace bs { namespace ct
 			if (devices[i] == nullptr)
 			{
 				mPerDeviceData[i].perSetData = nullptr;
+				mPerDeviceData[i].descriptorManager = nullptr;
 
 				continue;
 			}
@@ -117,7 +121,7 @@ namespace bs { namespace ct
 			bs_zero_out(mPerDeviceData[i].buffers, numBuffers);
 			bs_zero_out(mPerDeviceData[i].samplers, numSamplers);
 
-			VulkanDescriptorManager& descManager = devices[i]->getDescriptorManager();
+			mPerDeviceData[i].descriptorManager = &devices[i]->getDescriptorManager();
 			VulkanSampler* vkDefaultSampler = defaultSampler->getResource(i);
 
 			for (UINT32 j = 0; j < numSets; j++)
@@ -125,15 +129,12 @@ namespace bs { namespace ct
 				UINT32 numBindingsPerSet = vkParamInfo.getNumBindings(j);
 
 				PerSetData& perSetData = mPerDeviceData[i].perSetData[j];
-				new (&perSetData.sets) Vector<VulkanDescriptorSet*>();
-
 				perSetData.writeSetInfos = mAlloc.alloc<VkWriteDescriptorSet>(numBindingsPerSet);
 				perSetData.writeInfos = mAlloc.alloc<WriteInfo>(numBindingsPerSet);
+				perSetData.contentKey = mAlloc.alloc<UINT64>(numBindingsPerSet * KEY_WORDS_PER_BINDING);
 
-				VulkanDescriptorLayout* layout = vkParamInfo.getLayout(i, j);
 				perSetData.numElements = numBindingsPerSet;
-				perSetData.latestSet = descManager.createSet(layout);
-				perSetData.sets.push_back(perSetData.latestSet);
+				perSetData.cachedSet = nullptr;
 
 				VkDescriptorSetLayoutBinding* perSetBindings = vkParamInfo.getBindings(j);
 				GpuParamObjectType* types = vkParamInfo.getLayoutTypes(j);
@@ -541,6 +542,18 @@ namespace bs { namespace ct
 		UINT32 numBuffers = vkParamInfo.getNumElements(GpuPipelineParamInfo::ParamType::Buffer);
 		UINT32 numSamplers = vkParamInfo.getNumElements(GpuPipelineParamInfo::ParamType::SamplerState);
 		UINT32 numSets = vkParamInfo.getNumSets();
+		UINT32 numElements = numParamBlocks + numTextures + numStorageTextures + numBuffers + numSamplers;
+
+		// Resources referenced by each element, grouped per type, required for descriptor set lookup
+		VulkanResource** resources = (VulkanResource**)bs_stack_alloc(sizeof(VulkanResource*) * numElements * 2);
+		memset(resources, 0, sizeof(VulkanResource*) * numElements);
+
+		VulkanResource** paramBlockResources = resources;
+		VulkanResource** bufferResources = paramBlockResources + numParamBlocks;
+		VulkanResource** samplerResources = bufferResources + numBuffers;
+		VulkanResource** storageTextureResources = samplerResources + numSamplers;
+		VulkanResource** textureResources = storageTextureResources + numStorageTextures;
+		VulkanResource** setResources = resources + numElements;
 
 		Lock lock(mMutex);
 
@@ -559,6 +572,8 @@ namespace bs { namespace ct
 			if (resource == nullptr)
 				continue;
 
+			paramBlockResources[i] = resource;
+
 			// Register with command buffer
 			buffer.registerResource(resource, VK_ACCESS_UNIFORM_READ_BIT, VulkanUseFlag::Read);
 
@@ -590,6 +605,8 @@ namespace bs { namespace ct
 			if (resource == nullptr)
 				continue;
 
+			bufferResources[i] = resource;
+
 			// Register with command buffer
 			VkAccessFlags accessFlags = VK_ACCESS_SHADER_READ_BIT;
 			VulkanUseFlags useFlags = VulkanUseFlag::Read;
@@ -644,6 +661,8 @@ namespace bs { namespace ct
 			if (resource == nullptr)
 				continue;
 
+			samplerResources[i] = resource;
+
 			// Register with command buffer
 			buffer.registerResource(resource, VulkanUseFlag::Read);
 
@@ -675,6 +694,8 @@ namespace bs { namespace ct
 			if (resource == nullptr)
 				continue;
 
+			storageTextureResources[i] = resource;
+
 			const TextureSurface& surface = mLoadStoreTextureData[i].surface;
 			VkImageSubresourceRange range = resource->getRange(surface);
 
@@ -711,6 +732,8 @@ namespace bs { namespace ct
 			if (resource == nullptr)
 				continue;
 
+			textureResources[i] = resource;
+
 			// Register with command buffer
 			const TextureProperties& props = element->getProperties();
 
@@ -754,52 +777,91 @@ namespace bs { namespace ct
 			}
 		}
 
-		// Acquire sets as needed, and updated their contents if dirty
-		VulkanRenderAPI& rapi = static_cast<VulkanRenderAPI&>(RenderAPI::instance());
-		VulkanDevice& device = *rapi._getDevice(deviceIdx);
-		VulkanDescriptorManager& descManager = device.getDescriptorManager();
+		// Acquire sets matching the current contents, if dirty. Sets with the same contents are shared between all GPU
+		// parameter objects, and retrieved from the descriptor manager's cache when available.
+		VulkanDescriptorManager& descManager = *perDeviceData.descriptorManager;
 
-		for (UINT32 i = 0; i < numSets; i++)
+		UINT32 setIdx = 0;
+		UINT32 numSetResources = 0;
+		auto addSetResources = [&](GpuPipelineParamInfo::ParamType type, VulkanResource** elements, UINT32 count)
 		{
-			PerSetData& perSetData = perDeviceData.perSetData[i];
+			for (UINT32 j = 0; j < count; j++)
+			{
+				if (elements[j] == nullptr)
+					continue;
 
-			if (!mSetsDirty[i]) // Set not dirty, just use the last one we wrote (this is fine even across multiple command buffers)
+				UINT32 set, slot;
+				mParamInfo->getBinding(type, j, set, slot);
+
+				if (set == setIdx)
+					setResources[numSetResources++] = elements[j];
+			}
+		};
+
+		for (setIdx = 0; setIdx < numSets; setIdx++)
+		{
+			PerSetData& perSetData = perDeviceData.perSetData[setIdx];
+
+			// Set not dirty, just use the last one we acquired (this is fine even across multiple command buffers)
+			if (!mSetsDirty[setIdx] && perSetData.cachedSet != nullptr)
 				continue;
 
-			// Set is dirty, we need to update
-			//// Use latest unless already used, otherwise try to find an unused one
-			if(perSetData.latestSet->isBound()) // Checking this is okay, because it's only modified below when we call registerResource, which is under the same lock as this
+			numSetResources = 0;
+			addSetResources(GpuPipelineParamInfo::ParamType::ParamBlock, paramBlockResources, numParamBlocks);
+			addSetResources(GpuPipelineParamInfo::ParamType::Buffer, bufferResources, numBuffers);
+			addSetResources(GpuPipelineParamInfo::ParamType::SamplerState, samplerResources, numSamplers);
+			addSetResources(GpuPipelineParamInfo::ParamType::LoadStoreTexture, storageTextureResources, 
+				numStorageTextures);
+			addSetResources(GpuPipelineParamInfo::ParamType::Texture, textureResources, numTextures);
+
+			// Build the key from the fields relevant to each descriptor type, as unused parts of the write infos are
+			// undefined
+			for (UINT32 j = 0; j < perSetData.numElements; j++)
 			{
-				perSetData.latestSet = nullptr;
+				const WriteInfo& writeInfo = perSetData.writeInfos[j];
+				UINT64* bindingKey = &perSetData.contentKey[j * KEY_WORDS_PER_BINDING];
 
-				for(auto& entry : perSetData.sets)
+				switch (perSetData.writeSetInfos[j].descriptorType)
 				{
-					if(!entry->isBound())
-					{
-						perSetData.latestSet = entry;
-						break;
-					}
-				}
-
-				// Cannot find an empty set, allocate a new one
-				if (perSetData.latestSet == nullptr)
-				{
-					VulkanDescriptorLayout* layout = vkParamInfo.getLayout(deviceIdx, i);
-					perSetData.latestSet = descManager.createSet(layout);
-					perSetData.sets.push_back(perSetData.latestSet);
+				case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+				case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+				case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+					bindingKey[0] = (UINT64)writeInfo.image.sampler;
+					bindingKey[1] = (UINT64)writeInfo.image.imageView;
+					bindingKey[2] = (UINT64)writeInfo.image.imageLayout;
+					break;
+				case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+				case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+					bindingKey[0] = (UINT64)writeInfo.buffer.buffer;
+					bindingKey[1] = (UINT64)writeInfo.buffer.offset;
+					bindingKey[2] = (UINT64)writeInfo.buffer.range;
+					break;
+				default:
+					bindingKey[0] = (UINT64)writeInfo.bufferView;
+					bindingKey[1] = 0;
+					bindingKey[2] = 0;
+					break;
 				}
 			}
 
-			// Note: Currently I write to the entire set at once, but it might be beneficial to remember only the exact
-			// entries that were updated, and only write to them individually.
-			perSetData.latestSet->write(perSetData.writeSetInfos, perSetData.numElements);
+			VulkanDescriptorLayout* layout = vkParamInfo.getLayout(deviceIdx, setIdx);
+			UINT32 contentSize = perSetData.numElements * KEY_WORDS_PER_BINDING;
 
-			mSetsDirty[i] = false;
+			VulkanCachedDescriptorSet* cachedSet = descManager.acquireSet(layout, perSetData.writeSetInfos, 
+				perSetData.numElements, perSetData.contentKey, contentSize, setResources, numSetResources);
+
+			if (perSetData.cachedSet != nullptr)
+				descManager.releaseSet(perSetData.cachedSet);
+
+			perSetData.cachedSet = cachedSet;
+			mSetsDirty[setIdx] = false;
 		}
 
+		bs_stack_free(resources);
+
 		for (UINT32 i = 0; i < numSets; i++)
 		{
-			VulkanDescriptorSet* set = perDeviceData.perSetData[i].latestSet;
+			VulkanDescriptorSet* set = perDeviceData.perSetData[i].cachedSet->set;
 
 			buffer.registerResource(set, VulkanUseFlag::Read);
 			sets[i] = set->getHandle();
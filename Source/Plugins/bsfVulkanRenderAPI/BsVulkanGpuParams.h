@@ -39,12 +39,16 @@ namespace bs { namespace ct
 		UINT32 getNumSets() const;
 
 		/** 
-		 * Prepares the internal descriptor sets for a bind operation on the provided command buffer. It generates and/or
-		 * updates and descriptor sets, and registers the relevant resources with the command buffer.
+		 * Prepares the internal descriptor sets for a bind operation on the provided command buffer. It retrieves a 
+		 * descriptor set matching the current contents from the descriptor manager (potentially shared with other
+		 * objects binding the same resources), and registers the relevant resources with the command buffer.
 		 * 
 		 * Caller must perform external locking if some other thread could write to this object while it is being bound. 
 		 * The same applies to any resources held by this object.
 		 * 
+		 * The object's mutex is held while acquiring sets from the descriptor manager, which locks its own mutex in
+		 * turn. The manager never calls back into a GPU parameter object.
+		 * 
 		 * @param[in]	buffer	Buffer on which the parameters will be bound to.
 		 * @param[out]	sets	Pre-allocated buffer in which the descriptor set handled will be written. Must be of
 		 *						getNumSets() size.
@@ -62,14 +66,17 @@ namespace bs { namespace ct
 			VkBufferView bufferView;
 		};
 
+		/** Number of 64-bit words identifying the contents of a single binding, when looking up cached sets. */
+		static const UINT32 KEY_WORDS_PER_BINDING = 3;
+
 		/** All GPU param data related to a single descriptor set. */
 		struct PerSetData
 		{
-			VulkanDescriptorSet* latestSet;
-			Vector<VulkanDescriptorSet*> sets;
+			VulkanCachedDescriptorSet* cachedSet;
 
 			VkWriteDescriptorSet* writeSetInfos;
 			WriteInfo* writeInfos;
+			UINT64* contentKey;
 
 			UINT32 numElements;
 		};
@@ -78,6 +85,7 @@ namespace bs { namespace ct
 		struct PerDeviceData
 		{
 			PerSetData* perSetData;
+			VulkanDescriptorManager* descriptorManager;
 
 			VkImage* sampledImages;
 			VkImage* storageImages;
@@ -13,6 +13,8 @@
 #include "RenderAPI/BsDepthStencilState.h"
 #include "RenderAPI/BsBlendState.h"
 #include "Profiling/BsRenderStats.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
 
 namespace bs { namespace ct
 {
@@ -32,8 +34,8 @@ namespace bs { namespace ct
 	}
 
 	VulkanGraphicsPipelineState::GpuPipelineKey::GpuPipelineKey(
-		UINT32 framebufferId, UINT32 vertexInputId, UINT32 readOnlyFlags, DrawOperationType drawOp)
-		: framebufferId(framebufferId), vertexInputId(vertexInputId), readOnlyFlags(readOnlyFlags)
+		UINT32 layoutId, UINT32 vertexInputId, UINT32 readOnlyFlags, DrawOperationType drawOp)
+		: layoutId(layoutId), vertexInputId(vertexInputId), readOnlyFlags(readOnlyFlags)
 		, drawOp(drawOp)
 	{
 		
@@ -42,7 +44,7 @@ namespace bs { namespace ct
 	size_t VulkanGraphicsPipelineState::HashFunc::operator()(const GpuPipelineKey& key) const
 	{
 		size_t hash = 0;
-		hash_combine(hash, key.framebufferId);
+		hash_combine(hash, key.layoutId);
 		hash_combine(hash, key.vertexInputId);
 		hash_combine(hash, key.readOnlyFlags);
 		hash_combine(hash, key.drawOp);
@@ -52,7 +54,7 @@ namespace bs { namespace ct
 
 	bool VulkanGraphicsPipelineState::EqualFunc::operator()(const GpuPipelineKey& a, const GpuPipelineKey& b) const
 	{
-		if (a.framebufferId != b.framebufferId)
+		if (a.layoutId != b.layoutId)
 			return false;
 
 		if (a.vertexInputId != b.vertexInputId)
@@ -80,6 +82,12 @@ namespace bs { namespace ct
 
 	VulkanGraphicsPipelineState::~VulkanGraphicsPipelineState()
 	{
+		if (mPrecompileTask != nullptr)
+		{
+			mAbortPrecompile = true;
+			mPrecompileTask->wait();
+		}
+
 		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
 		{
 			if (mPerDeviceData[i].device == nullptr)
@@ -314,12 +322,77 @@ namespace bs { namespace ct
 			bs_stack_free(layouts);
 		}
 
+		// Hash identifying the pipeline state across runs, used for finding variations of the state recorded during
+		// previous runs. Programs without bytecode cannot be identified, and their variations are not recorded.
+		size_t stateHash = 0;
+		bool hasBytecode = true;
+		for(UINT32 i = 0; i < numStages; i++)
+		{
+			if (stages[i].second == nullptr)
+				continue;
+
+			SPtr<GpuProgramBytecode> bytecode = stages[i].second->getBytecode();
+			if (bytecode == nullptr || bytecode->instructions.size == 0)
+			{
+				hasBytecode = false;
+				break;
+			}
+
+			size_t programHash = 0;
+			hash_combine(programHash, (UINT32)stages[i].first);
+			hash_combine(programHash, String((const char*)bytecode->instructions.data, bytecode->instructions.size));
+			hash_combine(programHash, static_cast<VulkanGpuProgram*>(stages[i].second)->getEntryPoint());
+
+			hash_combine(stateHash, programHash);
+		}
+
+		if (hasBytecode)
+		{
+			hash_combine(stateHash, rstProps.getHash());
+			hash_combine(stateHash, blendProps.getHash());
+			hash_combine(stateHash, dsProps.getHash());
+
+			mStateHash = stateHash;
+		}
+
+		// Create variations used during previous runs on a worker thread, so they're ready before first use
+		if (mStateHash != 0 && mVertexDecl != nullptr)
+		{
+			for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
+			{
+				if (mPerDeviceData[i].device == nullptr)
+					continue;
+
+				VulkanPipelineCacheManager& cacheManager = mPerDeviceData[i].device->getPipelineCacheManager();
+				Vector<VulkanRecordedPipeline> recordedPipelines = cacheManager.getRecordedPipelines(mStateHash);
+
+				for (auto& entry : recordedPipelines)
+				{
+					PrecompileEntry precompileEntry;
+					precompileEntry.deviceIdx = i;
+					precompileEntry.recorded = entry;
+					precompileEntry.vertexInput = 
+						VulkanVertexInputManager::instance().getVertexInfo(entry.vertexDecl, mVertexDecl);
+
+					mPrecompileEntries.push_back(precompileEntry);
+				}
+			}
+
+			if (!mPrecompileEntries.empty())
+			{
+				mPrecompileTask = Task::create("PrecompilePipelines", 
+					std::bind(&VulkanGraphicsPipelineState::precompilePipelines, this), TaskPriority::Low);
+
+				TaskScheduler::instance().addTask(mPrecompileTask);
+			}
+		}
+
 		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_PipelineState);
 	}
 
 	VulkanPipeline* VulkanGraphicsPipelineState::getPipeline(
 		UINT32 deviceIdx, VulkanFramebuffer* framebuffer, UINT32 readOnlyFlags, DrawOperationType drawOp, 
-			const SPtr<VulkanVertexInput>& vertexInput)
+			const SPtr<VertexDeclaration>& vertexDecl, const SPtr<VulkanVertexInput>& vertexInput)
 	{
 		Lock lock(mMutex);
 
@@ -327,19 +400,68 @@ namespace bs { namespace ct
 			return nullptr;
 
 		readOnlyFlags &= ~FBT_COLOR; // Ignore the color
-		GpuPipelineKey key(framebuffer->getId(), vertexInput->getId(), readOnlyFlags, drawOp);
+		GpuPipelineKey key(framebuffer->getLayoutId(), vertexInput->getId(), readOnlyFlags, drawOp);
 
 		PerDeviceData& perDeviceData = mPerDeviceData[deviceIdx];
+		VulkanPipelineCacheManager& cacheManager = perDeviceData.device->getPipelineCacheManager();
+
 		auto iterFind = perDeviceData.pipelines.find(key);
 		if (iterFind != perDeviceData.pipelines.end())
+		{
+			if (!perDeviceData.unusedPrecompiled.empty() && perDeviceData.unusedPrecompiled.erase(iterFind->second) > 0)
+				cacheManager.notifyPrecompiledUsed();
+
 			return iterFind->second;
+		}
+
+		// Note: We can use the default render pass here (default clear/load/read flags), even though that might not be 
+		// the exact one currently bound. This is because load/store operations and layout transitions are allowed to 
+		// differ (as per spec 7.2., such render passes are considered compatible).
+		VkRenderPass renderPass = framebuffer->getRenderPass(RT_NONE, RT_NONE, CLEAR_NONE);
+
+		Timer timer;
+		VulkanPipeline* newPipeline = createPipeline(deviceIdx, renderPass, framebuffer->getLayout(), readOnlyFlags, 
+			drawOp, vertexInput);
+		cacheManager.notifyCreatedOnDemand(timer.getMicroseconds());
 
-		VulkanPipeline* newPipeline = createPipeline(deviceIdx, framebuffer, readOnlyFlags, drawOp, vertexInput);
 		perDeviceData.pipelines[key] = newPipeline;
 
+		if (mStateHash != 0)
+			cacheManager.recordPipeline(mStateHash, framebuffer->getLayoutId(), readOnlyFlags, drawOp, vertexDecl);
+
 		return newPipeline;
 	}
 
+	void VulkanGraphicsPipelineState::precompilePipelines()
+	{
+		for (auto& entry : mPrecompileEntries)
+		{
+			if (mAbortPrecompile)
+				break;
+
+			Lock lock(mMutex);
+
+			PerDeviceData& perDeviceData = mPerDeviceData[entry.deviceIdx];
+			const VulkanRecordedPipeline& recorded = entry.recorded;
+
+			GpuPipelineKey key(recorded.layoutId, entry.vertexInput->getId(), recorded.readOnlyFlags, recorded.drawOp);
+			if (perDeviceData.pipelines.find(key) != perDeviceData.pipelines.end())
+				continue;
+
+			VulkanPipeline* newPipeline = createPipeline(entry.deviceIdx, recorded.renderPass, recorded.layout,
+				recorded.readOnlyFlags, recorded.drawOp, entry.vertexInput);
+
+			perDeviceData.pipelines[key] = newPipeline;
+			perDeviceData.unusedPrecompiled.insert(newPipeline);
+
+			perDeviceData.device->getPipelineCacheManager().notifyPrecompiled();
+		}
+
+		// Vertex declarations and inputs are no longer needed
+		Lock lock(mMutex);
+		mPrecompileEntries.clear();
+	}
+
 	VkPipelineLayout VulkanGraphicsPipelineState::getPipelineLayout(UINT32 deviceIdx) const
 	{
 		return mPerDeviceData[deviceIdx].pipelineLayout;
@@ -369,13 +491,14 @@ namespace bs { namespace ct
 		}
 	}
 
-	VulkanPipeline* VulkanGraphicsPipelineState::createPipeline(UINT32 deviceIdx, VulkanFramebuffer* framebuffer,
-		UINT32 readOnlyFlags, DrawOperationType drawOp, const SPtr<VulkanVertexInput>& vertexInput)
+	VulkanPipeline* VulkanGraphicsPipelineState::createPipeline(UINT32 deviceIdx, VkRenderPass renderPass, 
+		const VulkanFramebufferLayout& layout, UINT32 readOnlyFlags, DrawOperationType drawOp, 
+		const SPtr<VulkanVertexInput>& vertexInput)
 	{
 		mInputAssemblyInfo.topology = VulkanUtility::getDrawOp(drawOp);
 		mTesselationInfo.patchControlPoints = 3; // Not provided by our shaders for now
-		mMultiSampleInfo.rasterizationSamples = framebuffer->getSampleFlags();
-		mColorBlendStateInfo.attachmentCount = framebuffer->getNumColorAttachments();
+		mMultiSampleInfo.rasterizationSamples = layout.sampleFlags;
+		mColorBlendStateInfo.attachmentCount = layout.numColorAttachments;
 
 		DepthStencilState* dsState = getDepthStencilState().get();
 		if (dsState == nullptr)
@@ -407,15 +530,12 @@ namespace bs { namespace ct
 			mDepthStencilInfo.back.depthFailOp = VK_STENCIL_OP_KEEP;
 		}
 
-		// Note: We can use the default render pass here (default clear/load/read flags), even though that might not be the
-		// exact one currently bound. This is because load/store operations and layout transitions are allowed to differ
-		// (as per spec 7.2., such render passes are considered compatible).
-		mPipelineInfo.renderPass = framebuffer->getRenderPass(RT_NONE, RT_NONE, CLEAR_NONE);
+		mPipelineInfo.renderPass = renderPass;
 		mPipelineInfo.layout = mPerDeviceData[deviceIdx].pipelineLayout;
 		mPipelineInfo.pVertexInputState = vertexInput->getCreateInfo();
 
 		bool depthReadOnly;
-		if (framebuffer->hasDepthAttachment())
+		if (layout.hasDepth)
 		{
 			mPipelineInfo.pDepthStencilState = &mDepthStencilInfo;
 			depthReadOnly = (readOnlyFlags & FBT_DEPTH) != 0;
@@ -427,7 +547,7 @@ namespace bs { namespace ct
 		}
 
 		std::array<bool, BS_MAX_MULTIPLE_RENDER_TARGETS> colorReadOnly;
-		if (framebuffer->getNumColorAttachments() > 0)
+		if (layout.numColorAttachments > 0)
 		{
 			mPipelineInfo.pColorBlendState = &mColorBlendStateInfo;
 
@@ -478,7 +598,8 @@ namespace bs { namespace ct
 		VkDevice vkDevice = mPerDeviceData[deviceIdx].device->getLogical();
 
 		VkPipeline pipeline;
-		VkResult result = vkCreateGraphicsPipelines(vkDevice, VK_NULL_HANDLE, 1, &mPipelineInfo, gVulkanAllocator, &pipeline);
+		VkPipelineCache pipelineCache = device->getPipelineCacheManager().getCache();
+		VkResult result = vkCreateGraphicsPipelines(vkDevice, pipelineCache, 1, &mPipelineInfo, gVulkanAllocator, &pipeline);
 		assert(result == VK_SUCCESS);
 
 		// Restore previous stencil op states
@@ -571,7 +692,8 @@ namespace bs { namespace ct
 			pipelineCI.layout = descManager.getPipelineLayout(layouts, numLayouts);
 
 			VkPipeline pipeline;
-			VkResult result = vkCreateComputePipelines(devices[i]->getLogical(), VK_NULL_HANDLE, 1, &pipelineCI,
+			VkPipelineCache pipelineCache = devices[i]->getPipelineCacheManager().getCache();
+			VkResult result = vkCreateComputePipelines(devices[i]->getLogical(), pipelineCache, 1, &pipelineCI,
 														gVulkanAllocator, &pipeline);
 			assert(result == VK_SUCCESS);
 
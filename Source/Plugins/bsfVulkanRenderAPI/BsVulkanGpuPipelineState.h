@@ -5,6 +5,7 @@
 #include "BsVulkanPrerequisites.h"
 #include "BsVulkanResource.h"
 #include "RenderAPI/BsGpuPipelineState.h"
+#include "Managers/BsVulkanPipelineCacheManager.h"
 
 namespace bs { namespace ct
 {
@@ -57,13 +58,15 @@ namespace bs { namespace ct
 		 * @param[in]	readOnlyFlags		Flags that control which portion of the framebuffer is read-only. Accepts
 		 *									combinations of FrameBufferType enum.
 		 * @param[in]	drawOp				Type of geometry that will be drawn using the pipeline.
+		 * @param[in]	vertexDecl			Declaration of the vertex buffers that will be bound with the pipeline.
 		 * @param[in]	vertexInput			State describing inputs to the vertex program.
 		 * @return							Vulkan graphics pipeline object.
 		 * 
 		 * @note	Thread safe.
 		 */
 		VulkanPipeline* getPipeline(UINT32 deviceIdx, VulkanFramebuffer* framebuffer, UINT32 readOnlyFlags, 
-			DrawOperationType drawOp, const SPtr<VulkanVertexInput>& vertexInput);
+			DrawOperationType drawOp, const SPtr<VertexDeclaration>& vertexDecl, 
+			const SPtr<VulkanVertexInput>& vertexInput);
 
 		/** 
 		 * Returns a pipeline layout object for the specified device index. If the device index doesn't match a bit in the
@@ -86,27 +89,32 @@ namespace bs { namespace ct
 		void initialize() override;
 
 		/** 
-		 * Create a new Vulkan graphics pipeline. 
+		 * Create a new Vulkan graphics pipeline. Caller must hold the pipeline state mutex.
 		 * 
 		 * @param[in]	deviceIdx			Index of the device to create the pipeline for.
-		 * @param[in]	framebuffer			Framebuffer object that defines the surfaces this pipeline will render to.
+		 * @param[in]	renderPass			Render pass compatible with the surfaces this pipeline will render to.
+		 * @param[in]	layout				Layout of the surfaces this pipeline will render to.
 		 * @param[in]	readOnlyFlags		Flags that control which portion of the framebuffer is read-only. Accepts
 		 *									combinations of FrameBufferType enum.
 		 * @param[in]	drawOp				Type of geometry that will be drawn using the pipeline.
 		 * @param[in]	vertexInput			State describing inputs to the vertex program.
 		 * @return							Vulkan graphics pipeline object.
-		 * 
-		 * @note	Thread safe.
 		 */
-		VulkanPipeline* createPipeline(UINT32 deviceIdx, VulkanFramebuffer* framebuffer, UINT32 readOnlyFlags, 
-			DrawOperationType drawOp, const SPtr<VulkanVertexInput>& vertexInput);
+		VulkanPipeline* createPipeline(UINT32 deviceIdx, VkRenderPass renderPass, const VulkanFramebufferLayout& layout,
+			UINT32 readOnlyFlags, DrawOperationType drawOp, const SPtr<VulkanVertexInput>& vertexInput);
+
+		/** 
+		 * Creates pipelines for all variations of this pipeline state recorded during previous runs. Meant to be called
+		 * from a worker thread.
+		 */
+		void precompilePipelines();
 
 		/**	Key uniquely identifying GPU pipelines. */
 		struct GpuPipelineKey
 		{
-			GpuPipelineKey(UINT32 framebufferId, UINT32 vertexInputId, UINT32 readOnlyFlags, DrawOperationType drawOp);
+			GpuPipelineKey(UINT32 layoutId, UINT32 vertexInputId, UINT32 readOnlyFlags, DrawOperationType drawOp);
 
-			UINT32 framebufferId;
+			UINT32 layoutId;
 			UINT32 vertexInputId;
 			UINT32 readOnlyFlags;
 			DrawOperationType drawOp;
@@ -132,6 +140,15 @@ namespace bs { namespace ct
 			VulkanDevice* device;
 			VkPipelineLayout pipelineLayout;
 			UnorderedMap<GpuPipelineKey, VulkanPipeline*, HashFunc, EqualFunc> pipelines;
+			UnorderedSet<VulkanPipeline*> unusedPrecompiled;
+		};
+
+		/** Information about a pipeline variation to create ahead of time. */
+		struct PrecompileEntry
+		{
+			UINT32 deviceIdx;
+			VulkanRecordedPipeline recorded;
+			SPtr<VulkanVertexInput> vertexInput;
 		};
 
 		VkPipelineShaderStageCreateInfo mShaderStageInfos[5];
@@ -152,6 +169,11 @@ namespace bs { namespace ct
 		GpuDeviceFlags mDeviceMask;
 		PerDeviceData mPerDeviceData[BS_MAX_DEVICES];
 
+		UINT64 mStateHash = 0;
+		Vector<PrecompileEntry> mPrecompileEntries;
+		SPtr<Task> mPrecompileTask;
+		std::atomic<bool> mAbortPrecompile{false};
+
 		Mutex mMutex;
 	};
 
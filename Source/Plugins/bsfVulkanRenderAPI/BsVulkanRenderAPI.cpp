@@ -13,6 +13,8 @@
 #include "Managers/BsVulkanQueryManager.h"
 #include "Managers/BsVulkanGLSLProgramFactory.h"
 #include "Managers/BsVulkanCommandBufferManager.h"
+#include "Managers/BsVulkanDescriptorManager.h"
+#include "Managers/BsVulkanPipelineCacheManager.h"
 #include "BsVulkanCommandBuffer.h"
 #include "BsVulkanGpuParams.h"
 #include "Managers/BsVulkanVertexInputManager.h"
@@ -288,6 +290,10 @@ namespace bs { namespace ct
 			mGLSLFactory = nullptr;
 		}
 
+		// Cached vertex declarations must be released before the managers that created them
+		for (auto& device : mDevices)
+			device->getPipelineCacheManager().releaseVertexDeclarations();
+
 		VulkanVertexInputManager::shutDown();
 		QueryManager::shutDown();
 		RenderStateManager::shutDown();
@@ -522,7 +528,10 @@ namespace bs { namespace ct
 		VulkanCommandBufferManager& cbm = static_cast<VulkanCommandBufferManager&>(CommandBufferManager::instance());
 		
 		for (UINT32 i = 0; i < (UINT32)mDevices.size(); i++)
+		{
 			cbm.refreshStates(i);
+			mDevices[i]->getDescriptorManager().update();
+		}
 
 		BS_INC_RENDER_STAT(NumPresents);
 	}
@@ -2,6 +2,8 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsVulkanResource.h"
 #include "BsVulkanCommandBuffer.h"
+#include "BsVulkanDevice.h"
+#include "Managers/BsVulkanDescriptorManager.h"
 #include "CoreThread/BsCoreThread.h"
 
 namespace bs { namespace ct
@@ -169,6 +171,9 @@ namespace bs { namespace ct
 
 	void VulkanResourceManager::destroy(VulkanResource* resource)
 	{
+		// Make sure no cached descriptor sets keep referencing the resource
+		mDevice.getDescriptorManager().notifyResourceDestroyed(resource);
+
 #if BS_DEBUG_MODE
 		{
 			Lock lock(mMutex);
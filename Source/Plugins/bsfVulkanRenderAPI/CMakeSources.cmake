@@ -39,6 +39,7 @@ set(BS_VULKANRENDERAPI_INC_MANAGERS
 	"Managers/BsVulkanRenderStateManager.h"
 	"Managers/BsVulkanVertexInputManager.h"
 	"Managers/BsVulkanDescriptorManager.h"
+	"Managers/BsVulkanPipelineCacheManager.h"
 )
 
 set(BS_VULKANRENDERAPI_SRC_NOFILTER
@@ -82,6 +83,7 @@ set(BS_VULKANRENDERAPI_SRC_MANAGERS
 	"Managers/BsVulkanRenderStateManager.cpp"
 	"Managers/BsVulkanVertexInputManager.cpp"
 	"Managers/BsVulkanDescriptorManager.cpp"
+	"Managers/BsVulkanPipelineCacheManager.cpp"
 )
 
 set(BS_VULKANRENDERAPI_INC_WIN32
@@ -69,6 +69,22 @@ namespace bs { namespace ct
 		return hash;
 	}
 
+	VulkanDescriptorSetKey::VulkanDescriptorSetKey(VulkanDescriptorLayout* layout, const UINT64* content, 
+		UINT32 contentSize)
+		:layout(layout), content(content), contentSize(contentSize), hash(layout->getHash())
+	{
+		for (UINT32 i = 0; i < contentSize; i++)
+			hash_combine(hash, content[i]);
+	}
+
+	bool VulkanDescriptorSetKey::operator==(const VulkanDescriptorSetKey& rhs) const
+	{
+		if (layout != rhs.layout || contentSize != rhs.contentSize)
+			return false;
+
+		return memcmp(content, rhs.content, contentSize * sizeof(UINT64)) == 0;
+	}
+
 	VulkanDescriptorManager::VulkanDescriptorManager(VulkanDevice& device)
 		:mDevice(device)
 	{
@@ -77,6 +93,27 @@ namespace bs { namespace ct
 
 	VulkanDescriptorManager::~VulkanDescriptorManager()
 	{
+		// Collect the sets first, as destroying them notifies the manager
+		Vector<VulkanCachedDescriptorSet*> sets = mUncachedSets;
+		for (auto& entry : mCachedSets)
+			sets.push_back(entry.second);
+
+		for (auto& entry : mFreeSets)
+			sets.insert(sets.end(), entry.second.begin(), entry.second.end());
+
+		mCachedSets.clear();
+		mUncachedSets.clear();
+		mSetsPerResource.clear();
+		mFreeSets.clear();
+
+		for (auto& entry : sets)
+		{
+			entry->set->destroy();
+
+			bs_free(entry->content);
+			bs_delete(entry);
+		}
+
 		for (auto& entry : mLayouts)
 		{
 			bs_delete(entry.layout);
@@ -140,6 +177,165 @@ namespace bs { namespace ct
 		return mDevice.getResourceManager().create<VulkanDescriptorSet>(set, allocateInfo.descriptorPool);
 	}
 
+	VulkanCachedDescriptorSet* VulkanDescriptorManager::acquireSet(VulkanDescriptorLayout* layout, 
+		VkWriteDescriptorSet* writes, UINT32 numWrites, const UINT64* content, UINT32 contentSize, 
+		VulkanResource** resources, UINT32 numResources)
+	{
+		VulkanDescriptorSetKey key(layout, content, contentSize);
+
+		Lock lock(mMutex);
+
+		auto iterFind = mCachedSets.find(key);
+		if (iterFind != mCachedSets.end())
+		{
+			VulkanCachedDescriptorSet* entry = iterFind->second;
+			entry->refCount++;
+			entry->lastUsedFrame = mFrameIdx;
+
+			return entry;
+		}
+
+		// Reuse a recycled set if one is available, otherwise allocate a new one
+		VulkanCachedDescriptorSet* entry;
+		Vector<VulkanCachedDescriptorSet*>& freeSets = mFreeSets[layout];
+		if (!freeSets.empty())
+		{
+			entry = freeSets.back();
+			freeSets.pop_back();
+		}
+		else
+		{
+			entry = bs_new<VulkanCachedDescriptorSet>();
+			entry->set = createSet(layout);
+			entry->layout = layout;
+			entry->content = nullptr;
+			entry->contentSize = 0;
+		}
+
+		if (entry->contentSize != contentSize)
+		{
+			bs_free(entry->content);
+			entry->content = bs_allocN<UINT64>(contentSize);
+		}
+
+		memcpy(entry->content, content, contentSize * sizeof(UINT64));
+		entry->contentSize = contentSize;
+		entry->resources.assign(resources, resources + numResources);
+		entry->refCount = 1;
+		entry->lastUsedFrame = mFrameIdx;
+		entry->isCached = true;
+
+		entry->set->write(writes, numWrites);
+
+		key.content = entry->content;
+		mCachedSets[key] = entry;
+
+		for (UINT32 i = 0; i < numResources; i++)
+			mSetsPerResource[resources[i]].push_back(entry);
+
+		return entry;
+	}
+
+	void VulkanDescriptorManager::releaseSet(VulkanCachedDescriptorSet* set)
+	{
+		Lock lock(mMutex);
+
+		assert(set->refCount > 0);
+		set->refCount--;
+		set->lastUsedFrame = mFrameIdx;
+	}
+
+	void VulkanDescriptorManager::notifyResourceDestroyed(VulkanResource* resource)
+	{
+		Lock lock(mMutex);
+
+		auto iterFind = mSetsPerResource.find(resource);
+		if (iterFind == mSetsPerResource.end())
+			return;
+
+		// Sets referencing the resource can no longer be returned by lookup, as a new resource could end up being
+		// allocated at the same address. They are recycled once no longer referenced or used by the GPU.
+		Vector<VulkanCachedDescriptorSet*> sets = std::move(iterFind->second);
+		mSetsPerResource.erase(iterFind);
+
+		for (auto& entry : sets)
+			removeFromCache(entry);
+	}
+
+	void VulkanDescriptorManager::update()
+	{
+		Lock lock(mMutex);
+
+		mFrameIdx++;
+
+		// No need to sweep every frame
+		if ((mFrameIdx % RECYCLE_AFTER_FRAMES) != 0)
+			return;
+
+		auto canRecycle = [](VulkanCachedDescriptorSet* entry)
+		{
+			return entry->refCount == 0 && !entry->set->isBound() && !entry->set->isUsed();
+		};
+
+		Vector<VulkanCachedDescriptorSet*> toRecycle;
+		for (auto& entry : mCachedSets)
+		{
+			VulkanCachedDescriptorSet* set = entry.second;
+			if ((mFrameIdx - set->lastUsedFrame) >= RECYCLE_AFTER_FRAMES && canRecycle(set))
+				toRecycle.push_back(set);
+		}
+
+		for (auto& entry : mUncachedSets)
+		{
+			if (canRecycle(entry))
+				toRecycle.push_back(entry);
+		}
+
+		for (auto& entry : toRecycle)
+			recycle(entry);
+	}
+
+	void VulkanDescriptorManager::recycle(VulkanCachedDescriptorSet* set)
+	{
+		if (set->isCached)
+			removeFromCache(set);
+
+		auto iterFind = std::find(mUncachedSets.begin(), mUncachedSets.end(), set);
+		if (iterFind != mUncachedSets.end())
+		{
+			std::swap(*iterFind, mUncachedSets.back());
+			mUncachedSets.pop_back();
+		}
+
+		for (auto& resource : set->resources)
+		{
+			auto iterFindRes = mSetsPerResource.find(resource);
+			if (iterFindRes == mSetsPerResource.end())
+				continue;
+
+			Vector<VulkanCachedDescriptorSet*>& sets = iterFindRes->second;
+			sets.erase(std::remove(sets.begin(), sets.end(), set), sets.end());
+
+			if (sets.empty())
+				mSetsPerResource.erase(iterFindRes);
+		}
+
+		set->resources.clear();
+		mFreeSets[set->layout].push_back(set);
+	}
+
+	void VulkanDescriptorManager::removeFromCache(VulkanCachedDescriptorSet* set)
+	{
+		if (!set->isCached)
+			return;
+
+		VulkanDescriptorSetKey key(set->layout, set->content, set->contentSize);
+		mCachedSets.erase(key);
+
+		set->isCached = false;
+		mUncachedSets.push_back(set);
+	}
+
 	VkPipelineLayout VulkanDescriptorManager::getPipelineLayout(VulkanDescriptorLayout** layouts, UINT32 numLayouts)
 	{
 		VulkanPipelineLayoutKey key(layouts, numLayouts);
@@ -35,6 +35,43 @@ namespace bs { namespace ct
 		UINT32 numLayouts;
 		VulkanDescriptorLayout** layouts;
 	};
+
+	/** Used as a key in a hash map containing cached descriptor sets. */
+	struct VulkanDescriptorSetKey
+	{
+		VulkanDescriptorSetKey(VulkanDescriptorLayout* layout, const UINT64* content, UINT32 contentSize);
+
+		/** Compares two descriptor set keys. */
+		bool operator==(const VulkanDescriptorSetKey& rhs) const;
+
+		VulkanDescriptorLayout* layout;
+		const UINT64* content;
+		UINT32 contentSize;
+		size_t hash;
+	};
+
+	/** Descriptor set shared by all GPU parameter objects with the same descriptor layout and contents. */
+	struct VulkanCachedDescriptorSet
+	{
+		VulkanDescriptorSet* set;
+		VulkanDescriptorLayout* layout;
+
+		/** Contents the set was written with, used for lookup. */
+		UINT64* content;
+		UINT32 contentSize;
+
+		/** Resources referenced by the set. The set cannot be reused once any of them is destroyed. */
+		Vector<VulkanResource*> resources;
+
+		/** Number of GPU parameter objects currently referencing the set. */
+		UINT32 refCount;
+
+		/** Frame during which the set was last referenced. */
+		UINT64 lastUsedFrame;
+
+		/** True if the set can be found through lookup. */
+		bool isCached;
+	};
 }}
 
 /** @cond STDLIB */
@@ -66,6 +103,16 @@ namespace std
 			return value.calculateHash();
 		}
 	};
+
+	/**	Hash value generator for VulkanDescriptorSetKey. */
+	template<>
+	struct hash<bs::ct::VulkanDescriptorSetKey>
+	{
+		size_t operator()(const bs::ct::VulkanDescriptorSetKey& value) const
+		{
+			return value.hash;
+		}
+	};
 }
 
 /** @} */
@@ -77,7 +124,17 @@ namespace bs { namespace ct
 	 *  @{
 	 */
 
-	/** Manages allocation of descriptor layouts and sets for a single Vulkan device. */
+	/** 
+	 * Manages allocation of descriptor layouts and sets for a single Vulkan device. Descriptor sets are cached by their 
+	 * contents, so objects binding the same resources share a single set, and sets that go unused for a few frames are 
+	 * recycled instead of freed.
+	 * 
+	 * Locking order: VulkanGpuParams holds its own mutex while calling acquireSet() and releaseSet(). While holding its
+	 * mutex the manager locks the mutexes of descriptor sets (when checking if they are in use), and of the resource
+	 * manager (when allocating sets). The manager never calls into GPU parameter objects, and resources call
+	 * notifyResourceDestroyed() only after releasing their own mutex, so the order is always GPU params -> descriptor
+	 * manager -> resource.
+	 */
 	class VulkanDescriptorManager
 	{
 	public:
@@ -90,15 +147,66 @@ namespace bs { namespace ct
 		/** Allocates a new empty descriptor set matching the provided layout. */
 		VulkanDescriptorSet* createSet(VulkanDescriptorLayout* layout);
 
+		/** 
+		 * Returns a descriptor set with the provided layout and contents. If a set with the same contents already exists
+		 * it is returned, otherwise a recycled or a newly allocated set is written using the provided write operations. 
+		 * Returned set must be released by calling releaseSet() once no longer needed.
+		 * 
+		 * @param[in]	layout			Layout of the descriptor set.
+		 * @param[in]	writes			Write operations that fully describe the descriptor set contents.
+		 * @param[in]	numWrites		Number of entries in the @p writes array.
+		 * @param[in]	content			Data uniquely identifying the contents written by @p writes, used for lookup.
+		 * @param[in]	contentSize		Number of 64-bit words in the @p content array.
+		 * @param[in]	resources		Resources referenced by the descriptor set.
+		 * @param[in]	numResources	Number of entries in the @p resources array.
+		 * 
+		 * @note	Thread safe. Called with the calling GPU parameter object's mutex held, see the class description
+		 *			for the locking order.
+		 */
+		VulkanCachedDescriptorSet* acquireSet(VulkanDescriptorLayout* layout, VkWriteDescriptorSet* writes, 
+			UINT32 numWrites, const UINT64* content, UINT32 contentSize, VulkanResource** resources, UINT32 numResources);
+
+		/** Releases a descriptor set previously retrieved from acquireSet(). Thread safe. */
+		void releaseSet(VulkanCachedDescriptorSet* set);
+
+		/** 
+		 * Notifies the manager that a resource was destroyed, so that any sets referencing the resource are no longer 
+		 * returned from acquireSet(). Thread safe.
+		 */
+		void notifyResourceDestroyed(VulkanResource* resource);
+
+		/** Recycles descriptor sets that haven't been used for a while. Should be called once per frame. */
+		void update();
+
 		/** Attempts to find an existing one, or allocates a new pipeline layout based on the provided descriptor layouts. */
 		VkPipelineLayout getPipelineLayout(VulkanDescriptorLayout** layouts, UINT32 numLayouts);
 
 	protected:
+		/** 
+		 * Removes a set from the lookup and from the per-resource lists, and makes it available for reuse by a set with
+		 * different contents. Caller must hold the mutex.
+		 */
+		void recycle(VulkanCachedDescriptorSet* set);
+
+		/** Removes a set from the lookup, so it cannot be found by acquireSet(). Caller must hold the mutex. */
+		void removeFromCache(VulkanCachedDescriptorSet* set);
+
+		/** Number of frames a set needs to go unused before it is recycled. */
+		static const UINT32 RECYCLE_AFTER_FRAMES = 8;
+
 		VulkanDevice& mDevice;
 
 		UnorderedSet<VulkanLayoutKey> mLayouts; 
 		UnorderedMap<VulkanPipelineLayoutKey, VkPipelineLayout> mPipelineLayouts;
 		Vector<VulkanDescriptorPool*> mPools;
+
+		UnorderedMap<VulkanDescriptorSetKey, VulkanCachedDescriptorSet*> mCachedSets;
+		Vector<VulkanCachedDescriptorSet*> mUncachedSets;
+		UnorderedMap<VulkanResource*, Vector<VulkanCachedDescriptorSet*>> mSetsPerResource;
+		UnorderedMap<VulkanDescriptorLayout*, Vector<VulkanCachedDescriptorSet*>> mFreeSets;
+		UINT64 mFrameIdx = 0;
+
+		Mutex mMutex;
 	};
 
 	/** @} */
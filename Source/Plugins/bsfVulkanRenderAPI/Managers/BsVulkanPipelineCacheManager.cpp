@@ -0,0 +1,473 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Managers/BsVulkanPipelineCacheManager.h"
+#include "BsVulkanDevice.h"
+#include "Managers/BsHardwareBufferManager.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+
+namespace bs { namespace ct
+{
+	/** Reads a single value from the stream. Returns false if the stream ended before the value was read. */
+	template<class T>
+	static bool readValue(DataStream& stream, T& value)
+	{
+		return stream.read(&value, sizeof(value)) == sizeof(value);
+	}
+
+	/** Writes a single value to the stream. */
+	template<class T>
+	static void writeValue(DataStream& stream, const T& value)
+	{
+		stream.write(&value, sizeof(value));
+	}
+
+	VulkanPipelineCacheManager::VulkanPipelineCacheManager(VulkanDevice& device)
+		:mDevice(device)
+	{
+		Vector<UINT8> cacheData;
+		load(cacheData);
+
+		VkPipelineCacheCreateInfo cacheCI;
+		cacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		cacheCI.pNext = nullptr;
+		cacheCI.flags = 0;
+		cacheCI.initialDataSize = cacheData.size();
+		cacheCI.pInitialData = cacheData.empty() ? nullptr : cacheData.data();
+
+		VkResult result = vkCreatePipelineCache(mDevice.getLogical(), &cacheCI, gVulkanAllocator, &mCache);
+		if (result != VK_SUCCESS)
+		{
+			// Driver rejected the data, start with an empty cache
+			LOGWRN("Vulkan driver rejected the pipeline cache data, starting with an empty cache.");
+
+			cacheCI.initialDataSize = 0;
+			cacheCI.pInitialData = nullptr;
+
+			result = vkCreatePipelineCache(mDevice.getLogical(), &cacheCI, gVulkanAllocator, &mCache);
+			assert(result == VK_SUCCESS);
+		}
+	}
+
+	VulkanPipelineCacheManager::~VulkanPipelineCacheManager()
+	{
+		// Normally already released by the render API during shutdown, but make sure no declaration outlives the device
+		releaseVertexDeclarations();
+		save();
+
+		if (mStats.numCreatedOnDemand > 0 || mStats.numPrecompiled > 0)
+		{
+			LOGDBG("Vulkan pipelines created on demand: " + toString(mStats.numCreatedOnDemand) + " (total " +
+				toString(mStats.onDemandCreationTime) + " ms, longest " + toString(mStats.maxOnDemandCreationTime) +
+				" ms). Pipelines created ahead of time: " + toString(mStats.numPrecompiled) + " (" +
+				toString(mStats.numPrecompiledUsed) + " used).");
+		}
+
+		VkDevice device = mDevice.getLogical();
+		for (auto& entry : mRenderPasses)
+		{
+			if (entry != VK_NULL_HANDLE)
+				vkDestroyRenderPass(device, entry, gVulkanAllocator);
+		}
+
+		vkDestroyPipelineCache(device, mCache, gVulkanAllocator);
+	}
+
+	void VulkanPipelineCacheManager::releaseVertexDeclarations()
+	{
+		Lock lock(mMutex);
+
+		// Layouts are kept, so the declarations can still be re-created and saved
+		for (auto& entry : mVertexDecls)
+			entry = nullptr;
+	}
+
+	UINT32 VulkanPipelineCacheManager::getLayoutId(const VulkanFramebufferLayout& layout)
+	{
+		Lock lock(mMutex);
+
+		// Only a handful of different layouts are expected, so a linear search is fine
+		UINT32 numLayouts = (UINT32)mLayouts.size();
+		for (UINT32 i = 0; i < numLayouts; i++)
+		{
+			if (mLayouts[i] == layout)
+				return i;
+		}
+
+		mLayouts.push_back(layout);
+		mRenderPasses.push_back(VK_NULL_HANDLE);
+
+		return numLayouts;
+	}
+
+	UINT32 VulkanPipelineCacheManager::getVertexLayoutId(const Vector<VertexElement>& elements)
+	{
+		UINT32 numVertexLayouts = (UINT32)mVertexLayouts.size();
+		for (UINT32 i = 0; i < numVertexLayouts; i++)
+		{
+			if (mVertexLayouts[i] == elements)
+				return i;
+		}
+
+		mVertexLayouts.push_back(elements);
+		mVertexDecls.push_back(nullptr);
+
+		return numVertexLayouts;
+	}
+
+	void VulkanPipelineCacheManager::recordPipeline(UINT64 stateHash, UINT32 layoutId, UINT32 readOnlyFlags,
+		DrawOperationType drawOp, const SPtr<VertexDeclaration>& vertexDecl)
+	{
+		Lock lock(mMutex);
+
+		if (mNumRecords >= MAX_RECORDED_PIPELINES)
+			return;
+
+		UINT32 vertexLayoutId = getVertexLayoutId(vertexDecl->getProperties().getElements());
+
+		Vector<RecordedEntry>& entries = mRecords[stateHash];
+		for (auto& entry : entries)
+		{
+			if (entry.layoutId == layoutId && entry.readOnlyFlags == readOnlyFlags && entry.drawOp == drawOp &&
+				entry.vertexLayoutId == vertexLayoutId)
+				return;
+		}
+
+		entries.push_back({ layoutId, readOnlyFlags, drawOp, vertexLayoutId });
+		mNumRecords++;
+
+		if (mVertexDecls[vertexLayoutId] == nullptr)
+			mVertexDecls[vertexLayoutId] = vertexDecl;
+	}
+
+	Vector<VulkanRecordedPipeline> VulkanPipelineCacheManager::getRecordedPipelines(UINT64 stateHash)
+	{
+		Lock lock(mMutex);
+
+		Vector<VulkanRecordedPipeline> output;
+
+		auto iterFind = mRecords.find(stateHash);
+		if (iterFind == mRecords.end())
+			return output;
+
+		for (auto& entry : iterFind->second)
+		{
+			// Render passes and vertex declarations for layouts loaded from disk are created on first use
+			VkRenderPass& renderPass = mRenderPasses[entry.layoutId];
+			if (renderPass == VK_NULL_HANDLE)
+				renderPass = VulkanFramebuffer::createCompatibleRenderPass(mDevice.getLogical(), mLayouts[entry.layoutId]);
+
+			SPtr<VertexDeclaration>& vertexDecl = mVertexDecls[entry.vertexLayoutId];
+			if (vertexDecl == nullptr)
+			{
+				vertexDecl = HardwareBufferManager::instance().createVertexDeclaration(
+					mVertexLayouts[entry.vertexLayoutId]);
+			}
+
+			VulkanRecordedPipeline recordedPipeline;
+			recordedPipeline.renderPass = renderPass;
+			recordedPipeline.layout = mLayouts[entry.layoutId];
+			recordedPipeline.layoutId = entry.layoutId;
+			recordedPipeline.readOnlyFlags = entry.readOnlyFlags;
+			recordedPipeline.drawOp = entry.drawOp;
+			recordedPipeline.vertexDecl = vertexDecl;
+
+			output.push_back(recordedPipeline);
+		}
+
+		return output;
+	}
+
+	void VulkanPipelineCacheManager::notifyCreatedOnDemand(UINT64 time)
+	{
+		Lock lock(mMutex);
+
+		float timeMs = time / 1000.0f;
+
+		mStats.numCreatedOnDemand++;
+		mStats.onDemandCreationTime += timeMs;
+		mStats.maxOnDemandCreationTime = std::max(mStats.maxOnDemandCreationTime, timeMs);
+	}
+
+	void VulkanPipelineCacheManager::notifyPrecompiled()
+	{
+		Lock lock(mMutex);
+		mStats.numPrecompiled++;
+	}
+
+	void VulkanPipelineCacheManager::notifyPrecompiledUsed()
+	{
+		Lock lock(mMutex);
+		mStats.numPrecompiledUsed++;
+	}
+
+	VulkanPipelineCreationStats VulkanPipelineCacheManager::getStats() const
+	{
+		Lock lock(mMutex);
+		return mStats;
+	}
+
+	Path VulkanPipelineCacheManager::getCachePath(const String& extension) const
+	{
+		const VkPhysicalDeviceProperties& props = mDevice.getDeviceProperties();
+
+		Path path = FileSystem::getTempDirectoryPath();
+		path.append("bsf/VulkanPipelineCache/");
+		path.setFilename(toString(props.vendorID) + "_" + toString(props.deviceID) + "_" +
+			toString(props.driverVersion) + extension);
+
+		return path;
+	}
+
+	void VulkanPipelineCacheManager::load(Vector<UINT8>& cacheData)
+	{
+		const VkPhysicalDeviceProperties& props = mDevice.getDeviceProperties();
+
+		Path cachePath = getCachePath(".cache");
+		Path recordsPath = getCachePath(".pipelines");
+
+		// Pipeline cache data, prefixed by a header identifying the device it was created on
+		{
+			Lock fileLock = FileScheduler::getLock(cachePath);
+
+			SPtr<DataStream> stream = FileSystem::isFile(cachePath) ? FileSystem::openFile(cachePath) : nullptr;
+			if (stream != nullptr)
+			{
+				cacheData.resize(stream->size());
+				if (!cacheData.empty())
+					cacheData.resize(stream->read(cacheData.data(), cacheData.size()));
+			}
+		}
+
+		// Drivers are expected to validate the data, but some don't handle data from a different device gracefully
+		if (!cacheData.empty())
+		{
+			const UINT32 headerSize = 16 + VK_UUID_SIZE;
+			const char* rejectReason = nullptr;
+
+			if (cacheData.size() < headerSize)
+				rejectReason = "truncated header";
+			else
+			{
+				UINT32 header[4];
+				memcpy(header, cacheData.data(), sizeof(header));
+
+				if (header[0] < headerSize || header[0] > cacheData.size())
+					rejectReason = "invalid header size";
+				else if (header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+					rejectReason = "unsupported header version";
+				else if (header[2] != props.vendorID || header[3] != props.deviceID)
+					rejectReason = "created on a different device";
+				else if (memcmp(cacheData.data() + 16, props.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+					rejectReason = "created by a different driver";
+			}
+
+			if (rejectReason != nullptr)
+			{
+				LOGWRN("Discarding Vulkan pipeline cache \"" + cachePath.toString() + "\": " + rejectReason + ".");
+				cacheData.clear();
+			}
+			else
+			{
+				LOGDBG("Loaded Vulkan pipeline cache \"" + cachePath.toString() + "\" (" +
+					toString((UINT32)cacheData.size()) + " bytes).");
+			}
+		}
+
+		// Recorded pipeline state variations
+		Lock fileLock = FileScheduler::getLock(recordsPath);
+
+		SPtr<DataStream> stream = FileSystem::isFile(recordsPath) ? FileSystem::openFile(recordsPath) : nullptr;
+		if (stream == nullptr)
+			return;
+
+		if (readRecords(*stream))
+		{
+			LOGDBG("Loaded " + toString(mNumRecords) + " recorded Vulkan pipeline states from \"" +
+				recordsPath.toString() + "\".");
+		}
+		else
+		{
+			LOGWRN("Discarding recorded Vulkan pipeline states \"" + recordsPath.toString() + "\": the file is " +
+				"corrupted or was written by a different version.");
+		}
+	}
+
+	bool VulkanPipelineCacheManager::readRecords(DataStream& stream)
+	{
+		UINT32 version = 0;
+		if (!readValue(stream, version) || version != RECORD_FILE_VERSION)
+			return false;
+
+		Vector<VulkanFramebufferLayout> layouts;
+		Vector<Vector<VertexElement>> vertexLayouts;
+		UnorderedMap<UINT64, Vector<RecordedEntry>> records;
+		UINT32 numRecords = 0;
+
+		UINT32 numLayouts = 0;
+		if (!readValue(stream, numLayouts))
+			return false;
+
+		for (UINT32 i = 0; i < numLayouts; i++)
+		{
+			VulkanFramebufferLayout layout;
+			UINT8 hasDepth = 0;
+
+			if (!readValue(stream, layout.numColorAttachments) ||
+				layout.numColorAttachments > BS_MAX_MULTIPLE_RENDER_TARGETS)
+				return false;
+
+			for (UINT32 j = 0; j < layout.numColorAttachments; j++)
+			{
+				if (!readValue(stream, layout.colorFormats[j]))
+					return false;
+			}
+
+			if (!readValue(stream, hasDepth) || !readValue(stream, layout.depthFormat) ||
+				!readValue(stream, layout.sampleFlags))
+				return false;
+
+			layout.hasDepth = hasDepth != 0;
+			layouts.push_back(layout);
+		}
+
+		UINT32 numVertexLayouts = 0;
+		if (!readValue(stream, numVertexLayouts))
+			return false;
+
+		for (UINT32 i = 0; i < numVertexLayouts; i++)
+		{
+			UINT32 numElements = 0;
+			if (!readValue(stream, numElements))
+				return false;
+
+			Vector<VertexElement> elements;
+			for (UINT32 j = 0; j < numElements; j++)
+			{
+				UINT16 streamIdx, semanticIdx;
+				UINT32 offset, type, semantic, instanceStepRate;
+
+				if (!readValue(stream, streamIdx) || !readValue(stream, offset) || !readValue(stream, type) ||
+					!readValue(stream, semantic) || !readValue(stream, semanticIdx) ||
+					!readValue(stream, instanceStepRate))
+					return false;
+
+				elements.push_back(VertexElement(streamIdx, offset, (VertexElementType)type,
+					(VertexElementSemantic)semantic, semanticIdx, instanceStepRate));
+			}
+
+			vertexLayouts.push_back(elements);
+		}
+
+		if (!readValue(stream, numRecords) || numRecords > MAX_RECORDED_PIPELINES)
+			return false;
+
+		for (UINT32 i = 0; i < numRecords; i++)
+		{
+			UINT64 stateHash;
+			UINT32 drawOp;
+			RecordedEntry entry;
+
+			if (!readValue(stream, stateHash) || !readValue(stream, entry.layoutId) ||
+				!readValue(stream, entry.readOnlyFlags) || !readValue(stream, drawOp) ||
+				!readValue(stream, entry.vertexLayoutId))
+				return false;
+
+			if (entry.layoutId >= numLayouts || entry.vertexLayoutId >= numVertexLayouts)
+				return false;
+
+			entry.drawOp = (DrawOperationType)drawOp;
+			records[stateHash].push_back(entry);
+		}
+
+		// Only accept the records if the entire file was read successfully
+		mLayouts = layouts;
+		mRenderPasses.resize(mLayouts.size(), VK_NULL_HANDLE);
+		mVertexLayouts = vertexLayouts;
+		mVertexDecls.resize(mVertexLayouts.size());
+		mRecords = records;
+		mNumRecords = numRecords;
+
+		return true;
+	}
+
+	void VulkanPipelineCacheManager::save()
+	{
+		Path cachePath = getCachePath(".cache");
+		Path recordsPath = getCachePath(".pipelines");
+
+		if (!FileSystem::exists(cachePath.getParent()))
+			FileSystem::createDir(cachePath.getParent());
+
+		size_t dataSize = 0;
+		VkResult result = vkGetPipelineCacheData(mDevice.getLogical(), mCache, &dataSize, nullptr);
+		if (result == VK_SUCCESS && dataSize > 0)
+		{
+			Vector<UINT8> cacheData(dataSize);
+			result = vkGetPipelineCacheData(mDevice.getLogical(), mCache, &dataSize, cacheData.data());
+
+			if (result == VK_SUCCESS)
+			{
+				Lock fileLock = FileScheduler::getLock(cachePath);
+
+				SPtr<DataStream> stream = FileSystem::createAndOpenFile(cachePath);
+				if (stream != nullptr)
+					stream->write(cacheData.data(), dataSize);
+			}
+		}
+
+		Lock lock(mMutex);
+		Lock fileLock = FileScheduler::getLock(recordsPath);
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(recordsPath);
+		if (stream == nullptr)
+			return;
+
+		UINT32 version = RECORD_FILE_VERSION;
+		writeValue(*stream, version);
+		writeValue(*stream, (UINT32)mLayouts.size());
+
+		for (auto& layout : mLayouts)
+		{
+			writeValue(*stream, layout.numColorAttachments);
+
+			for (UINT32 i = 0; i < layout.numColorAttachments; i++)
+				writeValue(*stream, layout.colorFormats[i]);
+
+			writeValue(*stream, (UINT8)(layout.hasDepth ? 1 : 0));
+			writeValue(*stream, layout.depthFormat);
+			writeValue(*stream, layout.sampleFlags);
+		}
+
+		writeValue(*stream, (UINT32)mVertexLayouts.size());
+
+		for (auto& elements : mVertexLayouts)
+		{
+			writeValue(*stream, (UINT32)elements.size());
+
+			for (auto& element : elements)
+			{
+				writeValue(*stream, element.getStreamIdx());
+				writeValue(*stream, element.getOffset());
+				writeValue(*stream, (UINT32)element.getType());
+				writeValue(*stream, (UINT32)element.getSemantic());
+				writeValue(*stream, element.getSemanticIdx());
+				writeValue(*stream, element.getInstanceStepRate());
+			}
+		}
+
+		writeValue(*stream, mNumRecords);
+
+		for (auto& entries : mRecords)
+		{
+			for (auto& entry : entries.second)
+			{
+				writeValue(*stream, entries.first);
+				writeValue(*stream, entry.layoutId);
+				writeValue(*stream, entry.readOnlyFlags);
+				writeValue(*stream, (UINT32)entry.drawOp);
+				writeValue(*stream, entry.vertexLayoutId);
+			}
+		}
+	}
+}}
@@ -0,0 +1,171 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsVulkanPrerequisites.h"
+#include "BsVulkanFramebuffer.h"
+#include "RenderAPI/BsVertexDeclaration.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Vulkan
+	 *  @{
+	 */
+
+	/** Statistics about graphics pipeline creation on a single device. */
+	struct VulkanPipelineCreationStats
+	{
+		/** Number of pipelines created when first used. Each such creation stalls the thread recording the commands. */
+		UINT32 numCreatedOnDemand = 0;
+
+		/** Total time spent creating pipelines on demand, in milliseconds. */
+		float onDemandCreationTime = 0.0f;
+
+		/** Longest time spent creating a single pipeline on demand, in milliseconds. */
+		float maxOnDemandCreationTime = 0.0f;
+
+		/** Number of pipelines created ahead of time on a worker thread. */
+		UINT32 numPrecompiled = 0;
+
+		/** Number of pipelines created ahead of time that were later used for rendering. */
+		UINT32 numPrecompiledUsed = 0;
+	};
+
+	/** Describes a variation of a graphics pipeline state that was used before and is expected to be used again. */
+	struct VulkanRecordedPipeline
+	{
+		/** Render pass compatible with the frame-buffers the pipeline was used with. */
+		VkRenderPass renderPass;
+
+		/** Layout of the frame-buffers the pipeline was used with. */
+		VulkanFramebufferLayout layout;
+
+		/** Layout ID of the frame-buffers the pipeline was used with. */
+		UINT32 layoutId;
+
+		/** Flags that control which portion of the framebuffer is read-only. */
+		UINT32 readOnlyFlags;
+
+		/** Type of geometry the pipeline was used to draw. */
+		DrawOperationType drawOp;
+
+		/** Declaration of the vertex buffers the pipeline was used with. */
+		SPtr<VertexDeclaration> vertexDecl;
+	};
+
+	/**
+	 * Manages the Vulkan pipeline cache of a single device, persisting it between runs. Also records which variations of
+	 * graphics pipeline states end up being used, so they can be created ahead of time on the next run, and keeps track of
+	 * statistics about pipeline creation.
+	 */
+	class VulkanPipelineCacheManager
+	{
+	public:
+		VulkanPipelineCacheManager(VulkanDevice& device);
+		~VulkanPipelineCacheManager();
+
+		/** Returns the pipeline cache object to provide when creating pipelines. */
+		VkPipelineCache getCache() const { return mCache; }
+
+		/**
+		 * Returns an ID shared by all frame-buffers with the provided layout. IDs persist between runs, as long as the
+		 * cache isn't invalidated.
+		 *
+		 * @note	Thread safe.
+		 */
+		UINT32 getLayoutId(const VulkanFramebufferLayout& layout);
+
+		/**
+		 * Records a variation of a graphics pipeline state that was used for rendering, so it can be created ahead of
+		 * time in the future.
+		 *
+		 * @param[in]	stateHash		Hash uniquely identifying the pipeline state, valid across runs.
+		 * @param[in]	layoutId		Layout ID of the frame-buffer the pipeline was used with.
+		 * @param[in]	readOnlyFlags	Flags that control which portion of the framebuffer is read-only.
+		 * @param[in]	drawOp			Type of geometry the pipeline was used to draw.
+		 * @param[in]	vertexDecl		Declaration of the vertex buffers the pipeline was used with.
+		 *
+		 * @note	Thread safe.
+		 */
+		void recordPipeline(UINT64 stateHash, UINT32 layoutId, UINT32 readOnlyFlags, DrawOperationType drawOp,
+			const SPtr<VertexDeclaration>& vertexDecl);
+
+		/**
+		 * Returns all previously recorded variations of the pipeline state with the provided hash.
+		 *
+		 * @note	Core thread only.
+		 */
+		Vector<VulkanRecordedPipeline> getRecordedPipelines(UINT64 stateHash);
+
+		/**
+		 * Notifies the manager that a pipeline had to be created when first used.
+		 *
+		 * @param[in]	time	Time it took to create the pipeline, in microseconds.
+		 */
+		void notifyCreatedOnDemand(UINT64 time);
+
+		/** Notifies the manager that a pipeline was created ahead of time. */
+		void notifyPrecompiled();
+
+		/** Notifies the manager that a pipeline created ahead of time was used for the first time. */
+		void notifyPrecompiledUsed();
+
+		/** Returns statistics about pipelines created on the device so far. */
+		VulkanPipelineCreationStats getStats() const;
+
+		/** 
+		 * Releases vertex declarations referenced by recorded pipelines. Must be called before the hardware buffer
+		 * manager is shut down, as the declarations were created through it.
+		 */
+		void releaseVertexDeclarations();
+
+	private:
+		/** Information about a single recorded pipeline state variation. */
+		struct RecordedEntry
+		{
+			UINT32 layoutId;
+			UINT32 readOnlyFlags;
+			DrawOperationType drawOp;
+			UINT32 vertexLayoutId;
+		};
+
+		/** Returns an ID uniquely identifying the provided vertex layout. Caller must hold the mutex. */
+		UINT32 getVertexLayoutId(const Vector<VertexElement>& elements);
+
+		/** Returns the path to the file with the specified extension, in which the device's cached data is stored. */
+		Path getCachePath(const String& extension) const;
+
+		/**
+		 * Reads the pipeline cache data and recorded pipelines from the disk. Cache data is left empty if it was
+		 * created on a different device or driver, or its header is malformed.
+		 */
+		void load(Vector<UINT8>& cacheData);
+
+		/**
+		 * Reads recorded pipelines from the stream. Returns false, leaving the current records untouched, if the stream
+		 * was written by a different file version or is corrupted.
+		 */
+		bool readRecords(DataStream& stream);
+
+		/** Writes the pipeline cache data and recorded pipelines to the disk. */
+		void save();
+
+		static const UINT32 RECORD_FILE_VERSION = 1;
+		static const UINT32 MAX_RECORDED_PIPELINES = 16384;
+
+		VulkanDevice& mDevice;
+		VkPipelineCache mCache = VK_NULL_HANDLE;
+
+		Vector<VulkanFramebufferLayout> mLayouts;
+		Vector<VkRenderPass> mRenderPasses;
+		Vector<Vector<VertexElement>> mVertexLayouts;
+		Vector<SPtr<VertexDeclaration>> mVertexDecls;
+		UnorderedMap<UINT64, Vector<RecordedEntry>> mRecords;
+		UINT32 mNumRecords = 0;
+
+		VulkanPipelineCreationStats mStats;
+		mutable Mutex mMutex;
+	};
+
+	/** @} */
+}}